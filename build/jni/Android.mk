@@ -41,8 +41,12 @@ LOCAL_SRC_FILES :=../../ouzel/animators/Animator.cpp \
     ../../ouzel/audio/opensl/AudioDeviceSL.cpp \
     ../../ouzel/audio/Audio.cpp \
     ../../ouzel/audio/AudioDevice.cpp \
+    ../../ouzel/audio/Effect.cpp \
+    ../../ouzel/audio/Filter.cpp \
     ../../ouzel/audio/Listener.cpp \
+    ../../ouzel/audio/Limiter.cpp \
     ../../ouzel/audio/Mixer.cpp \
+    ../../ouzel/audio/Reverb.cpp \
     ../../ouzel/audio/Sound.cpp \
     ../../ouzel/audio/SoundData.cpp \
     ../../ouzel/audio/SoundDataVorbis.cpp \
@@ -56,14 +60,18 @@ LOCAL_SRC_FILES :=../../ouzel/animators/Animator.cpp \
     ../../ouzel/core/android/main.cpp \
     ../../ouzel/core/android/WindowResourceAndroid.cpp \
     ../../ouzel/core/Engine.cpp \
+    ../../ouzel/core/FramePacer.cpp \
+    ../../ouzel/core/Profiler.cpp \
     ../../ouzel/core/Timer.cpp \
     ../../ouzel/core/UpdateCallback.cpp \
+    ../../ouzel/core/UpdateScheduler.cpp \
     ../../ouzel/core/Window.cpp \
     ../../ouzel/core/WindowResource.cpp \
     ../../ouzel/events/EventDispatcher.cpp \
     ../../ouzel/events/EventHandler.cpp \
     ../../ouzel/files/Archive.cpp \
     ../../ouzel/files/File.cpp \
+    ../../ouzel/files/MappedFile.cpp \
     ../../ouzel/files/FileSystem.cpp \
     ../../ouzel/graphics/empty/BlendStateResourceEmpty.cpp \
     ../../ouzel/graphics/empty/BufferResourceEmpty.cpp \
@@ -140,19 +148,24 @@ LOCAL_SRC_FILES :=../../ouzel/animators/Animator.cpp \
     ../../ouzel/scene/Component.cpp \
     ../../ouzel/scene/Layer.cpp \
     ../../ouzel/scene/Light.cpp \
+    ../../ouzel/scene/MeshOptimizer.cpp \
     ../../ouzel/scene/ModelData.cpp \
     ../../ouzel/scene/ModelRenderer.cpp \
+    ../../ouzel/scene/InstancedModelRenderer.cpp \
     ../../ouzel/scene/ParticleSystem.cpp \
     ../../ouzel/scene/ParticleSystemData.cpp \
     ../../ouzel/scene/Scene.cpp \
     ../../ouzel/scene/SceneManager.cpp \
+    ../../ouzel/scene/AnimationSystem.cpp \
     ../../ouzel/scene/ShapeRenderer.cpp \
     ../../ouzel/scene/Sprite.cpp \
     ../../ouzel/scene/SpriteData.cpp \
     ../../ouzel/scene/TextRenderer.cpp \
     ../../ouzel/thread/Condition.cpp \
+    ../../ouzel/thread/ExecuteQueue.cpp \
     ../../ouzel/thread/Mutex.cpp \
     ../../ouzel/thread/Thread.cpp \
+    ../../ouzel/thread/JobSystem.cpp \
     ../../ouzel/utils/INI.cpp \
     ../../ouzel/utils/JSON.cpp \
     ../../ouzel/utils/Log.cpp \
@@ -13,11 +13,12 @@ namespace ouzel
         Animator::Animator(float initLength):
             Component(Component::ANIMATOR), length(initLength)
         {
-            updateCallback.callback = std::bind(&Animator::update, this, std::placeholders::_1);
         }
 
         Animator::~Animator()
         {
+            if (animationSystem) animationSystem->removeAnimator(this);
+
             if (parent) parent->removeAnimator(this);
 
             for (const auto& animator : animators)
@@ -55,15 +56,11 @@ namespace ouzel
 
                 updateProgress();
             }
-            else
-            {
-                updateCallback.remove();
-            }
         }
 
         void Animator::start()
         {
-            engine->scheduleUpdate(&updateCallback);
+            engine->getSceneManager()->getAnimationSystem()->addAnimator(this);
             play();
 
             Event startEvent;
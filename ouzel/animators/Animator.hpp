@@ -6,7 +6,7 @@
 #include <functional>
 #include <memory>
 #include "scene/Component.hpp"
-#include "core/UpdateCallback.hpp"
+#include "scene/AnimationSystem.hpp"
 
 namespace ouzel
 {
@@ -17,6 +17,7 @@ namespace ouzel
         class Animator: public Component
         {
             friend Actor;
+            friend AnimationSystem;
         public:
             Animator(float initLength);
             virtual ~Animator();
@@ -83,7 +84,8 @@ namespace ouzel
             Animator* parent = nullptr;
             Actor* targetActor = nullptr;
 
-            UpdateCallback updateCallback;
+            AnimationSystem* animationSystem = nullptr;
+            uint32_t animationIndex = AnimationSystem::INVALID_INDEX;
 
             std::vector<Animator*> animators;
             std::vector<std::unique_ptr<Animator>> ownedAnimators;
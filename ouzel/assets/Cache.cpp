@@ -12,6 +12,7 @@
 #include "scene/ParticleSystemData.hpp"
 #include "scene/SpriteData.hpp"
 #include "files/FileSystem.hpp"
+#include "files/MappedFile.hpp"
 #include "audio/SoundDataWave.hpp"
 #include "audio/SoundDataVorbis.hpp"
 #include "gui/BMFont.hpp"
@@ -22,6 +23,8 @@ namespace ouzel
 {
     namespace assets
     {
+        static const scene::SpriteData EMPTY_SPRITE_DATA;
+
         Cache::Cache()
         {
             addLoader(&loaderBMF);
@@ -79,8 +82,11 @@ namespace ouzel
 
         bool Cache::loadAsset(uint32_t loaderType, const std::string& filename, bool mipmaps) const
         {
-            std::vector<uint8_t> data;
-            if (!engine->getFileSystem()->readFile(filename, data))
+            OUZEL_PROFILE_ZONE("Cache::loadAsset");
+
+            // the loaders parse the mapped file directly, so the file is not copied into memory
+            MappedFile file;
+            if (!engine->getFileSystem()->mapFile(filename, file))
             {
                 return false;
             }
@@ -94,7 +100,7 @@ namespace ouzel
                 if (loader->getType() == loaderType &&
                     std::find(loader->extensions.begin(), loader->extensions.end(), extension) != loader->extensions.end())
                 {
-                    if (loader->loadAsset(filename, data, mipmaps)) return true;
+                    if (loader->loadAsset(filename, file.getData(), file.getSize(), mipmaps)) return true;
                 }
             }
 
@@ -104,8 +110,10 @@ namespace ouzel
 
         bool Cache::loadAsset(const std::string& filename, bool mipmaps) const
         {
-            std::vector<uint8_t> data;
-            if (!engine->getFileSystem()->readFile(filename, data))
+            OUZEL_PROFILE_ZONE("Cache::loadAsset");
+
+            MappedFile file;
+            if (!engine->getFileSystem()->mapFile(filename, file))
             {
                 return false;
             }
@@ -118,7 +126,7 @@ namespace ouzel
                 Loader* loader = *i;
                 if (std::find(loader->extensions.begin(), loader->extensions.end(), extension) != loader->extensions.end())
                 {
-                    if (loader->loadAsset(filename, data, mipmaps)) return true;
+                    if (loader->loadAsset(filename, file.getData(), file.getSize(), mipmaps)) return true;
                 }
             }
 
@@ -255,46 +263,30 @@ namespace ouzel
             }
         }
 
-        bool Cache::preloadSpriteData(const std::string& filename, bool mipmaps,
-                                            uint32_t spritesX, uint32_t spritesY,
-                                            const Vector2& pivot)
+        bool Cache::loadSpriteData(const std::string& filename, bool mipmaps,
+                                   uint32_t spritesX, uint32_t spritesY,
+                                   const Vector2& pivot) const
         {
             if (std::find(loaderImage.extensions.begin(), loaderImage.extensions.end(),
                           engine->getFileSystem()->getExtensionPart(filename)) != loaderImage.extensions.end())
             {
                 scene::SpriteData newSpriteData;
 
-                if (spritesX == 0) spritesX = 1;
-                if (spritesY == 0) spritesY = 1;
-
-                newSpriteData.texture = engine->getCache()->getTexture(filename, mipmaps);
+                newSpriteData.texture = getTexture(filename, mipmaps);
 
-                if (newSpriteData.texture)
+                if (!newSpriteData.texture)
                 {
                     return false;
                 }
 
-                Size2 spriteSize = Size2(newSpriteData.texture->getSize().width / spritesX,
-                                         newSpriteData.texture->getSize().height / spritesY);
-
-                scene::SpriteData::Animation animation;
-                animation.frames.reserve(spritesX * spritesY);
-
-                for (uint32_t x = 0; x < spritesX; ++x)
+                std::shared_ptr<scene::SpriteData::AnimationMap> animations = std::make_shared<scene::SpriteData::AnimationMap>();
+                if (!scene::SpriteData::createGrid(*animations, filename, newSpriteData.texture->getSize(), spritesX, spritesY, pivot))
                 {
-                    for (uint32_t y = 0; y < spritesY; ++y)
-                    {
-                        Rect rectangle(spriteSize.width * x,
-                                       spriteSize.height * y,
-                                       spriteSize.width,
-                                       spriteSize.height);
-
-                        scene::SpriteData::Frame frame = scene::SpriteData::Frame(filename, newSpriteData.texture->getSize(), rectangle, false, spriteSize, Vector2(), pivot);
-                        animation.frames.push_back(frame);
-                    }
+                    Log(Log::Level::ERR) << "Failed to pack sprite frames of " << filename;
+                    return false;
                 }
 
-                newSpriteData.animations[""] = std::move(animation);
+                newSpriteData.animations = animations;
 
                 spriteData[filename] = newSpriteData;
             }
@@ -306,70 +298,59 @@ namespace ouzel
             return true;
         }
 
+        bool Cache::preloadSpriteData(const std::string& filename, bool mipmaps,
+                                            uint32_t spritesX, uint32_t spritesY,
+                                            const Vector2& pivot)
+        {
+            return loadSpriteData(filename, mipmaps, spritesX, spritesY, pivot);
+        }
+
         const scene::SpriteData& Cache::getSpriteData(const std::string& filename, bool mipmaps,
                                                                   uint32_t spritesX, uint32_t spritesY,
                                                                   const Vector2& pivot) const
         {
             auto i = spriteData.find(filename);
 
-            if (i != spriteData.end())
+            if (i == spriteData.end())
             {
-                return i->second;
-            }
-            else
-            {
-                if (std::find(loaderImage.extensions.begin(), loaderImage.extensions.end(),
-                              engine->getFileSystem()->getExtensionPart(filename)) != loaderImage.extensions.end())
-                {
-                    scene::SpriteData newSpriteData;
-
-                    if (spritesX == 0) spritesX = 1;
-                    if (spritesY == 0) spritesY = 1;
+                // sprite data that failed to load is not cached, so the next call tries again
+                if (!loadSpriteData(filename, mipmaps, spritesX, spritesY, pivot)) return EMPTY_SPRITE_DATA;
 
-                    newSpriteData.texture = engine->getCache()->getTexture(filename, mipmaps);
+                i = spriteData.find(filename);
 
-                    if (newSpriteData.texture)
-                    {
-                        scene::SpriteData::Animation animation;
-                        animation.frames.reserve(spritesX * spritesY);
-
-                        Size2 spriteSize = Size2(newSpriteData.texture->getSize().width / spritesX,
-                                                 newSpriteData.texture->getSize().height / spritesY);
+                if (i == spriteData.end()) return EMPTY_SPRITE_DATA;
+            }
 
-                        for (uint32_t x = 0; x < spritesX; ++x)
-                        {
-                            for (uint32_t y = 0; y < spritesY; ++y)
-                            {
-                                Rect rectangle(spriteSize.width * x,
-                                               spriteSize.height * y,
-                                               spriteSize.width,
-                                               spriteSize.height);
+            return i->second;
+        }
 
-                                scene::SpriteData::Frame frame = scene::SpriteData::Frame(filename, newSpriteData.texture->getSize(), rectangle, false, spriteSize, Vector2(), pivot);
-                                animation.frames.push_back(frame);
-                            }
-                        }
+        const scene::SpriteData& Cache::getSpriteData(const std::shared_ptr<graphics::Texture>& texture,
+                                                      uint32_t spritesX, uint32_t spritesY,
+                                                      const Vector2& pivot) const
+        {
+            // the cached sprite data holds a reference to the texture, so its address can't be reused for another texture
+            auto key = std::make_tuple(texture.get(), spritesX, spritesY, pivot.x, pivot.y);
+            auto i = textureSpriteData.find(key);
 
-                        newSpriteData.animations[""] = std::move(animation);
-                    }
+            if (i == textureSpriteData.end())
+            {
+                if (!texture) return EMPTY_SPRITE_DATA;
 
-                    i = spriteData.insert(std::make_pair(filename, newSpriteData)).first;
-                }
-                else
+                std::shared_ptr<scene::SpriteData::AnimationMap> animations = std::make_shared<scene::SpriteData::AnimationMap>();
+                if (!scene::SpriteData::createGrid(*animations, "", texture->getSize(), spritesX, spritesY, pivot))
                 {
-                    loadAsset(Loader::SPRITE, filename, mipmaps);
-
-                    i = spriteData.find(filename);
-
-                    if (i == spriteData.end())
-                    {
-                        scene::SpriteData newSpriteData;
-                        i = spriteData.insert(std::make_pair(filename, newSpriteData)).first;
-                    }
+                    Log(Log::Level::ERR) << "Failed to pack sprite frames";
+                    return EMPTY_SPRITE_DATA;
                 }
 
-                return i->second;
+                scene::SpriteData newSpriteData;
+                newSpriteData.texture = texture;
+                newSpriteData.animations = animations;
+
+                i = textureSpriteData.insert(std::make_pair(key, newSpriteData)).first;
             }
+
+            return i->second;
         }
 
         void Cache::setSpriteData(const std::string& filename, const scene::SpriteData& newSpriteData)
@@ -380,6 +361,7 @@ namespace ouzel
         void Cache::releaseSpriteData()
         {
             spriteData.clear();
+            textureSpriteData.clear();
         }
 
         const scene::ParticleSystemData& Cache::getParticleSystemData(const std::string& filename, bool mipmaps) const
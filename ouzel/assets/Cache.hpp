@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 #include <map>
+#include <tuple>
 #include "assets/LoaderBMF.hpp"
 #include "assets/LoaderCollada.hpp"
 #include "assets/LoaderImage.hpp"
@@ -71,6 +72,10 @@ namespace ouzel
             const scene::SpriteData& getSpriteData(const std::string& filename, bool mipmaps = true,
                                                    uint32_t spritesX = 1, uint32_t spritesY = 1,
                                                    const Vector2& pivot = Vector2(0.5f, 0.5f)) const;
+            // the frames of a texture split into a grid, packed once and shared by all of the sprites that use it
+            const scene::SpriteData& getSpriteData(const std::shared_ptr<graphics::Texture>& texture,
+                                                   uint32_t spritesX = 1, uint32_t spritesY = 1,
+                                                   const Vector2& pivot = Vector2(0.5f, 0.5f)) const;
             void setSpriteData(const std::string& filename, const scene::SpriteData& newSpriteData);
             void releaseSpriteData();
 
@@ -94,7 +99,18 @@ namespace ouzel
             void setModelData(const std::string& filename, const scene::ModelData& newModelData);
             void releaseModelData();
 
+            // reorder the indices and vertices of loaded models for the post-transform cache, overdraw and vertex fetch
+            inline bool isModelOptimizationEnabled() const { return modelOptimizationEnabled; }
+            inline void setModelOptimizationEnabled(bool enabled) { modelOptimizationEnabled = enabled; }
+            // pack the vertices of loaded models into a compact layout (see MeshOptimizer::quantize), this is lossy
+            inline bool isModelQuantizationEnabled() const { return modelQuantizationEnabled; }
+            inline void setModelQuantizationEnabled(bool enabled) { modelQuantizationEnabled = enabled; }
+
         protected:
+            bool loadSpriteData(const std::string& filename, bool mipmaps,
+                                uint32_t spritesX, uint32_t spritesY,
+                                const Vector2& pivot) const;
+
             LoaderBMF loaderBMF;
             LoaderCollada loaderCollada;
             LoaderImage loaderImage;
@@ -111,10 +127,13 @@ namespace ouzel
             mutable std::map<std::string, scene::ParticleSystemData> particleSystemData;
             mutable std::map<std::string, std::shared_ptr<graphics::BlendState>> blendStates;
             mutable std::map<std::string, scene::SpriteData> spriteData;
+            mutable std::map<std::tuple<graphics::Texture*, uint32_t, uint32_t, float, float>, scene::SpriteData> textureSpriteData;
             mutable std::map<std::string, std::shared_ptr<Font>> fonts;
             mutable std::map<std::string, std::shared_ptr<audio::SoundData>> soundData;
             mutable std::map<std::string, std::shared_ptr<graphics::Material>> materials;
             mutable std::map<std::string, scene::ModelData> modelData;
+            bool modelOptimizationEnabled = false;
+            bool modelQuantizationEnabled = false;
         };
     } // namespace assets
 } // namespace ouzel
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -40,7 +41,7 @@ namespace ouzel
 
             inline uint32_t getType() const { return type; }
 
-            virtual bool loadAsset(const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps = true) = 0;
+            virtual bool loadAsset(const std::string& filename, const uint8_t* data, uint32_t size, bool mipmaps = true) = 0;
 
         protected:
             uint32_t type = Type::NONE;
@@ -10,14 +10,14 @@ namespace ouzel
     namespace assets
     {
         LoaderBMF::LoaderBMF():
-            Loader(TYPE, {"fnt"})
+            Loader(TYPE, {"fnt", "obf"})
         {
         }
 
-        bool LoaderBMF::loadAsset(const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        bool LoaderBMF::loadAsset(const std::string& filename, const uint8_t* data, uint32_t size, bool mipmaps)
         {
             std::shared_ptr<BMFont> font = std::make_shared<BMFont>();
-            if (!font->init(data, mipmaps))
+            if (!font->init(data, size, mipmaps))
             {
                 return false;
             }
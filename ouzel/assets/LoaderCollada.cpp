@@ -16,11 +16,11 @@ namespace ouzel
         {
         }
 
-        bool LoaderCollada::loadAsset(const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        bool LoaderCollada::loadAsset(const std::string& filename, const uint8_t* data, uint32_t size, bool mipmaps)
         {
             xml::Data colladaData;
 
-            if (!colladaData.init(data)) return false;
+            if (!colladaData.init(data, size)) return false;
 
             if (colladaData.getChildren().empty())
             {
@@ -28,7 +28,7 @@ namespace ouzel
                 return false;
             }
 
-            xml::Node rootNode = colladaData.getChildren().front();
+            const xml::Node& rootNode = colladaData.getChildren().front();
 
             if (rootNode.getValue() != "COLLADA")
             {
@@ -21,10 +21,10 @@ namespace ouzel
         {
         }
 
-        bool LoaderImage::loadAsset(const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        bool LoaderImage::loadAsset(const std::string& filename, const uint8_t* data, uint32_t size, bool mipmaps)
         {
             graphics::ImageDataSTB image;
-            if (!image.init(data))
+            if (!image.init(data, size))
             {
                 return false;
             }
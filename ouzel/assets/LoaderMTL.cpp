@@ -27,14 +27,14 @@ namespace ouzel
             return c <= 0x1F;
         }
 
-        static bool skipWhitespaces(const std::vector<uint8_t>& str,
-                                    std::vector<uint8_t>::const_iterator& iterator)
+        static bool skipWhitespaces(const uint8_t*& iterator,
+                                    const uint8_t* end)
         {
-            if (iterator == str.end()) return false;
+            if (iterator == end) return false;
 
             for (;;)
             {
-                if (iterator == str.end()) break;
+                if (iterator == end) break;
 
                 if (isWhitespace(*iterator))
                     ++iterator;
@@ -45,12 +45,12 @@ namespace ouzel
             return true;
         }
 
-        static void skipLine(const std::vector<uint8_t>& str,
-                             std::vector<uint8_t>::const_iterator& iterator)
+        static void skipLine(const uint8_t*& iterator,
+                             const uint8_t* end)
         {
             for (;;)
             {
-                if (iterator == str.end()) break;
+                if (iterator == end) break;
 
                 if (isNewline(*iterator))
                 {
@@ -62,15 +62,15 @@ namespace ouzel
             }
         }
 
-        static bool parseString(const std::vector<uint8_t>& str,
-                                std::vector<uint8_t>::const_iterator& iterator,
+        static bool parseString(const uint8_t*& iterator,
+                                const uint8_t* end,
                                 std::string& result)
         {
             result.clear();
 
             for (;;)
             {
-                if (iterator == str.end() || isControlChar(*iterator) || isWhitespace(*iterator)) break;
+                if (iterator == end || isControlChar(*iterator) || isWhitespace(*iterator)) break;
 
                 result.push_back(static_cast<char>(*iterator));
 
@@ -80,14 +80,14 @@ namespace ouzel
             return !result.empty();
         }
 
-        static bool parseFloat(const std::vector<uint8_t>& str,
-                               std::vector<uint8_t>::const_iterator& iterator,
+        static bool parseFloat(const uint8_t*& iterator,
+                               const uint8_t* end,
                                float& result)
         {
             std::string value;
             uint32_t length = 1;
 
-            if (iterator != str.end() && *iterator == '-')
+            if (iterator != end && *iterator == '-')
             {
                 value.push_back(static_cast<char>(*iterator));
                 ++length;
@@ -96,14 +96,14 @@ namespace ouzel
 
             for (;;)
             {
-                if (iterator == str.end() || *iterator < '0' || *iterator > '9') break;
+                if (iterator == end || *iterator < '0' || *iterator > '9') break;
 
                 value.push_back(static_cast<char>(*iterator));
 
                 ++iterator;
             }
 
-            if (iterator != str.end() && *iterator == '.')
+            if (iterator != end && *iterator == '.')
             {
                 value.push_back(static_cast<char>(*iterator));
                 ++length;
@@ -111,7 +111,7 @@ namespace ouzel
 
                 for (;;)
                 {
-                    if (iterator == str.end() || *iterator < '0' || *iterator > '9') break;
+                    if (iterator == end || *iterator < '0' || *iterator > '9') break;
 
                     value.push_back(static_cast<char>(*iterator));
 
@@ -131,7 +131,7 @@ namespace ouzel
         {
         }
 
-        bool LoaderMTL::loadAsset(const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        bool LoaderMTL::loadAsset(const std::string& filename, const uint8_t* data, uint32_t size, bool mipmaps)
         {
             std::string name = filename;
             std::shared_ptr<graphics::Texture> diffuseTexture;
@@ -141,14 +141,15 @@ namespace ouzel
 
             uint32_t materialCount = 0;
 
-            std::vector<uint8_t>::const_iterator iterator = data.begin();
+            const uint8_t* iterator = data;
+            const uint8_t* end = data + size;
 
             std::string keyword;
             std::string value;
 
             for (;;)
             {
-                if (iterator == data.end()) break;
+                if (iterator == end) break;
 
                 if (isNewline(*iterator))
                 {
@@ -158,12 +159,12 @@ namespace ouzel
                 else if (*iterator == '#')
                 {
                     // skip the comment
-                    skipLine(data, iterator);
+                    skipLine(iterator, end);
                 }
                 else
                 {
-                    if (!skipWhitespaces(data, iterator) ||
-                        !parseString(data, iterator, keyword))
+                    if (!skipWhitespaces(iterator, end) ||
+                        !parseString(iterator, end, keyword))
                     {
                         Log(Log::Level::ERR) << "Failed to parse keyword";
                         return false;
@@ -184,14 +185,14 @@ namespace ouzel
                             engine->getCache()->setMaterial(name, material);
                         }
 
-                        if (!skipWhitespaces(data, iterator) ||
-                            !parseString(data, iterator, name))
+                        if (!skipWhitespaces(iterator, end) ||
+                            !parseString(iterator, end, name))
                         {
                             Log(Log::Level::ERR) << "Failed to parse material name";
                             return false;
                         }
 
-                        skipLine(data, iterator);
+                        skipLine(iterator, end);
 
                         diffuseTexture.reset();
                         ambientTexture.reset();
@@ -200,85 +201,85 @@ namespace ouzel
                     }
                     else if (keyword == "map_Ka") // ambient texture map
                     {
-                        if (!skipWhitespaces(data, iterator) ||
-                            !parseString(data, iterator, value))
+                        if (!skipWhitespaces(iterator, end) ||
+                            !parseString(iterator, end, value))
                         {
                             Log(Log::Level::ERR) << "Failed to parse ambient texture map";
                             return false;
                         }
 
-                        skipLine(data, iterator);
+                        skipLine(iterator, end);
 
                         ambientTexture = engine->getCache()->getTexture(value, mipmaps);
                     }
                     else if (keyword == "map_Kd") // diffuse texture map
                     {
-                        if (!skipWhitespaces(data, iterator) ||
-                            !parseString(data, iterator, value))
+                        if (!skipWhitespaces(iterator, end) ||
+                            !parseString(iterator, end, value))
                         {
                             Log(Log::Level::ERR) << "Failed to parse diffuse texture map";
                             return false;
                         }
 
-                        skipLine(data, iterator);
+                        skipLine(iterator, end);
 
                         diffuseTexture = engine->getCache()->getTexture(value, mipmaps);
                     }
                     else if (keyword == "Ka") // ambient color
                     {
-                        skipLine(data, iterator);
+                        skipLine(iterator, end);
                     }
                     else if (keyword == "Kd") // diffuse color
                     {
                         float color[4];
 
-                        if (!skipWhitespaces(data, iterator) ||
-                            !parseFloat(data, iterator, color[0]) ||
-                            !skipWhitespaces(data, iterator) ||
-                            !parseFloat(data, iterator, color[1]) ||
-                            !skipWhitespaces(data, iterator) ||
-                            !parseFloat(data, iterator, color[2]))
+                        if (!skipWhitespaces(iterator, end) ||
+                            !parseFloat(iterator, end, color[0]) ||
+                            !skipWhitespaces(iterator, end) ||
+                            !parseFloat(iterator, end, color[1]) ||
+                            !skipWhitespaces(iterator, end) ||
+                            !parseFloat(iterator, end, color[2]))
                         {
                             Log(Log::Level::ERR) << "Failed to parse normal";
                             return false;
                         }
 
-                        skipLine(data, iterator);
+                        skipLine(iterator, end);
 
                         color[3] = 1.0f;
                         diffuseColor = Color(color);
                     }
                     else if (keyword == "Ks") // specular color
                     {
-                        skipLine(data, iterator);
+                        skipLine(iterator, end);
                     }
                     else if (keyword == "Ke") // emissive color
                     {
-                        skipLine(data, iterator);
+                        skipLine(iterator, end);
                     }
                     else if (keyword == "d") // opacity
                     {
-                        if (!skipWhitespaces(data, iterator) ||
-                            !parseFloat(data, iterator, opacity))
+                        if (!skipWhitespaces(iterator, end) ||
+                            !parseFloat(iterator, end, opacity))
                         {
                             Log(Log::Level::ERR) << "Failed to parse opacity";
                             return false;
                         }
 
-                        skipLine(data, iterator);
+                        skipLine(iterator, end);
                     }
                     else if (keyword == "Tr") // transparency
                     {
                         float transparency;
 
-                        if (!skipWhitespaces(data, iterator) ||
-                            !parseFloat(data, iterator, transparency))
+                        if (!skipWhitespaces(iterator, end) ||
+                            !parseFloat(iterator, end, transparency))
                         {
                             Log(Log::Level::ERR) << "Failed to parse transparency";
                             return false;
                         }
 
-                        skipLine(data, iterator);
+                        skipLine(iterator, end);
 
                         // d = 1 - Tr
                         opacity = 1.0f - transparency;
@@ -286,7 +287,7 @@ namespace ouzel
                     else
                     {
                         // skip all unknown commands
-                        skipLine(data, iterator);
+                        skipLine(iterator, end);
                     }
 
                     if (!materialCount) ++materialCount; // if we got at least one attribute, we have an material
@@ -1,21 +1,140 @@
 // Copyright (C) 2018 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
-#include <cstdlib>
-#include <iterator>
-#include <map>
+#include "core/Setup.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <string>
-#include <tuple>
 #include "LoaderOBJ.hpp"
 #include "Cache.hpp"
 #include "core/Engine.hpp"
 #include "graphics/Material.hpp"
+#include "scene/MeshOptimizer.hpp"
+#include "thread/JobSystem.hpp"
 #include "utils/Log.hpp"
+#include "utils/Utils.hpp"
 
 namespace ouzel
 {
     namespace assets
     {
+        // files smaller than this are parsed on the calling thread
+        static const uint32_t MIN_CHUNK_SIZE = 1024 * 1024;
+        static const uint32_t NO_INDEX = std::numeric_limits<uint32_t>::max();
+
+        struct Command
+        {
+            enum class Type
+            {
+                MATERIAL_LIBRARY,
+                MATERIAL,
+                OBJECT
+            };
+
+            Type type;
+            size_t offset; // offset in the face vertex list of the chunk
+            std::string name;
+        };
+
+        struct Chunk
+        {
+            const uint8_t* begin = nullptr;
+            const uint8_t* end = nullptr;
+
+            std::vector<Vector3> positions;
+            std::vector<Vector2> texCoords;
+            std::vector<Vector3> normals;
+            // position, texture coordinate and normal index of every triangle corner
+            std::vector<uint32_t> faceVertices;
+            // face vertex components that were relative to the end of this chunk's lists
+            std::vector<size_t> relativeIndices;
+            std::vector<Command> commands;
+            const char* error = nullptr;
+        };
+
+        // open addressing hash map from face vertex to vertex index
+        class VertexMap
+        {
+        public:
+            void reset(size_t count)
+            {
+                size_t capacity = 16;
+                while (capacity < count * 2) capacity *= 2;
+
+                size = 0;
+                mask = capacity - 1;
+                entries.assign(capacity, Entry());
+            }
+
+            // returns the existing vertex index or inserts the given one
+            uint32_t insert(const uint32_t* key, uint32_t index, bool& inserted)
+            {
+                // keep the load factor under 0.5
+                if ((size + 1) * 2 > entries.size()) grow();
+
+                for (size_t i = getHash(key) & mask;; i = (i + 1) & mask)
+                {
+                    Entry& entry = entries[i];
+
+                    if (entry.index == NO_INDEX)
+                    {
+                        entry.key[0] = key[0];
+                        entry.key[1] = key[1];
+                        entry.key[2] = key[2];
+                        entry.index = index;
+                        ++size;
+                        inserted = true;
+                        return index;
+                    }
+                    else if (entry.key[0] == key[0] &&
+                             entry.key[1] == key[1] &&
+                             entry.key[2] == key[2])
+                    {
+                        inserted = false;
+                        return entry.index;
+                    }
+                }
+            }
+
+        private:
+            struct Entry
+            {
+                uint32_t key[3];
+                uint32_t index = NO_INDEX;
+            };
+
+            static size_t getHash(const uint32_t* key)
+            {
+                uint64_t hash = key[0];
+                hash = hash * 0x9E3779B97F4A7C15ULL ^ key[1];
+                hash = hash * 0x9E3779B97F4A7C15ULL ^ key[2];
+                return static_cast<size_t>(hash ^ (hash >> 29));
+            }
+
+            void grow()
+            {
+                std::vector<Entry> oldEntries(entries.size() < 16 ? 16 : entries.size() * 2);
+                oldEntries.swap(entries);
+                mask = entries.size() - 1;
+
+                for (const Entry& entry : oldEntries)
+                {
+                    if (entry.index == NO_INDEX) continue;
+
+                    size_t i = getHash(entry.key) & mask;
+                    while (entries[i].index != NO_INDEX) i = (i + 1) & mask;
+                    entries[i] = entry;
+                }
+            }
+
+            size_t size = 0;
+            size_t mask = 0;
+            std::vector<Entry> entries;
+        };
+
         static bool isWhitespace(uint8_t c)
         {
             return c == ' ' || c == '\t';
@@ -31,411 +150,646 @@ namespace ouzel
             return c <= 0x1F;
         }
 
-        static bool skipWhitespaces(const std::vector<uint8_t>& str,
-                                    std::vector<uint8_t>::const_iterator& iterator)
+        static bool isDigit(uint8_t c)
         {
-            if (iterator == str.end()) return false;
+            return c >= '0' && c <= '9';
+        }
 
-            for (;;)
-            {
-                if (iterator == str.end()) break;
+        static bool skipWhitespaces(const uint8_t*& iterator,
+                                    const uint8_t* end)
+        {
+            if (iterator == end) return false;
 
-                if (isWhitespace(*iterator))
-                    ++iterator;
-                else
-                    break;
-            }
+            while (iterator != end && isWhitespace(*iterator))
+                ++iterator;
 
             return true;
         }
 
-        static void skipLine(const std::vector<uint8_t>& str,
-                             std::vector<uint8_t>::const_iterator& iterator)
+        static void skipLine(const uint8_t*& iterator,
+                             const uint8_t* end)
         {
-            for (;;)
+            while (iterator != end)
             {
-                if (iterator == str.end()) break;
-
-                if (isNewline(*iterator))
-                {
-                    ++iterator;
-                    break;
-                }
-
-                ++iterator;
+                if (isNewline(*iterator++)) break;
             }
         }
 
-        static bool parseString(const std::vector<uint8_t>& str,
-                                std::vector<uint8_t>::const_iterator& iterator,
+        static bool parseString(const uint8_t*& iterator,
+                                const uint8_t* end,
                                 std::string& result)
         {
-            result.clear();
+            const uint8_t* begin = iterator;
 
-            for (;;)
-            {
-                if (iterator == str.end() || isControlChar(*iterator) || isWhitespace(*iterator)) break;
+            while (iterator != end && !isControlChar(*iterator) && !isWhitespace(*iterator))
+                ++iterator;
 
-                result.push_back(static_cast<char>(*iterator));
+            result.assign(reinterpret_cast<const char*>(begin), static_cast<size_t>(iterator - begin));
 
+            return !result.empty();
+        }
+
+        static bool parseKeyword(const uint8_t*& iterator,
+                                 const uint8_t* end,
+                                 const uint8_t*& keyword,
+                                 size_t& length)
+        {
+            keyword = iterator;
+
+            while (iterator != end && !isControlChar(*iterator) && !isWhitespace(*iterator))
                 ++iterator;
-            }
 
-            return !result.empty();
+            length = static_cast<size_t>(iterator - keyword);
+
+            return length > 0;
         }
 
-        static bool parseInt32(const std::vector<uint8_t>& str,
-                               std::vector<uint8_t>::const_iterator& iterator,
+        static bool isKeyword(const uint8_t* keyword, size_t length, const char* value)
+        {
+            return std::strlen(value) == length && std::memcmp(keyword, value, length) == 0;
+        }
+
+        static bool parseInt32(const uint8_t*& iterator,
+                               const uint8_t* end,
                                int32_t& result)
         {
-            std::string value;
-            uint32_t length = 1;
+            bool negative = false;
 
-            if (iterator != str.end() && *iterator == '-')
+            if (iterator != end && (*iterator == '-' || *iterator == '+'))
             {
-                value.push_back(static_cast<char>(*iterator));
-                ++length;
+                negative = (*iterator == '-');
                 ++iterator;
             }
 
-            for (;;)
-            {
-                if (iterator == str.end() || *iterator < '0' || *iterator > '9') break;
+            if (iterator == end || !isDigit(*iterator)) return false;
 
-                value.push_back(static_cast<char>(*iterator));
+            int64_t value = 0;
 
+            while (iterator != end && isDigit(*iterator))
+            {
+                value = value * 10 + (*iterator - '0');
+                if (value > std::numeric_limits<int32_t>::max()) return false;
                 ++iterator;
             }
 
-            if (value.length() < length) return false;
-
-            result = std::stoi(value);
+            result = static_cast<int32_t>(negative ? -value : value);
 
             return true;
         }
 
-        static bool parseFloat(const std::vector<uint8_t>& str,
-                               std::vector<uint8_t>::const_iterator& iterator,
+        static bool parseFloat(const uint8_t*& iterator,
+                               const uint8_t* end,
                                float& result)
         {
-            std::string value;
-            uint32_t length = 1;
+            // powers of ten that can be represented exactly by a double
+            static const double POWERS_OF_TEN[] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+                1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+                1e21, 1e22
+            };
+            static const uint64_t MAX_MANTISSA = 100000000000000000ULL;
 
-            if (iterator != str.end() && *iterator == '-')
+            bool negative = false;
+
+            if (iterator != end && (*iterator == '-' || *iterator == '+'))
             {
-                value.push_back(static_cast<char>(*iterator));
-                ++length;
+                negative = (*iterator == '-');
                 ++iterator;
             }
 
-            for (;;)
-            {
-                if (iterator == str.end() || *iterator < '0' || *iterator > '9') break;
+            uint64_t mantissa = 0;
+            int32_t exponent = 0;
+            uint32_t digits = 0;
 
-                value.push_back(static_cast<char>(*iterator));
+            for (; iterator != end && isDigit(*iterator); ++iterator, ++digits)
+            {
+                if (mantissa < MAX_MANTISSA)
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*iterator - '0');
+                else
+                    ++exponent;
+            }
 
+            if (iterator != end && *iterator == '.')
+            {
                 ++iterator;
+
+                for (; iterator != end && isDigit(*iterator); ++iterator, ++digits)
+                {
+                    if (mantissa < MAX_MANTISSA)
+                    {
+                        mantissa = mantissa * 10 + static_cast<uint64_t>(*iterator - '0');
+                        --exponent;
+                    }
+                }
             }
 
-            if (iterator != str.end() && *iterator == '.')
+            if (!digits) return false;
+
+            if (iterator != end && (*iterator == 'e' || *iterator == 'E'))
             {
-                value.push_back(static_cast<char>(*iterator));
-                ++length;
                 ++iterator;
 
-                for (;;)
-                {
-                    if (iterator == str.end() || *iterator < '0' || *iterator > '9') break;
+                int32_t explicitExponent;
+                if (!parseInt32(iterator, end, explicitExponent)) return false;
+
+                exponent += explicitExponent;
+            }
 
-                    value.push_back(static_cast<char>(*iterator));
+            double value = static_cast<double>(mantissa);
 
-                    ++iterator;
+            if (mantissa)
+            {
+                if (exponent < 0)
+                {
+                    if (exponent >= -22)
+                        value /= POWERS_OF_TEN[-exponent];
+                    else
+                        value *= std::pow(10.0, exponent);
+                }
+                else if (exponent > 0)
+                {
+                    if (exponent <= 22)
+                        value *= POWERS_OF_TEN[exponent];
+                    else
+                        value *= std::pow(10.0, exponent);
                 }
             }
 
-            if (value.length() < length) return false;
-
-            result = std::stof(value);
+            result = static_cast<float>(negative ? -value : value);
 
             return true;
         }
 
-        static bool parseToken(const std::vector<uint8_t>& str,
-                               std::vector<uint8_t>::const_iterator& iterator,
+        static bool parseToken(const uint8_t*& iterator,
+                               const uint8_t* end,
                                char token)
         {
-            if (iterator == str.end() || *iterator != static_cast<uint8_t>(token)) return false;
+            if (iterator == end || *iterator != static_cast<uint8_t>(token)) return false;
 
             ++iterator;
 
             return true;
         }
 
-        LoaderOBJ::LoaderOBJ():
-            Loader(TYPE, {"obj"})
+        // converts a one-based OBJ index to zero-based, negative indices are relative to the end of the list
+        static bool resolveIndex(int32_t index, size_t count, uint32_t& result, bool& relative)
         {
+            if (index > 0)
+            {
+                result = static_cast<uint32_t>(index - 1);
+                relative = false;
+                return true;
+            }
+            else if (index < 0)
+            {
+                // may wrap around if the index points to a previous chunk, adding the chunk base fixes it
+                result = static_cast<uint32_t>(count) + static_cast<uint32_t>(index);
+                relative = true;
+                return true;
+            }
+
+            return false;
         }
 
-        bool LoaderOBJ::loadAsset(const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        static bool parseFaceVertex(const uint8_t*& iterator,
+                                    const uint8_t* end,
+                                    Chunk& chunk,
+                                    std::vector<uint32_t>& polygon,
+                                    std::vector<bool>& relative)
         {
-            std::string name = filename;
-            std::shared_ptr<graphics::Material> material;
-            std::vector<Vector3> positions;
-            std::vector<Vector2> texCoords;
-            std::vector<Vector3> normals;
-            std::vector<graphics::Vertex> vertices;
-            std::map<std::tuple<uint32_t, uint32_t, uint32_t>, uint32_t> vertexMap;
-            std::vector<uint32_t> indices;
-            Box3 boundingBox;
+            int32_t positionIndex = 0;
+            int32_t texCoordIndex = 0;
+            int32_t normalIndex = 0;
 
-            uint32_t objectCount = 0;
+            if (!parseInt32(iterator, end, positionIndex)) return false;
 
-            std::vector<uint8_t>::const_iterator iterator = data.begin();
+            if (parseToken(iterator, end, '/'))
+            {
+                // texture coordinate index can be omitted (v//vn)
+                if (iterator != end && *iterator != '/' &&
+                    !parseInt32(iterator, end, texCoordIndex))
+                    return false;
+
+                if (parseToken(iterator, end, '/') &&
+                    !parseInt32(iterator, end, normalIndex))
+                    return false;
+            }
 
-            std::string keyword;
-            std::string value;
+            uint32_t index;
+            bool isRelative;
 
-            for (;;)
+            if (!resolveIndex(positionIndex, chunk.positions.size(), index, isRelative)) return false;
+            polygon.push_back(index);
+            relative.push_back(isRelative);
+
+            if (texCoordIndex)
             {
-                if (iterator == data.end()) break;
+                if (!resolveIndex(texCoordIndex, chunk.texCoords.size(), index, isRelative)) return false;
+                polygon.push_back(index);
+                relative.push_back(isRelative);
+            }
+            else
+            {
+                polygon.push_back(NO_INDEX);
+                relative.push_back(false);
+            }
+
+            if (normalIndex)
+            {
+                if (!resolveIndex(normalIndex, chunk.normals.size(), index, isRelative)) return false;
+                polygon.push_back(index);
+                relative.push_back(isRelative);
+            }
+            else
+            {
+                polygon.push_back(NO_INDEX);
+                relative.push_back(false);
+            }
+
+            return true;
+        }
+
+        static void addFaceVertex(Chunk& chunk,
+                                  const std::vector<uint32_t>& polygon,
+                                  const std::vector<bool>& relative,
+                                  size_t corner)
+        {
+            for (size_t component = corner * 3; component < corner * 3 + 3; ++component)
+            {
+                if (relative[component]) chunk.relativeIndices.push_back(chunk.faceVertices.size());
+                chunk.faceVertices.push_back(polygon[component]);
+            }
+        }
 
+        static void parseChunk(Chunk& chunk)
+        {
+            const uint8_t* iterator = chunk.begin;
+            const uint8_t* end = chunk.end;
+
+            const uint8_t* keyword;
+            size_t length;
+            Command command;
+            std::vector<uint32_t> polygon;
+            std::vector<bool> relative;
+
+            while (iterator != end)
+            {
                 if (isNewline(*iterator))
                 {
                     // skip empty lines
                     ++iterator;
+                    continue;
                 }
                 else if (*iterator == '#')
                 {
                     // skip the comment
-                    skipLine(data, iterator);
+                    skipLine(iterator, end);
+                    continue;
                 }
-                else
+
+                if (!skipWhitespaces(iterator, end) ||
+                    !parseKeyword(iterator, end, keyword, length))
                 {
-                    if (!skipWhitespaces(data, iterator) ||
-                        !parseString(data, iterator, keyword))
+                    // line containing only whitespaces
+                    if (iterator != end && isNewline(*iterator))
                     {
-                        Log(Log::Level::ERR) << "Failed to parse keyword";
-                        return false;
+                        ++iterator;
+                        continue;
                     }
 
-                    if (keyword == "mtllib")
+                    chunk.error = "Failed to parse keyword";
+                    return;
+                }
+
+                if (isKeyword(keyword, length, "v"))
+                {
+                    Vector3 position;
+
+                    if (!skipWhitespaces(iterator, end) ||
+                        !parseFloat(iterator, end, position.x) ||
+                        !skipWhitespaces(iterator, end) ||
+                        !parseFloat(iterator, end, position.y) ||
+                        !skipWhitespaces(iterator, end) ||
+                        !parseFloat(iterator, end, position.z))
                     {
-                        if (!skipWhitespaces(data, iterator) ||
-                            !parseString(data, iterator, value))
-                        {
-                            Log(Log::Level::ERR) << "Failed to parse material library";
-                            return false;
-                        }
+                        chunk.error = "Failed to parse position";
+                        return;
+                    }
 
-                        skipLine(data, iterator);
+                    chunk.positions.push_back(position);
+                }
+                else if (isKeyword(keyword, length, "vt"))
+                {
+                    Vector2 texCoord;
 
-                        cache->loadAsset(value, mipmaps);
+                    if (!skipWhitespaces(iterator, end) ||
+                        !parseFloat(iterator, end, texCoord.x) ||
+                        !skipWhitespaces(iterator, end) ||
+                        !parseFloat(iterator, end, texCoord.y))
+                    {
+                        chunk.error = "Failed to parse texture coordinates";
+                        return;
                     }
-                    else if (keyword == "usemtl")
+
+                    chunk.texCoords.push_back(texCoord);
+                }
+                else if (isKeyword(keyword, length, "vn"))
+                {
+                    Vector3 normal;
+
+                    if (!skipWhitespaces(iterator, end) ||
+                        !parseFloat(iterator, end, normal.x) ||
+                        !skipWhitespaces(iterator, end) ||
+                        !parseFloat(iterator, end, normal.y) ||
+                        !skipWhitespaces(iterator, end) ||
+                        !parseFloat(iterator, end, normal.z))
                     {
-                        if (!skipWhitespaces(data, iterator) ||
-                            !parseString(data, iterator, value))
-                        {
-                            Log(Log::Level::ERR) << "Failed to parse material name";
-                            return false;
-                        }
+                        chunk.error = "Failed to parse normal";
+                        return;
+                    }
 
-                        skipLine(data, iterator);
+                    chunk.normals.push_back(normal);
+                }
+                else if (isKeyword(keyword, length, "f"))
+                {
+                    polygon.clear();
+                    relative.clear();
 
-                        material = cache->getMaterial(value);
-                    }
-                    else if (keyword == "o")
+                    for (;;)
                     {
-                        if (objectCount)
-                        {
-                            scene::ModelData modelData;
-                            modelData.init(boundingBox, indices, vertices, material);
-                            engine->getCache()->setModelData(name, modelData);
-                        }
+                        skipWhitespaces(iterator, end);
 
-                        if (!skipWhitespaces(data, iterator) ||
-                            !parseString(data, iterator, name))
+                        if (iterator == end || isNewline(*iterator) || *iterator == '#') break;
+
+                        if (!parseFaceVertex(iterator, end, chunk, polygon, relative))
                         {
-                            Log(Log::Level::ERR) << "Failed to parse object name";
-                            return false;
+                            chunk.error = "Failed to parse face";
+                            return;
                         }
+                    }
 
-                        skipLine(data, iterator);
+                    size_t cornerCount = polygon.size() / 3;
 
-                        material.reset();
-                        positions.clear();
-                        texCoords.clear();
-                        normals.clear();
-                        vertices.clear();
-                        indices.clear();
-                        boundingBox.reset();
-                        ++objectCount;
-                    }
-                    else if (keyword == "v")
+                    if (cornerCount < 3)
                     {
-                        Vector3 position;
-
-                        if (!skipWhitespaces(data, iterator) ||
-                            !parseFloat(data, iterator, position.x) ||
-                            !skipWhitespaces(data, iterator) ||
-                            !parseFloat(data, iterator, position.y) ||
-                            !skipWhitespaces(data, iterator) ||
-                            !parseFloat(data, iterator, position.z))
-                        {
-                            Log(Log::Level::ERR) << "Failed to parse position";
-                            return false;
-                        }
-
-                        skipLine(data, iterator);
+                        chunk.error = "Invalid face count";
+                        return;
+                    }
 
-                        positions.push_back(position);
+                    // triangulate convex polygons as a fan
+                    for (size_t corner = 2; corner < cornerCount; ++corner)
+                    {
+                        addFaceVertex(chunk, polygon, relative, 0);
+                        addFaceVertex(chunk, polygon, relative, corner - 1);
+                        addFaceVertex(chunk, polygon, relative, corner);
                     }
-                    else if (keyword == "vt")
+                }
+                else if (isKeyword(keyword, length, "mtllib") ||
+                         isKeyword(keyword, length, "usemtl") ||
+                         isKeyword(keyword, length, "o"))
+                {
+                    if (isKeyword(keyword, length, "mtllib"))
+                        command.type = Command::Type::MATERIAL_LIBRARY;
+                    else if (isKeyword(keyword, length, "usemtl"))
+                        command.type = Command::Type::MATERIAL;
+                    else
+                        command.type = Command::Type::OBJECT;
+
+                    if (!skipWhitespaces(iterator, end) ||
+                        !parseString(iterator, end, command.name))
                     {
-                        Vector3 texCoord;
+                        if (command.type == Command::Type::MATERIAL_LIBRARY)
+                            chunk.error = "Failed to parse material library";
+                        else if (command.type == Command::Type::MATERIAL)
+                            chunk.error = "Failed to parse material name";
+                        else
+                            chunk.error = "Failed to parse object name";
+                        return;
+                    }
 
-                        if (!skipWhitespaces(data, iterator) ||
-                            !parseFloat(data, iterator, texCoord.x) ||
-                            !skipWhitespaces(data, iterator) ||
-                            !parseFloat(data, iterator, texCoord.y))
-                        {
-                            Log(Log::Level::ERR) << "Failed to parse texture coordinates";
-                            return false;
-                        }
+                    command.offset = chunk.faceVertices.size();
+                    chunk.commands.push_back(command);
+                }
 
-                        skipLine(data, iterator);
+                // skip the rest of the line and all unknown commands
+                skipLine(iterator, end);
+            }
+        }
 
-                        texCoords.push_back(texCoord);
-                    }
-                    else if (keyword == "vn")
-                    {
-                        Vector3 normal;
-
-                        if (!skipWhitespaces(data, iterator) ||
-                            !parseFloat(data, iterator, normal.x) ||
-                            !skipWhitespaces(data, iterator) ||
-                            !parseFloat(data, iterator, normal.y) ||
-                            !skipWhitespaces(data, iterator) ||
-                            !parseFloat(data, iterator, normal.z))
-                        {
-                            Log(Log::Level::ERR) << "Failed to parse normal";
-                            return false;
-                        }
+        template<class T>
+        static void convertIndices(const std::vector<uint32_t>& indices, std::vector<T>& result)
+        {
+            result.resize(indices.size());
+            for (size_t i = 0; i < indices.size(); ++i)
+                result[i] = static_cast<T>(indices[i]);
+        }
 
-                        skipLine(data, iterator);
+        static void addModelData(Cache* cache,
+                                 const std::string& name,
+                                 const Box3& boundingBox,
+                                 std::vector<uint32_t>& indices,
+                                 std::vector<graphics::Vertex>& vertices,
+                                 const std::shared_ptr<graphics::Material>& material)
+        {
+            if (cache->isModelOptimizationEnabled())
+            {
+                scene::MeshOptimizer::Statistics before;
+                scene::MeshOptimizer::Statistics after;
+                scene::MeshOptimizer::optimize(indices, vertices, &before, &after);
+
+                Log(Log::Level::INFO) << "Optimized model " << name << ": " <<
+                    after.triangleCount << " triangles, " <<
+                    before.vertexCount << " -> " << after.vertexCount << " vertices, " <<
+                    "ACMR " << before.acmr << " -> " << after.acmr << ", " <<
+                    "ATVR " << before.atvr << " -> " << after.atvr;
+            }
 
-                        normals.push_back(normal);
-                    }
-                    else if (keyword == "f")
-                    {
-                        std::vector<uint32_t> vertexIndices;
+            scene::ModelData modelData;
 
-                        std::tuple<uint32_t, uint32_t, uint32_t> i = std::make_tuple(0, 0, 0);
-                        int32_t positionIndex = 0, texCoordIndex = 0, normalIndex = 0;
+            // use 16-bit indices if all of the vertices can be addressed with them
+            std::vector<uint16_t> shortIndices;
+            uint32_t indexSize = sizeof(uint32_t);
+            const void* indexData = indices.data();
+            uint32_t indexDataSize = static_cast<uint32_t>(getVectorSize(indices));
 
-                        for (;;)
-                        {
-                            if (iterator == data.end() || isNewline(*iterator)) break;
-
-                            if (!skipWhitespaces(data, iterator))
-                            {
-                                Log(Log::Level::ERR) << "Failed to parse face";
-                                return false;
-                            }
-
-                            if (!parseInt32(data, iterator, positionIndex) ||
-                                !parseToken(data, iterator, '/') ||
-                                !parseInt32(data, iterator, texCoordIndex) ||
-                                !parseToken(data, iterator, '/') ||
-                                !parseInt32(data, iterator, normalIndex))
-                            {
-                                Log(Log::Level::ERR) << "Failed to parse face";
-                                return false;
-                            }
-
-                            if (positionIndex < 0)
-                                std::get<0>(i) = static_cast<uint32_t>(static_cast<long>(positions.size()) + positionIndex);
-                            else if (positionIndex > 0)
-                                std::get<0>(i) = static_cast<uint32_t>(positionIndex - 1);
-                            else
-                            {
-                                Log(Log::Level::ERR) << "Failed to parse face";
-                                return false;
-                            }
-
-                            if (texCoordIndex < 0)
-                                std::get<1>(i) = static_cast<uint32_t>(static_cast<long>(texCoords.size()) + texCoordIndex);
-                            else if (texCoordIndex > 0)
-                                std::get<1>(i) = static_cast<uint32_t>(texCoordIndex - 1);
-                            else
-                            {
-                                Log(Log::Level::ERR) << "Failed to parse face";
-                                return false;
-                            }
-
-                            if (normalIndex < 0)
-                                std::get<2>(i) = static_cast<uint32_t>(static_cast<long>(normals.size()) + normalIndex);
-                            else if (normalIndex > 0)
-                                std::get<2>(i) = static_cast<uint32_t>(normalIndex - 1);
-                            else
-                            {
-                                Log(Log::Level::ERR) << "Failed to parse face";
-                                return false;
-                            }
-
-                            auto vertexIterator = vertexMap.find(i);
-                            if (vertexIterator != vertexMap.end())
-                            {
-                                vertexIndices.push_back(vertexIterator->second);
-                            }
-                            else
-                            {
-                                graphics::Vertex vertex;
-                                vertex.position = positions[std::get<0>(i)];
-                                vertex.texCoords[0] = texCoords[std::get<1>(i)];
-                                vertex.color = Color::WHITE;
-                                vertex.normal = normals[std::get<2>(i)];
-                                vertexIndices.push_back(static_cast<uint32_t>(vertices.size()));
-                                vertices.push_back(vertex);
-                                boundingBox.insertPoint(vertex.position);
-                            }
-                        }
+            if (vertices.size() <= std::numeric_limits<uint16_t>::max() + 1U)
+            {
+                convertIndices(indices, shortIndices);
+                indexSize = sizeof(uint16_t);
+                indexData = shortIndices.data();
+                indexDataSize = static_cast<uint32_t>(getVectorSize(shortIndices));
+            }
 
-                        if (vertexIndices.size() < 3)
-                        {
-                            Log(Log::Level::ERR) << "Invalid face count";
-                            return false;
-                        }
-                        else if (vertexIndices.size() == 3)
+            if (cache->isModelQuantizationEnabled())
+            {
+                scene::MeshOptimizer::QuantizedVertices quantizedVertices;
+                scene::MeshOptimizer::quantize(vertices, quantizedVertices);
+
+                Log(Log::Level::INFO) << "Quantized model " << name << ": " <<
+                    sizeof(graphics::Vertex) << " -> " << quantizedVertices.layout.getStride() << " bytes per vertex, " <<
+                    getVectorSize(vertices) << " -> " << quantizedVertices.data.size() << " bytes";
+
+                modelData.init(boundingBox, indexSize, indexData, indexDataSize,
+                               quantizedVertices.layout, quantizedVertices.data.data(), static_cast<uint32_t>(quantizedVertices.data.size()),
+                               quantizedVertices.positionTransform, material);
+            }
+            else
+                modelData.init(boundingBox, indexSize, indexData, indexDataSize,
+                               graphics::Vertex::LAYOUT, vertices.data(), static_cast<uint32_t>(getVectorSize(vertices)),
+                               Matrix4::IDENTITY, material);
+
+            cache->setModelData(name, modelData);
+        }
+
+        LoaderOBJ::LoaderOBJ():
+            Loader(TYPE, {"obj"})
+        {
+        }
+
+        bool LoaderOBJ::loadAsset(const std::string& filename, const uint8_t* data, uint32_t size, bool mipmaps)
+        {
+            JobSystem* jobSystem = engine->getJobSystem();
+            uint32_t threadCount = jobSystem->getWorkerCount() + 1;
+            uint32_t chunkCount = std::max(1U, std::min(threadCount, size / MIN_CHUNK_SIZE));
+
+            // split the file into chunks at line boundaries
+            std::vector<Chunk> chunks(chunkCount);
+            const uint8_t* end = data + size;
+            const uint8_t* chunkBegin = data;
+
+            for (uint32_t i = 0; i < chunkCount; ++i)
+            {
+                const uint8_t* chunkEnd = (i == chunkCount - 1) ? end : data + static_cast<size_t>(size) * (i + 1) / chunkCount;
+                if (chunkEnd < chunkBegin) chunkEnd = chunkBegin;
+                while (chunkEnd != end && !isNewline(*chunkEnd)) ++chunkEnd;
+
+                chunks[i].begin = chunkBegin;
+                chunks[i].end = chunkEnd;
+                chunkBegin = chunkEnd;
+            }
+
+            jobSystem->parallelFor(chunkCount, [&chunks](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) parseChunk(chunks[i]);
+            });
+
+            size_t positionCount = 0;
+            size_t texCoordCount = 0;
+            size_t normalCount = 0;
+            size_t faceVertexCount = 0;
+
+            for (const Chunk& chunk : chunks)
+            {
+                if (chunk.error)
+                {
+                    Log(Log::Level::ERR) << chunk.error;
+                    return false;
+                }
+
+                positionCount += chunk.positions.size();
+                texCoordCount += chunk.texCoords.size();
+                normalCount += chunk.normals.size();
+                faceVertexCount += chunk.faceVertices.size() / 3;
+            }
+
+            std::vector<Vector3> positions;
+            std::vector<Vector2> texCoords;
+            std::vector<Vector3> normals;
+            positions.reserve(positionCount);
+            texCoords.reserve(texCoordCount);
+            normals.reserve(normalCount);
+
+            // make relative indices absolute and merge the attribute lists
+            for (Chunk& chunk : chunks)
+            {
+                const uint32_t bases[3] = {
+                    static_cast<uint32_t>(positions.size()),
+                    static_cast<uint32_t>(texCoords.size()),
+                    static_cast<uint32_t>(normals.size())
+                };
+
+                for (size_t index : chunk.relativeIndices)
+                    chunk.faceVertices[index] += bases[index % 3];
+
+                positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+                texCoords.insert(texCoords.end(), chunk.texCoords.begin(), chunk.texCoords.end());
+                normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+
+                std::vector<Vector3>().swap(chunk.positions);
+                std::vector<Vector2>().swap(chunk.texCoords);
+                std::vector<Vector3>().swap(chunk.normals);
+            }
+
+            std::string name = filename;
+            std::shared_ptr<graphics::Material> material;
+            std::vector<graphics::Vertex> vertices;
+            std::vector<uint32_t> indices;
+            VertexMap vertexMap;
+            Box3 boundingBox;
+            bool hasObject = false;
+
+            indices.reserve(faceVertexCount);
+            vertices.reserve(std::min(positionCount, faceVertexCount));
+
+            for (const Chunk& chunk : chunks)
+            {
+                auto command = chunk.commands.begin();
+
+                for (size_t offset = 0; offset <= chunk.faceVertices.size(); offset += 3)
+                {
+                    for (; command != chunk.commands.end() && command->offset == offset; ++command)
+                    {
+                        switch (command->type)
                         {
-                            for (uint32_t vertexIndex : vertexIndices)
-                            {
-                                indices.push_back(vertexIndex);
-                            }
+                            case Command::Type::MATERIAL_LIBRARY:
+                                cache->loadAsset(command->name, mipmaps);
+                                break;
+                            case Command::Type::MATERIAL:
+                                material = cache->getMaterial(command->name);
+                                break;
+                            case Command::Type::OBJECT:
+                                if (!indices.empty()) addModelData(cache, name, boundingBox, indices, vertices, material);
+
+                                name = command->name;
+                                material.reset();
+                                vertices.clear();
+                                indices.clear();
+                                vertexMap.reset(0);
+                                boundingBox.reset();
+                                hasObject = true;
+                                break;
                         }
-                        else
+                    }
+
+                    if (offset == chunk.faceVertices.size()) break;
+
+                    const uint32_t* key = &chunk.faceVertices[offset];
+                    bool inserted;
+                    uint32_t index = vertexMap.insert(key, static_cast<uint32_t>(vertices.size()), inserted);
+
+                    if (inserted)
+                    {
+                        if (key[0] >= positions.size() ||
+                            (key[1] != NO_INDEX && key[1] >= texCoords.size()) ||
+                            (key[2] != NO_INDEX && key[2] >= normals.size()))
                         {
-                            // TODO: implement
-                            Log(Log::Level::ERR) << "Non-triangle faces are not supported";
+                            Log(Log::Level::ERR) << "Invalid face vertex index";
                             return false;
                         }
-                    }
-                    else
-                    {
-                        // skip all unknown commands
-                        skipLine(data, iterator);
+
+                        graphics::Vertex vertex;
+                        vertex.position = positions[key[0]];
+                        if (key[1] != NO_INDEX) vertex.texCoords[0] = texCoords[key[1]];
+                        vertex.color = Color::WHITE;
+                        if (key[2] != NO_INDEX) vertex.normal = normals[key[2]];
+                        vertices.push_back(vertex);
+                        boundingBox.insertPoint(vertex.position);
                     }
 
-                    if (!objectCount) ++objectCount; // if we got at least one attribute, we have an object
+                    indices.push_back(index);
                 }
             }
 
-            if (objectCount)
-            {
-                scene::ModelData modelData;
-                modelData.init(boundingBox, indices, vertices, material);
-                engine->getCache()->setModelData(name, modelData);
-            }
+            if (hasObject || !indices.empty()) addModelData(cache, name, boundingBox, indices, vertices, material);
 
             return true;
         }
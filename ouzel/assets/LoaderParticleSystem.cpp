@@ -1,6 +1,7 @@
 // Copyright (C) 2018 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <unordered_map>
 #include "LoaderParticleSystem.hpp"
 #include "Cache.hpp"
 #include "core/Engine.hpp"
@@ -8,113 +9,257 @@
 #include "scene/ParticleSystemData.hpp"
 #include "utils/JSON.hpp"
 #include "utils/Log.hpp"
+#include "utils/OBF.hpp"
 
 namespace ouzel
 {
     namespace assets
     {
-        LoaderParticleSystem::LoaderParticleSystem():
-            Loader(TYPE, {"json"})
+        // compiled particle systems are OBF dictionaries with the same keys as the JSON files
+        static const char* FORMAT = "particle_system";
+        static const uint32_t VERSION = 2;
+
+        static const std::unordered_map<std::string, float scene::ParticleSystemData::*> FLOAT_MEMBERS = {
+            {"duration", &scene::ParticleSystemData::duration},
+            {"particleLifespan", &scene::ParticleSystemData::particleLifespan},
+            {"particleLifespanVariance", &scene::ParticleSystemData::particleLifespanVariance},
+            {"speed", &scene::ParticleSystemData::speed},
+            {"speedVariance", &scene::ParticleSystemData::speedVariance},
+            {"startParticleSize", &scene::ParticleSystemData::startParticleSize},
+            {"startParticleSizeVariance", &scene::ParticleSystemData::startParticleSizeVariance},
+            {"finishParticleSize", &scene::ParticleSystemData::finishParticleSize},
+            {"finishParticleSizeVariance", &scene::ParticleSystemData::finishParticleSizeVariance},
+            {"angle", &scene::ParticleSystemData::angle},
+            {"angleVariance", &scene::ParticleSystemData::angleVariance},
+            {"rotationStart", &scene::ParticleSystemData::startRotation},
+            {"rotationStartVariance", &scene::ParticleSystemData::startRotationVariance},
+            {"rotationEnd", &scene::ParticleSystemData::finishRotation},
+            {"rotationEndVariance", &scene::ParticleSystemData::finishRotationVariance},
+            {"rotatePerSecond", &scene::ParticleSystemData::rotatePerSecond},
+            {"rotatePerSecondVariance", &scene::ParticleSystemData::rotatePerSecondVariance},
+            {"minRadius", &scene::ParticleSystemData::minRadius},
+            {"minRadiusVariance", &scene::ParticleSystemData::minRadiusVariance},
+            {"maxRadius", &scene::ParticleSystemData::maxRadius},
+            {"maxRadiusVariance", &scene::ParticleSystemData::maxRadiusVariance},
+            {"radialAcceleration", &scene::ParticleSystemData::radialAcceleration},
+            {"radialAccelVariance", &scene::ParticleSystemData::radialAccelVariance},
+            {"tangentialAcceleration", &scene::ParticleSystemData::tangentialAcceleration},
+            {"tangentialAccelVariance", &scene::ParticleSystemData::tangentialAccelVariance},
+            {"startColorRed", &scene::ParticleSystemData::startColorRed},
+            {"startColorGreen", &scene::ParticleSystemData::startColorGreen},
+            {"startColorBlue", &scene::ParticleSystemData::startColorBlue},
+            {"startColorAlpha", &scene::ParticleSystemData::startColorAlpha},
+            {"startColorVarianceRed", &scene::ParticleSystemData::startColorRedVariance},
+            {"startColorVarianceGreen", &scene::ParticleSystemData::startColorGreenVariance},
+            {"startColorVarianceBlue", &scene::ParticleSystemData::startColorBlueVariance},
+            {"startColorVarianceAlpha", &scene::ParticleSystemData::startColorAlphaVariance},
+            {"finishColorRed", &scene::ParticleSystemData::finishColorRed},
+            {"finishColorGreen", &scene::ParticleSystemData::finishColorGreen},
+            {"finishColorBlue", &scene::ParticleSystemData::finishColorBlue},
+            {"finishColorAlpha", &scene::ParticleSystemData::finishColorAlpha},
+            {"finishColorVarianceRed", &scene::ParticleSystemData::finishColorRedVariance},
+            {"finishColorVarianceGreen", &scene::ParticleSystemData::finishColorGreenVariance},
+            {"finishColorVarianceBlue", &scene::ParticleSystemData::finishColorBlueVariance},
+            {"finishColorVarianceAlpha", &scene::ParticleSystemData::finishColorAlphaVariance}
+        };
+
+        static const std::pair<const char*, Vector2 scene::ParticleSystemData::*> VECTOR_MEMBERS[] = {
+            {"sourcePosition", &scene::ParticleSystemData::sourcePosition},
+            {"sourcePositionVariance", &scene::ParticleSystemData::sourcePositionVariance},
+            {"gravity", &scene::ParticleSystemData::gravity}
+        };
+
+        static float* getFloatValue(scene::ParticleSystemData& particleSystemData, const std::string& key)
         {
+            auto i = FLOAT_MEMBERS.find(key);
+            if (i != FLOAT_MEMBERS.end()) return &(particleSystemData.*(i->second));
+
+            // vector components are stored as e.g. gravityx and gravityy
+            if (!key.empty() && (key.back() == 'x' || key.back() == 'y'))
+            {
+                for (const auto& member : VECTOR_MEMBERS)
+                {
+                    if (key.compare(0, key.length() - 1, member.first) == 0)
+                    {
+                        Vector2& vector = particleSystemData.*(member.second);
+                        return (key.back() == 'x') ? &vector.x : &vector.y;
+                    }
+                }
+            }
+
+            return nullptr;
         }
 
-        bool LoaderParticleSystem::loadAsset(const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        static void setNumber(scene::ParticleSystemData& particleSystemData, const std::string& key, double value)
         {
-            scene::ParticleSystemData particleSystemData;
+            if (key == "blendFuncSource") particleSystemData.blendFuncSource = static_cast<uint32_t>(value);
+            else if (key == "blendFuncDestination") particleSystemData.blendFuncDestination = static_cast<uint32_t>(value);
+            else if (key == "emitterType")
+            {
+                switch (static_cast<uint32_t>(value))
+                {
+                    case 0: particleSystemData.emitterType = scene::ParticleSystemData::EmitterType::GRAVITY; break;
+                    case 1: particleSystemData.emitterType = scene::ParticleSystemData::EmitterType::RADIUS; break;
+                }
+            }
+            else if (key == "maxParticles") particleSystemData.maxParticles = static_cast<uint32_t>(value);
+            else if (key == "absolutePosition") particleSystemData.absolutePosition = (value != 0.0);
+            else if (key == "yCoordFlipped") particleSystemData.yCoordFlipped = (static_cast<uint32_t>(value) == 1);
+            else if (key == "rotationIsDir") particleSystemData.rotationIsDir = (value != 0.0);
+            else if (float* floatValue = getFloatValue(particleSystemData, key)) *floatValue = static_cast<float>(value);
+        }
+
+        static bool parseCompiled(const obf::View& root, scene::ParticleSystemData& particleSystemData, std::string& textureFilename)
+        {
+            obf::View format = root["format"];
+            obf::View version = root["version"];
 
-            json::Data document;
+            if (!format.isStringType() || format.asString() != FORMAT) return false;
 
-            if (!document.init(data))
+            if (!version.isIntType() || version.asUInt32() != VERSION)
             {
+                Log(Log::Level::ERR) << "Unsupported compiled particle system version";
                 return false;
             }
 
-            if (!document.hasMember("textureFileName") ||
-                !document.hasMember("configName"))
+            bool configNameFound = false;
+            bool textureFileNameFound = false;
+
+            for (uint32_t i = 0; i < root.getSize(); ++i)
             {
-                return false;
+                std::string key = root.getName(i);
+                obf::View value = root.getElement(i);
+
+                if (value.isStringType())
+                {
+                    if (key == "configName")
+                    {
+                        particleSystemData.name = value.asString();
+                        configNameFound = true;
+                    }
+                    else if (key == "textureFileName")
+                    {
+                        textureFilename = value.asString();
+                        textureFileNameFound = true;
+                    }
+                }
+                else if (value.isIntType()) setNumber(particleSystemData, key, static_cast<double>(value.asUInt64()));
+                else if (value.isFloatType()) setNumber(particleSystemData, key, value.asDouble());
             }
 
-            particleSystemData.name = document["configName"].asString();
+            return configNameFound && textureFileNameFound;
+        }
+
+        LoaderParticleSystem::LoaderParticleSystem():
+            Loader(TYPE, {"json", "obf"})
+        {
+        }
+
+        bool LoaderParticleSystem::parse(const uint8_t* data, uint32_t size,
+                                         scene::ParticleSystemData& particleSystemData,
+                                         std::string& textureFilename)
+        {
+            obf::View root(data, size);
+            if (root.getType() == obf::Value::Type::DICTIONARY) return parseCompiled(root, particleSystemData, textureFilename);
+
+            // the members are read straight into the particle system data without building the DOM
+            json::Reader reader(data, size);
 
-            if (document.hasMember("blendFuncSource")) particleSystemData.blendFuncSource = document["blendFuncSource"].asUInt32();
-            if (document.hasMember("blendFuncDestination")) particleSystemData.blendFuncDestination = document["blendFuncDestination"].asUInt32();
+            if (reader.next() != json::Reader::Event::BEGIN_OBJECT)
+            {
+                return false;
+            }
 
-            if (document.hasMember("emitterType"))
+            bool configNameFound = false;
+            bool textureFileNameFound = false;
+            std::string key;
+
+            for (;;)
             {
-                switch (document["emitterType"].asUInt32())
+                json::Reader::Event event = reader.next();
+
+                if (event == json::Reader::Event::END_OBJECT) break;
+                if (event != json::Reader::Event::KEY) return false;
+
+                key = reader.asString();
+
+                event = reader.next();
+
+                if (event == json::Reader::Event::STRING)
                 {
-                    case 0: particleSystemData.emitterType = scene::ParticleSystemData::EmitterType::GRAVITY; break;
-                    case 1: particleSystemData.emitterType = scene::ParticleSystemData::EmitterType::RADIUS; break;
+                    if (key == "configName")
+                    {
+                        particleSystemData.name = reader.asString();
+                        configNameFound = true;
+                    }
+                    else if (key == "textureFileName")
+                    {
+                        textureFilename = reader.asString();
+                        textureFileNameFound = true;
+                    }
+                }
+                else if (event == json::Reader::Event::NUMBER ||
+                         event == json::Reader::Event::BOOLEAN)
+                {
+                    setNumber(particleSystemData, key, reader.asDouble());
+                }
+                else if (event == json::Reader::Event::BEGIN_OBJECT ||
+                         event == json::Reader::Event::BEGIN_ARRAY)
+                {
+                    if (!reader.skipContainer()) return false;
+                }
+                else if (event != json::Reader::Event::NULL_VALUE)
+                {
+                    return false;
                 }
             }
 
-            if (document.hasMember("maxParticles")) particleSystemData.maxParticles = document["maxParticles"].asUInt32();
-
-            if (document.hasMember("duration")) particleSystemData.duration = document["duration"].asFloat();
-            if (document.hasMember("particleLifespan")) particleSystemData.particleLifespan = document["particleLifespan"].asFloat();
-            if (document.hasMember("particleLifespanVariance")) particleSystemData.particleLifespanVariance = document["particleLifespanVariance"].asFloat();
-
-            if (document.hasMember("speed")) particleSystemData.speed = document["speed"].asFloat();
-            if (document.hasMember("speedVariance")) particleSystemData.speedVariance = document["speedVariance"].asFloat();
-
-            if (document.hasMember("absolutePosition")) particleSystemData.absolutePosition = document["absolutePosition"].asBool();
-
-            if (document.hasMember("yCoordFlipped")) particleSystemData.yCoordFlipped = (document["yCoordFlipped"].asUInt32() == 1);
-
-            if (document.hasMember("sourcePositionx")) particleSystemData.sourcePosition.x = document["sourcePositionx"].asFloat();
-            if (document.hasMember("sourcePositiony")) particleSystemData.sourcePosition.y = document["sourcePositiony"].asFloat();
-            if (document.hasMember("sourcePositionVariancex")) particleSystemData.sourcePositionVariance.x = document["sourcePositionVariancex"].asFloat();
-            if (document.hasMember("sourcePositionVariancey")) particleSystemData.sourcePositionVariance.y = document["sourcePositionVariancey"].asFloat();
-
-            if (document.hasMember("startParticleSize")) particleSystemData.startParticleSize = document["startParticleSize"].asFloat();
-            if (document.hasMember("startParticleSizeVariance")) particleSystemData.startParticleSizeVariance = document["startParticleSizeVariance"].asFloat();
-            if (document.hasMember("finishParticleSize")) particleSystemData.finishParticleSize = document["finishParticleSize"].asFloat();
-            if (document.hasMember("finishParticleSizeVariance")) particleSystemData.finishParticleSizeVariance = document["finishParticleSizeVariance"].asFloat();
-            if (document.hasMember("angle")) particleSystemData.angle = document["angle"].asFloat();
-            if (document.hasMember("angleVariance")) particleSystemData.angleVariance = document["angleVariance"].asFloat();
-            if (document.hasMember("rotationStart")) particleSystemData.startRotation = document["rotationStart"].asFloat();
-            if (document.hasMember("rotationStartVariance")) particleSystemData.startRotationVariance = document["rotationStartVariance"].asFloat();
-            if (document.hasMember("rotationEnd")) particleSystemData.finishRotation = document["rotationEnd"].asFloat();
-            if (document.hasMember("rotationEndVariance")) particleSystemData.finishRotationVariance = document["rotationEndVariance"].asFloat();
-            if (document.hasMember("rotatePerSecond")) particleSystemData.rotatePerSecond = document["rotatePerSecond"].asFloat();
-            if (document.hasMember("rotatePerSecondVariance")) particleSystemData.rotatePerSecondVariance = document["rotatePerSecondVariance"].asFloat();
-            if (document.hasMember("minRadius")) particleSystemData.minRadius = document["minRadius"].asFloat();
-            if (document.hasMember("minRadiusVariance")) particleSystemData.minRadiusVariance = document["minRadiusVariance"].asFloat();
-            if (document.hasMember("maxRadius")) particleSystemData.maxRadius = document["maxRadius"].asFloat();
-            if (document.hasMember("maxRadiusVariance")) particleSystemData.maxRadiusVariance = document["maxRadiusVariance"].asFloat();
-
-            if (document.hasMember("radialAcceleration")) particleSystemData.radialAcceleration = document["radialAcceleration"].asFloat();
-            if (document.hasMember("radialAccelVariance")) particleSystemData.radialAccelVariance = document["radialAccelVariance"].asFloat();
-            if (document.hasMember("tangentialAcceleration")) particleSystemData.tangentialAcceleration = document["tangentialAcceleration"].asFloat();
-            if (document.hasMember("tangentialAccelVariance")) particleSystemData.tangentialAccelVariance = document["tangentialAccelVariance"].asFloat();
-
-            if (document.hasMember("rotationIsDir")) particleSystemData.rotationIsDir = document["rotationIsDir"].asBool();
-
-            if (document.hasMember("gravityx")) particleSystemData.gravity.x = document["gravityx"].asFloat();
-            if (document.hasMember("gravityy")) particleSystemData.gravity.y = document["gravityy"].asFloat();
-
-            if (document.hasMember("startColorRed")) particleSystemData.startColorRed = document["startColorRed"].asFloat();
-            if (document.hasMember("startColorGreen")) particleSystemData.startColorGreen = document["startColorGreen"].asFloat();
-            if (document.hasMember("startColorBlue")) particleSystemData.startColorBlue = document["startColorBlue"].asFloat();
-            if (document.hasMember("startColorAlpha")) particleSystemData.startColorAlpha = document["startColorAlpha"].asFloat();
-
-            if (document.hasMember("startColorVarianceRed")) particleSystemData.startColorRedVariance = document["startColorVarianceRed"].asFloat();
-            if (document.hasMember("startColorVarianceGreen")) particleSystemData.startColorGreenVariance = document["startColorVarianceGreen"].asFloat();
-            if (document.hasMember("startColorVarianceBlue")) particleSystemData.startColorBlueVariance = document["startColorVarianceBlue"].asFloat();
-            if (document.hasMember("startColorVarianceAlpha")) particleSystemData.startColorAlphaVariance = document["startColorVarianceAlpha"].asFloat();
-
-            if (document.hasMember("finishColorRed")) particleSystemData.finishColorRed = document["finishColorRed"].asFloat();
-            if (document.hasMember("finishColorGreen")) particleSystemData.finishColorGreen = document["finishColorGreen"].asFloat();
-            if (document.hasMember("finishColorBlue")) particleSystemData.finishColorBlue = document["finishColorBlue"].asFloat();
-            if (document.hasMember("finishColorAlpha")) particleSystemData.finishColorAlpha = document["finishColorAlpha"].asFloat();
-
-            if (document.hasMember("finishColorVarianceRed")) particleSystemData.finishColorRedVariance = document["finishColorVarianceRed"].asFloat();
-            if (document.hasMember("finishColorVarianceGreen")) particleSystemData.finishColorGreenVariance = document["finishColorVarianceGreen"].asFloat();
-            if (document.hasMember("finishColorVarianceBlue")) particleSystemData.finishColorBlueVariance = document["finishColorVarianceBlue"].asFloat();
-            if (document.hasMember("finishColorVarianceAlpha")) particleSystemData.finishColorAlphaVariance = document["finishColorVarianceAlpha"].asFloat();
-
-            if (document.hasMember("textureFileName")) particleSystemData.texture = engine->getCache()->getTexture(document["textureFileName"].asString(), mipmaps);
+            return reader.next() == json::Reader::Event::END &&
+                textureFileNameFound && configNameFound;
+        }
+
+        bool LoaderParticleSystem::bake(const scene::ParticleSystemData& particleSystemData,
+                                        const std::string& textureFilename,
+                                        std::vector<uint8_t>& result)
+        {
+            obf::Value root = obf::Value::Type::DICTIONARY;
+            root["format"] = std::string(FORMAT);
+            root["version"] = VERSION;
+            root["configName"] = particleSystemData.name;
+            root["textureFileName"] = textureFilename;
+            root["blendFuncSource"] = particleSystemData.blendFuncSource;
+            root["blendFuncDestination"] = particleSystemData.blendFuncDestination;
+            root["emitterType"] = static_cast<uint32_t>(particleSystemData.emitterType == scene::ParticleSystemData::EmitterType::RADIUS ? 1 : 0);
+            root["maxParticles"] = particleSystemData.maxParticles;
+            root["absolutePosition"] = static_cast<uint32_t>(particleSystemData.absolutePosition ? 1 : 0);
+            root["yCoordFlipped"] = static_cast<uint32_t>(particleSystemData.yCoordFlipped ? 1 : 0);
+            root["rotationIsDir"] = static_cast<uint32_t>(particleSystemData.rotationIsDir ? 1 : 0);
+
+            for (const auto& member : FLOAT_MEMBERS)
+                root[member.first] = particleSystemData.*(member.second);
+
+            for (const auto& member : VECTOR_MEMBERS)
+            {
+                const Vector2& vector = particleSystemData.*(member.second);
+                root[std::string(member.first) + "x"] = vector.x;
+                root[std::string(member.first) + "y"] = vector.y;
+            }
+
+            result.clear();
+            return root.encode(result) != 0;
+        }
+
+        bool LoaderParticleSystem::loadAsset(const std::string& filename, const uint8_t* data, uint32_t size, bool mipmaps)
+        {
+            scene::ParticleSystemData particleSystemData;
+            std::string textureFilename;
+
+            if (!parse(data, size, particleSystemData, textureFilename))
+            {
+                return false;
+            }
+
+            particleSystemData.texture = engine->getCache()->getTexture(textureFilename, mipmaps);
 
             particleSystemData.emissionRate = static_cast<float>(particleSystemData.maxParticles) / particleSystemData.particleLifespan;
 
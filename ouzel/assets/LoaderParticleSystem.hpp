@@ -4,6 +4,7 @@
 #pragma once
 
 #include "assets/Loader.hpp"
+#include "scene/ParticleSystemData.hpp"
 
 namespace ouzel
 {
@@ -15,7 +16,16 @@ namespace ouzel
             static const uint32_t TYPE = Loader::PARTICLE_SYSTEM;
 
             LoaderParticleSystem();
-            virtual bool loadAsset(const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps = true) override;
+            virtual bool loadAsset(const std::string& filename, const uint8_t* data, uint32_t size, bool mipmaps = true) override;
+
+            // parses either a particle designer JSON file or a compiled particle system, the texture is not loaded
+            static bool parse(const uint8_t* data, uint32_t size,
+                              scene::ParticleSystemData& particleSystemData,
+                              std::string& textureFilename);
+            // encodes the particle system in the compiled (OBF) format
+            static bool bake(const scene::ParticleSystemData& particleSystemData,
+                             const std::string& textureFilename,
+                             std::vector<uint8_t>& result);
         };
     } // namespace assets
 } // namespace ouzel
@@ -7,128 +7,412 @@
 #include "core/Engine.hpp"
 #include "scene/SpriteData.hpp"
 #include "utils/JSON.hpp"
+#include "utils/Log.hpp"
+#include "utils/OBF.hpp"
+#include "utils/Utils.hpp"
 
 namespace ouzel
 {
     namespace assets
     {
-        LoaderSprite::LoaderSprite():
-            Loader(TYPE, {"json"})
+        // reads the members of an object whose BEGIN_OBJECT event has already been read,
+        // callback is called for every key and has to consume the value
+        template<class Callback>
+        static bool readObject(json::Reader& reader, Callback callback)
         {
+            for (;;)
+            {
+                json::Reader::Event event = reader.next();
+
+                if (event == json::Reader::Event::END_OBJECT) return true;
+                if (event != json::Reader::Event::KEY) return false;
+                if (!callback(reader.asString())) return false;
+            }
         }
 
-        bool LoaderSprite::loadAsset(const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        static bool readNumber(json::Reader& reader, float& result)
         {
-            scene::SpriteData spriteData;
+            if (reader.next() != json::Reader::Event::NUMBER) return false;
+
+            result = reader.asFloat();
+
+            return true;
+        }
+
+        static bool readVector(json::Reader& reader, const char* xKey, const char* yKey, Vector2& result)
+        {
+            if (reader.next() != json::Reader::Event::BEGIN_OBJECT) return false;
+
+            return readObject(reader, [&reader, xKey, yKey, &result](const std::string& key) -> bool {
+                if (key == xKey) return readNumber(reader, result.x);
+                else if (key == yKey) return readNumber(reader, result.y);
+                else return reader.skipValue();
+            });
+        }
 
-            json::Data document;
+        // reads an array of arrays of numbers, e.g. [[1, 2], [3, 4]]
+        static bool readNumberArrays(json::Reader& reader, std::vector<float>& result)
+        {
+            if (reader.next() != json::Reader::Event::BEGIN_ARRAY) return false;
 
-            if (!document.init(data))
+            for (;;)
             {
-                return false;
+                json::Reader::Event event = reader.next();
+
+                if (event == json::Reader::Event::END_ARRAY) return true;
+                if (event != json::Reader::Event::BEGIN_ARRAY) return false;
+
+                for (;;)
+                {
+                    event = reader.next();
+
+                    if (event == json::Reader::Event::END_ARRAY) break;
+                    if (event != json::Reader::Event::NUMBER) return false;
+
+                    result.push_back(reader.asFloat());
+                }
             }
+        }
 
-            if (!document.hasMember("meta") ||
-                !document.hasMember("frames"))
+        // compiled sheets are OBF dictionaries, every frame is an array of FRAME_FIELDS values
+        static const char* FORMAT = "sprite";
+        static const uint32_t VERSION = 2;
+        static const uint32_t FRAME_FIELDS = 15;
+
+        // floats are stored big-endian, like every other value in compiled assets
+        static std::vector<uint8_t> encodeFloats(const std::vector<float>& values)
+        {
+            std::vector<uint8_t> result(values.size() * sizeof(float));
+            for (size_t i = 0; i < values.size(); ++i)
+                encodeFloatBig(result.data() + i * sizeof(float), values[i]);
+            return result;
+        }
+
+        static bool decodeFloats(const obf::View& view, std::vector<float>& result)
+        {
+            if (view.getType() != obf::Value::Type::BYTE_ARRAY ||
+                view.getByteArraySize() % sizeof(float) != 0)
             {
                 return false;
             }
 
-            const json::Value& metaObject = document["meta"];
+            const uint8_t* data = view.getByteArrayData();
+            result.resize(view.getByteArraySize() / sizeof(float));
+            for (size_t i = 0; i < result.size(); ++i)
+                result[i] = decodeFloatBig(data + i * sizeof(float));
 
-            spriteData.texture = engine->getCache()->getTexture(metaObject["image"].asString(), mipmaps);
+            return true;
+        }
 
-            if (!spriteData.texture)
+        static bool parseCompiled(const obf::View& root, LoaderSprite::SheetDescription& sheet)
+        {
+            obf::View format = root["format"];
+            obf::View version = root["version"];
+            obf::View image = root["image"];
+            obf::View frames = root["frames"];
+
+            if (!format.isStringType() || format.asString() != FORMAT) return false;
+
+            if (!version.isIntType() || version.asUInt32() != VERSION)
             {
+                Log(Log::Level::ERR) << "Unsupported compiled sprite version";
                 return false;
             }
 
-            const json::Value& framesArray = document["frames"];
+            if (!image.isStringType() || frames.getType() != obf::Value::Type::ARRAY)
+            {
+                Log(Log::Level::ERR) << "Invalid compiled sprite";
+                return false;
+            }
 
-            scene::SpriteData::Animation animation;
+            sheet.imageFilename = image.asString();
+            sheet.frames.resize(frames.getSize());
 
-            animation.frames.reserve(framesArray.getSize());
+            float values[10];
 
-            for (const json::Value& frameObject : framesArray.asArray())
+            for (uint32_t i = 0; i < frames.getSize(); ++i)
             {
-                std::string name = frameObject["filename"].asString();
+                obf::View frameView = frames.getElement(i);
+                LoaderSprite::FrameDescription& frame = sheet.frames[i];
+
+                if (frameView.getType() != obf::Value::Type::ARRAY ||
+                    frameView.getSize() != FRAME_FIELDS)
+                {
+                    Log(Log::Level::ERR) << "Invalid compiled sprite frame";
+                    return false;
+                }
+
+                obf::View name = frameView.getElement(0);
+                if (!name.isStringType()) return false;
+                frame.name = name.asString();
+
+                for (uint32_t v = 0; v < 10; ++v)
+                {
+                    obf::View value = frameView.getElement(v + 1);
+                    if (!value.isFloatType()) return false;
+                    values[v] = value.asFloat();
+                }
+
+                frame.frameRectangle = Rect(values[0], values[1], values[2], values[3]);
+                frame.sourceSize = Size2(values[4], values[5]);
+                frame.sourceOffset = Vector2(values[6], values[7]);
+                frame.pivot = Vector2(values[8], values[9]);
+
+                obf::View rotated = frameView.getElement(11);
+                if (!rotated.isIntType()) return false;
+                frame.rotated = rotated.asUInt8() != 0;
 
-                const json::Value& frameRectangleObject = frameObject["frame"];
+                obf::View triangles = frameView.getElement(12);
+                frame.hasTriangles = (triangles.getType() != obf::Value::Type::NONE);
 
-                Rect frameRectangle(static_cast<float>(frameRectangleObject["x"].asInt32()),
-                                    static_cast<float>(frameRectangleObject["y"].asInt32()),
-                                    static_cast<float>(frameRectangleObject["w"].asInt32()),
-                                    static_cast<float>(frameRectangleObject["h"].asInt32()));
+                if ((frame.hasTriangles && !decodeFloats(triangles, frame.triangles)) ||
+                    !decodeFloats(frameView.getElement(13), frame.vertices) ||
+                    !decodeFloats(frameView.getElement(14), frame.verticesUV))
+                {
+                    Log(Log::Level::ERR) << "Invalid compiled sprite frame";
+                    return false;
+                }
+            }
 
-                const json::Value& sourceSizeObject = frameObject["sourceSize"];
+            return true;
+        }
 
-                Size2 sourceSize(static_cast<float>(sourceSizeObject["w"].asInt32()),
-                                 static_cast<float>(sourceSizeObject["h"].asInt32()));
+        LoaderSprite::LoaderSprite():
+            Loader(TYPE, {"json", "obf"})
+        {
+        }
 
-                const json::Value& spriteSourceSizeObject = frameObject["spriteSourceSize"];
+        bool LoaderSprite::parse(const uint8_t* data, uint32_t size, SheetDescription& sheet)
+        {
+            sheet.imageFilename.clear();
+            sheet.frames.clear();
+
+            obf::View root(data, size);
+            if (root.getType() == obf::Value::Type::DICTIONARY) return parseCompiled(root, sheet);
+
+            // the DOM is not built, the values are read straight into the frame descriptions
+            // (TexturePacker writes the meta object last, so the frames are read before the texture is known)
+            json::Reader reader(data, size);
+
+            if (reader.next() != json::Reader::Event::BEGIN_OBJECT)
+            {
+                return false;
+            }
 
-                Vector2 sourceOffset(static_cast<float>(spriteSourceSizeObject["x"].asInt32()),
-                                     static_cast<float>(spriteSourceSizeObject["y"].asInt32()));
+            bool metaFound = false;
+            bool framesFound = false;
 
-                const json::Value& pivotObject = frameObject["pivot"];
+            auto readFrame = [&reader](FrameDescription& frame) -> bool {
+                return readObject(reader, [&reader, &frame](const std::string& key) -> bool {
+                    if (key == "filename")
+                    {
+                        if (reader.next() != json::Reader::Event::STRING) return false;
+                        frame.name = reader.asString();
+                        return true;
+                    }
+                    else if (key == "frame")
+                    {
+                        if (reader.next() != json::Reader::Event::BEGIN_OBJECT) return false;
+
+                        return readObject(reader, [&reader, &frame](const std::string& rectangleKey) -> bool {
+                            if (rectangleKey == "x") return readNumber(reader, frame.frameRectangle.position.x);
+                            else if (rectangleKey == "y") return readNumber(reader, frame.frameRectangle.position.y);
+                            else if (rectangleKey == "w") return readNumber(reader, frame.frameRectangle.size.width);
+                            else if (rectangleKey == "h") return readNumber(reader, frame.frameRectangle.size.height);
+                            else return reader.skipValue();
+                        });
+                    }
+                    else if (key == "sourceSize")
+                    {
+                        Vector2 sourceSize;
+                        if (!readVector(reader, "w", "h", sourceSize)) return false;
+                        frame.sourceSize = Size2(sourceSize.x, sourceSize.y);
+                        return true;
+                    }
+                    else if (key == "spriteSourceSize") return readVector(reader, "x", "y", frame.sourceOffset);
+                    else if (key == "pivot") return readVector(reader, "x", "y", frame.pivot);
+                    else if (key == "rotated")
+                    {
+                        json::Reader::Event event = reader.next();
+                        if (event != json::Reader::Event::BOOLEAN && event != json::Reader::Event::NUMBER) return false;
+                        frame.rotated = reader.asBool();
+                        return true;
+                    }
+                    else if (key == "triangles")
+                    {
+                        frame.hasTriangles = true;
+                        return readNumberArrays(reader, frame.triangles);
+                    }
+                    else if (key == "vertices") return readNumberArrays(reader, frame.vertices);
+                    else if (key == "verticesUV") return readNumberArrays(reader, frame.verticesUV);
+                    else return reader.skipValue();
+                });
+            };
+
+            bool result = readObject(reader, [&](const std::string& key) -> bool {
+                if (key == "meta")
+                {
+                    metaFound = true;
 
-                Vector2 pivot(pivotObject["x"].asFloat(),
-                              pivotObject["y"].asFloat());
+                    if (reader.next() != json::Reader::Event::BEGIN_OBJECT) return false;
 
-                if (frameObject.hasMember("vertices") &&
-                    frameObject.hasMember("verticesUV") &&
-                    frameObject.hasMember("triangles"))
+                    return readObject(reader, [&reader, &sheet](const std::string& metaKey) -> bool {
+                        if (metaKey == "image")
+                        {
+                            if (reader.next() != json::Reader::Event::STRING) return false;
+                            sheet.imageFilename = reader.asString();
+                            return true;
+                        }
+                        else return reader.skipValue();
+                    });
+                }
+                else if (key == "frames")
                 {
-                    std::vector<uint16_t> indices;
+                    framesFound = true;
 
-                    const json::Value& trianglesObject = frameObject["triangles"];
+                    json::Reader::Event event = reader.next();
 
-                    for (const json::Value& triangleObject : trianglesObject.asArray())
+                    if (event == json::Reader::Event::BEGIN_ARRAY)
                     {
-                        for (const json::Value& indexObject : triangleObject.asArray())
+                        for (;;)
                         {
-                            indices.push_back(static_cast<uint16_t>(indexObject.asUInt32()));
+                            event = reader.next();
+
+                            if (event == json::Reader::Event::END_ARRAY) return true;
+                            if (event != json::Reader::Event::BEGIN_OBJECT) return false;
+
+                            sheet.frames.push_back(FrameDescription());
+                            if (!readFrame(sheet.frames.back())) return false;
                         }
                     }
+                    else if (event == json::Reader::Event::BEGIN_OBJECT) // hash format, frames are keyed by their names
+                    {
+                        return readObject(reader, [&](const std::string& name) -> bool {
+                            sheet.frames.push_back(FrameDescription());
+                            sheet.frames.back().name = name;
 
-                    // reverse the vertices, so that they are counterclockwise
-                    std::reverse(indices.begin(), indices.end());
+                            return reader.next() == json::Reader::Event::BEGIN_OBJECT &&
+                                readFrame(sheet.frames.back());
+                        });
+                    }
+                    else return false;
+                }
+                else return reader.skipValue();
+            });
 
-                    std::vector<graphics::Vertex> vertices;
+            return result && metaFound && framesFound &&
+                reader.next() == json::Reader::Event::END;
+        }
 
-                    const json::Value& verticesObject = frameObject["vertices"];
-                    const json::Value& verticesUVObject = frameObject["verticesUV"];
+        bool LoaderSprite::bake(const SheetDescription& sheet, std::vector<uint8_t>& result)
+        {
+            obf::Value root = obf::Value::Type::DICTIONARY;
+            root["format"] = std::string(FORMAT);
+            root["version"] = VERSION;
+            root["image"] = sheet.imageFilename;
 
-                    const Size2& textureSize = spriteData.texture->getSize();
+            obf::Value frames = obf::Value::Type::ARRAY;
 
-                    Vector2 finalOffset(-sourceSize.width * pivot.x + sourceOffset.x,
-                                        -sourceSize.height * pivot.y + (sourceSize.height - frameRectangle.size.height - sourceOffset.y));
+            for (const FrameDescription& frame : sheet.frames)
+            {
+                obf::Value frameValue = obf::Value::Type::ARRAY;
+                frameValue.append(frame.name);
+                frameValue.append(frame.frameRectangle.position.x);
+                frameValue.append(frame.frameRectangle.position.y);
+                frameValue.append(frame.frameRectangle.size.width);
+                frameValue.append(frame.frameRectangle.size.height);
+                frameValue.append(frame.sourceSize.width);
+                frameValue.append(frame.sourceSize.height);
+                frameValue.append(frame.sourceOffset.x);
+                frameValue.append(frame.sourceOffset.y);
+                frameValue.append(frame.pivot.x);
+                frameValue.append(frame.pivot.y);
+                frameValue.append(static_cast<uint8_t>(frame.rotated ? 1 : 0));
+                frameValue.append(frame.hasTriangles ? obf::Value(encodeFloats(frame.triangles)) : obf::Value());
+                frameValue.append(encodeFloats(frame.vertices));
+                frameValue.append(encodeFloats(frame.verticesUV));
+
+                frames.append(frameValue);
+            }
+
+            root["frames"] = frames;
+
+            result.clear();
+            return root.encode(result) != 0;
+        }
 
-                    for (size_t vertexIndex = 0; vertexIndex < verticesObject.getSize(); ++vertexIndex)
+        bool LoaderSprite::loadAsset(const std::string& filename, const uint8_t* data, uint32_t size, bool mipmaps)
+        {
+            SheetDescription sheet;
+
+            if (!parse(data, size, sheet))
+            {
+                return false;
+            }
+
+            scene::SpriteData spriteData;
+
+            spriteData.texture = engine->getCache()->getTexture(sheet.imageFilename, mipmaps);
+
+            if (!spriteData.texture)
+            {
+                return false;
+            }
+
+            const Size2& textureSize = spriteData.texture->getSize();
+
+            scene::SpriteData::Animation animation;
+
+            animation.frames.reserve(sheet.frames.size());
+
+            for (const FrameDescription& frame : sheet.frames)
+            {
+                if (frame.hasTriangles &&
+                    !frame.vertices.empty() &&
+                    frame.vertices.size() == frame.verticesUV.size())
+                {
+                    std::vector<uint16_t> indices;
+                    indices.reserve(frame.triangles.size());
+
+                    // reverse the vertices, so that they are counterclockwise
+                    for (auto i = frame.triangles.rbegin(); i != frame.triangles.rend(); ++i)
                     {
-                        const json::Value& vertexObject = verticesObject[vertexIndex];
-                        const json::Value& vertexUVObject = verticesUVObject[vertexIndex];
-
-                        vertices.push_back(graphics::Vertex(Vector3(static_cast<float>(vertexObject[0].asInt32()) + finalOffset.x,
-                                                                    -static_cast<float>(vertexObject[1].asInt32()) - finalOffset.y,
-                                                                    0.0f),
-                                                            Color::WHITE,
-                                                            Vector2(static_cast<float>(vertexUVObject[0].asInt32()) / textureSize.width,
-                                                                    static_cast<float>(vertexUVObject[1].asInt32()) / textureSize.height),
-                                                            Vector3(0.0f, 0.0f, -1.0f)));
+                        indices.push_back(static_cast<uint16_t>(*i));
                     }
 
-                    animation.frames.push_back(scene::SpriteData::Frame(name, indices, vertices, frameRectangle, sourceSize, sourceOffset, pivot));
+                    std::vector<graphics::TextureVertex> vertices;
+                    vertices.reserve(frame.vertices.size() / 2);
+
+                    Vector2 finalOffset(-frame.sourceSize.width * frame.pivot.x + frame.sourceOffset.x,
+                                        -frame.sourceSize.height * frame.pivot.y + (frame.sourceSize.height - frame.frameRectangle.size.height - frame.sourceOffset.y));
+
+                    for (size_t i = 0; i + 1 < frame.vertices.size(); i += 2)
+                    {
+                        vertices.push_back(graphics::TextureVertex(Vector3(frame.vertices[i] + finalOffset.x,
+                                                                           -frame.vertices[i + 1] - finalOffset.y,
+                                                                           0.0f),
+                                                                   Color::WHITE,
+                                                                   Vector2(frame.verticesUV[i] / textureSize.width,
+                                                                           frame.verticesUV[i + 1] / textureSize.height)));
+                    }
+
+                    animation.frames.push_back(scene::SpriteData::Frame(frame.name, indices, vertices, frame.frameRectangle, frame.sourceSize, frame.sourceOffset, frame.pivot));
                 }
                 else
                 {
-                    bool rotated = frameObject["rotated"].asBool();
-
-                    animation.frames.push_back(scene::SpriteData::Frame(name, spriteData.texture->getSize(), frameRectangle, rotated, sourceSize, sourceOffset, pivot));
+                    animation.frames.push_back(scene::SpriteData::Frame(frame.name, textureSize, frame.frameRectangle, frame.rotated, frame.sourceSize, frame.sourceOffset, frame.pivot));
                 }
             }
 
-            spriteData.animations[""] = std::move(animation);
+            std::shared_ptr<scene::SpriteData::AnimationMap> animations = std::make_shared<scene::SpriteData::AnimationMap>();
+            (*animations)[""] = std::move(animation);
+            if (!scene::SpriteData::packFrames(*animations))
+            {
+                Log(Log::Level::ERR) << "Failed to pack sprite frames";
+                return false;
+            }
+
+            spriteData.animations = animations;
 
             cache->setSpriteData(filename, spriteData);
 
@@ -4,6 +4,9 @@
 #pragma once
 
 #include "assets/Loader.hpp"
+#include "math/Rect.hpp"
+#include "math/Size2.hpp"
+#include "math/Vector2.hpp"
 
 namespace ouzel
 {
@@ -14,8 +17,34 @@ namespace ouzel
         public:
             static const uint32_t TYPE = Loader::SPRITE;
 
+            struct FrameDescription
+            {
+                std::string name;
+                Rect frameRectangle;
+                Size2 sourceSize;
+                Vector2 sourceOffset;
+                Vector2 pivot;
+                bool rotated = false;
+                bool hasTriangles = false;
+                std::vector<float> triangles;
+                std::vector<float> vertices;
+                std::vector<float> verticesUV;
+            };
+
+            // sprite sheet as it is stored in the file, before the texture is loaded
+            struct SheetDescription
+            {
+                std::string imageFilename;
+                std::vector<FrameDescription> frames;
+            };
+
             LoaderSprite();
-            virtual bool loadAsset(const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps = true) override;
+            virtual bool loadAsset(const std::string& filename, const uint8_t* data, uint32_t size, bool mipmaps = true) override;
+
+            // parses either a TexturePacker JSON sheet or a compiled sheet
+            static bool parse(const uint8_t* data, uint32_t size, SheetDescription& sheet);
+            // encodes the sheet in the compiled (OBF) format
+            static bool bake(const SheetDescription& sheet, std::vector<uint8_t>& result);
         };
     } // namespace assets
 } // namespace ouzel
@@ -14,10 +14,10 @@ namespace ouzel
         {
         }
 
-        bool LoaderTTF::loadAsset(const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        bool LoaderTTF::loadAsset(const std::string& filename, const uint8_t* data, uint32_t size, bool mipmaps)
         {
             std::shared_ptr<TTFont> font = std::make_shared<TTFont>();
-            if (!font->init(data, mipmaps))
+            if (!font->init(data, size, mipmaps))
             {
                 return false;
             }
@@ -14,10 +14,10 @@ namespace ouzel
         {
         }
 
-        bool LoaderVorbis::loadAsset(const std::string& filename, const std::vector<uint8_t>& data, bool)
+        bool LoaderVorbis::loadAsset(const std::string& filename, const uint8_t* data, uint32_t size, bool)
         {
             std::shared_ptr<audio::SoundData> soundData = std::make_shared<audio::SoundDataVorbis>();
-            if (!soundData->init(data))
+            if (!soundData->init(data, size))
             {
                 return false;
             }
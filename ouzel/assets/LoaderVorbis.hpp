@@ -15,7 +15,7 @@ namespace ouzel
             static const uint32_t TYPE = Loader::SOUND;
 
             LoaderVorbis();
-            virtual bool loadAsset(const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps = true) override;
+            virtual bool loadAsset(const std::string& filename, const uint8_t* data, uint32_t size, bool mipmaps = true) override;
         };
     } // namespace assets
 } // namespace ouzel
@@ -100,6 +100,8 @@ namespace ouzel
                     device.reset(new AudioDeviceEmpty());
                     break;
             }
+
+            executeQueue = &device->executeQueue;
         }
 
         Audio::~Audio()
@@ -130,11 +132,6 @@ namespace ouzel
             return true;
         }
 
-        void Audio::executeOnAudioThread(const std::function<void(void)>& func)
-        {
-            device->executeOnAudioThread(func);
-        }
-
         void Audio::addListener(Listener* listener)
         {
             if (listener->audio != this)
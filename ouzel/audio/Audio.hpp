@@ -10,6 +10,7 @@
 #include <vector>
 #include "math/Quaternion.hpp"
 #include "math/Vector3.hpp"
+#include "thread/ExecuteQueue.hpp"
 
 namespace ouzel
 {
@@ -79,7 +80,10 @@ namespace ouzel
 
             bool update();
 
-            void executeOnAudioThread(const std::function<void(void)>& func);
+            template<class F> void executeOnAudioThread(F&& func)
+            {
+                executeQueue->push(std::forward<F>(func));
+            }
 
             void addListener(Listener* listener);
             void removeListener(Listener* listener);
@@ -93,6 +97,7 @@ namespace ouzel
             bool init(bool debugAudio);
 
             std::unique_ptr<AudioDevice> device;
+            ExecuteQueue* executeQueue = nullptr; // owned by the device
 
             std::vector<Listener*> listeners;
         };
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include "AudioDevice.hpp"
+#include "core/Profiler.hpp"
 #include "math/MathUtils.hpp"
 #include "thread/Lock.hpp"
 
@@ -93,6 +94,10 @@ namespace ouzel
             buffers[buffer].resize(frames * channels);
             std::fill(buffers[buffer].begin(), buffers[buffer].end(), 0.0f);
 
+            // the result buffer is shared between siblings, so clear the previous sibling's output
+            result.resize(frames * channels);
+            std::fill(result.begin(), result.end(), 0.0f);
+
             if (renderCommand.attributeCallback)
             {
                 renderCommand.attributeCallback(listenerPosition,
@@ -140,6 +145,8 @@ namespace ouzel
 
         bool AudioDevice::getData(uint32_t frames, std::vector<uint8_t>& result)
         {
+            OUZEL_PROFILE_ZONE("AudioDevice::getData");
+
             currentBuffer = 0;
             uint32_t buffer = currentBuffer++;
             if (currentBuffer > buffers.size()) return true; // out of buffers
@@ -180,32 +187,9 @@ namespace ouzel
             return true;
         }
 
-        void AudioDevice::executeOnAudioThread(const std::function<void(void)>& func)
-        {
-            Lock lock(executeMutex);
-
-            executeQueue.push(func);
-        }
-
         void AudioDevice::executeAll()
         {
-            std::function<void(void)> func;
-
-            for (;;)
-            {
-                {
-                    Lock lock(executeMutex);
-                    if (executeQueue.empty()) break;
-
-                    func = std::move(executeQueue.front());
-                    executeQueue.pop();
-                }
-
-                if (func)
-                {
-                    func();
-                }
-            }
+            executeQueue.executeAll();
         }
     } // namespace audio
 } // namespace ouzel
@@ -6,6 +6,7 @@
 #include <queue>
 #include <vector>
 #include "audio/Audio.hpp"
+#include "thread/ExecuteQueue.hpp"
 #include "thread/Mutex.hpp"
 
 namespace ouzel
@@ -32,7 +33,13 @@ namespace ouzel
             inline uint16_t getAPIMajorVersion() const { return apiMajorVersion; }
             inline uint16_t getAPIMinorVersion() const { return apiMinorVersion; }
 
-            void executeOnAudioThread(const std::function<void(void)>& func);
+            inline uint32_t getSampleRate() const { return sampleRate; }
+            inline uint16_t getChannels() const { return channels; }
+
+            template<class F> void executeOnAudioThread(F&& func)
+            {
+                executeQueue.push(std::forward<F>(func));
+            }
 
             struct RenderCommand
             {
@@ -86,8 +93,7 @@ namespace ouzel
             std::vector<std::vector<float>> buffers;
             uint32_t currentBuffer = 0;
 
-            std::queue<std::function<void(void)>> executeQueue;
-            Mutex executeMutex;
+            ExecuteQueue executeQueue;
 
             std::vector<RenderCommand> renderQueue;
             Mutex renderQueueMutex;
@@ -0,0 +1,32 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include "Effect.hpp"
+
+namespace ouzel
+{
+    namespace audio
+    {
+        Effect::Effect()
+        {
+        }
+
+        Effect::~Effect()
+        {
+        }
+
+        void Effect::addRenderCommands(std::vector<AudioDevice::RenderCommand>& renderCommands)
+        {
+            AudioDevice::RenderCommand renderCommand;
+
+            for (SoundInput* input : inputs)
+            {
+                input->addRenderCommands(renderCommand.renderCommands);
+            }
+
+            if (enabled) setRenderCallback(renderCommand);
+
+            renderCommands.push_back(renderCommand);
+        }
+    } // namespace audio
+} // namespace ouzel
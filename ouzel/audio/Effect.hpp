@@ -0,0 +1,38 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include "audio/SoundInput.hpp"
+#include "audio/SoundOutput.hpp"
+
+namespace ouzel
+{
+    namespace audio
+    {
+        class Effect: public SoundInput, public SoundOutput
+        {
+        public:
+            virtual ~Effect();
+
+            Effect(const Effect&) = delete;
+            Effect& operator=(const Effect&) = delete;
+
+            Effect(Effect&&) = delete;
+            Effect& operator=(Effect&&) = delete;
+
+            inline bool isEnabled() const { return enabled; }
+            inline void setEnabled(bool newEnabled) { enabled = newEnabled; }
+
+            virtual void addRenderCommands(std::vector<AudioDevice::RenderCommand>& renderCommands) override;
+
+        protected:
+            Effect();
+
+            // sets the render callback that processes the mixed inputs in place
+            virtual void setRenderCallback(AudioDevice::RenderCommand& renderCommand) = 0;
+
+            bool enabled = true;
+        };
+    } // namespace audio
+} // namespace ouzel
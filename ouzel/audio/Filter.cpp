@@ -0,0 +1,178 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include <cmath>
+#include "core/Setup.h"
+#if OUZEL_SUPPORTS_SSE
+#include <xmmintrin.h>
+#endif
+#include "Filter.hpp"
+#include "math/MathUtils.hpp"
+
+namespace ouzel
+{
+    namespace audio
+    {
+        Filter::Filter(Type initType,
+                       float initCutoffFrequency,
+                       float initResonance):
+            type(initType),
+            cutoffFrequency(initCutoffFrequency),
+            resonance(initResonance),
+            state(std::make_shared<State>())
+        {
+        }
+
+        void Filter::setRenderCallback(AudioDevice::RenderCommand& renderCommand)
+        {
+            renderCommand.renderCallback = std::bind(&Filter::render,
+                                                     std::placeholders::_1,
+                                                     std::placeholders::_2,
+                                                     std::placeholders::_3,
+                                                     std::placeholders::_4,
+                                                     std::placeholders::_5,
+                                                     std::placeholders::_6,
+                                                     std::placeholders::_7,
+                                                     std::placeholders::_8,
+                                                     std::placeholders::_9,
+                                                     state,
+                                                     type,
+                                                     cutoffFrequency,
+                                                     resonance);
+        }
+
+        bool Filter::render(uint32_t,
+                            uint16_t channels,
+                            uint32_t sampleRate,
+                            const Vector3&,
+                            const Quaternion&,
+                            float,
+                            float,
+                            float,
+                            std::vector<float>& result,
+                            const std::shared_ptr<State>& state,
+                            Type type,
+                            float cutoffFrequency,
+                            float resonance)
+        {
+            if (channels == 0 || sampleRate == 0) return true;
+
+            if (state->type != type ||
+                state->cutoffFrequency != cutoffFrequency ||
+                state->resonance != resonance ||
+                state->sampleRate != sampleRate)
+            {
+                state->type = type;
+                state->cutoffFrequency = cutoffFrequency;
+                state->resonance = resonance;
+                state->sampleRate = sampleRate;
+
+                // coefficients from Robert Bristow-Johnson's audio EQ cookbook
+                float frequency = clamp(cutoffFrequency, 1.0f, sampleRate * 0.49f);
+                float w0 = TAU * frequency / sampleRate;
+                float cosW0 = cosf(w0);
+                float alpha = sinf(w0) / (2.0f * std::max(resonance, 0.01f));
+                float a0 = 1.0f + alpha;
+
+                switch (type)
+                {
+                    case Type::LOW_PASS:
+                        state->b0 = (1.0f - cosW0) / 2.0f / a0;
+                        state->b1 = (1.0f - cosW0) / a0;
+                        state->b2 = state->b0;
+                        break;
+                    case Type::HIGH_PASS:
+                        state->b0 = (1.0f + cosW0) / 2.0f / a0;
+                        state->b1 = -(1.0f + cosW0) / a0;
+                        state->b2 = state->b0;
+                        break;
+                }
+
+                state->a1 = -2.0f * cosW0 / a0;
+                state->a2 = (1.0f - alpha) / a0;
+            }
+
+            // reallocate only when the channel count grows
+            uint32_t paddedChannels = (channels + 3) & ~3U;
+            if (state->z1.size() < paddedChannels)
+            {
+                state->z1.resize(paddedChannels, 0.0f);
+                state->z2.resize(paddedChannels, 0.0f);
+            }
+
+            uint32_t frameCount = static_cast<uint32_t>(result.size()) / channels;
+
+#if OUZEL_SUPPORTS_SSE
+            // transposed direct form II, up to four channels are filtered in parallel
+            const __m128 b0 = _mm_set1_ps(state->b0);
+            const __m128 b1 = _mm_set1_ps(state->b1);
+            const __m128 b2 = _mm_set1_ps(state->b2);
+            const __m128 a1 = _mm_set1_ps(state->a1);
+            const __m128 a2 = _mm_set1_ps(state->a2);
+
+            for (uint32_t firstChannel = 0; firstChannel < channels; firstChannel += 4)
+            {
+                uint32_t laneCount = std::min(4U, channels - firstChannel);
+                __m128 z1 = _mm_loadu_ps(&state->z1[firstChannel]);
+                __m128 z2 = _mm_loadu_ps(&state->z2[firstChannel]);
+                float* samples = result.data() + firstChannel;
+
+                if (laneCount == 4)
+                {
+                    for (uint32_t frame = 0; frame < frameCount; ++frame, samples += channels)
+                    {
+                        __m128 x = _mm_loadu_ps(samples);
+                        __m128 y = _mm_add_ps(_mm_mul_ps(b0, x), z1);
+                        z1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)), z2);
+                        z2 = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+                        _mm_storeu_ps(samples, y);
+                    }
+                }
+                else
+                {
+                    float lanes[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+                    for (uint32_t frame = 0; frame < frameCount; ++frame, samples += channels)
+                    {
+                        for (uint32_t lane = 0; lane < laneCount; ++lane) lanes[lane] = samples[lane];
+
+                        __m128 x = _mm_loadu_ps(lanes);
+                        __m128 y = _mm_add_ps(_mm_mul_ps(b0, x), z1);
+                        z1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)), z2);
+                        z2 = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+                        _mm_storeu_ps(lanes, y);
+
+                        for (uint32_t lane = 0; lane < laneCount; ++lane) samples[lane] = lanes[lane];
+                    }
+                }
+
+                _mm_storeu_ps(&state->z1[firstChannel], z1);
+                _mm_storeu_ps(&state->z2[firstChannel], z2);
+            }
+#else
+            // transposed direct form II
+            for (uint32_t channel = 0; channel < channels; ++channel)
+            {
+                float z1 = state->z1[channel];
+                float z2 = state->z2[channel];
+                float* samples = result.data() + channel;
+
+                for (uint32_t frame = 0; frame < frameCount; ++frame, samples += channels)
+                {
+                    float x = *samples;
+                    float y = state->b0 * x + z1;
+                    z1 = state->b1 * x - state->a1 * y + z2;
+                    z2 = state->b2 * x - state->a2 * y;
+                    *samples = y;
+                }
+
+                state->z1[channel] = z1;
+                state->z2[channel] = z2;
+            }
+#endif
+
+            return true;
+        }
+    } // namespace audio
+} // namespace ouzel
@@ -0,0 +1,80 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "audio/Effect.hpp"
+
+namespace ouzel
+{
+    namespace audio
+    {
+        // second-order (biquad) filter
+        class Filter: public Effect
+        {
+        public:
+            enum class Type
+            {
+                LOW_PASS,
+                HIGH_PASS
+            };
+
+            Filter(Type initType = Type::LOW_PASS,
+                   float initCutoffFrequency = 1000.0f,
+                   float initResonance = 0.7071f);
+
+            inline Type getType() const { return type; }
+            inline void setType(Type newType) { type = newType; }
+
+            inline float getCutoffFrequency() const { return cutoffFrequency; }
+            inline void setCutoffFrequency(float newCutoffFrequency) { cutoffFrequency = newCutoffFrequency; }
+
+            inline float getResonance() const { return resonance; }
+            inline void setResonance(float newResonance) { resonance = newResonance; }
+
+        protected:
+            // accessed only on the audio thread
+            struct State
+            {
+                Type type = Type::LOW_PASS;
+                float cutoffFrequency = 0.0f;
+                float resonance = 0.0f;
+                uint32_t sampleRate = 0;
+
+                float b0 = 1.0f;
+                float b1 = 0.0f;
+                float b2 = 0.0f;
+                float a1 = 0.0f;
+                float a2 = 0.0f;
+
+                // per-channel delay elements, padded to a multiple of 4 channels
+                std::vector<float> z1;
+                std::vector<float> z2;
+            };
+
+            virtual void setRenderCallback(AudioDevice::RenderCommand& renderCommand) override;
+
+            static bool render(uint32_t frames,
+                               uint16_t channels,
+                               uint32_t sampleRate,
+                               const Vector3& listenerPosition,
+                               const Quaternion& listenerRotation,
+                               float pitch,
+                               float gain,
+                               float rolloffFactor,
+                               std::vector<float>& result,
+                               const std::shared_ptr<State>& state,
+                               Type type,
+                               float cutoffFrequency,
+                               float resonance);
+
+            Type type;
+            float cutoffFrequency;
+            float resonance;
+
+            std::shared_ptr<State> state;
+        };
+    } // namespace audio
+} // namespace ouzel
@@ -0,0 +1,151 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include <cmath>
+#include "Limiter.hpp"
+
+namespace ouzel
+{
+    namespace audio
+    {
+        Limiter::Limiter(float initThreshold,
+                         float initLookAhead,
+                         float initRelease):
+            threshold(initThreshold),
+            lookAhead(initLookAhead),
+            release(initRelease),
+            state(std::make_shared<State>())
+        {
+        }
+
+        void Limiter::setRenderCallback(AudioDevice::RenderCommand& renderCommand)
+        {
+            renderCommand.renderCallback = std::bind(&Limiter::render,
+                                                     std::placeholders::_1,
+                                                     std::placeholders::_2,
+                                                     std::placeholders::_3,
+                                                     std::placeholders::_4,
+                                                     std::placeholders::_5,
+                                                     std::placeholders::_6,
+                                                     std::placeholders::_7,
+                                                     std::placeholders::_8,
+                                                     std::placeholders::_9,
+                                                     state,
+                                                     threshold,
+                                                     lookAhead,
+                                                     release);
+        }
+
+        bool Limiter::render(uint32_t,
+                             uint16_t channels,
+                             uint32_t sampleRate,
+                             const Vector3&,
+                             const Quaternion&,
+                             float,
+                             float,
+                             float,
+                             std::vector<float>& result,
+                             const std::shared_ptr<State>& state,
+                             float threshold,
+                             float lookAhead,
+                             float release)
+        {
+            if (channels == 0 || sampleRate == 0 || threshold <= 0.0f) return true;
+
+            // buffers are reallocated only when the format or the look-ahead time changes
+            if (state->sampleRate != sampleRate ||
+                state->channels != channels ||
+                state->lookAhead != lookAhead)
+            {
+                state->sampleRate = sampleRate;
+                state->channels = channels;
+                state->lookAhead = lookAhead;
+                state->lookAheadFrames = std::max(static_cast<uint32_t>(lookAhead * sampleRate), 1U);
+
+                state->delay.assign(state->lookAheadFrames * channels, 0.0f);
+                state->delayPosition = 0;
+
+                state->holdValues.assign(state->lookAheadFrames + 1, 1.0f);
+                state->holdFrames.assign(state->lookAheadFrames + 1, 0);
+                state->holdStart = 0;
+                state->holdCount = 0;
+
+                state->averageValues.assign(state->lookAheadFrames, 1.0f);
+                state->averagePosition = 0;
+                state->averageSum = state->lookAheadFrames;
+
+                state->envelope = 1.0f;
+                state->frame = 0;
+            }
+
+            const uint32_t lookAheadFrames = state->lookAheadFrames;
+            const uint32_t holdCapacity = lookAheadFrames + 1;
+            const float releaseCoefficient = (release > 0.0f) ? 1.0f - expf(-1.0f / (release * sampleRate)) : 1.0f;
+            const double averageScale = 1.0 / lookAheadFrames;
+
+            uint32_t frameCount = static_cast<uint32_t>(result.size()) / channels;
+            float* samples = result.data();
+
+            for (uint32_t frame = 0; frame < frameCount; ++frame, samples += channels)
+            {
+                float peak = 0.0f;
+                for (uint32_t channel = 0; channel < channels; ++channel)
+                    peak = std::max(peak, fabsf(samples[channel]));
+
+                // the envelope drops instantly and recovers with the release time,
+                // so it never exceeds the gain needed for the current frame
+                float targetGain = (peak > threshold) ? threshold / peak : 1.0f;
+                if (targetGain < state->envelope)
+                    state->envelope = targetGain;
+                else
+                    state->envelope += (targetGain - state->envelope) * releaseCoefficient;
+
+                // hold the minimum over the last lookAheadFrames + 1 frames
+                uint32_t currentFrame = state->frame++;
+
+                while (state->holdCount > 0)
+                {
+                    uint32_t last = (state->holdStart + state->holdCount - 1) % holdCapacity;
+                    if (state->holdValues[last] < state->envelope) break;
+                    --state->holdCount;
+                }
+
+                if (state->holdCount > 0 &&
+                    currentFrame - state->holdFrames[state->holdStart] >= holdCapacity)
+                {
+                    state->holdStart = (state->holdStart + 1) % holdCapacity;
+                    --state->holdCount;
+                }
+
+                uint32_t next = (state->holdStart + state->holdCount) % holdCapacity;
+                state->holdValues[next] = state->envelope;
+                state->holdFrames[next] = currentFrame;
+                ++state->holdCount;
+
+                float heldGain = state->holdValues[state->holdStart];
+
+                // smooth the held gain over the look-ahead window, every frame that is averaged
+                // still covers the delayed sample, so the result never exceeds the threshold
+                state->averageSum += heldGain - state->averageValues[state->averagePosition];
+                state->averageValues[state->averagePosition] = heldGain;
+                if (++state->averagePosition >= lookAheadFrames) state->averagePosition = 0;
+
+                float gain = static_cast<float>(state->averageSum * averageScale);
+
+                float* delayed = &state->delay[state->delayPosition * channels];
+
+                for (uint32_t channel = 0; channel < channels; ++channel)
+                {
+                    float sample = samples[channel];
+                    samples[channel] = delayed[channel] * gain;
+                    delayed[channel] = sample;
+                }
+
+                if (++state->delayPosition >= lookAheadFrames) state->delayPosition = 0;
+            }
+
+            return true;
+        }
+    } // namespace audio
+} // namespace ouzel
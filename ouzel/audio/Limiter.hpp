@@ -0,0 +1,83 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "audio/Effect.hpp"
+
+namespace ouzel
+{
+    namespace audio
+    {
+        // look-ahead peak limiter, delays the signal by the look-ahead time
+        class Limiter: public Effect
+        {
+        public:
+            Limiter(float initThreshold = 1.0f,
+                    float initLookAhead = 0.005f,
+                    float initRelease = 0.1f);
+
+            inline float getThreshold() const { return threshold; }
+            inline void setThreshold(float newThreshold) { threshold = newThreshold; }
+
+            // look-ahead time in seconds
+            inline float getLookAhead() const { return lookAhead; }
+            inline void setLookAhead(float newLookAhead) { lookAhead = newLookAhead; }
+
+            // release time in seconds
+            inline float getRelease() const { return release; }
+            inline void setRelease(float newRelease) { release = newRelease; }
+
+        protected:
+            // accessed only on the audio thread
+            struct State
+            {
+                uint32_t sampleRate = 0;
+                uint16_t channels = 0;
+                float lookAhead = -1.0f;
+                uint32_t lookAheadFrames = 0;
+
+                std::vector<float> delay; // lookAheadFrames * channels samples
+                uint32_t delayPosition = 0;
+
+                // sliding window minimum of the gain as a ring buffer deque
+                std::vector<float> holdValues;
+                std::vector<uint32_t> holdFrames;
+                uint32_t holdStart = 0;
+                uint32_t holdCount = 0;
+
+                // moving average of the held gain
+                std::vector<float> averageValues;
+                uint32_t averagePosition = 0;
+                double averageSum = 0.0;
+
+                float envelope = 1.0f;
+                uint32_t frame = 0;
+            };
+
+            virtual void setRenderCallback(AudioDevice::RenderCommand& renderCommand) override;
+
+            static bool render(uint32_t frames,
+                               uint16_t channels,
+                               uint32_t sampleRate,
+                               const Vector3& listenerPosition,
+                               const Quaternion& listenerRotation,
+                               float pitch,
+                               float gain,
+                               float rolloffFactor,
+                               std::vector<float>& result,
+                               const std::shared_ptr<State>& state,
+                               float threshold,
+                               float lookAhead,
+                               float release);
+
+            float threshold;
+            float lookAhead;
+            float release;
+
+            std::shared_ptr<State> state;
+        };
+    } // namespace audio
+} // namespace ouzel
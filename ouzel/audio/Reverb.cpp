@@ -0,0 +1,190 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include <cmath>
+#include "core/Setup.h"
+#if OUZEL_SUPPORTS_SSE
+#include <xmmintrin.h>
+#endif
+#include "Reverb.hpp"
+#include "math/MathUtils.hpp"
+
+namespace ouzel
+{
+    namespace audio
+    {
+        // mutually prime delay line lengths in seconds for the largest room
+        static const float DELAY_TIMES[] = {0.0297f, 0.0371f, 0.0411f, 0.0437f};
+        static const float MINIMUM_ROOM_SIZE = 0.1f;
+
+        // keeps the decaying feedback out of the denormal range
+        static const float ANTI_DENORMAL = 1.0e-20f;
+
+        Reverb::Reverb(float initRoomSize,
+                       float initDecayTime,
+                       float initDamping,
+                       float initWet):
+            roomSize(initRoomSize),
+            decayTime(initDecayTime),
+            damping(initDamping),
+            wet(initWet),
+            state(std::make_shared<State>())
+        {
+        }
+
+        void Reverb::setRenderCallback(AudioDevice::RenderCommand& renderCommand)
+        {
+            renderCommand.renderCallback = std::bind(&Reverb::render,
+                                                     std::placeholders::_1,
+                                                     std::placeholders::_2,
+                                                     std::placeholders::_3,
+                                                     std::placeholders::_4,
+                                                     std::placeholders::_5,
+                                                     std::placeholders::_6,
+                                                     std::placeholders::_7,
+                                                     std::placeholders::_8,
+                                                     std::placeholders::_9,
+                                                     state,
+                                                     roomSize,
+                                                     decayTime,
+                                                     damping,
+                                                     wet);
+        }
+
+        bool Reverb::render(uint32_t,
+                            uint16_t channels,
+                            uint32_t sampleRate,
+                            const Vector3&,
+                            const Quaternion&,
+                            float,
+                            float,
+                            float,
+                            std::vector<float>& result,
+                            const std::shared_ptr<State>& state,
+                            float roomSize,
+                            float decayTime,
+                            float damping,
+                            float wet)
+        {
+            if (channels == 0 || sampleRate == 0) return true;
+
+            if (state->sampleRate != sampleRate)
+            {
+                // the lines are allocated for the largest room, so room size changes never allocate
+                for (uint32_t line = 0; line < LINE_COUNT; ++line)
+                {
+                    state->lines[line].assign(static_cast<size_t>(DELAY_TIMES[line] * sampleRate) + 1, 0.0f);
+                    state->positions[line] = 0;
+                    state->filters[line] = 0.0f;
+                }
+
+                state->sampleRate = sampleRate;
+                state->roomSize = -1.0f;
+            }
+
+            if (state->roomSize != roomSize || state->decayTime != decayTime)
+            {
+                state->roomSize = roomSize;
+                state->decayTime = decayTime;
+
+                float scale = clamp(roomSize, MINIMUM_ROOM_SIZE, 1.0f);
+
+                for (uint32_t line = 0; line < LINE_COUNT; ++line)
+                {
+                    uint32_t length = std::max(static_cast<uint32_t>(DELAY_TIMES[line] * scale * sampleRate), 1U);
+                    state->lengths[line] = length;
+                    if (state->positions[line] >= length) state->positions[line] = 0;
+
+                    // attenuation per pass through the line for a 60 dB decay in decayTime seconds
+                    state->gains[line] = (decayTime > 0.0f) ?
+                        powf(10.0f, -3.0f * length / (decayTime * sampleRate)) : 0.0f;
+                }
+            }
+
+            float filterCoefficient = 1.0f - clamp(damping, 0.0f, 1.0f);
+            float wetGain = clamp(wet, 0.0f, 1.0f);
+            float dryGain = 1.0f - wetGain;
+            float inputScale = 1.0f / channels;
+
+            uint32_t frameCount = static_cast<uint32_t>(result.size()) / channels;
+            float* samples = result.data();
+            float outputs[LINE_COUNT];
+            float feedback[LINE_COUNT];
+
+#if OUZEL_SUPPORTS_SSE
+            const __m128 gains = _mm_loadu_ps(state->gains);
+            const __m128 coefficient = _mm_set1_ps(filterCoefficient);
+            const __m128 antiDenormal = _mm_set1_ps(ANTI_DENORMAL);
+            const __m128 signs1 = _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f);
+            const __m128 signs2 = _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f);
+            const __m128 half = _mm_set1_ps(0.5f);
+            __m128 filters = _mm_loadu_ps(state->filters);
+#endif
+
+            for (uint32_t frame = 0; frame < frameCount; ++frame, samples += channels)
+            {
+                float input = 0.0f;
+                for (uint32_t channel = 0; channel < channels; ++channel) input += samples[channel];
+                input *= inputScale;
+
+                for (uint32_t line = 0; line < LINE_COUNT; ++line)
+                    outputs[line] = state->lines[line][state->positions[line]];
+
+#if OUZEL_SUPPORTS_SSE
+                // one-pole low-pass in every line
+                __m128 delayed = _mm_loadu_ps(outputs);
+                filters = _mm_add_ps(filters, _mm_add_ps(_mm_mul_ps(_mm_sub_ps(delayed, filters), coefficient), antiDenormal));
+                filters = _mm_sub_ps(filters, antiDenormal);
+
+                // normalized 4x4 Hadamard feedback matrix
+                __m128 even = _mm_shuffle_ps(filters, filters, _MM_SHUFFLE(2, 2, 0, 0));
+                __m128 odd = _mm_shuffle_ps(filters, filters, _MM_SHUFFLE(3, 3, 1, 1));
+                __m128 pairs = _mm_add_ps(even, _mm_mul_ps(odd, signs1));
+                __m128 low = _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 0, 1, 0));
+                __m128 high = _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(3, 2, 3, 2));
+                __m128 mixed = _mm_mul_ps(_mm_add_ps(low, _mm_mul_ps(high, signs2)), half);
+
+                _mm_storeu_ps(feedback, _mm_mul_ps(mixed, gains));
+#else
+                for (uint32_t line = 0; line < LINE_COUNT; ++line)
+                {
+                    state->filters[line] += (outputs[line] - state->filters[line]) * filterCoefficient + ANTI_DENORMAL;
+                    state->filters[line] -= ANTI_DENORMAL;
+                }
+
+                const float* f = state->filters;
+                feedback[0] = (f[0] + f[1] + f[2] + f[3]) * 0.5f * state->gains[0];
+                feedback[1] = (f[0] - f[1] + f[2] - f[3]) * 0.5f * state->gains[1];
+                feedback[2] = (f[0] + f[1] - f[2] - f[3]) * 0.5f * state->gains[2];
+                feedback[3] = (f[0] - f[1] - f[2] + f[3]) * 0.5f * state->gains[3];
+#endif
+
+                for (uint32_t line = 0; line < LINE_COUNT; ++line)
+                {
+                    state->lines[line][state->positions[line]] = input + feedback[line];
+                    if (++state->positions[line] >= state->lengths[line]) state->positions[line] = 0;
+                }
+
+                float left = (outputs[0] + outputs[2]) * 0.5f;
+                float right = (outputs[1] + outputs[3]) * 0.5f;
+
+                if (channels == 1)
+                {
+                    samples[0] = samples[0] * dryGain + (left + right) * 0.5f * wetGain;
+                }
+                else
+                {
+                    for (uint32_t channel = 0; channel < channels; ++channel)
+                        samples[channel] = samples[channel] * dryGain + ((channel % 2) ? right : left) * wetGain;
+                }
+            }
+
+#if OUZEL_SUPPORTS_SSE
+            _mm_storeu_ps(state->filters, filters);
+#endif
+
+            return true;
+        }
+    } // namespace audio
+} // namespace ouzel
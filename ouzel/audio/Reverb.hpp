@@ -0,0 +1,78 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "audio/Effect.hpp"
+
+namespace ouzel
+{
+    namespace audio
+    {
+        // feedback delay network reverb with four delay lines
+        class Reverb: public Effect
+        {
+        public:
+            Reverb(float initRoomSize = 0.5f,
+                   float initDecayTime = 1.5f,
+                   float initDamping = 0.3f,
+                   float initWet = 0.3f);
+
+            inline float getRoomSize() const { return roomSize; }
+            inline void setRoomSize(float newRoomSize) { roomSize = newRoomSize; }
+
+            // time in seconds for the reverberation to decay by 60 dB
+            inline float getDecayTime() const { return decayTime; }
+            inline void setDecayTime(float newDecayTime) { decayTime = newDecayTime; }
+
+            inline float getDamping() const { return damping; }
+            inline void setDamping(float newDamping) { damping = newDamping; }
+
+            inline float getWet() const { return wet; }
+            inline void setWet(float newWet) { wet = newWet; }
+
+        protected:
+            static const uint32_t LINE_COUNT = 4;
+
+            // accessed only on the audio thread
+            struct State
+            {
+                uint32_t sampleRate = 0;
+                float roomSize = -1.0f;
+                float decayTime = -1.0f;
+
+                std::vector<float> lines[LINE_COUNT];
+                uint32_t lengths[LINE_COUNT];
+                uint32_t positions[LINE_COUNT];
+                float gains[LINE_COUNT];
+                float filters[LINE_COUNT];
+            };
+
+            virtual void setRenderCallback(AudioDevice::RenderCommand& renderCommand) override;
+
+            static bool render(uint32_t frames,
+                               uint16_t channels,
+                               uint32_t sampleRate,
+                               const Vector3& listenerPosition,
+                               const Quaternion& listenerRotation,
+                               float pitch,
+                               float gain,
+                               float rolloffFactor,
+                               std::vector<float>& result,
+                               const std::shared_ptr<State>& state,
+                               float roomSize,
+                               float decayTime,
+                               float damping,
+                               float wet);
+
+            float roomSize;
+            float decayTime;
+            float damping;
+            float wet;
+
+            std::shared_ptr<State> state;
+        };
+    } // namespace audio
+} // namespace ouzel
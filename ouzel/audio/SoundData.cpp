@@ -4,6 +4,8 @@
 #include "SoundData.hpp"
 #include "Audio.hpp"
 #include "core/Engine.hpp"
+#include "files/FileSystem.hpp"
+#include "files/MappedFile.hpp"
 
 namespace ouzel
 {
@@ -19,16 +21,21 @@ namespace ouzel
 
         bool SoundData::init(const std::string& filename)
         {
-            std::vector<uint8_t> data;
-            if (!engine->getFileSystem()->readFile(filename, data))
+            MappedFile file;
+            if (!engine->getFileSystem()->mapFile(filename, file))
             {
                 return false;
             }
 
-            return init(data);
+            return init(file.getData(), file.getSize());
         }
 
-        bool SoundData::init(const std::vector<uint8_t>&)
+        bool SoundData::init(const std::vector<uint8_t>& newData)
+        {
+            return init(newData.data(), static_cast<uint32_t>(newData.size()));
+        }
+
+        bool SoundData::init(const uint8_t*, uint32_t)
         {
             return true;
         }
@@ -30,6 +30,7 @@ namespace ouzel
 
             virtual bool init(const std::string& filename);
             virtual bool init(const std::vector<uint8_t>& newData);
+            virtual bool init(const uint8_t* newData, uint32_t newDataSize);
 
             virtual std::shared_ptr<Stream> createStream() = 0;
             bool getData(Stream* stream, uint32_t frames, uint32_t neededChannels, uint32_t neededSampleRate, float pitch, std::vector<float>& result);
@@ -16,9 +16,10 @@ namespace ouzel
         {
         }
 
-        bool SoundDataVorbis::init(const std::vector<uint8_t>& newData)
+        bool SoundDataVorbis::init(const uint8_t* newData, uint32_t newDataSize)
         {
-            data = newData;
+            // the stream decodes from the compressed data, so it has to be kept
+            data.assign(newData, newData + newDataSize);
 
             stb_vorbis* vorbisStream = stb_vorbis_open_memory(data.data(), static_cast<int>(data.size()), nullptr, nullptr);
             stb_vorbis_info info = stb_vorbis_get_info(vorbisStream);
@@ -17,7 +17,7 @@ namespace ouzel
         public:
             SoundDataVorbis();
 
-            virtual bool init(const std::vector<uint8_t>& newData) override;
+            virtual bool init(const uint8_t* newData, uint32_t newDataSize) override;
 
             virtual std::shared_ptr<Stream> createStream() override;
 
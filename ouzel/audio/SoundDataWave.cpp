@@ -1,6 +1,7 @@
 // Copyright (C) 2018 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <cstring>
 #include <iterator>
 #include "SoundDataWave.hpp"
 #include "StreamWave.hpp"
@@ -22,11 +23,11 @@ namespace ouzel
         {
         }
 
-        bool SoundDataWave::init(const std::vector<uint8_t>& newData)
+        bool SoundDataWave::init(const uint8_t* newData, uint32_t newDataSize)
         {
             uint32_t offset = 0;
 
-            if (newData.size() < 16) // RIFF + size + WAVE
+            if (newDataSize < 16) // RIFF + size + WAVE
             {
                 Log(Log::Level::ERR) << "Failed to load sound file, file too small";
                 return false;
@@ -43,11 +44,11 @@ namespace ouzel
 
             offset += 4;
 
-            uint32_t length = decodeUInt32Little(newData.data() + offset);
+            uint32_t length = decodeUInt32Little(newData + offset);
 
             offset += 4;
 
-            if (newData.size() != length + 8)
+            if (newDataSize != length + 8)
             {
                 Log(Log::Level::ERR) << "Failed to load sound file, size mismatch";
             }
@@ -68,11 +69,13 @@ namespace ouzel
 
             uint16_t bitsPerSample = 0;
             uint16_t formatTag = 0;
-            std::vector<uint8_t> soundData;
+            // points into the source data, the samples are converted without an intermediate copy
+            const uint8_t* soundData = nullptr;
+            uint32_t soundDataSize = 0;
 
-            for (; offset < newData.size();)
+            for (; offset < newDataSize;)
             {
-                if (newData.size() < offset + 8)
+                if (newDataSize < offset + 8)
                 {
                     Log(Log::Level::ERR) << "Failed to load sound file, not enough data to read chunk";
                     return false;
@@ -86,10 +89,10 @@ namespace ouzel
 
                 offset += 4;
 
-                uint32_t chunkSize = decodeUInt32Little(newData.data() + offset);
+                uint32_t chunkSize = decodeUInt32Little(newData + offset);
                 offset += 4;
 
-                if (newData.size() < offset + chunkSize)
+                if (newDataSize < offset + chunkSize)
                 {
                     Log(Log::Level::ERR) << "Failed to load sound file, not enough data to read chunk";
                     return false;
@@ -105,27 +108,28 @@ namespace ouzel
 
                     uint32_t i = offset;
 
-                    formatTag = decodeUInt16Little(newData.data() + i);
+                    formatTag = decodeUInt16Little(newData + i);
                     i += 2;
 
-                    channels = decodeUInt16Little(newData.data() + i);
+                    channels = decodeUInt16Little(newData + i);
                     i += 2;
 
-                    sampleRate = decodeUInt32Little(newData.data() + i);
+                    sampleRate = decodeUInt32Little(newData + i);
                     i += 4;
 
                     i += 4; // average bytes per second
 
                     i += 2; // block align
 
-                    bitsPerSample = decodeUInt16Little(newData.data() + i);
+                    bitsPerSample = decodeUInt16Little(newData + i);
                     i += 2;
 
                     formatChunkFound = true;
                 }
                 else if (chunkHeader[0] == 'd' && chunkHeader[1] == 'a' && chunkHeader[2] == 't' && chunkHeader[3] == 'a')
                 {
-                    soundData.assign(newData.begin() + static_cast<int>(offset), newData.begin() + static_cast<int>(offset + chunkSize));
+                    soundData = newData + offset;
+                    soundDataSize = chunkSize;
 
                     dataChunkFound = true;
                 }
@@ -153,7 +157,7 @@ namespace ouzel
             }
 
             uint32_t bytesPerSample = bitsPerSample / 8;
-            uint32_t samples = static_cast<uint32_t>(soundData.size() / bytesPerSample);
+            uint32_t samples = soundDataSize / bytesPerSample;
             data.resize(samples);
 
             if (formatTag == PCM)
@@ -192,10 +196,8 @@ namespace ouzel
             {
                 if (bitsPerSample == 32)
                 {
-                    for (uint32_t i = 0; i < samples; ++i)
-                    {
-                        data[i] = reinterpret_cast<float*>(soundData.data())[i];
-                    }
+                    // the data chunk is not guaranteed to be aligned
+                    std::memcpy(data.data(), soundData, samples * sizeof(float));
                 }
                 else
                 {
@@ -1,15 +1,145 @@
 // Copyright (C) 2018 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <algorithm>
+#include <chrono>
 #include "AudioDeviceEmpty.hpp"
+#include "core/Engine.hpp"
+#include "files/FileSystem.hpp"
+#include "utils/Log.hpp"
+#include "utils/Utils.hpp"
 
 namespace ouzel
 {
     namespace audio
     {
+        static float getPercentile(const std::vector<float>& sortedValues, float percentile)
+        {
+            if (sortedValues.empty()) return 0.0f;
+
+            // nearest-rank method
+            size_t rank = static_cast<size_t>(percentile * sortedValues.size() + 0.5f);
+            if (rank > 0) --rank;
+            if (rank >= sortedValues.size()) rank = sortedValues.size() - 1;
+
+            return sortedValues[rank];
+        }
+
         AudioDeviceEmpty::AudioDeviceEmpty():
             AudioDevice(Audio::Driver::EMPTY)
         {
         }
+
+        bool AudioDeviceEmpty::render(uint32_t frames, uint32_t periodSize,
+                                      std::vector<uint8_t>& result,
+                                      RenderStatistics& statistics)
+        {
+            if (periodSize == 0)
+            {
+                Log(Log::Level::ERR) << "Invalid period size";
+                return false;
+            }
+
+            uint32_t sampleSize = (format == Audio::Format::SINT16) ? sizeof(int16_t) : sizeof(float);
+
+            result.clear();
+            result.reserve(frames * channels * sampleSize);
+
+            std::vector<float> timings;
+            timings.reserve((frames + periodSize - 1) / periodSize);
+
+            for (uint32_t renderedFrames = 0; renderedFrames < frames;)
+            {
+                uint32_t periodFrames = std::min(periodSize, frames - renderedFrames);
+
+                auto startTime = std::chrono::steady_clock::now();
+
+                process();
+
+                if (!getData(periodFrames, data))
+                {
+                    Log(Log::Level::ERR) << "Failed to get audio data";
+                    return false;
+                }
+
+                auto endTime = std::chrono::steady_clock::now();
+                timings.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count() / 1000.0f);
+
+                result.insert(result.end(), data.begin(), data.begin() + periodFrames * channels * sampleSize);
+                renderedFrames += periodFrames;
+            }
+
+            statistics = RenderStatistics();
+            statistics.periods = static_cast<uint32_t>(timings.size());
+            statistics.framesPerPeriod = periodSize;
+
+            for (float timing : timings)
+            {
+                statistics.totalTime += timing;
+            }
+
+            if (!timings.empty())
+            {
+                std::sort(timings.begin(), timings.end());
+
+                statistics.minimum = timings.front();
+                statistics.average = statistics.totalTime / timings.size();
+                statistics.median = getPercentile(timings, 0.5f);
+                statistics.percentile90 = getPercentile(timings, 0.9f);
+                statistics.percentile99 = getPercentile(timings, 0.99f);
+                statistics.maximum = timings.back();
+            }
+
+            if (statistics.totalTime > 0.0f)
+            {
+                float audioTime = static_cast<float>(frames) * 1000000.0f / sampleRate;
+                statistics.realTimeFactor = audioTime / statistics.totalTime;
+            }
+
+            return true;
+        }
+
+        bool AudioDeviceEmpty::renderToFile(const std::string& filename,
+                                            uint32_t frames, uint32_t periodSize,
+                                            RenderStatistics& statistics)
+        {
+            std::vector<uint8_t> samples;
+
+            if (!render(frames, periodSize, samples, statistics)) return false;
+
+            uint16_t formatTag = (format == Audio::Format::SINT16) ? 1 : 3; // PCM or IEEE float
+            uint16_t bitsPerSample = (format == Audio::Format::SINT16) ? 16 : 32;
+            uint16_t blockAlign = channels * bitsPerSample / 8;
+
+            std::vector<uint8_t> wave(44);
+            uint8_t* header = wave.data();
+
+            header[0] = 'R'; header[1] = 'I'; header[2] = 'F'; header[3] = 'F';
+            encodeUInt32Little(header + 4, static_cast<uint32_t>(36 + samples.size()));
+            header[8] = 'W'; header[9] = 'A'; header[10] = 'V'; header[11] = 'E';
+
+            header[12] = 'f'; header[13] = 'm'; header[14] = 't'; header[15] = ' ';
+            encodeUInt32Little(header + 16, 16);
+            encodeUInt16Little(header + 20, formatTag);
+            encodeUInt16Little(header + 22, channels);
+            encodeUInt32Little(header + 24, sampleRate);
+            encodeUInt32Little(header + 28, sampleRate * blockAlign); // average bytes per second
+            encodeUInt16Little(header + 32, blockAlign);
+            encodeUInt16Little(header + 34, bitsPerSample);
+
+            header[36] = 'd'; header[37] = 'a'; header[38] = 't'; header[39] = 'a';
+            encodeUInt32Little(header + 40, static_cast<uint32_t>(samples.size()));
+
+            wave.insert(wave.end(), samples.begin(), samples.end());
+
+            if (!engine->getFileSystem()->writeFile(filename, wave)) return false;
+
+            Log(Log::Level::INFO) << "Rendered " << frames << " frames to " << filename <<
+                " in " << statistics.periods << " periods, median: " << statistics.median <<
+                "us, 90%: " << statistics.percentile90 << "us, 99%: " << statistics.percentile99 <<
+                "us, max: " << statistics.maximum << "us, " << statistics.realTimeFactor << "x real time";
+
+            return true;
+        }
     } // namespace audio
 } // namespace ouzel
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
 #include "audio/AudioDevice.hpp"
 
 namespace ouzel
@@ -16,8 +18,35 @@ namespace ouzel
         class AudioDeviceEmpty: public AudioDevice
         {
             friend Audio;
+        public:
+            // timings are in microseconds
+            struct RenderStatistics
+            {
+                uint32_t periods = 0;
+                uint32_t framesPerPeriod = 0;
+                float totalTime = 0.0f;
+                float minimum = 0.0f;
+                float average = 0.0f;
+                float median = 0.0f;
+                float percentile90 = 0.0f;
+                float percentile99 = 0.0f;
+                float maximum = 0.0f;
+                float realTimeFactor = 0.0f; // how many times faster than real time
+            };
+
+            // renders the given number of frames without waiting for a real device,
+            // calling the mixer once per period of periodSize frames
+            bool render(uint32_t frames, uint32_t periodSize,
+                        std::vector<uint8_t>& result,
+                        RenderStatistics& statistics);
+            bool renderToFile(const std::string& filename,
+                              uint32_t frames, uint32_t periodSize,
+                              RenderStatistics& statistics);
+
         protected:
             AudioDeviceEmpty();
+
+            std::vector<uint8_t> data;
         };
     } // namespace audio
 } // namespace ouzel
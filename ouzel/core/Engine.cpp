@@ -2,6 +2,7 @@
 // This file is part of the Ouzel engine.
 
 #include <algorithm>
+#include <thread>
 #include "Engine.hpp"
 #include "Setup.h"
 #include "utils/Log.hpp"
@@ -68,16 +69,7 @@ namespace ouzel
         }
 #endif
 
-        for (UpdateCallback* updateCallback : updateCallbackAddSet)
-        {
-            updateCallback->engine = nullptr;
-        }
-
-        for (UpdateCallback* updateCallback : updateCallbacks)
-        {
-            auto i = std::find(updateCallbackDeleteSet.begin(), updateCallbackDeleteSet.end(), updateCallback);
-            if (i == updateCallbackDeleteSet.end()) updateCallback->engine = nullptr;
-        }
+        updateScheduler.clear();
 
         engine = nullptr;
     }
@@ -100,6 +92,13 @@ namespace ouzel
         bool highDpi = true; // should high DPI resolution be used
         audio::Audio::Driver audioDriver = audio::Audio::Driver::DEFAULT;
         bool debugAudio = false;
+        bool coalesceMoves = false; // merge mouse and touch moves into one event per update
+        uint32_t jobThreads = 0; // workers of the job system, jobs run on the waiting thread without them
+
+#if OUZEL_MULTITHREADED
+        uint32_t cpuCount = std::thread::hardware_concurrency();
+        if (cpuCount > 1) jobThreads = cpuCount - 1;
+#endif
 
         defaultSettings.init("settings.ini");
         userSettings.init(fileSystem.getStorageDirectory() + FileSystem::DIRECTORY_SEPARATOR + "settings.ini");
@@ -240,9 +239,20 @@ namespace ouzel
             }
         }
 
+        std::string updateRateValue = userEngineSection.getValue("updateRate", defaultEngineSection.getValue("updateRate"));
+        if (!updateRateValue.empty()) framePacer.setTargetRate(std::stof(updateRateValue));
+
         std::string debugAudioValue = userEngineSection.getValue("debugAudio", defaultEngineSection.getValue("debugAudio"));
         if (!debugAudioValue.empty()) debugAudio = (debugAudioValue == "true" || debugAudioValue == "1" || debugAudioValue == "yes");
 
+        std::string coalesceMovesValue = userEngineSection.getValue("coalesceMoves", defaultEngineSection.getValue("coalesceMoves"));
+        if (!coalesceMovesValue.empty()) coalesceMoves = (coalesceMovesValue == "true" || coalesceMovesValue == "1" || coalesceMovesValue == "yes");
+
+        std::string jobThreadsValue = userEngineSection.getValue("jobThreads", defaultEngineSection.getValue("jobThreads"));
+        if (!jobThreadsValue.empty()) jobThreads = static_cast<uint32_t>(std::stoul(jobThreadsValue));
+
+        jobSystem.reset(new JobSystem(jobThreads));
+
         if (graphicsDriver == graphics::Renderer::Driver::DEFAULT)
         {
             auto availableDrivers = graphics::Renderer::getAvailableRenderDrivers();
@@ -356,6 +366,8 @@ namespace ouzel
             return false;
         }
 
+        input->setMoveCoalescing(coalesceMoves);
+
         if (!network.init())
         {
             return false;
@@ -434,6 +446,8 @@ namespace ouzel
             active = false;
         }
 
+        framePacer.wake();
+
 #if OUZEL_MULTITHREADED
         if (updateThread.isJoinable() &&
             updateThread.getId() != Thread::getCurrentThreadId())
@@ -453,68 +467,30 @@ namespace ouzel
         std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
         auto diff = currentTime - previousUpdateTime;
 
-        if (diff > std::chrono::milliseconds(1)) // at least one millisecond has passed
-        {
-            executeAll();
+        // the frame pacer decides when to update, so every wake (e.g. for a posted event) is handled
+        OUZEL_PROFILE_ZONE("Engine::update");
 
-            previousUpdateTime = currentTime;
-            float delta = std::chrono::duration_cast<std::chrono::microseconds>(diff).count() / 1000000.0f;
+        executeAll();
 
-            eventDispatcher.dispatchEvents();
+        previousUpdateTime = currentTime;
+        float delta = std::chrono::duration_cast<std::chrono::microseconds>(diff).count() / 1000000.0f;
 
-            for (UpdateCallback* updateCallback : updateCallbackDeleteSet)
-            {
-                auto i = std::find(updateCallbacks.begin(), updateCallbacks.end(), updateCallback);
-
-                if (i != updateCallbacks.end())
-                {
-                    updateCallbacks.erase(i);
-                }
-            }
-
-            updateCallbackDeleteSet.clear();
-
-            for (UpdateCallback* updateCallback : updateCallbackAddSet)
-            {
-                auto i = std::find(updateCallbacks.begin(), updateCallbacks.end(), updateCallback);
-
-                if (i == updateCallbacks.end())
-                {
-                    auto upperBound = std::upper_bound(updateCallbacks.begin(), updateCallbacks.end(), updateCallback,
-                                                       [](const UpdateCallback* a, const UpdateCallback* b) {
-                                                           return a->priority > b->priority;
-                                                       });
-
-                    updateCallbacks.insert(upperBound, updateCallback);
-                }
-            }
+        input->flushMoves();
+        eventDispatcher.dispatchEvents();
 
-            updateCallbackAddSet.clear();
+        fileSystem.update();
 
-            for (UpdateCallback* updateCallback : updateCallbacks)
-            {
-                auto i = std::find(updateCallbackDeleteSet.begin(), updateCallbackDeleteSet.end(), updateCallback);
+        updateScheduler.update(delta);
 
-                if (i == updateCallbackDeleteSet.end())
-                {
-                    updateCallback->timeSinceLastUpdate += delta;
+        sceneManager.update(delta);
 
-                    if (updateCallback->timeSinceLastUpdate >= updateCallback->interval)
-                    {
-                        updateCallback->timeSinceLastUpdate = (updateCallback->interval > 0.0f) ? fmodf(updateCallback->timeSinceLastUpdate, updateCallback->interval) : 0.0f;
-                        if (updateCallback->callback) updateCallback->callback(delta);
-                    }
-                }
-            }
-
-            if (renderer->getDevice()->getRefillQueue())
-            {
-                sceneManager.draw();
-                renderer->getDevice()->flushCommands();
-            }
-
-            audio->update();
+        if (renderer->getDevice()->getRefillQueue())
+        {
+            sceneManager.draw();
+            renderer->getDevice()->flushCommands();
         }
+
+        audio->update();
     }
 
     void Engine::main()
@@ -526,9 +502,8 @@ namespace ouzel
         {
             if (!paused)
             {
+                framePacer.wait();
                 update();
-
-                // TODO: implement sleep to reduce the power consumption
             }
             else
             {
@@ -550,15 +525,7 @@ namespace ouzel
         }
 
         callback->engine = this;
-
-        updateCallbackAddSet.insert(callback);
-
-        auto setIterator = updateCallbackDeleteSet.find(callback);
-
-        if (setIterator != updateCallbackDeleteSet.end())
-        {
-            updateCallbackDeleteSet.erase(setIterator);
-        }
+        updateScheduler.add(callback);
     }
 
     void Engine::unscheduleUpdate(UpdateCallback* callback)
@@ -566,44 +533,13 @@ namespace ouzel
         if (callback->engine == this)
         {
             callback->engine = nullptr;
-        }
-
-        updateCallbackDeleteSet.insert(callback);
-
-        auto setIterator = updateCallbackAddSet.find(callback);
-
-        if (setIterator != updateCallbackAddSet.end())
-        {
-            updateCallbackAddSet.erase(setIterator);
+            updateScheduler.remove(callback);
         }
     }
 
-    void Engine::executeOnUpdateThread(const std::function<void(void)>& func)
-    {
-        Lock lock(executeMutex);
-
-        executeQueue.push(func);
-    }
-
     void Engine::executeAll()
     {
-        std::function<void(void)> func;
-
-        for (;;)
-        {
-            {
-                Lock lock(executeMutex);
-                if (executeQueue.empty()) break;
-
-                func = std::move(executeQueue.front());
-                executeQueue.pop();
-            }
-
-            if (func)
-            {
-                func();
-            }
-        }
+        executeQueue.executeAll();
     }
 
     bool Engine::openURL(const std::string&)
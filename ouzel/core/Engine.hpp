@@ -9,7 +9,10 @@
 #include <atomic>
 #include <chrono>
 #include "Setup.h"
+#include "core/FramePacer.hpp"
+#include "core/Profiler.hpp"
 #include "core/UpdateCallback.hpp"
+#include "core/UpdateScheduler.hpp"
 #include "core/Timer.hpp"
 #include "core/Window.hpp"
 #include "graphics/Renderer.hpp"
@@ -21,6 +24,8 @@
 #include "localization/Localization.hpp"
 #include "network/Network.hpp"
 #include "thread/Condition.hpp"
+#include "thread/ExecuteQueue.hpp"
+#include "thread/JobSystem.hpp"
 #include "thread/Mutex.hpp"
 #include "thread/Thread.hpp"
 #include "utils/INI.hpp"
@@ -56,6 +61,11 @@ namespace ouzel
         inline scene::SceneManager* getSceneManager() { return &sceneManager; }
         inline input::Input* getInput() const { return input.get(); }
         inline Localization* getLocalization() { return &localization; }
+        inline FramePacer* getFramePacer() { return &framePacer; }
+        inline JobSystem* getJobSystem() const { return jobSystem.get(); }
+#if OUZEL_ENABLE_PROFILER
+        inline Profiler* getProfiler() { return &profiler; }
+#endif
         inline network::Network* getNetwork() { return &network; }
 
         inline const ini::Data& getDefaultSettings() const { return defaultSettings; }
@@ -73,7 +83,14 @@ namespace ouzel
         void scheduleUpdate(UpdateCallback* callback);
         void unscheduleUpdate(UpdateCallback* callback);
 
-        void executeOnUpdateThread(const std::function<void(void)>& func);
+        inline float getFixedUpdateStep() const { return updateScheduler.getFixedStep(); }
+        inline void setFixedUpdateStep(float step) { updateScheduler.setFixedStep(step); }
+        inline float getFixedUpdateAlpha() const { return updateScheduler.getFixedStepAlpha(); }
+
+        template<class F> void executeOnUpdateThread(F&& func)
+        {
+            executeQueue.push(std::forward<F>(func));
+        }
 
         void update();
 
@@ -88,6 +105,10 @@ namespace ouzel
         virtual void main();
         void executeAll();
 
+#if OUZEL_ENABLE_PROFILER
+        Profiler profiler; // zones can be recorded until all of the other members are destroyed
+#endif
+        std::unique_ptr<JobSystem> jobSystem; // destroyed after everything that could be running jobs
         FileSystem fileSystem;
         EventDispatcher eventDispatcher;
         Window window;
@@ -104,9 +125,8 @@ namespace ouzel
 
         std::chrono::steady_clock::time_point previousUpdateTime;
 
-        std::vector<UpdateCallback*> updateCallbacks;
-        std::set<UpdateCallback*> updateCallbackAddSet;
-        std::set<UpdateCallback*> updateCallbackDeleteSet;
+        UpdateScheduler updateScheduler;
+        FramePacer framePacer;
 
 #if OUZEL_MULTITHREADED
         Thread updateThread;
@@ -114,8 +134,7 @@ namespace ouzel
         Condition updateCondition;
 #endif
 
-        std::queue<std::function<void(void)>> executeQueue;
-        Mutex executeMutex;
+        ExecuteQueue executeQueue;
 
         std::atomic<bool> active;
         std::atomic<bool> paused;
@@ -0,0 +1,120 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <cmath>
+#include <thread>
+#include "FramePacer.hpp"
+#include "thread/Lock.hpp"
+
+namespace ouzel
+{
+    // condition variables can oversleep by the timer resolution, so the last part of the wait is spent yielding
+    static const std::chrono::steady_clock::duration SPIN_TIME = std::chrono::microseconds(500);
+    // the update runs at least this often even if nothing wakes it
+    static const std::chrono::steady_clock::duration MAX_IDLE_TIME = std::chrono::milliseconds(100);
+    // weight of the latest frame in the running averages
+    static const float AVERAGE_WEIGHT = 0.05f;
+
+    FramePacer::FramePacer():
+        waiting(false), woken(false), targetRate(0.0f)
+    {
+    }
+
+    void FramePacer::setTargetRate(float newTargetRate)
+    {
+        targetRate = (newTargetRate > 0.0f) ? newTargetRate : 0.0f;
+    }
+
+    void FramePacer::wait()
+    {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        float rate = targetRate;
+
+        if (rate > 0.0f)
+        {
+            std::chrono::steady_clock::duration period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(1.0f / rate));
+
+            // start over instead of running several updates back to back after a stall
+            if (nextFrameTime + period < now) nextFrameTime = now;
+
+            waitUntil(nextFrameTime, false);
+            nextFrameTime += period;
+        }
+        else
+        {
+            waitUntil(now + MAX_IDLE_TIME, true);
+            nextFrameTime = std::chrono::steady_clock::now();
+        }
+
+        updateStatistics(std::chrono::steady_clock::now());
+    }
+
+    void FramePacer::wake()
+    {
+        woken = true;
+
+        if (waiting)
+        {
+            Lock lock(mutex);
+            condition.signal();
+        }
+    }
+
+    void FramePacer::resetStatistics()
+    {
+        frameTime = 0.0f;
+        averageFrameTime = 0.0f;
+        jitter = 0.0f;
+        maxJitter = 0.0f;
+        frameCount = 0;
+    }
+
+    void FramePacer::waitUntil(std::chrono::steady_clock::time_point time, bool wakeable)
+    {
+        // waits that follow the renderer don't need a precise wake-up time
+        std::chrono::steady_clock::duration spinTime = wakeable ? std::chrono::steady_clock::duration::zero() : SPIN_TIME;
+
+        {
+            Lock lock(mutex);
+            waiting = true;
+
+            for (;;)
+            {
+                if (wakeable && woken) break;
+
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                if (now + spinTime >= time) break;
+
+                condition.wait(mutex, time - now - spinTime);
+            }
+
+            waiting = false;
+        }
+
+        if (!wakeable)
+        {
+            while (std::chrono::steady_clock::now() < time)
+                std::this_thread::yield();
+        }
+
+        woken = false;
+    }
+
+    void FramePacer::updateStatistics(std::chrono::steady_clock::time_point now)
+    {
+        if (frameCount > 0)
+        {
+            frameTime = std::chrono::duration<float>(now - previousFrameTime).count();
+            averageFrameTime = (frameCount == 1) ? frameTime : averageFrameTime + (frameTime - averageFrameTime) * AVERAGE_WEIGHT;
+
+            float rate = targetRate;
+            float deviation = std::fabs(frameTime - ((rate > 0.0f) ? 1.0f / rate : averageFrameTime));
+
+            jitter += (deviation - jitter) * AVERAGE_WEIGHT;
+            if (deviation > maxJitter) maxJitter = deviation;
+        }
+
+        previousFrameTime = now;
+        ++frameCount;
+    }
+}
@@ -0,0 +1,63 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "thread/Condition.hpp"
+#include "thread/Mutex.hpp"
+
+namespace ouzel
+{
+    // decides when the update thread runs the next update and sleeps in between
+    class FramePacer final
+    {
+    public:
+        FramePacer();
+
+        FramePacer(const FramePacer&) = delete;
+        FramePacer& operator=(const FramePacer&) = delete;
+
+        FramePacer(FramePacer&&) = delete;
+        FramePacer& operator=(FramePacer&&) = delete;
+
+        // updates per second, 0 means that the update follows the renderer and posted events
+        inline float getTargetRate() const { return targetRate; }
+        void setTargetRate(float newTargetRate);
+
+        // blocks the calling thread until the next update should run
+        void wait();
+
+        // can be called from any thread, cuts the wait short when there is no target rate
+        void wake();
+
+        inline float getFrameTime() const { return frameTime; }
+        inline float getAverageFrameTime() const { return averageFrameTime; }
+        // average deviation of the frame time from the target period (or from the average frame time)
+        inline float getJitter() const { return jitter; }
+        inline float getMaxJitter() const { return maxJitter; }
+        inline uint64_t getFrameCount() const { return frameCount; }
+        void resetStatistics();
+
+    private:
+        void waitUntil(std::chrono::steady_clock::time_point time, bool wakeable);
+        void updateStatistics(std::chrono::steady_clock::time_point now);
+
+        Mutex mutex;
+        Condition condition;
+        std::atomic<bool> waiting;
+        std::atomic<bool> woken;
+
+        std::atomic<float> targetRate;
+        std::chrono::steady_clock::time_point nextFrameTime;
+        std::chrono::steady_clock::time_point previousFrameTime;
+
+        float frameTime = 0.0f;
+        float averageFrameTime = 0.0f;
+        float jitter = 0.0f;
+        float maxJitter = 0.0f;
+        uint64_t frameCount = 0;
+    };
+}
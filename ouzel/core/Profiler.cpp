@@ -0,0 +1,237 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include "Profiler.hpp"
+
+#if OUZEL_ENABLE_PROFILER
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include "core/Engine.hpp"
+#include "thread/Lock.hpp"
+#include "utils/JSON.hpp"
+
+namespace ouzel
+{
+    Profiler::Profiler():
+        startTime(std::chrono::steady_clock::now()), enabled(true), threadBufferCount(0)
+    {
+    }
+
+    uint64_t Profiler::getTime() const
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count());
+    }
+
+    void Profiler::addZone(const char* name, uint64_t start, uint64_t end)
+    {
+        ThreadBuffer* threadBuffer = getThreadBuffer();
+        if (!threadBuffer) return;
+
+        // only the owning thread writes to the buffer, so the position doesn't need a read-modify-write
+        uint64_t position = threadBuffer->position.load(std::memory_order_relaxed);
+        Entry& entry = threadBuffer->entries[position & (BUFFER_SIZE - 1)];
+
+        // the entry can be read at the same time, the readers check the sequence before and after reading it
+        entry.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        entry.name.store(name, std::memory_order_relaxed);
+        entry.start.store(start, std::memory_order_relaxed);
+        entry.end.store(end, std::memory_order_relaxed);
+
+        entry.sequence.store(position + 1, std::memory_order_release);
+        threadBuffer->position.store(position + 1, std::memory_order_release);
+    }
+
+    std::vector<Profiler::Zone> Profiler::getZones() const
+    {
+        std::vector<Zone> zones;
+
+        uint32_t count = threadBufferCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < count; ++i)
+            readZones(i, zones);
+
+        std::sort(zones.begin(), zones.end(), [](const Zone& a, const Zone& b) {
+            return a.start < b.start;
+        });
+
+        return zones;
+    }
+
+    std::vector<std::string> Profiler::getThreadNames() const
+    {
+        std::vector<std::string> threadNames;
+
+        uint32_t count = threadBufferCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < count; ++i)
+            threadNames.push_back(threadBuffers[i]->name);
+
+        return threadNames;
+    }
+
+    std::vector<Profiler::ZoneStatistics> Profiler::getStatistics(float period) const
+    {
+        uint64_t currentTime = getTime();
+        uint64_t periodTime = static_cast<uint64_t>(period * 1000000000.0f);
+        uint64_t periodStart = (currentTime > periodTime) ? currentTime - periodTime : 0;
+
+        std::map<std::string, ZoneStatistics> zoneStatistics;
+
+        for (const Zone& zone : getZones())
+        {
+            if (zone.end < periodStart) continue;
+
+            ZoneStatistics& statistics = zoneStatistics[zone.name];
+            float time = static_cast<float>(zone.end - zone.start) / 1000000000.0f;
+
+            ++statistics.count;
+            statistics.totalTime += time;
+            if (time > statistics.maxTime) statistics.maxTime = time;
+        }
+
+        std::vector<ZoneStatistics> result;
+        result.reserve(zoneStatistics.size());
+
+        for (auto& i : zoneStatistics)
+        {
+            i.second.name = i.first;
+            result.push_back(i.second);
+        }
+
+        std::sort(result.begin(), result.end(), [](const ZoneStatistics& a, const ZoneStatistics& b) {
+            return a.totalTime > b.totalTime;
+        });
+
+        return result;
+    }
+
+    std::string Profiler::getSummary(float period) const
+    {
+        std::string summary;
+
+        for (const ZoneStatistics& statistics : getStatistics(period))
+        {
+            char line[256];
+            snprintf(line, sizeof(line), "%s: %u calls, %.2f ms total, %.3f ms avg, %.3f ms max\n",
+                     statistics.name.c_str(), statistics.count,
+                     statistics.totalTime * 1000.0f,
+                     statistics.totalTime * 1000.0f / statistics.count,
+                     statistics.maxTime * 1000.0f);
+
+            summary += line;
+        }
+
+        return summary;
+    }
+
+    bool Profiler::exportTrace(const std::string& filename) const
+    {
+        json::Data data;
+        json::Value& traceEvents = data["traceEvents"];
+        traceEvents = json::Value::Type::ARRAY;
+
+        std::vector<std::string> threadNames = getThreadNames();
+
+        for (size_t i = 0; i < threadNames.size(); ++i)
+        {
+            json::Value event = json::Value::Type::OBJECT;
+            event["name"] = std::string("thread_name");
+            event["ph"] = std::string("M");
+            event["pid"] = 0;
+            event["tid"] = static_cast<uint32_t>(i);
+            json::Value& args = event["args"];
+            args = json::Value::Type::OBJECT;
+            args["name"] = threadNames[i];
+
+            traceEvents.asArray().push_back(event);
+        }
+
+        for (const Zone& zone : getZones())
+        {
+            // timestamps are in microseconds
+            json::Value event = json::Value::Type::OBJECT;
+            event["name"] = std::string(zone.name);
+            event["ph"] = std::string("X");
+            event["pid"] = 0;
+            event["tid"] = zone.thread;
+            event["ts"] = static_cast<double>(zone.start) / 1000.0;
+            event["dur"] = static_cast<double>(zone.end - zone.start) / 1000.0;
+
+            traceEvents.asArray().push_back(event);
+        }
+
+        data["displayTimeUnit"] = std::string("ms");
+
+        return data.save(filename);
+    }
+
+    Profiler::ThreadBuffer* Profiler::getThreadBuffer()
+    {
+        Thread::ID currentThreadId = Thread::getCurrentThreadId();
+
+        uint32_t count = threadBufferCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < count; ++i)
+            if (threadBuffers[i]->threadId == currentThreadId) return threadBuffers[i].get();
+
+        // the buffer of this thread can only be added by this thread, so it can't have appeared in the meantime
+        Lock lock(threadBufferMutex);
+
+        count = threadBufferCount.load(std::memory_order_relaxed);
+        if (count >= MAX_THREADS) return nullptr;
+
+        std::unique_ptr<ThreadBuffer> threadBuffer(new ThreadBuffer(currentThreadId));
+        threadBuffer->name = Thread::getCurrentThreadName();
+        if (threadBuffer->name.empty()) threadBuffer->name = "Thread " + std::to_string(count);
+
+        threadBuffers[count] = std::move(threadBuffer);
+        threadBufferCount.store(count + 1, std::memory_order_release);
+
+        return threadBuffers[count].get();
+    }
+
+    void Profiler::readZones(uint32_t threadIndex, std::vector<Zone>& zones) const
+    {
+        const ThreadBuffer& threadBuffer = *threadBuffers[threadIndex];
+
+        uint64_t end = threadBuffer.position.load(std::memory_order_acquire);
+        uint64_t begin = (end > BUFFER_SIZE) ? end - BUFFER_SIZE : 0;
+
+        for (uint64_t i = begin; i < end; ++i)
+        {
+            const Entry& entry = threadBuffer.entries[i & (BUFFER_SIZE - 1)];
+
+            // skip the entries that the writer has already reused
+            if (entry.sequence.load(std::memory_order_acquire) != i + 1) continue;
+
+            Zone zone;
+            zone.name = entry.name.load(std::memory_order_relaxed);
+            zone.thread = threadIndex;
+            zone.start = entry.start.load(std::memory_order_relaxed);
+            zone.end = entry.end.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (entry.sequence.load(std::memory_order_relaxed) != i + 1) continue;
+
+            zones.push_back(zone);
+        }
+    }
+
+    ProfileZone::ProfileZone(const char* initName):
+        name(initName)
+    {
+        if (engine && engine->getProfiler()->isEnabled())
+        {
+            profiler = engine->getProfiler();
+            start = profiler->getTime();
+        }
+    }
+
+    ProfileZone::~ProfileZone()
+    {
+        if (profiler) profiler->addZone(name, start, profiler->getTime());
+    }
+}
+
+#endif
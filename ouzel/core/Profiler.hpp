@@ -0,0 +1,135 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include "core/Setup.h"
+
+#if OUZEL_ENABLE_PROFILER
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "thread/Mutex.hpp"
+#include "thread/Thread.hpp"
+
+namespace ouzel
+{
+    // records the time spent in the zones of every thread, each thread writes only to its own ring buffer
+    class Profiler final
+    {
+    public:
+        static const uint32_t MAX_THREADS = 64; // zones of any further threads are not recorded
+        static const uint32_t BUFFER_SIZE = 16384; // zones kept for every thread, must be a power of two
+
+        struct Zone
+        {
+            const char* name;
+            uint32_t thread;
+            uint64_t start; // nanoseconds since the profiler was created
+            uint64_t end;
+        };
+
+        struct ZoneStatistics
+        {
+            std::string name;
+            uint32_t count = 0;
+            float totalTime = 0.0f; // in seconds
+            float maxTime = 0.0f;
+        };
+
+        Profiler();
+
+        Profiler(const Profiler&) = delete;
+        Profiler& operator=(const Profiler&) = delete;
+
+        Profiler(Profiler&&) = delete;
+        Profiler& operator=(Profiler&&) = delete;
+
+        inline void setEnabled(bool newEnabled) { enabled = newEnabled; }
+        inline bool isEnabled() const { return enabled; }
+
+        uint64_t getTime() const;
+
+        // can be called from any thread, the name must stay valid as long as the profiler exists
+        void addZone(const char* name, uint64_t start, uint64_t end);
+
+        // zones that are still in the buffers, sorted by their start time
+        std::vector<Zone> getZones() const;
+        std::vector<std::string> getThreadNames() const;
+
+        // zones that ended during the last period seconds, sorted by the total time
+        std::vector<ZoneStatistics> getStatistics(float period = 1.0f) const;
+        // one line per zone, meant to be shown in a label
+        std::string getSummary(float period = 1.0f) const;
+
+        // writes the zones in the Chrome trace event format (chrome://tracing)
+        bool exportTrace(const std::string& filename) const;
+
+    private:
+        struct Entry
+        {
+            std::atomic<uint64_t> sequence; // position + 1 of the zone in the entry, 0 while it is being written
+            std::atomic<const char*> name;
+            std::atomic<uint64_t> start;
+            std::atomic<uint64_t> end;
+        };
+
+        struct ThreadBuffer
+        {
+            explicit ThreadBuffer(const Thread::ID& initThreadId):
+                threadId(initThreadId), position(0)
+            {
+                for (Entry& entry : entries) entry.sequence.store(0, std::memory_order_relaxed);
+            }
+
+            Thread::ID threadId;
+            std::string name;
+            std::atomic<uint64_t> position;
+            Entry entries[BUFFER_SIZE];
+        };
+
+        ThreadBuffer* getThreadBuffer();
+        void readZones(uint32_t threadIndex, std::vector<Zone>& zones) const;
+
+        std::chrono::steady_clock::time_point startTime;
+        std::atomic<bool> enabled;
+
+        // buffers are only added, so that the writers never have to lock
+        Mutex threadBufferMutex;
+        std::unique_ptr<ThreadBuffer> threadBuffers[MAX_THREADS];
+        std::atomic<uint32_t> threadBufferCount;
+    };
+
+    // adds a zone to the engine's profiler that lasts from the construction to the destruction
+    class ProfileZone final
+    {
+    public:
+        explicit ProfileZone(const char* initName);
+        ~ProfileZone();
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+
+        ProfileZone(ProfileZone&&) = delete;
+        ProfileZone& operator=(ProfileZone&&) = delete;
+
+    private:
+        Profiler* profiler = nullptr;
+        const char* name;
+        uint64_t start = 0;
+    };
+}
+
+#define OUZEL_PROFILE_CONCATENATE_DETAIL(a, b) a##b
+#define OUZEL_PROFILE_CONCATENATE(a, b) OUZEL_PROFILE_CONCATENATE_DETAIL(a, b)
+#define OUZEL_PROFILE_ZONE(name) ouzel::ProfileZone OUZEL_PROFILE_CONCATENATE(profileZone, __LINE__)(name)
+
+#else
+
+#define OUZEL_PROFILE_ZONE(name)
+
+#endif
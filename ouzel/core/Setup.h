@@ -77,3 +77,8 @@
 #if OUZEL_SUPPORTS_ALSA && OUZEL_ENABLE_ALSA
 #define OUZEL_COMPILE_ALSA 1
 #endif
+
+// Profiler
+#ifndef OUZEL_ENABLE_PROFILER
+#define OUZEL_ENABLE_PROFILER 0
+#endif
@@ -9,24 +9,45 @@
 namespace ouzel
 {
     class Engine;
+    class UpdateScheduler;
 
     class UpdateCallback
     {
         friend Engine;
+        friend UpdateScheduler;
     public:
+        enum class Phase
+        {
+            VARIABLE, // called once per frame with the frame delta
+            FIXED // called zero or more times per frame with the fixed update step
+        };
+
         static const int32_t PRIORITY_MAX = 0x1000;
 
-        explicit UpdateCallback(int32_t initPriority = 0): priority(initPriority) {}
+        explicit UpdateCallback(int32_t initPriority = 0, Phase initPhase = Phase::VARIABLE):
+            priority(initPriority), phase(initPhase) {}
         ~UpdateCallback();
 
+        UpdateCallback(const UpdateCallback&) = delete;
+        UpdateCallback& operator=(const UpdateCallback&) = delete;
+
+        UpdateCallback(UpdateCallback&&) = delete;
+        UpdateCallback& operator=(UpdateCallback&&) = delete;
+
         void remove();
 
+        inline int32_t getPriority() const { return priority; }
+        inline Phase getPhase() const { return phase; }
+
         std::function<void(float)> callback;
-        float interval = 0.0f;
 
     protected:
         int32_t priority;
+        Phase phase;
         Engine* engine = nullptr;
-        float timeSinceLastUpdate = 0.0f;
+
+        // position in the scheduler, valid while engine is set
+        uint32_t index = 0;
+        bool pending = false;
     };
 }
@@ -0,0 +1,177 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include "UpdateScheduler.hpp"
+
+namespace ouzel
+{
+    UpdateScheduler::UpdateScheduler()
+    {
+    }
+
+    UpdateScheduler::~UpdateScheduler()
+    {
+        clear();
+    }
+
+    void UpdateScheduler::add(UpdateCallback* callback)
+    {
+        callback->pending = true;
+        callback->index = static_cast<uint32_t>(pendingCallbacks.size());
+        pendingCallbacks.push_back(callback);
+        ++callbackCount;
+    }
+
+    void UpdateScheduler::remove(UpdateCallback* callback)
+    {
+        if (callback->pending)
+        {
+            pendingCallbacks[callback->index] = nullptr;
+            callback->pending = false;
+        }
+        else
+        {
+            Bucket& bucket = getBucket(callback->phase, callback->priority);
+            bucket.callbacks[callback->index] = nullptr;
+            bucket.dirty = true;
+        }
+
+        --callbackCount;
+    }
+
+    void UpdateScheduler::clear()
+    {
+        for (UpdateCallback* callback : pendingCallbacks)
+        {
+            if (callback)
+            {
+                callback->engine = nullptr;
+                callback->pending = false;
+            }
+        }
+
+        for (std::vector<Bucket>* buckets : {&variableBuckets, &fixedBuckets})
+        {
+            for (Bucket& bucket : *buckets)
+            {
+                for (UpdateCallback* callback : bucket.callbacks)
+                {
+                    if (callback) callback->engine = nullptr;
+                }
+            }
+
+            buckets->clear();
+        }
+
+        pendingCallbacks.clear();
+        callbackCount = 0;
+    }
+
+    void UpdateScheduler::update(float delta)
+    {
+        for (UpdateCallback* callback : pendingCallbacks)
+        {
+            if (callback)
+            {
+                Bucket& bucket = getBucket(callback->phase, callback->priority);
+                callback->pending = false;
+                callback->index = static_cast<uint32_t>(bucket.callbacks.size());
+                bucket.callbacks.push_back(callback);
+            }
+        }
+
+        pendingCallbacks.clear();
+
+        if (fixedStep > 0.0f)
+        {
+            accumulator += delta;
+
+            uint32_t steps = 0;
+            while (accumulator >= fixedStep)
+            {
+                // drop the remaining time instead of spiraling when the fixed phase can't keep up
+                if (maxFixedSteps && steps >= maxFixedSteps)
+                {
+                    accumulator = 0.0f;
+                    break;
+                }
+
+                runBuckets(fixedBuckets, fixedStep);
+                accumulator -= fixedStep;
+                ++steps;
+            }
+        }
+
+        runBuckets(variableBuckets, delta);
+
+        compactBuckets(fixedBuckets);
+        compactBuckets(variableBuckets);
+    }
+
+    void UpdateScheduler::setFixedStep(float newFixedStep)
+    {
+        fixedStep = newFixedStep;
+        accumulator = 0.0f;
+    }
+
+    std::vector<UpdateScheduler::Bucket>& UpdateScheduler::getBuckets(UpdateCallback::Phase phase)
+    {
+        return (phase == UpdateCallback::Phase::FIXED) ? fixedBuckets : variableBuckets;
+    }
+
+    UpdateScheduler::Bucket& UpdateScheduler::getBucket(UpdateCallback::Phase phase, int32_t priority)
+    {
+        std::vector<Bucket>& buckets = getBuckets(phase);
+
+        auto i = std::lower_bound(buckets.begin(), buckets.end(), priority,
+                                  [](const Bucket& bucket, int32_t value) {
+                                      return bucket.priority > value;
+                                  });
+
+        if (i == buckets.end() || i->priority != priority)
+        {
+            Bucket bucket;
+            bucket.priority = priority;
+            i = buckets.insert(i, std::move(bucket));
+        }
+
+        return *i;
+    }
+
+    void UpdateScheduler::runBuckets(std::vector<Bucket>& buckets, float delta)
+    {
+        for (Bucket& bucket : buckets)
+        {
+            // callbacks added during the update go to the pending list, so the size doesn't change
+            for (size_t i = 0; i < bucket.callbacks.size(); ++i)
+            {
+                UpdateCallback* callback = bucket.callbacks[i];
+                if (callback && callback->callback) callback->callback(delta);
+            }
+        }
+    }
+
+    void UpdateScheduler::compactBuckets(std::vector<Bucket>& buckets)
+    {
+        for (Bucket& bucket : buckets)
+        {
+            if (!bucket.dirty) continue;
+
+            uint32_t index = 0;
+            for (UpdateCallback* callback : bucket.callbacks)
+            {
+                if (callback)
+                {
+                    callback->index = index;
+                    bucket.callbacks[index++] = callback;
+                }
+            }
+
+            bucket.callbacks.resize(index);
+            bucket.dirty = false;
+        }
+
+        // buckets are kept when they become empty, priorities are usually reused
+    }
+}
@@ -0,0 +1,71 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "core/UpdateCallback.hpp"
+
+namespace ouzel
+{
+    class UpdateScheduler final
+    {
+    public:
+        static const uint32_t DEFAULT_MAX_FIXED_STEPS = 8;
+
+        UpdateScheduler();
+        ~UpdateScheduler();
+
+        UpdateScheduler(const UpdateScheduler&) = delete;
+        UpdateScheduler& operator=(const UpdateScheduler&) = delete;
+
+        UpdateScheduler(UpdateScheduler&&) = delete;
+        UpdateScheduler& operator=(UpdateScheduler&&) = delete;
+
+        // added callbacks are first called on the next update, removed ones are not called anymore
+        void add(UpdateCallback* callback);
+        void remove(UpdateCallback* callback);
+
+        // detaches all callbacks from the engine without calling them
+        void clear();
+
+        // runs the fixed phase as many times as the accumulated time allows and then the variable phase
+        void update(float delta);
+
+        inline float getFixedStep() const { return fixedStep; }
+        void setFixedStep(float newFixedStep);
+
+        inline uint32_t getMaxFixedSteps() const { return maxFixedSteps; }
+        inline void setMaxFixedSteps(uint32_t newMaxFixedSteps) { maxFixedSteps = newMaxFixedSteps; }
+
+        // how far the variable phase is between the last and the next fixed step (0..1), used for interpolation
+        inline float getFixedStepAlpha() const { return fixedStep > 0.0f ? accumulator / fixedStep : 0.0f; }
+
+        inline size_t getCallbackCount() const { return callbackCount; }
+
+    private:
+        struct Bucket
+        {
+            int32_t priority;
+            std::vector<UpdateCallback*> callbacks;
+            bool dirty = false; // has removed callbacks
+        };
+
+        std::vector<Bucket>& getBuckets(UpdateCallback::Phase phase);
+        Bucket& getBucket(UpdateCallback::Phase phase, int32_t priority);
+        static void runBuckets(std::vector<Bucket>& buckets, float delta);
+        static void compactBuckets(std::vector<Bucket>& buckets);
+
+        // sorted by priority in descending order
+        std::vector<Bucket> variableBuckets;
+        std::vector<Bucket> fixedBuckets;
+        std::vector<UpdateCallback*> pendingCallbacks;
+        size_t callbackCount = 0;
+
+        float fixedStep = 1.0f / 60.0f;
+        uint32_t maxFixedSteps = DEFAULT_MAX_FIXED_STEPS;
+        float accumulator = 0.0f;
+    };
+}
@@ -4,7 +4,7 @@
 #include <algorithm>
 #include "EventDispatcher.hpp"
 #include "EventHandler.hpp"
-#include "thread/Lock.hpp"
+#include "core/Engine.hpp"
 
 namespace ouzel
 {
@@ -14,171 +14,56 @@ namespace ouzel
 
     EventDispatcher::~EventDispatcher()
     {
-        for (EventHandler* eventHandler : eventHandlerAddSet)
+        for (EventHandler* eventHandler : pendingEventHandlers)
         {
-            eventHandler->eventDispatcher = nullptr;
+            if (eventHandler) eventHandler->eventDispatcher = nullptr;
         }
 
         for (EventHandler* eventHandler : eventHandlers)
         {
-            auto i = std::find(eventHandlerDeleteSet.begin(), eventHandlerDeleteSet.end(), eventHandler);
-            if (i == eventHandlerDeleteSet.end()) eventHandler->eventDispatcher = nullptr;
+            if (eventHandler) eventHandler->eventDispatcher = nullptr;
         }
     }
 
     void EventDispatcher::dispatchEvents()
     {
-        for (EventHandler* eventHandler : eventHandlerDeleteSet)
-        {
-            auto i = std::find(eventHandlers.begin(), eventHandlers.end(), eventHandler);
-
-            if (i != eventHandlers.end())
-            {
-                eventHandlers.erase(i);
-            }
-        }
-
-        eventHandlerDeleteSet.clear();
+        OUZEL_PROFILE_ZONE("EventDispatcher::dispatchEvents");
 
-        for (EventHandler* eventHandler : eventHandlerAddSet)
+        if (eventHandlersDirty)
         {
-            auto i = std::find(eventHandlers.begin(), eventHandlers.end(), eventHandler);
-
-            if (i == eventHandlers.end())
-            {
-                auto upperBound = std::upper_bound(eventHandlers.begin(), eventHandlers.end(), eventHandler,
-                                                   [](const EventHandler* a, const EventHandler* b) {
-                                                       return a->priority > b->priority;
-                                                   });
-
-                eventHandlers.insert(upperBound, eventHandler);
-            }
+            eventHandlers.erase(std::remove(eventHandlers.begin(), eventHandlers.end(), nullptr), eventHandlers.end());
+            eventHandlersDirty = false;
         }
 
-        eventHandlerAddSet.clear();
-
-        Event event;
-
-        for (;;)
+        if (!pendingEventHandlers.empty())
         {
-            {
-                Lock lock(eventQueueMutex);
-                if (eventQueue.empty()) break;
-
-                event = std::move(eventQueue.front());
-                eventQueue.pop();
-            }
-
-            bool propagate = true;
+            size_t count = eventHandlers.size();
 
-            for (const EventHandler* eventHandler : eventHandlers)
+            for (EventHandler* eventHandler : pendingEventHandlers)
             {
-                auto i = std::find(eventHandlerDeleteSet.begin(), eventHandlerDeleteSet.end(), eventHandler);
-
-                if (i == eventHandlerDeleteSet.end())
+                if (eventHandler)
                 {
-                    switch (event.type)
-                    {
-                        case Event::Type::KEY_PRESS:
-                        case Event::Type::KEY_RELEASE:
-                        case Event::Type::KEY_REPEAT:
-                            if (eventHandler->keyboardHandler)
-                            {
-                                propagate = eventHandler->keyboardHandler(event.type, event.keyboardEvent);
-                            }
-                            break;
-
-                        case Event::Type::MOUSE_PRESS:
-                        case Event::Type::MOUSE_RELEASE:
-                        case Event::Type::MOUSE_SCROLL:
-                        case Event::Type::MOUSE_MOVE:
-                            if (eventHandler->mouseHandler)
-                            {
-                                propagate = eventHandler->mouseHandler(event.type, event.mouseEvent);
-                            }
-                            break;
-                        case Event::Type::TOUCH_BEGIN:
-                        case Event::Type::TOUCH_MOVE:
-                        case Event::Type::TOUCH_END:
-                        case Event::Type::TOUCH_CANCEL:
-                            if (eventHandler->touchHandler)
-                            {
-                                propagate = eventHandler->touchHandler(event.type, event.touchEvent);
-                            }
-                            break;
-                        case Event::Type::GAMEPAD_CONNECT:
-                        case Event::Type::GAMEPAD_DISCONNECT:
-                        case Event::Type::GAMEPAD_BUTTON_CHANGE:
-                            if (eventHandler->gamepadHandler)
-                            {
-                                propagate = eventHandler->gamepadHandler(event.type, event.gamepadEvent);
-                            }
-                            break;
-                        case Event::Type::WINDOW_SIZE_CHANGE:
-                        case Event::Type::WINDOW_TITLE_CHANGE:
-                        case Event::Type::FULLSCREEN_CHANGE:
-                        case Event::Type::SCREEN_CHANGE:
-                        case Event::Type::RESOLUTION_CHANGE:
-                            if (eventHandler->windowHandler)
-                            {
-                                propagate = eventHandler->windowHandler(event.type, event.windowEvent);
-                            }
-                            break;
-                        case Event::Type::ENGINE_START:
-                        case Event::Type::ENGINE_STOP:
-                        case Event::Type::ENGINE_RESUME:
-                        case Event::Type::ENGINE_PAUSE:
-                        case Event::Type::ORIENTATION_CHANGE:
-                        case Event::Type::LOW_MEMORY:
-                        case Event::Type::OPEN_FILE:
-                            if (eventHandler->systemHandler)
-                            {
-                                propagate = eventHandler->systemHandler(event.type, event.systemEvent);
-                            }
-                            break;
-                        case Event::Type::ACTOR_ENTER:
-                        case Event::Type::ACTOR_LEAVE:
-                        case Event::Type::ACTOR_PRESS:
-                        case Event::Type::ACTOR_RELEASE:
-                        case Event::Type::ACTOR_CLICK:
-                        case Event::Type::ACTOR_DRAG:
-                        case Event::Type::WIDGET_CHANGE:
-                            if (eventHandler->uiHandler)
-                            {
-                                propagate = eventHandler->uiHandler(event.type, event.uiEvent);
-                            }
-                            break;
-                        case Event::Type::ANIMATION_START:
-                        case Event::Type::ANIMATION_RESET:
-                        case Event::Type::ANIMATION_FINISH:
-                            if (eventHandler->animationHandler)
-                            {
-                                propagate = eventHandler->animationHandler(event.type, event.animationEvent);
-                            }
-                            break;
-                        case Event::Type::SOUND_START:
-                        case Event::Type::SOUND_RESET:
-                        case Event::Type::SOUND_FINISH:
-                            if (eventHandler->soundHandler)
-                            {
-                                propagate = eventHandler->soundHandler(event.type, event.soundEvent);
-                            }
-                            break;
-                        case Event::Type::USER:
-                            if (eventHandler->userHandler)
-                            {
-                                propagate = eventHandler->userHandler(event.type, event.userEvent);
-                            }
-                            break;
-                    }
+                    eventHandler->pending = false;
+                    eventHandlers.push_back(eventHandler);
                 }
             }
 
-            if (!propagate)
+            pendingEventHandlers.clear();
+
+            // new handlers go after the existing ones with the same priority
+            if (eventHandlers.size() != count)
             {
-                break;
+                std::stable_sort(eventHandlers.begin(), eventHandlers.end(),
+                                 [](const EventHandler* a, const EventHandler* b) {
+                                     return a->priority > b->priority;
+                                 });
             }
         }
+
+        // handler functions can be changed after the handler was added, so the lists are rebuilt every time
+        updateCategoryHandlers();
+
+        eventQueue.executeAll();
     }
 
     void EventDispatcher::addEventHandler(EventHandler* eventHandler)
@@ -189,38 +74,190 @@ namespace ouzel
         }
 
         eventHandler->eventDispatcher = this;
+        eventHandler->pending = true;
+        eventHandler->index = static_cast<uint32_t>(pendingEventHandlers.size());
+        pendingEventHandlers.push_back(eventHandler);
+    }
 
-        eventHandlerAddSet.insert(eventHandler);
+    void EventDispatcher::removeEventHandler(EventHandler* eventHandler)
+    {
+        if (eventHandler->eventDispatcher != this) return;
 
-        auto setIterator = eventHandlerDeleteSet.find(eventHandler);
+        eventHandler->eventDispatcher = nullptr;
 
-        if (setIterator != eventHandlerDeleteSet.end())
+        if (eventHandler->pending)
+        {
+            pendingEventHandlers[eventHandler->index] = nullptr;
+            eventHandler->pending = false;
+        }
+        else
         {
-            eventHandlerDeleteSet.erase(setIterator);
+            // the handler can be deleted while the events are being dispatched, so its slot is cleared right away
+            eventHandlers[eventHandler->index] = nullptr;
+            eventHandlersDirty = true;
         }
     }
 
-    void EventDispatcher::removeEventHandler(EventHandler* eventHandler)
+    void EventDispatcher::postEvent(const Event& event)
     {
-        if (eventHandler->eventDispatcher == this)
+        switch (event.type)
         {
-            eventHandler->eventDispatcher = nullptr;
+            case Event::Type::KEY_PRESS:
+            case Event::Type::KEY_RELEASE:
+            case Event::Type::KEY_REPEAT:
+                postEvent(event.type, event.keyboardEvent);
+                break;
+            case Event::Type::MOUSE_PRESS:
+            case Event::Type::MOUSE_RELEASE:
+            case Event::Type::MOUSE_SCROLL:
+            case Event::Type::MOUSE_MOVE:
+                postEvent(event.type, event.mouseEvent);
+                break;
+            case Event::Type::TOUCH_BEGIN:
+            case Event::Type::TOUCH_MOVE:
+            case Event::Type::TOUCH_END:
+            case Event::Type::TOUCH_CANCEL:
+                postEvent(event.type, event.touchEvent);
+                break;
+            case Event::Type::GAMEPAD_CONNECT:
+            case Event::Type::GAMEPAD_DISCONNECT:
+            case Event::Type::GAMEPAD_BUTTON_CHANGE:
+                postEvent(event.type, event.gamepadEvent);
+                break;
+            case Event::Type::WINDOW_SIZE_CHANGE:
+            case Event::Type::WINDOW_TITLE_CHANGE:
+            case Event::Type::FULLSCREEN_CHANGE:
+            case Event::Type::SCREEN_CHANGE:
+            case Event::Type::RESOLUTION_CHANGE:
+                postEvent(event.type, event.windowEvent);
+                break;
+            case Event::Type::ENGINE_START:
+            case Event::Type::ENGINE_STOP:
+            case Event::Type::ENGINE_RESUME:
+            case Event::Type::ENGINE_PAUSE:
+            case Event::Type::ORIENTATION_CHANGE:
+            case Event::Type::LOW_MEMORY:
+            case Event::Type::OPEN_FILE:
+                postEvent(event.type, event.systemEvent);
+                break;
+            case Event::Type::ACTOR_ENTER:
+            case Event::Type::ACTOR_LEAVE:
+            case Event::Type::ACTOR_PRESS:
+            case Event::Type::ACTOR_RELEASE:
+            case Event::Type::ACTOR_CLICK:
+            case Event::Type::ACTOR_DRAG:
+            case Event::Type::WIDGET_CHANGE:
+                postEvent(event.type, event.uiEvent);
+                break;
+            case Event::Type::ANIMATION_START:
+            case Event::Type::ANIMATION_RESET:
+            case Event::Type::ANIMATION_FINISH:
+                postEvent(event.type, event.animationEvent);
+                break;
+            case Event::Type::SOUND_START:
+            case Event::Type::SOUND_RESET:
+            case Event::Type::SOUND_FINISH:
+                postEvent(event.type, event.soundEvent);
+                break;
+            case Event::Type::USER:
+                postEvent(event.type, event.userEvent);
+                break;
         }
+    }
 
-        eventHandlerDeleteSet.insert(eventHandler);
+    void EventDispatcher::postEvent(Event::Type type, const KeyboardEvent& keyboardEvent)
+    {
+        post(Category::KEYBOARD, type, keyboardEvent, &EventHandler::keyboardHandler);
+    }
 
-        auto setIterator = eventHandlerAddSet.find(eventHandler);
+    void EventDispatcher::postEvent(Event::Type type, const MouseEvent& mouseEvent)
+    {
+        post(Category::MOUSE, type, mouseEvent, &EventHandler::mouseHandler);
+    }
 
-        if (setIterator != eventHandlerAddSet.end())
-        {
-            eventHandlerAddSet.erase(setIterator);
-        }
+    void EventDispatcher::postEvent(Event::Type type, const TouchEvent& touchEvent)
+    {
+        post(Category::TOUCH, type, touchEvent, &EventHandler::touchHandler);
     }
 
-    void EventDispatcher::postEvent(const Event& event)
+    void EventDispatcher::postEvent(Event::Type type, const GamepadEvent& gamepadEvent)
+    {
+        post(Category::GAMEPAD, type, gamepadEvent, &EventHandler::gamepadHandler);
+    }
+
+    void EventDispatcher::postEvent(Event::Type type, const WindowEvent& windowEvent)
+    {
+        post(Category::WINDOW, type, windowEvent, &EventHandler::windowHandler);
+    }
+
+    void EventDispatcher::postEvent(Event::Type type, const SystemEvent& systemEvent)
+    {
+        post(Category::SYSTEM, type, systemEvent, &EventHandler::systemHandler);
+    }
+
+    void EventDispatcher::postEvent(Event::Type type, const UIEvent& uiEvent)
+    {
+        post(Category::UI, type, uiEvent, &EventHandler::uiHandler);
+    }
+
+    void EventDispatcher::postEvent(Event::Type type, const AnimationEvent& animationEvent)
+    {
+        post(Category::ANIMATION, type, animationEvent, &EventHandler::animationHandler);
+    }
+
+    void EventDispatcher::postEvent(Event::Type type, const SoundEvent& soundEvent)
+    {
+        post(Category::SOUND, type, soundEvent, &EventHandler::soundHandler);
+    }
+
+    void EventDispatcher::postEvent(Event::Type type, const UserEvent& userEvent)
+    {
+        post(Category::USER, type, userEvent, &EventHandler::userHandler);
+    }
+
+    template<class T> void EventDispatcher::post(Category category, Event::Type type, const T& data,
+                                                 std::function<bool(Event::Type, const T&)> EventHandler::*handler)
+    {
+        // the data is stored in the queue together with the function, so posting plain events doesn't allocate memory
+        eventQueue.push([this, category, type, data, handler]() {
+            const std::vector<uint32_t>& handlers = categoryHandlers[static_cast<uint32_t>(category)];
+
+            // handlers added during the dispatch are pending, so the lists don't change while iterating
+            for (size_t i = 0; i < handlers.size(); ++i)
+            {
+                const EventHandler* eventHandler = eventHandlers[handlers[i]];
+
+                if (eventHandler && eventHandler->*handler)
+                {
+                    // the handler returns false to stop the event from reaching the handlers with lower priority
+                    if (!(eventHandler->*handler)(type, data)) break;
+                }
+            }
+        });
+
+        if (engine) engine->getFramePacer()->wake();
+    }
+
+    void EventDispatcher::updateCategoryHandlers()
     {
-        Lock lock(eventQueueMutex);
+        for (std::vector<uint32_t>& handlers : categoryHandlers)
+            handlers.clear();
 
-        eventQueue.push(event);
+        for (uint32_t index = 0; index < eventHandlers.size(); ++index)
+        {
+            EventHandler* eventHandler = eventHandlers[index];
+            eventHandler->index = index;
+
+            if (eventHandler->keyboardHandler) categoryHandlers[static_cast<uint32_t>(Category::KEYBOARD)].push_back(index);
+            if (eventHandler->mouseHandler) categoryHandlers[static_cast<uint32_t>(Category::MOUSE)].push_back(index);
+            if (eventHandler->touchHandler) categoryHandlers[static_cast<uint32_t>(Category::TOUCH)].push_back(index);
+            if (eventHandler->gamepadHandler) categoryHandlers[static_cast<uint32_t>(Category::GAMEPAD)].push_back(index);
+            if (eventHandler->windowHandler) categoryHandlers[static_cast<uint32_t>(Category::WINDOW)].push_back(index);
+            if (eventHandler->systemHandler) categoryHandlers[static_cast<uint32_t>(Category::SYSTEM)].push_back(index);
+            if (eventHandler->uiHandler) categoryHandlers[static_cast<uint32_t>(Category::UI)].push_back(index);
+            if (eventHandler->animationHandler) categoryHandlers[static_cast<uint32_t>(Category::ANIMATION)].push_back(index);
+            if (eventHandler->soundHandler) categoryHandlers[static_cast<uint32_t>(Category::SOUND)].push_back(index);
+            if (eventHandler->userHandler) categoryHandlers[static_cast<uint32_t>(Category::USER)].push_back(index);
+        }
     }
 }
@@ -4,11 +4,10 @@
 #pragma once
 
 #include <vector>
-#include <queue>
-#include <set>
 #include <cstdint>
 #include "events/Event.hpp"
 #include "events/EventHandler.hpp"
+#include "thread/ExecuteQueue.hpp"
 
 namespace ouzel
 {
@@ -29,16 +28,50 @@ namespace ouzel
         void addEventHandler(EventHandler* eventHandler);
         void removeEventHandler(EventHandler* eventHandler);
 
+        // can be called from any thread, only the data of the event type's category is queued
         void postEvent(const Event& event);
 
+        void postEvent(Event::Type type, const KeyboardEvent& keyboardEvent);
+        void postEvent(Event::Type type, const MouseEvent& mouseEvent);
+        void postEvent(Event::Type type, const TouchEvent& touchEvent);
+        void postEvent(Event::Type type, const GamepadEvent& gamepadEvent);
+        void postEvent(Event::Type type, const WindowEvent& windowEvent);
+        void postEvent(Event::Type type, const SystemEvent& systemEvent);
+        void postEvent(Event::Type type, const UIEvent& uiEvent);
+        void postEvent(Event::Type type, const AnimationEvent& animationEvent);
+        void postEvent(Event::Type type, const SoundEvent& soundEvent);
+        void postEvent(Event::Type type, const UserEvent& userEvent);
+
     protected:
+        enum class Category
+        {
+            KEYBOARD,
+            MOUSE,
+            TOUCH,
+            GAMEPAD,
+            WINDOW,
+            SYSTEM,
+            UI,
+            ANIMATION,
+            SOUND,
+            USER,
+            COUNT
+        };
+
         EventDispatcher();
 
+        template<class T> void post(Category category, Event::Type type, const T& data,
+                                    std::function<bool(Event::Type, const T&)> EventHandler::*handler);
+        void updateCategoryHandlers();
+
+        // sorted by priority, removed handlers are set to null and compacted on the next dispatch
         std::vector<EventHandler*> eventHandlers;
-        std::set<EventHandler*> eventHandlerAddSet;
-        std::set<EventHandler*> eventHandlerDeleteSet;
+        std::vector<EventHandler*> pendingEventHandlers;
+        bool eventHandlersDirty = false;
+
+        // indices in eventHandlers of the handlers that have the function for the category set
+        std::vector<uint32_t> categoryHandlers[static_cast<uint32_t>(Category::COUNT)];
 
-        Mutex eventQueueMutex;
-        std::queue<Event> eventQueue;
+        ExecuteQueue eventQueue;
     };
 }
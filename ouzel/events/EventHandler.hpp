@@ -36,5 +36,9 @@ namespace ouzel
     protected:
         int32_t priority;
         EventDispatcher* eventDispatcher = nullptr;
+
+        // position in the dispatcher, valid while eventDispatcher is set
+        uint32_t index = 0;
+        bool pending = false;
     };
 }
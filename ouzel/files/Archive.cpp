@@ -4,6 +4,7 @@
 #include "Archive.hpp"
 #include "FileSystem.hpp"
 #include "core/Engine.hpp"
+#include "thread/Lock.hpp"
 #include "utils/Log.hpp"
 #include "utils/Utils.hpp"
 
@@ -21,7 +22,9 @@ namespace ouzel
 
     bool Archive::open(const std::string& filename)
     {
-        if (!file.open(engine->getFileSystem()->getPath(filename, false), File::READ))
+        path = engine->getFileSystem()->getPath(filename, false);
+
+        if (!file.open(path, File::READ))
         {
             Log(Log::Level::ERR) << "Failed to open file " << filename;
             return false;
@@ -157,6 +160,8 @@ namespace ouzel
 
         if (i == entries.end()) return false;
 
+        Lock lock(fileMutex);
+
         if (!file.seek(static_cast<int32_t>(i->second.offset), File::BEGIN))
         {
             Log(Log::Level::ERR) << "Failed to seek file";
@@ -174,6 +179,31 @@ namespace ouzel
         return true;
     }
 
+    bool Archive::mapFile(const std::string& filename, MappedFile& result) const
+    {
+        auto i = entries.find(filename);
+
+        if (i == entries.end()) return false;
+
+        Lock lock(fileMutex);
+
+        if (!mappedFile.isOpen() && !mappedFile.open(path))
+        {
+            Log(Log::Level::ERR) << "Failed to map archive " << path;
+            return false;
+        }
+
+        result = mappedFile.getView(i->second.offset, i->second.size);
+
+        if (!result.isOpen())
+        {
+            Log(Log::Level::ERR) << "Invalid archive entry " << filename;
+            return false;
+        }
+
+        return true;
+    }
+
     bool Archive::fileExists(const std::string& filename) const
     {
         return entries.find(filename) != entries.end();
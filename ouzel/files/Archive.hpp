@@ -8,6 +8,8 @@
 #include <string>
 #include <vector>
 #include "files/File.hpp"
+#include "files/MappedFile.hpp"
+#include "thread/Mutex.hpp"
 
 namespace ouzel
 {
@@ -30,12 +32,17 @@ namespace ouzel
         bool open(const std::string& filename);
 
         bool readFile(const std::string& filename, std::vector<uint8_t>& data) const;
+        bool mapFile(const std::string& filename, MappedFile& result) const;
 
         bool fileExists(const std::string& filename) const;
 
     private:
         FileSystem* fileSystem = nullptr;
+        uint32_t readers = 0; // number of reads in progress, guarded by the file system's resourceMutex
+        std::string path;
         File file;
+        mutable Mutex fileMutex; // the file can be read from multiple I/O threads
+        mutable MappedFile mappedFile; // mapped on the first mapFile call
 
         struct Entry
         {
@@ -4,8 +4,12 @@
 #include "core/Setup.h"
 
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <sys/stat.h>
+#if !OUZEL_PLATFORM_WINDOWS
+#include <dirent.h>
+#endif
 #if OUZEL_PLATFORM_WINDOWS
 #include <Windows.h>
 #include <Shlobj.h>
@@ -24,6 +28,8 @@ extern "C" id NSTemporaryDirectory();
 
 #include "FileSystem.hpp"
 #include "Archive.hpp"
+#include "MappedFile.hpp"
+#include "thread/Lock.hpp"
 #include "utils/Log.hpp"
 
 #if OUZEL_PLATFORM_WINDOWS || OUZEL_PLATFORM_LINUX || OUZEL_PLATFORM_RASPBIAN
@@ -39,7 +45,8 @@ namespace ouzel
     const std::string FileSystem::DIRECTORY_SEPARATOR = "/";
 #endif
 
-    FileSystem::FileSystem()
+    FileSystem::FileSystem():
+        running(false)
     {
 #if OUZEL_PLATFORM_WINDOWS
         char* exePath = _pgmptr;
@@ -84,6 +91,20 @@ namespace ouzel
 #endif
     }
 
+    FileSystem::~FileSystem()
+    {
+        {
+            Lock lock(requestMutex);
+            running = false;
+            requestCondition.broadcast();
+        }
+
+        for (Thread& ioThread : ioThreads)
+        {
+            if (ioThread.isJoinable()) ioThread.join();
+        }
+    }
+
     std::string FileSystem::getStorageDirectory(bool user) const
     {
 #if OUZEL_PLATFORM_WINDOWS
@@ -255,12 +276,14 @@ namespace ouzel
 
         if (searchResources)
         {
-            for (const auto& archive : archives)
+            std::string name;
+
+            // the lookup is locked, but the read is not, so that other threads are not blocked by it
+            if (Archive* archive = acquireArchive(normalizePath(filename), name))
             {
-                if (archive->readFile(filename, data))
-                {
-                    return true;
-                }
+                bool result = archive->readFile(name, data);
+                releaseArchive(archive);
+                return result;
             }
         }
 
@@ -305,41 +328,259 @@ namespace ouzel
         return true;
     }
 
-    bool FileSystem::resourceFileExists(const std::string& filename) const
+    bool FileSystem::mapFile(const std::string& filename, MappedFile& result, bool searchResources) const
     {
-        if (isAbsolutePath(filename))
+#if OUZEL_PLATFORM_ANDROID
+        if (!isAbsolutePath(filename))
         {
-            return fileExists(filename);
+            EngineAndroid* engineAndroid = static_cast<EngineAndroid*>(engine);
+
+            AAsset* asset = AAssetManager_open(engineAndroid->getAssetManager(), filename.c_str(), AASSET_MODE_BUFFER);
+
+            if (!asset)
+            {
+                Log(Log::Level::ERR) << "Failed to open file " << filename;
+                return false;
+            }
+
+            return result.open(asset);
         }
-        else
+#endif
+
+        if (searchResources)
         {
-            std::string str = appPath + DIRECTORY_SEPARATOR + filename;
+            std::string name;
 
-            if (fileExists(str))
+            if (Archive* archive = acquireArchive(normalizePath(filename), name))
             {
+                bool success = archive->mapFile(name, result);
+                releaseArchive(archive);
+                return success;
+            }
+        }
+
+        std::string path = getPath(filename, searchResources);
+
+        // file does not exist
+        if (path.empty())
+        {
+            Log(Log::Level::ERR) << "Failed to find file " << filename;
+            return false;
+        }
+
+        return result.open(path);
+    }
+
+    uint32_t FileSystem::readFileAsync(const std::string& filename,
+                                       const std::function<void(bool, std::vector<uint8_t>&)>& callback,
+                                       Priority priority,
+                                       bool searchResources)
+    {
+        std::shared_ptr<Request> request = std::make_shared<Request>();
+        request->type = Request::Type::READ;
+        request->filename = filename;
+        request->searchResources = searchResources;
+        request->readCallback = callback;
+
+        return addRequest(request, priority);
+    }
+
+    uint32_t FileSystem::writeFileAsync(const std::string& filename,
+                                        const std::vector<uint8_t>& data,
+                                        const std::function<void(bool)>& callback,
+                                        Priority priority)
+    {
+        std::shared_ptr<Request> request = std::make_shared<Request>();
+        request->type = Request::Type::WRITE;
+        request->filename = filename;
+        request->data = data;
+        request->writeCallback = callback;
+
+        return addRequest(request, priority);
+    }
+
+    bool FileSystem::cancelRequest(uint32_t requestId)
+    {
+        Lock lock(requestMutex);
+
+        auto hasId = [requestId](const std::shared_ptr<Request>& request) {
+            return request->id == requestId;
+        };
+
+        for (auto& requestQueue : requestQueues)
+        {
+            auto i = std::find_if(requestQueue.begin(), requestQueue.end(), hasId);
+
+            if (i != requestQueue.end())
+            {
+                requestQueue.erase(i);
                 return true;
             }
-            else
+        }
+
+        // the I/O thread drops the result of a request that is no longer active,
+        // a write is not interrupted, so that the file is never left half written
+        auto activeIterator = std::find_if(activeRequests.begin(), activeRequests.end(), hasId);
+
+        if (activeIterator != activeRequests.end())
+        {
+            activeRequests.erase(activeIterator);
+            return true;
+        }
+
+        auto finishedIterator = std::find_if(finishedRequests.begin(), finishedRequests.end(), hasId);
+
+        if (finishedIterator != finishedRequests.end())
+        {
+            finishedRequests.erase(finishedIterator);
+            return true;
+        }
+
+        return false;
+    }
+
+    uint32_t FileSystem::addRequest(const std::shared_ptr<Request>& request, Priority priority)
+    {
+        Lock lock(requestMutex);
+
+        if (++lastRequestId == 0) ++lastRequestId; // 0 is reserved for invalid requests
+        request->id = lastRequestId;
+
+        requestQueues[static_cast<uint32_t>(priority)].push_back(request);
+
+#if OUZEL_MULTITHREADED
+        if (ioThreads.empty())
+        {
+            running = true;
+            ioThreads.reserve(IO_THREAD_COUNT);
+
+            for (uint32_t i = 0; i < IO_THREAD_COUNT; ++i)
             {
-                for (const std::string& path : resourcePaths)
+                ioThreads.push_back(Thread(std::bind(&FileSystem::ioMain, this), "File I/O"));
+            }
+        }
+
+        requestCondition.signal();
+#endif
+
+        return request->id;
+    }
+
+    std::shared_ptr<FileSystem::Request> FileSystem::getNextRequest()
+    {
+        // the oldest request with the highest priority
+        for (uint32_t priority = 3; priority > 0; --priority)
+        {
+            std::deque<std::shared_ptr<Request>>& requestQueue = requestQueues[priority - 1];
+
+            if (!requestQueue.empty())
+            {
+                std::shared_ptr<Request> request = requestQueue.front();
+                requestQueue.pop_front();
+                return request;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void FileSystem::ioMain()
+    {
+        for (;;)
+        {
+            std::shared_ptr<Request> request;
+
+            {
+                Lock lock(requestMutex);
+
+                for (;;)
                 {
-                    if (isAbsolutePath(path)) // if resource path is absolute
-                    {
-                        str = path + DIRECTORY_SEPARATOR + filename;
-                    }
-                    else
-                    {
-                        str = appPath + DIRECTORY_SEPARATOR + path + DIRECTORY_SEPARATOR + filename;
-                    }
+                    if (!running) return;
 
-                    if (fileExists(str))
-                    {
-                        return true;
-                    }
+                    request = getNextRequest();
+                    if (request) break;
+
+                    requestCondition.wait(requestMutex);
                 }
+
+                activeRequests.push_back(request);
             }
 
-            return false;
+            if (request->type == Request::Type::READ)
+                request->success = readFile(request->filename, request->data, request->searchResources);
+            else
+                request->success = writeFile(request->filename, request->data);
+
+            Lock lock(requestMutex);
+
+            auto i = std::find(activeRequests.begin(), activeRequests.end(), request);
+
+            // the request was not canceled while it was processed
+            if (i != activeRequests.end())
+            {
+                activeRequests.erase(i);
+                finishedRequests.push_back(request);
+            }
+        }
+    }
+
+    void FileSystem::update()
+    {
+#if !OUZEL_MULTITHREADED
+        for (;;)
+        {
+            std::shared_ptr<Request> request;
+
+            {
+                Lock lock(requestMutex);
+                request = getNextRequest();
+            }
+
+            if (!request) break;
+
+            if (request->type == Request::Type::READ)
+                request->success = readFile(request->filename, request->data, request->searchResources);
+            else
+                request->success = writeFile(request->filename, request->data);
+
+            Lock lock(requestMutex);
+            finishedRequests.push_back(request);
+        }
+#endif
+
+        for (;;)
+        {
+            std::shared_ptr<Request> request;
+
+            // take one request at a time, so that callbacks can cancel other finished requests
+            {
+                Lock lock(requestMutex);
+                if (finishedRequests.empty()) break;
+
+                request = finishedRequests.front();
+                finishedRequests.pop_front();
+            }
+
+            if (request->type == Request::Type::READ)
+            {
+                if (request->readCallback) request->readCallback(request->success, request->data);
+            }
+            else
+            {
+                if (request->writeCallback) request->writeCallback(request->success);
+            }
+        }
+    }
+
+    bool FileSystem::resourceFileExists(const std::string& filename) const
+    {
+        if (isAbsolutePath(filename))
+        {
+            return fileExists(filename);
+        }
+        else
+        {
+            return !getPath(filename).empty();
         }
     }
 
@@ -398,6 +639,15 @@ namespace ouzel
         }
         else
         {
+            if (searchResources)
+            {
+                Lock lock(resourceMutex);
+
+                std::string path = findResource(filename);
+                if (!path.empty()) return path;
+            }
+
+            // files that were created after their directory was listed
             std::string str = appPath + DIRECTORY_SEPARATOR + filename;
 
             if (fileExists(str))
@@ -407,6 +657,8 @@ namespace ouzel
 
             if (searchResources)
             {
+                Lock lock(resourceMutex);
+
                 for (const std::string& path : resourcePaths)
                 {
                     if (isAbsolutePath(path)) // if resource path is absolute
@@ -431,6 +683,8 @@ namespace ouzel
 
     void FileSystem::addResourcePath(const std::string& path)
     {
+        Lock lock(resourceMutex);
+
         auto i = std::find(resourcePaths.begin(), resourcePaths.end(), path);
 
         if (i == resourcePaths.end())
@@ -443,26 +697,214 @@ namespace ouzel
     {
         if (archive->fileSystem) archive->fileSystem->removeArchive(archive);
 
+        Lock lock(resourceMutex);
+
         auto i = std::find(archives.begin(), archives.end(), archive);
 
         if (i == archives.end())
         {
             archive->fileSystem = this;
             archives.push_back(archive);
+
+            Lock indexLock(indexMutex);
+            indexArchives();
         }
     }
 
     void FileSystem::removeArchive(Archive* archive)
     {
+        Lock lock(resourceMutex);
+
         auto i = std::find(archives.begin(), archives.end(), archive);
 
         if (i != archives.end())
         {
             archive->fileSystem = nullptr;
             archives.erase(i);
+
+            {
+                Lock indexLock(indexMutex);
+                indexArchives();
+            }
+
+            // the archive can't be found anymore, wait for the reads that have already started
+            while (archive->readers)
+                readerCondition.wait(resourceMutex);
+        }
+    }
+
+    void FileSystem::updateResourceIndex()
+    {
+        Lock lock(resourceMutex);
+        Lock indexLock(indexMutex);
+        directoryIndex.clear();
+        indexArchives();
+    }
+
+    std::string FileSystem::normalizePath(const std::string& path)
+    {
+        std::string result;
+        result.reserve(path.size());
+
+        // skip empty and "." segments, so that "./images//a.png" and "images/a.png" map to the same entry
+        for (std::string::size_type start = 0; start < path.size();)
+        {
+#if OUZEL_PLATFORM_WINDOWS
+            std::string::size_type end = path.find_first_of("/\\", start);
+#else
+            std::string::size_type end = path.find('/', start);
+#endif
+            if (end == std::string::npos) end = path.size();
+
+            if (end != start && !(end - start == 1 && path[start] == '.'))
+            {
+                if (!result.empty()) result.push_back('/');
+                result.append(path, start, end - start);
+            }
+
+            start = end + 1;
+        }
+
+        return result;
+    }
+
+    const std::unordered_set<std::string>& FileSystem::getDirectoryFiles(const std::string& directory) const
+    {
+        auto i = directoryIndex.find(directory);
+        if (i != directoryIndex.end()) return i->second;
+
+        // directories are listed one at a time, so that a lookup never walks the whole tree
+        std::unordered_set<std::string>& files = directoryIndex[directory];
+
+#if OUZEL_PLATFORM_WINDOWS
+        WCHAR buffer[MAX_PATH];
+        if (MultiByteToWideChar(CP_UTF8, 0, (directory + DIRECTORY_SEPARATOR + "*").c_str(), -1, buffer, MAX_PATH) == 0)
+        {
+            Log(Log::Level::ERR) << "Failed to convert UTF-8 to wide char";
+            return files;
+        }
+
+        WIN32_FIND_DATAW findData;
+        HANDLE findHandle = FindFirstFileW(buffer, &findData);
+
+        if (findHandle == INVALID_HANDLE_VALUE) return files;
+
+        do
+        {
+            if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) continue;
+
+            char name[MAX_PATH];
+            if (WideCharToMultiByte(CP_UTF8, 0, findData.cFileName, -1, name, sizeof(name), nullptr, nullptr) == 0)
+            {
+                Log(Log::Level::ERR) << "Failed to convert wide char to UTF-8";
+                continue;
+            }
+
+            files.insert(name);
+        }
+        while (FindNextFileW(findHandle, &findData));
+
+        FindClose(findHandle);
+#else
+        DIR* dir = opendir(directory.c_str());
+
+        if (!dir) return files;
+
+        while (dirent* entry = readdir(dir))
+        {
+            // symbolic links to files are listed too
+            struct stat buf;
+            if (stat((directory + DIRECTORY_SEPARATOR + entry->d_name).c_str(), &buf) != 0) continue;
+
+            if (S_ISREG(buf.st_mode)) files.insert(entry->d_name);
+        }
+
+        closedir(dir);
+#endif
+
+        return files;
+    }
+
+    std::string FileSystem::findResource(const std::string& filename) const
+    {
+        std::string name = normalizePath(filename);
+        std::string::size_type separator = name.find_last_of('/');
+        std::string directory = (separator == std::string::npos) ? std::string() : name.substr(0, separator);
+        std::string file = (separator == std::string::npos) ? name : name.substr(separator + 1);
+
+        if (file.empty()) return std::string();
+
+        // the first file found wins, so the directories are searched in the same order as the fallback in getPath
+        std::vector<std::string> roots;
+        if (!appPath.empty()) roots.push_back(appPath);
+
+        for (const std::string& path : resourcePaths)
+        {
+            if (isAbsolutePath(path)) // if resource path is absolute
+                roots.push_back(path);
+            else if (!appPath.empty())
+                roots.push_back(appPath + DIRECTORY_SEPARATOR + path);
+        }
+
+        Lock lock(indexMutex);
+
+        for (const std::string& root : roots)
+        {
+            std::string path = directory.empty() ? root : root + DIRECTORY_SEPARATOR + directory;
+
+            const std::unordered_set<std::string>& files = getDirectoryFiles(path);
+            if (files.find(file) != files.end()) return path + DIRECTORY_SEPARATOR + file;
+        }
+
+        return std::string();
+    }
+
+    void FileSystem::indexArchives()
+    {
+        archiveIndex.clear();
+
+        for (Archive* archive : archives)
+        {
+            for (const auto& entry : archive->entries)
+            {
+                // the archive looks entries up by the name they are stored under
+                ArchiveEntry archiveEntry;
+                archiveEntry.archive = archive;
+                archiveEntry.name = entry.first;
+                archiveIndex.insert(std::make_pair(normalizePath(entry.first), archiveEntry));
+            }
         }
     }
 
+    Archive* FileSystem::acquireArchive(const std::string& filename, std::string& entryName) const
+    {
+        Lock lock(resourceMutex);
+
+        Archive* archive = findArchive(filename, entryName);
+        if (archive) ++archive->readers;
+
+        return archive;
+    }
+
+    void FileSystem::releaseArchive(Archive* archive) const
+    {
+        Lock lock(resourceMutex);
+
+        if (--archive->readers == 0)
+            readerCondition.broadcast();
+    }
+
+    Archive* FileSystem::findArchive(const std::string& filename, std::string& entryName) const
+    {
+        Lock lock(indexMutex);
+
+        auto i = archiveIndex.find(filename);
+        if (i == archiveIndex.end()) return nullptr;
+
+        entryName = i->second.name;
+        return i->second.archive;
+    }
+
     std::string FileSystem::getExtensionPart(const std::string& path)
     {
         size_t pos = path.find_last_of('.');
@@ -3,20 +3,37 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
-#include <cstdint>
+#include "thread/Condition.hpp"
+#include "thread/Mutex.hpp"
+#include "thread/Thread.hpp"
 
 namespace ouzel
 {
     class Engine;
     class Archive;
+    class MappedFile;
 
     class FileSystem final
     {
         friend Engine;
     public:
-        ~FileSystem() = default;
+        enum class Priority
+        {
+            LOW,
+            NORMAL,
+            HIGH
+        };
+
+        ~FileSystem();
 
         FileSystem(const FileSystem&) = delete;
         FileSystem& operator=(const FileSystem&) = delete;
@@ -31,6 +48,21 @@ namespace ouzel
 
         bool readFile(const std::string& filename, std::vector<uint8_t>& data, bool searchResources = true) const;
         bool writeFile(const std::string& filename, const std::vector<uint8_t>& data) const;
+        // maps the file (or the archive entry) into memory instead of copying its contents
+        bool mapFile(const std::string& filename, MappedFile& result, bool searchResources = true) const;
+
+        // asynchronous requests are processed on I/O threads and their callbacks are called on the update thread,
+        // the returned request ID can be passed to cancelRequest (0 means that the request failed)
+        uint32_t readFileAsync(const std::string& filename,
+                               const std::function<void(bool success, std::vector<uint8_t>& data)>& callback,
+                               Priority priority = Priority::NORMAL,
+                               bool searchResources = true);
+        uint32_t writeFileAsync(const std::string& filename,
+                                const std::vector<uint8_t>& data,
+                                const std::function<void(bool success)>& callback,
+                                Priority priority = Priority::NORMAL);
+        // the callback of a canceled request is not called, but a write that has already started always completes
+        bool cancelRequest(uint32_t requestId);
 
         bool resourceFileExists(const std::string& filename) const;
         std::string getPath(const std::string& filename, bool searchResources = true) const;
@@ -38,6 +70,10 @@ namespace ouzel
         void addArchive(Archive* archive);
         void removeArchive(Archive* archive);
 
+        // every resource directory is listed on the first lookup in it and archives are indexed when they are added,
+        // the listings have to be dropped if files are added to the resource directories afterwards
+        void updateResourceIndex();
+
         static std::string getExtensionPart(const std::string& path);
         static std::string getFilenamePart(const std::string& path);
         static std::string getDirectoryPart(const std::string& path);
@@ -49,8 +85,70 @@ namespace ouzel
     protected:
         FileSystem();
 
+        struct Request
+        {
+            enum class Type
+            {
+                READ,
+                WRITE
+            };
+
+            uint32_t id = 0;
+            Type type = Type::READ;
+            std::string filename;
+            bool searchResources = true;
+            std::vector<uint8_t> data;
+            bool success = false;
+
+            std::function<void(bool, std::vector<uint8_t>&)> readCallback;
+            std::function<void(bool)> writeCallback;
+        };
+
+        uint32_t addRequest(const std::shared_ptr<Request>& request, Priority priority);
+        std::shared_ptr<Request> getNextRequest(); // must be called with requestMutex locked
+        void ioMain();
+
+        // executes the callbacks of finished requests, called on the update thread
+        void update();
+
+        static std::string normalizePath(const std::string& path);
+        // must be called with indexMutex locked
+        const std::unordered_set<std::string>& getDirectoryFiles(const std::string& directory) const;
+        std::string findResource(const std::string& filename) const; // must be called with resourceMutex locked
+        void indexArchives(); // must be called with resourceMutex and indexMutex locked
+        // returns the archive and the name of the entry in it, must be called with resourceMutex locked
+        Archive* findArchive(const std::string& filename, std::string& entryName) const;
+        // finds the archive and keeps it from being removed until releaseArchive is called
+        Archive* acquireArchive(const std::string& filename, std::string& entryName) const;
+        void releaseArchive(Archive* archive) const;
+
         std::string appPath;
+
+        // resource paths and archives are read by the I/O threads, must be locked before indexMutex
+        mutable Mutex resourceMutex;
         std::vector<std::string> resourcePaths;
         std::vector<Archive*> archives;
+        mutable Condition readerCondition; // signaled when the last read of an archive finishes
+
+        struct ArchiveEntry
+        {
+            Archive* archive;
+            std::string name; // as it is stored in the archive
+        };
+
+        mutable Mutex indexMutex;
+        mutable std::unordered_map<std::string, std::unordered_set<std::string>> directoryIndex; // directory -> names of its files
+        std::unordered_map<std::string, ArchiveEntry> archiveIndex; // normalized entry name -> archive entry
+
+        static const uint32_t IO_THREAD_COUNT = 2;
+
+        std::deque<std::shared_ptr<Request>> requestQueues[3]; // one queue per priority
+        std::vector<std::shared_ptr<Request>> activeRequests;
+        std::deque<std::shared_ptr<Request>> finishedRequests;
+        uint32_t lastRequestId = 0;
+        Mutex requestMutex;
+        Condition requestCondition;
+        std::atomic<bool> running;
+        std::vector<Thread> ioThreads;
     };
 }
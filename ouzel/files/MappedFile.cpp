@@ -0,0 +1,183 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include "core/Setup.h"
+
+#if OUZEL_PLATFORM_WINDOWS
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "MappedFile.hpp"
+#include "utils/Log.hpp"
+
+namespace ouzel
+{
+    MappedFile::Mapping::~Mapping()
+    {
+#if OUZEL_PLATFORM_WINDOWS
+        if (address) UnmapViewOfFile(address);
+        if (fileMapping) CloseHandle(fileMapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+#if OUZEL_PLATFORM_ANDROID
+        if (asset)
+        {
+            AAsset_close(asset);
+            return;
+        }
+#endif
+        if (address) munmap(address, length);
+#endif
+    }
+
+    MappedFile::MappedFile(const std::string& filename)
+    {
+        open(filename);
+    }
+
+    bool MappedFile::open(const std::string& filename)
+    {
+        close();
+
+        std::shared_ptr<Mapping> newMapping = std::make_shared<Mapping>();
+
+#if OUZEL_PLATFORM_WINDOWS
+        WCHAR buffer[MAX_PATH];
+        if (MultiByteToWideChar(CP_UTF8, 0, filename.c_str(), -1, buffer, MAX_PATH) == 0)
+        {
+            Log(Log::Level::ERR) << "Failed to convert UTF-8 to wide char";
+            return false;
+        }
+
+        newMapping->file = CreateFile(buffer, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (newMapping->file == INVALID_HANDLE_VALUE)
+        {
+            Log(Log::Level::ERR) << "Failed to open file " << filename;
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(newMapping->file, &fileSize) || fileSize.HighPart != 0)
+        {
+            Log(Log::Level::ERR) << "Failed to get size of file " << filename;
+            return false;
+        }
+
+        newMapping->length = static_cast<size_t>(fileSize.LowPart);
+
+        // zero-length files can not be mapped
+        if (newMapping->length > 0)
+        {
+            newMapping->fileMapping = CreateFileMapping(newMapping->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+            if (!newMapping->fileMapping)
+            {
+                Log(Log::Level::ERR) << "Failed to create file mapping for " << filename;
+                return false;
+            }
+
+            newMapping->address = MapViewOfFile(newMapping->fileMapping, FILE_MAP_READ, 0, 0, 0);
+
+            if (!newMapping->address)
+            {
+                Log(Log::Level::ERR) << "Failed to map view of file " << filename;
+                return false;
+            }
+        }
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+
+        if (fd == -1)
+        {
+            Log(Log::Level::ERR) << "Failed to open file " << filename;
+            return false;
+        }
+
+        struct stat buf;
+        if (fstat(fd, &buf) == -1 || static_cast<uint64_t>(buf.st_size) > UINT32_MAX)
+        {
+            ::close(fd);
+            Log(Log::Level::ERR) << "Failed to get size of file " << filename;
+            return false;
+        }
+
+        newMapping->length = static_cast<size_t>(buf.st_size);
+
+        // zero-length files can not be mapped
+        if (newMapping->length > 0)
+        {
+            void* address = mmap(nullptr, newMapping->length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (address == MAP_FAILED)
+            {
+                ::close(fd);
+                Log(Log::Level::ERR) << "Failed to map file " << filename;
+                return false;
+            }
+
+            newMapping->address = address;
+        }
+
+        // the mapping stays valid after the descriptor is closed
+        ::close(fd);
+#endif
+
+        mapping = newMapping;
+        data = static_cast<const uint8_t*>(mapping->address);
+        size = static_cast<uint32_t>(mapping->length);
+
+        return true;
+    }
+
+#if OUZEL_PLATFORM_ANDROID
+    bool MappedFile::open(AAsset* asset)
+    {
+        close();
+
+        if (!asset) return false;
+
+        std::shared_ptr<Mapping> newMapping = std::make_shared<Mapping>();
+        newMapping->asset = asset;
+
+        // uncompressed assets are mapped directly from the APK, compressed ones are inflated by the asset manager
+        const void* buffer = AAsset_getBuffer(asset);
+
+        if (!buffer)
+        {
+            Log(Log::Level::ERR) << "Failed to get asset buffer";
+            return false;
+        }
+
+        mapping = newMapping;
+        data = static_cast<const uint8_t*>(buffer);
+        size = static_cast<uint32_t>(AAsset_getLength(asset));
+
+        return true;
+    }
+#endif
+
+    void MappedFile::close()
+    {
+        mapping.reset();
+        data = nullptr;
+        size = 0;
+    }
+
+    MappedFile MappedFile::getView(uint32_t offset, uint32_t viewSize) const
+    {
+        MappedFile result;
+
+        if (mapping && offset <= size && viewSize <= size - offset)
+        {
+            result.mapping = mapping;
+            result.data = data + offset;
+            result.size = viewSize;
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,67 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#if OUZEL_PLATFORM_WINDOWS
+#include <windows.h>
+#endif
+
+#if OUZEL_PLATFORM_ANDROID
+#include <android/asset_manager_jni.h>
+#endif
+
+namespace ouzel
+{
+    // read-only view of a file that is mapped into memory, copies share the same mapping
+    class MappedFile
+    {
+    public:
+        MappedFile() {}
+        MappedFile(const std::string& filename);
+
+        bool open(const std::string& filename);
+#if OUZEL_PLATFORM_ANDROID
+        bool open(AAsset* asset); // takes the ownership of the asset
+#endif
+        void close();
+
+        inline bool isOpen() const { return mapping != nullptr; }
+
+        inline const uint8_t* getData() const { return data; }
+        inline uint32_t getSize() const { return size; }
+
+        // returns a view of a part of the file that keeps the whole mapping alive
+        MappedFile getView(uint32_t offset, uint32_t viewSize) const;
+
+    protected:
+        struct Mapping
+        {
+            Mapping() {}
+            ~Mapping();
+
+            Mapping(const Mapping&) = delete;
+            Mapping& operator=(const Mapping&) = delete;
+
+            Mapping(Mapping&&) = delete;
+            Mapping& operator=(Mapping&&) = delete;
+
+            void* address = nullptr;
+            size_t length = 0;
+#if OUZEL_PLATFORM_WINDOWS
+            HANDLE file = INVALID_HANDLE_VALUE;
+            HANDLE fileMapping = nullptr;
+#elif OUZEL_PLATFORM_ANDROID
+            AAsset* asset = nullptr;
+#endif
+        };
+
+        std::shared_ptr<Mapping> mapping;
+        const uint8_t* data = nullptr;
+        uint32_t size = 0;
+    };
+}
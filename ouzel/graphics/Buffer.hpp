@@ -24,7 +24,8 @@ namespace ouzel
             {
                 NONE,
                 INDEX,
-                VERTEX
+                VERTEX,
+                CONSTANT
             };
 
             Buffer();
@@ -5,6 +5,7 @@
 #include "utils/Log.hpp"
 #include "core/Engine.hpp"
 #include "files/FileSystem.hpp"
+#include "files/MappedFile.hpp"
 #define STBI_NO_PSD
 #define STBI_NO_HDR
 #define STBI_NO_PIC
@@ -22,17 +23,23 @@ namespace ouzel
         bool ImageDataSTB::init(const std::string& filename,
                                 PixelFormat newPixelFormat)
         {
-            std::vector<uint8_t> newData;
-            if (!engine->getFileSystem()->readFile(filename, newData))
+            MappedFile file;
+            if (!engine->getFileSystem()->mapFile(filename, file))
             {
                 return false;
             }
 
-            return init(newData, newPixelFormat);
+            return init(file.getData(), file.getSize(), newPixelFormat);
         }
 
         bool ImageDataSTB::init(const std::vector<uint8_t>& newData,
                                 PixelFormat newPixelFormat)
+        {
+            return init(newData.data(), static_cast<uint32_t>(newData.size()), newPixelFormat);
+        }
+
+        bool ImageDataSTB::init(const uint8_t* newData, uint32_t newDataSize,
+                                PixelFormat newPixelFormat)
         {
             int width;
             int height;
@@ -47,7 +54,7 @@ namespace ouzel
                 default: reqComp = STBI_default;
             }
 
-            stbi_uc* tempData = stbi_load_from_memory(newData.data(), static_cast<int>(newData.size()), &width, &height, &comp, reqComp);
+            stbi_uc* tempData = stbi_load_from_memory(newData, static_cast<int>(newDataSize), &width, &height, &comp, reqComp);
 
             if (!tempData)
             {
@@ -17,6 +17,8 @@ namespace ouzel
                       PixelFormat newPixelFormat = PixelFormat::RGBA8_UNORM);
             bool init(const std::vector<uint8_t>& newData,
                       PixelFormat newPixelFormat = PixelFormat::RGBA8_UNORM);
+            bool init(const uint8_t* newData, uint32_t newDataSize,
+                      PixelFormat newPixelFormat = PixelFormat::RGBA8_UNORM);
             bool writeToFile(const std::string& filename);
         };
     } // namespace graphics
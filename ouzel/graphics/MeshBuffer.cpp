@@ -23,11 +23,13 @@ namespace ouzel
         }
 
         bool MeshBuffer::init(uint32_t newIndexSize, const std::shared_ptr<Buffer>& newIndexBuffer,
-                              const std::shared_ptr<Buffer>& newVertexBuffer)
+                              const std::shared_ptr<Buffer>& newVertexBuffer,
+                              const VertexLayout& newVertexLayout)
         {
             indexBuffer = newIndexBuffer;
             vertexBuffer = newVertexBuffer;
             indexSize = newIndexSize;
+            vertexLayout = newVertexLayout;
 
             BufferResource* indexBufferResource = newIndexBuffer ? newIndexBuffer->getResource() : nullptr;
             BufferResource* vertexBufferResource = newVertexBuffer ? newVertexBuffer->getResource() : nullptr;
@@ -36,7 +38,8 @@ namespace ouzel
                                                                          resource,
                                                                          newIndexSize,
                                                                          indexBufferResource,
-                                                                         vertexBufferResource));
+                                                                         vertexBufferResource,
+                                                                         newVertexLayout));
 
             return true;
         }
@@ -27,7 +27,8 @@ namespace ouzel
             MeshBuffer& operator=(MeshBuffer&&) = delete;
 
             bool init(uint32_t newIndexSize, const std::shared_ptr<Buffer>& newIndexBuffer,
-                      const std::shared_ptr<Buffer>& newVertexBuffer);
+                      const std::shared_ptr<Buffer>& newVertexBuffer,
+                      const VertexLayout& newVertexLayout = Vertex::LAYOUT);
 
             inline MeshBufferResource* getResource() const { return resource; }
 
@@ -40,12 +41,15 @@ namespace ouzel
             inline const std::shared_ptr<Buffer>& getVertexBuffer() const { return vertexBuffer; }
             bool setVertexBuffer(const std::shared_ptr<Buffer>& newVertexBuffer);
 
+            inline const VertexLayout& getVertexLayout() const { return vertexLayout; }
+
         private:
             MeshBufferResource* resource = nullptr;
 
             std::shared_ptr<Buffer> indexBuffer;
             std::shared_ptr<Buffer> vertexBuffer;
             uint32_t indexSize = 0;
+            VertexLayout vertexLayout;
         };
     } // namespace graphics
 } // namespace ouzel
@@ -18,11 +18,12 @@ namespace ouzel
         }
 
         bool MeshBufferResource::init(uint32_t newIndexSize, BufferResource* newIndexBuffer,
-                                      BufferResource* newVertexBuffer)
+                                      BufferResource* newVertexBuffer, const VertexLayout& newVertexLayout)
         {
             indexSize = newIndexSize;
             indexBuffer = newIndexBuffer;
             vertexBuffer = newVertexBuffer;
+            vertexLayout = newVertexLayout;
 
             return true;
         }
@@ -20,7 +20,7 @@ namespace ouzel
             virtual ~MeshBufferResource();
 
             virtual bool init(uint32_t newIndexSize, BufferResource* newIndexBuffer,
-                              BufferResource* newVertexBuffer);
+                              BufferResource* newVertexBuffer, const VertexLayout& newVertexLayout);
 
             inline uint32_t getIndexSize() const { return indexSize; }
             virtual bool setIndexSize(uint32_t newIndexSize);
@@ -31,12 +31,15 @@ namespace ouzel
             inline BufferResource* getVertexBuffer() const { return vertexBuffer; }
             virtual bool setVertexBuffer(BufferResource* newVertexBuffer);
 
+            inline const VertexLayout& getVertexLayout() const { return vertexLayout; }
+
         protected:
             MeshBufferResource();
 
             uint32_t indexSize = 0;
             BufferResource* indexBuffer = nullptr;
             BufferResource* vertexBuffer = nullptr;
+            VertexLayout vertexLayout;
         };
     } // namespace graphics
 } // namespace ouzel
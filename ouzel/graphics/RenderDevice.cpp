@@ -3,6 +3,9 @@
 
 #include <algorithm>
 #include "RenderDevice.hpp"
+#include "BufferResource.hpp"
+#include "SharedConstants.hpp"
+#include "core/Engine.hpp"
 #include "thread/Lock.hpp"
 #include "utils/Log.hpp"
 
@@ -50,6 +53,8 @@ namespace ouzel
 
         bool RenderDevice::process()
         {
+            OUZEL_PROFILE_ZONE("RenderDevice::process");
+
             std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
             auto diff = std::chrono::duration_cast<std::chrono::nanoseconds>(currentTime - previousFrameTime);
             previousFrameTime = currentTime;
@@ -86,6 +91,7 @@ namespace ouzel
 
             // refills the draw queue
             refillQueue = true;
+            if (engine) engine->getFramePacer()->wake();
 
             std::vector<std::unique_ptr<RenderResource>> deleteResources; // will be cleared at the end of the scope
             {
@@ -96,10 +102,40 @@ namespace ouzel
             executeAll();
 
             ++currentFrame;
+            totalTime += delta;
+
+            if (constantBuffersSupported)
+            {
+                if (!frameConstantBuffer)
+                {
+                    frameConstantBuffer = createBuffer();
+
+                    if (!frameConstantBuffer->init(Buffer::Usage::CONSTANT, Buffer::DYNAMIC, sizeof(FrameConstants)))
+                    {
+                        return false;
+                    }
+                }
+
+                FrameConstants frameConstants;
+                frameConstants.time = totalTime;
+                frameConstants.deltaTime = delta;
+                frameConstants.width = size.width;
+                frameConstants.height = size.height;
+
+                if (!frameConstantBuffer->setData(std::vector<uint8_t>(reinterpret_cast<const uint8_t*>(&frameConstants),
+                                                                       reinterpret_cast<const uint8_t*>(&frameConstants) + sizeof(frameConstants))))
+                {
+                    return false;
+                }
+            }
 
-            if (!draw(drawCommands))
             {
-                return false;
+                OUZEL_PROFILE_ZONE("RenderDevice::draw");
+
+                if (!draw(drawCommands))
+                {
+                    return false;
+                }
             }
 
             return true;
@@ -177,32 +213,9 @@ namespace ouzel
             return true;
         }
 
-        void RenderDevice::executeOnRenderThread(const std::function<void(void)>& func)
-        {
-            Lock lock(executeMutex);
-
-            executeQueue.push(func);
-        }
-
         void RenderDevice::executeAll()
         {
-            std::function<void(void)> func;
-
-            for (;;)
-            {
-                {
-                    Lock lock(executeMutex);
-                    if (executeQueue.empty()) break;
-
-                    func = std::move(executeQueue.front());
-                    executeQueue.pop();
-                }
-
-                if (func)
-                {
-                    func();
-                }
-            }
+            executeQueue.executeAll();
         }
     } // namespace graphics
 } // namespace ouzel
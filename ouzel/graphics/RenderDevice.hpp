@@ -12,6 +12,7 @@
 #include "graphics/Shader.hpp"
 #include "graphics/Texture.hpp"
 #include "thread/Condition.hpp"
+#include "thread/ExecuteQueue.hpp"
 #include "thread/Mutex.hpp"
 
 namespace ouzel
@@ -79,6 +80,9 @@ namespace ouzel
                 bool scissorTest;
                 Rect scissorRectangle;
                 Renderer::CullMode cullMode;
+                BufferResource* instanceBuffer; // InstanceData for every instance
+                uint32_t instanceCount; // 0 for non-instanced draw calls
+                BufferResource* cameraConstantBuffer; // CameraConstants, can be null
             };
 
             bool addDrawCommand(const DrawCommand& drawCommand);
@@ -105,6 +109,8 @@ namespace ouzel
             inline bool isMultisamplingSupported() const { return multisamplingSupported; }
             inline bool isAnisotropicFilteringSupported() const { return anisotropicFilteringSupported; }
             inline bool isRenderTargetsSupported() const { return renderTargetsSupported; }
+            inline bool isInstancingSupported() const { return instancingSupported; }
+            inline bool isConstantBuffersSupported() const { return constantBuffersSupported; }
 
             const Matrix4& getProjectionTransform(bool renderTarget) const
             {
@@ -114,7 +120,10 @@ namespace ouzel
             inline float getFPS() const { return currentFPS; }
             inline float getAccumulatedFPS() const { return accumulatedFPS; }
 
-            void executeOnRenderThread(const std::function<void(void)>& func);
+            template<class F> void executeOnRenderThread(F&& func)
+            {
+                executeQueue.push(std::forward<F>(func));
+            }
 
         protected:
             RenderDevice(Renderer::Driver aDriver);
@@ -162,6 +171,8 @@ namespace ouzel
             bool multisamplingSupported = true;
             bool anisotropicFilteringSupported = true;
             bool renderTargetsSupported = true;
+            bool instancingSupported = false;
+            bool constantBuffersSupported = false;
 
             Matrix4 projectionTransform;
             Matrix4 renderTargetProjectionTransform;
@@ -178,6 +189,9 @@ namespace ouzel
 
             uint32_t drawCallCount = 0;
 
+            BufferResource* frameConstantBuffer = nullptr; // FrameConstants, created on the first frame
+            float totalTime = 0.0f;
+
             std::vector<DrawCommand> drawQueue;
             Mutex drawQueueMutex;
             Condition queueCondition;
@@ -191,8 +205,7 @@ namespace ouzel
             float currentAccumulatedFPS = 0.0f;
             std::atomic<float> accumulatedFPS;
 
-            std::queue<std::function<void(void)>> executeQueue;
-            Mutex executeMutex;
+            ExecuteQueue executeQueue;
         };
     } // namespace graphics
 } // namespace ouzel
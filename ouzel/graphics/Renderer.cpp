@@ -1,6 +1,7 @@
 // Copyright (C) 2018 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <algorithm>
 #include "core/Setup.h"
 #include "Renderer.hpp"
 #include "RenderDevice.hpp"
@@ -134,6 +135,8 @@ namespace ouzel
                     device.reset(new RenderDeviceEmpty());
                     break;
             }
+
+            executeQueue = &device->executeQueue;
         }
 
         Renderer::~Renderer()
@@ -220,11 +223,6 @@ namespace ouzel
             return true;
         }
 
-        void Renderer::executeOnRenderThread(const std::function<void(void)>& func)
-        {
-            device->executeOnRenderThread(func);
-        }
-
         void Renderer::setClearColorBuffer(bool clear)
         {
             clearColorBuffer = clear;
@@ -283,7 +281,9 @@ namespace ouzel
                                       bool wireframe,
                                       bool scissorTest,
                                       const Rect& scissorRectangle,
-                                      CullMode cullMode)
+                                      CullMode cullMode,
+                                      const std::shared_ptr<Buffer>& instanceBuffer,
+                                      const std::vector<InstanceData>& instances)
         {
             if (!shader)
             {
@@ -303,6 +303,36 @@ namespace ouzel
                 return false;
             }
 
+            bool instanced = false;
+
+            if (!instances.empty())
+            {
+                const std::set<Vertex::Attribute::Usage>& vertexAttributes = shader->getVertexAttributes();
+                instanced = (vertexAttributes.find(Vertex::Attribute::Usage::INSTANCE_TRANSFORM) != vertexAttributes.end() ||
+                             vertexAttributes.find(Vertex::Attribute::Usage::INSTANCE_COLOR) != vertexAttributes.end());
+
+                if (instanced)
+                {
+                    if (!device->isInstancingSupported())
+                    {
+                        Log(Log::Level::ERR) << "Instancing is not supported by the render device";
+                        return false;
+                    }
+
+                    if (!instanceBuffer)
+                    {
+                        Log(Log::Level::ERR) << "No instance buffer passed to render queue";
+                        return false;
+                    }
+                }
+                else if ((!vertexShaderConstants.empty() && vertexShaderConstants[0].size() != 16) ||
+                         (!pixelShaderConstants.empty() && pixelShaderConstants[0].size() != 4))
+                {
+                    Log(Log::Level::ERR) << "Instances can't be expanded, the first shader constants must be a transform and a color";
+                    return false;
+                }
+            }
+
             std::vector<TextureResource*> drawTextures;
 
             for (const std::shared_ptr<Texture>& texture : textures)
@@ -327,10 +357,39 @@ namespace ouzel
                 wireframe,
                 scissorTest,
                 scissorRectangle,
-                cullMode
+                cullMode,
+                instanced ? instanceBuffer->getResource() : nullptr,
+                instanced ? static_cast<uint32_t>(instances.size()) : 0,
+                cameraConstantBuffer ? cameraConstantBuffer->getResource() : nullptr
             };
 
-            return device->addDrawCommand(drawCommand);
+            if (instanced || instances.empty())
+                return device->addDrawCommand(drawCommand);
+
+            // the shader can't instance, draw every instance separately
+            for (const InstanceData& instance : instances)
+            {
+                if (!vertexShaderConstants.empty())
+                {
+                    Matrix4 transform;
+                    std::copy(vertexShaderConstants[0].begin(), vertexShaderConstants[0].end(), transform.m);
+                    transform *= instance.transform;
+                    drawCommand.vertexShaderConstants[0].assign(std::begin(transform.m), std::end(transform.m));
+                }
+
+                if (!pixelShaderConstants.empty())
+                {
+                    drawCommand.pixelShaderConstants[0][0] = pixelShaderConstants[0][0] * instance.color.normR();
+                    drawCommand.pixelShaderConstants[0][1] = pixelShaderConstants[0][1] * instance.color.normG();
+                    drawCommand.pixelShaderConstants[0][2] = pixelShaderConstants[0][2] * instance.color.normB();
+                    drawCommand.pixelShaderConstants[0][3] = pixelShaderConstants[0][3] * instance.color.normA();
+                }
+
+                if (!device->addDrawCommand(drawCommand))
+                    return false;
+            }
+
+            return true;
         }
     } // namespace graphics
 } // namespace ouzel
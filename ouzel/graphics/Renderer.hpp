@@ -16,6 +16,8 @@
 #include "math/Size2.hpp"
 #include "math/Color.hpp"
 #include "graphics/Texture.hpp"
+#include "graphics/Vertex.hpp"
+#include "thread/ExecuteQueue.hpp"
 
 namespace ouzel
 {
@@ -26,6 +28,7 @@ namespace ouzel
     {
         const std::string SHADER_TEXTURE = "shaderTexture";
         const std::string SHADER_COLOR = "shaderColor";
+        const std::string SHADER_TEXTURE_INSTANCED = "shaderTextureInstanced";
 
         const std::string BLEND_NO_BLEND = "blendNoBlend";
         const std::string BLEND_ADD = "blendAdd";
@@ -37,6 +40,7 @@ namespace ouzel
 
         class RenderDevice;
         class BlendState;
+        class Buffer;
         class MeshBuffer;
         class Shader;
 
@@ -82,7 +86,10 @@ namespace ouzel
 
             inline RenderDevice* getDevice() const { return device.get(); }
 
-            void executeOnRenderThread(const std::function<void(void)>& func);
+            template<class F> void executeOnRenderThread(F&& func)
+            {
+                executeQueue->push(std::forward<F>(func));
+            }
 
             void setClearColorBuffer(bool clear);
             inline bool getClearColorBuffer() const { return clearColorBuffer; }
@@ -100,6 +107,14 @@ namespace ouzel
 
             bool saveScreenshot(const std::string& filename);
 
+            // CameraConstants buffer that is attached to the following draw commands
+            void setCameraConstantBuffer(const std::shared_ptr<Buffer>& newCameraConstantBuffer) { cameraConstantBuffer = newCameraConstantBuffer; }
+            inline const std::shared_ptr<Buffer>& getCameraConstantBuffer() const { return cameraConstantBuffer; }
+
+            // a draw command with instances is drawn with one instanced draw call if the shader has instance attributes
+            // (the instance buffer must hold the same instances), otherwise it is expanded to one draw call per instance:
+            // the first vertex shader constant (the transform) is multiplied by the instance transform
+            // and the first pixel shader constant (the color) by the instance color
             bool addDrawCommand(const std::vector<std::shared_ptr<Texture>>& textures,
                                 const std::shared_ptr<Shader>& shader,
                                 const std::vector<std::vector<float>>& pixelShaderConstants,
@@ -116,7 +131,9 @@ namespace ouzel
                                 bool wireframe,
                                 bool scissorTest,
                                 const Rect& scissorRectangle,
-                                CullMode cullMode);
+                                CullMode cullMode,
+                                const std::shared_ptr<Buffer>& instanceBuffer = nullptr,
+                                const std::vector<InstanceData>& instances = std::vector<InstanceData>());
 
         protected:
             explicit Renderer(Driver driver);
@@ -132,12 +149,15 @@ namespace ouzel
             void setSize(const Size2& newSize);
 
             std::unique_ptr<RenderDevice> device;
+            ExecuteQueue* executeQueue = nullptr; // owned by the device
 
             Size2 size;
             Color clearColor;
             float clearDepth = 1.0;
             bool clearColorBuffer = true;
             bool clearDepthBuffer = false;
+
+            std::shared_ptr<Buffer> cameraConstantBuffer;
         };
     } // namespace graphics
 } // namespace ouzel
@@ -61,6 +61,10 @@ namespace ouzel
 
             const std::set<Vertex::Attribute::Usage>& getVertexAttributes() const;
 
+            // shaders that read the view projection from the camera constant buffer take the model matrix as the first vertex shader constant instead of the model view projection
+            inline bool isCameraConstantsUsed() const { return cameraConstantsUsed; }
+            inline void setCameraConstantsUsed(bool newCameraConstantsUsed) { cameraConstantsUsed = newCameraConstantsUsed; }
+
         private:
             ShaderResource* resource = nullptr;
 
@@ -68,6 +72,8 @@ namespace ouzel
 
             std::string pixelShaderFilename;
             std::string vertexShaderFilename;
+
+            bool cameraConstantsUsed = false;
         };
     } // namespace graphics
 } // namespace ouzel
@@ -0,0 +1,35 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <cstdint>
+#include "math/Matrix4.hpp"
+
+namespace ouzel
+{
+    namespace graphics
+    {
+        // constant buffers that are shared between draw calls, bound by the render device only when they change
+        // OpenGL: uniform blocks "FrameConstants" and "CameraConstants" with the std140 layout
+        // Direct3D 11: cbuffer registers b1 and b2 (b0 holds the per draw call constants)
+        // Metal: vertex and fragment buffer indices 2 and 3
+        const uint32_t FRAME_CONSTANTS_SLOT = 0;
+        const uint32_t CAMERA_CONSTANTS_SLOT = 1;
+
+        // updated by the render device once per frame
+        struct FrameConstants
+        {
+            float time; // seconds since the render device was started
+            float deltaTime;
+            float width; // render size
+            float height;
+        };
+
+        // updated by the camera when its view projection changes
+        struct CameraConstants
+        {
+            Matrix4 viewProjection;
+        };
+    } // namespace graphics
+} // namespace ouzel
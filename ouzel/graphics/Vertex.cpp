@@ -1,6 +1,7 @@
 // Copyright (C) 2018 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <algorithm>
 #include "Vertex.hpp"
 
 namespace ouzel
@@ -12,9 +13,35 @@ namespace ouzel
             Vertex::Attribute(Vertex::Attribute::Usage::COLOR, DataType::UNSIGNED_BYTE_VECTOR4_NORM),
             Vertex::Attribute(Vertex::Attribute::Usage::TEXTURE_COORDINATES0, DataType::FLOAT_VECTOR2),
             Vertex::Attribute(Vertex::Attribute::Usage::TEXTURE_COORDINATES1, DataType::FLOAT_VECTOR2),
-            Vertex::Attribute(Vertex::Attribute::Usage::NORMAL, DataType::FLOAT_VECTOR3)
+            Vertex::Attribute(Vertex::Attribute::Usage::NORMAL, DataType::FLOAT_VECTOR3),
+            Vertex::Attribute(Vertex::Attribute::Usage::INSTANCE_TRANSFORM, DataType::FLOAT_MATRIX4),
+            Vertex::Attribute(Vertex::Attribute::Usage::INSTANCE_COLOR, DataType::UNSIGNED_BYTE_VECTOR4_NORM)
         };
 
+        const VertexLayout Vertex::LAYOUT({
+            Vertex::Attribute(Vertex::Attribute::Usage::POSITION, DataType::FLOAT_VECTOR3),
+            Vertex::Attribute(Vertex::Attribute::Usage::COLOR, DataType::UNSIGNED_BYTE_VECTOR4_NORM),
+            Vertex::Attribute(Vertex::Attribute::Usage::TEXTURE_COORDINATES0, DataType::FLOAT_VECTOR2),
+            Vertex::Attribute(Vertex::Attribute::Usage::TEXTURE_COORDINATES1, DataType::FLOAT_VECTOR2),
+            Vertex::Attribute(Vertex::Attribute::Usage::NORMAL, DataType::FLOAT_VECTOR3)
+        }, sizeof(Vertex));
+
+        const VertexLayout ColorVertex::LAYOUT({
+            Vertex::Attribute(Vertex::Attribute::Usage::POSITION, DataType::FLOAT_VECTOR3),
+            Vertex::Attribute(Vertex::Attribute::Usage::COLOR, DataType::UNSIGNED_BYTE_VECTOR4_NORM)
+        }, sizeof(ColorVertex));
+
+        const VertexLayout TextureVertex::LAYOUT({
+            Vertex::Attribute(Vertex::Attribute::Usage::POSITION, DataType::FLOAT_VECTOR3),
+            Vertex::Attribute(Vertex::Attribute::Usage::COLOR, DataType::UNSIGNED_BYTE_VECTOR4_NORM),
+            Vertex::Attribute(Vertex::Attribute::Usage::TEXTURE_COORDINATES0, DataType::FLOAT_VECTOR2)
+        }, sizeof(TextureVertex));
+
+        const VertexLayout InstanceData::LAYOUT({
+            Vertex::Attribute(Vertex::Attribute::Usage::INSTANCE_TRANSFORM, DataType::FLOAT_MATRIX4),
+            Vertex::Attribute(Vertex::Attribute::Usage::INSTANCE_COLOR, DataType::UNSIGNED_BYTE_VECTOR4_NORM)
+        }, sizeof(InstanceData));
+
         Vertex::Vertex()
         {
         }
@@ -24,5 +51,81 @@ namespace ouzel
         {
             texCoords[0] = initTexCoord;
         }
+
+        VertexLayout::VertexLayout(const std::vector<Vertex::Attribute>& initAttributes, uint32_t initStride):
+            attributes(initAttributes)
+        {
+            uint32_t offset = 0;
+
+            for (const Vertex::Attribute& attribute : attributes)
+            {
+                offsets.push_back(offset);
+                offset += getDataTypeSize(attribute.dataType);
+            }
+
+            stride = std::max(offset, initStride);
+        }
+
+        bool VertexLayout::hasAttribute(Vertex::Attribute::Usage usage) const
+        {
+            for (const Vertex::Attribute& attribute : attributes)
+            {
+                if (attribute.usage == usage) return true;
+            }
+
+            return false;
+        }
+
+        int32_t VertexLayout::getLocation(Vertex::Attribute::Usage usage)
+        {
+            uint32_t location = 0;
+
+            for (const Vertex::Attribute& attribute : Vertex::ATTRIBUTES)
+            {
+                if (attribute.usage == usage) return static_cast<int32_t>(location);
+                location += getLocationCount(attribute.dataType);
+            }
+
+            return -1;
+        }
+
+        uint32_t VertexLayout::getLocationCount(DataType dataType)
+        {
+            switch (dataType)
+            {
+                case DataType::FLOAT_MATRIX3: return 3;
+                case DataType::FLOAT_MATRIX4: return 4;
+                default: return 1;
+            }
+        }
+
+        bool VertexLayout::operator==(const VertexLayout& other) const
+        {
+            if (stride != other.stride || attributes.size() != other.attributes.size()) return false;
+
+            for (size_t i = 0; i < attributes.size(); ++i)
+            {
+                if (attributes[i].usage != other.attributes[i].usage ||
+                    attributes[i].dataType != other.attributes[i].dataType) return false;
+            }
+
+            return true;
+        }
+
+        bool VertexLayout::operator<(const VertexLayout& other) const
+        {
+            if (stride != other.stride) return stride < other.stride;
+            if (attributes.size() != other.attributes.size()) return attributes.size() < other.attributes.size();
+
+            for (size_t i = 0; i < attributes.size(); ++i)
+            {
+                if (attributes[i].usage != other.attributes[i].usage)
+                    return attributes[i].usage < other.attributes[i].usage;
+                if (attributes[i].dataType != other.attributes[i].dataType)
+                    return attributes[i].dataType < other.attributes[i].dataType;
+            }
+
+            return false;
+        }
     } // namespace graphics
 } // namespace ouzel
@@ -8,12 +8,15 @@
 #include "graphics/DataType.hpp"
 #include "math/Vector2.hpp"
 #include "math/Vector3.hpp"
+#include "math/Matrix4.hpp"
 #include "math/Color.hpp"
 
 namespace ouzel
 {
     namespace graphics
     {
+        class VertexLayout;
+
         class Vertex final
         {
         public:
@@ -32,7 +35,9 @@ namespace ouzel
                     POINT_SIZE,
                     TANGENT,
                     TEXTURE_COORDINATES0,
-                    TEXTURE_COORDINATES1
+                    TEXTURE_COORDINATES1,
+                    INSTANCE_TRANSFORM,
+                    INSTANCE_COLOR
                 };
 
                 Attribute(Usage initUsage, DataType initDataType):
@@ -41,7 +46,9 @@ namespace ouzel
                 DataType dataType = DataType::NONE;
             };
 
+            // all of the attributes that shaders can consume, in the order of their locations
             static const std::vector<Attribute> ATTRIBUTES;
+            static const VertexLayout LAYOUT;
 
             Vertex();
             Vertex(const Vector3& initPosition, Color initColor, const Vector2& initTexCoord, const Vector3& initNormal);
@@ -51,5 +58,76 @@ namespace ouzel
             Vector2 texCoords[2];
             Vector3 normal;
         };
+
+        class VertexLayout final
+        {
+        public:
+            VertexLayout() {}
+            // attributes are packed in the given order, stride defaults to the size of all of them
+            VertexLayout(const std::vector<Vertex::Attribute>& initAttributes, uint32_t initStride = 0);
+
+            inline const std::vector<Vertex::Attribute>& getAttributes() const { return attributes; }
+            inline const std::vector<uint32_t>& getOffsets() const { return offsets; }
+            inline uint32_t getStride() const { return stride; }
+
+            bool hasAttribute(Vertex::Attribute::Usage usage) const;
+            // returns the first location of the attribute or -1 if shaders can't consume it,
+            // locations follow the order of Vertex::ATTRIBUTES
+            static int32_t getLocation(Vertex::Attribute::Usage usage);
+            // matrices take one location per column
+            static uint32_t getLocationCount(DataType dataType);
+
+            bool operator==(const VertexLayout& other) const;
+            bool operator!=(const VertexLayout& other) const { return !(*this == other); }
+            bool operator<(const VertexLayout& other) const;
+
+        private:
+            std::vector<Vertex::Attribute> attributes;
+            std::vector<uint32_t> offsets;
+            uint32_t stride = 0;
+        };
+
+        // vertex for untextured geometry (shapes, SHADER_COLOR)
+        class ColorVertex final
+        {
+        public:
+            static const VertexLayout LAYOUT;
+
+            ColorVertex() {}
+            ColorVertex(const Vector3& initPosition, Color initColor):
+                position(initPosition), color(initColor) {}
+
+            Vector3 position;
+            Color color;
+        };
+
+        // vertex for sprites, text and particles (SHADER_TEXTURE)
+        class TextureVertex final
+        {
+        public:
+            static const VertexLayout LAYOUT;
+
+            TextureVertex() {}
+            TextureVertex(const Vector3& initPosition, Color initColor, const Vector2& initTexCoord):
+                position(initPosition), color(initColor), texCoord(initTexCoord) {}
+
+            Vector3 position;
+            Color color;
+            Vector2 texCoord;
+        };
+
+        // per-instance data of instanced draw calls
+        class InstanceData final
+        {
+        public:
+            static const VertexLayout LAYOUT;
+
+            InstanceData() {}
+            InstanceData(const Matrix4& initTransform, Color initColor):
+                transform(initTransform), color(initColor) {}
+
+            Matrix4 transform;
+            Color color;
+        };
     } // namespace graphics
 } // namespace ouzel
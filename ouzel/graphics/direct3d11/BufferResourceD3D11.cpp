@@ -116,6 +116,11 @@ namespace ouzel
                     case Buffer::Usage::VERTEX:
                         bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
                         break;
+                    case Buffer::Usage::CONSTANT:
+                        // constant buffer sizes must be multiples of 16
+                        bufferDesc.ByteWidth = ((bufferSize + 15) / 16) * 16;
+                        bufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+                        break;
                     default:
                         Log(Log::Level::ERR) << "Unsupported buffer type";
                         return false;
@@ -23,7 +23,7 @@ namespace ouzel
             virtual ~MeshBufferResourceD3D11();
 
             virtual bool init(uint32_t newIndexSize, BufferResource* newIndexBuffer,
-                              BufferResource* newVertexBuffer) override;
+                              BufferResource* newVertexBuffer, const VertexLayout& newVertexLayout) override;
 
             virtual bool setIndexSize(uint32_t newIndexSize) override;
             virtual bool setIndexBuffer(BufferResource* newIndexBuffer) override;
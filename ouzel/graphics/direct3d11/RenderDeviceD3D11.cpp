@@ -5,16 +5,19 @@
 
 #if OUZEL_COMPILE_DIRECT3D11
 
+#include <d3dcompiler.h>
 #include "RenderDeviceD3D11.hpp"
 #include "BlendStateResourceD3D11.hpp"
 #include "TextureResourceD3D11.hpp"
 #include "ShaderResourceD3D11.hpp"
 #include "MeshBufferResourceD3D11.hpp"
 #include "BufferResourceD3D11.hpp"
+#include "graphics/SharedConstants.hpp"
 #include "TexturePSD3D11.h"
 #include "TextureVSD3D11.h"
 #include "ColorPSD3D11.h"
 #include "ColorVSD3D11.h"
+#include "TextureInstancedVSD3D11.h"
 #include "core/Engine.hpp"
 #include "thread/Lock.hpp"
 #include "utils/Log.hpp"
@@ -25,6 +28,51 @@ namespace ouzel
 {
     namespace graphics
     {
+        // the shader compiler is loaded only when a shader has to be compiled, so that the engine doesn't depend on it
+        static bool compileShader(const uint8_t* source, size_t sourceSize, const char* target, std::vector<uint8_t>& result)
+        {
+            HMODULE compiler = LoadLibraryW(L"d3dcompiler_47.dll");
+
+            if (!compiler)
+            {
+                Log(Log::Level::WARN) << "Failed to load the Direct3D shader compiler";
+                return false;
+            }
+
+            pD3DCompile d3dCompile = reinterpret_cast<pD3DCompile>(GetProcAddress(compiler, "D3DCompile"));
+
+            if (!d3dCompile)
+            {
+                Log(Log::Level::WARN) << "Failed to get the D3DCompile function";
+                FreeLibrary(compiler);
+                return false;
+            }
+
+            ID3DBlob* code = nullptr;
+            ID3DBlob* errors = nullptr;
+
+            HRESULT hr = d3dCompile(source, sourceSize, nullptr, nullptr, nullptr, "main", target,
+                                    D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, &code, &errors);
+
+            if (FAILED(hr))
+            {
+                Log(Log::Level::ERR) << "Failed to compile a Direct3D 11 shader, error: " << hr <<
+                    (errors ? ", " + std::string(static_cast<const char*>(errors->GetBufferPointer()), errors->GetBufferSize()) : std::string());
+            }
+            else
+            {
+                const uint8_t* data = static_cast<const uint8_t*>(code->GetBufferPointer());
+                result.assign(data, data + code->GetBufferSize());
+            }
+
+            // the blobs are implemented by the compiler, so they have to be released before it is unloaded
+            if (code) code->Release();
+            if (errors) errors->Release();
+            FreeLibrary(compiler);
+
+            return SUCCEEDED(hr);
+        }
+
         RenderDeviceD3D11::RenderDeviceD3D11():
             RenderDevice(Renderer::Driver::DIRECT3D11), running(false)
         {
@@ -158,6 +206,10 @@ namespace ouzel
                 npotTexturesSupported = false;
             }
 
+            // instanced draw calls need at least feature level 9_3
+            instancingSupported = device->GetFeatureLevel() >= D3D_FEATURE_LEVEL_9_3;
+            constantBuffersSupported = true;
+
             IDXGIDevice* dxgiDevice;
             IDXGIFactory* factory;
 
@@ -375,6 +427,28 @@ namespace ouzel
 
             engine->getCache()->setShader(SHADER_COLOR, colorShader);
 
+            if (instancingSupported)
+            {
+                // the instanced shader needs feature level 9_3, so it isn't precompiled with the other built-in shaders
+                std::vector<uint8_t> textureInstancedVertexShader;
+
+                if (compileShader(TextureInstancedVS_hlsl, sizeof(TextureInstancedVS_hlsl), "vs_4_0_level_9_3", textureInstancedVertexShader))
+                {
+                    std::shared_ptr<Shader> textureInstancedShader = std::make_shared<Shader>();
+
+                    if (textureInstancedShader->init(std::vector<uint8_t>(std::begin(TEXTURE_PIXEL_SHADER_D3D11), std::end(TEXTURE_PIXEL_SHADER_D3D11)),
+                                                     textureInstancedVertexShader,
+                                                     {Vertex::Attribute::Usage::POSITION, Vertex::Attribute::Usage::COLOR, Vertex::Attribute::Usage::TEXTURE_COORDINATES0,
+                                                      Vertex::Attribute::Usage::INSTANCE_TRANSFORM, Vertex::Attribute::Usage::INSTANCE_COLOR},
+                                                     {{"color", DataType::FLOAT_VECTOR4}},
+                                                     {{"model", DataType::FLOAT_MATRIX4}}))
+                    {
+                        textureInstancedShader->setCameraConstantsUsed(true);
+                        engine->getCache()->setShader(SHADER_TEXTURE_INSTANCED, textureInstancedShader);
+                    }
+                }
+            }
+
             frameBufferClearColor[0] = clearColor.normR();
             frameBufferClearColor[1] = clearColor.normG();
             frameBufferClearColor[2] = clearColor.normB();
@@ -432,6 +506,16 @@ namespace ouzel
             viewport.MinDepth = 0.0f;
             viewport.MaxDepth = 1.0f;
 
+            // register b0 is used by the per draw call constants
+            if (frameConstantBuffer)
+            {
+                ID3D11Buffer* frameConstantBuffers[1] = {static_cast<BufferResourceD3D11*>(frameConstantBuffer)->getBuffer()};
+                context->VSSetConstantBuffers(FRAME_CONSTANTS_SLOT + 1, 1, frameConstantBuffers);
+                context->PSSetConstantBuffers(FRAME_CONSTANTS_SLOT + 1, 1, frameConstantBuffers);
+            }
+
+            BufferResource* currentCameraConstantBuffer = nullptr;
+
             if (drawCommands.empty())
             {
                 frameBufferClearedFrame = currentFrame;
@@ -555,8 +639,6 @@ namespace ouzel
                 context->PSSetShader(shaderD3D11->getPixelShader(), nullptr, 0);
                 context->VSSetShader(shaderD3D11->getVertexShader(), nullptr, 0);
 
-                context->IASetInputLayout(shaderD3D11->getInputLayout());
-
                 // pixel shader constants
                 const std::vector<ShaderResourceD3D11::Location>& pixelShaderConstantLocations = shaderD3D11->getPixelShaderConstantLocations();
 
@@ -627,6 +709,15 @@ namespace ouzel
                 ID3D11Buffer* vertexShaderConstantBuffers[1] = {shaderD3D11->getVertexShaderConstantBuffer()};
                 context->VSSetConstantBuffers(0, 1, vertexShaderConstantBuffers);
 
+                if (drawCommand.cameraConstantBuffer &&
+                    drawCommand.cameraConstantBuffer != currentCameraConstantBuffer)
+                {
+                    ID3D11Buffer* cameraConstantBuffers[1] = {static_cast<BufferResourceD3D11*>(drawCommand.cameraConstantBuffer)->getBuffer()};
+                    context->VSSetConstantBuffers(CAMERA_CONSTANTS_SLOT + 1, 1, cameraConstantBuffers);
+                    context->PSSetConstantBuffers(CAMERA_CONSTANTS_SLOT + 1, 1, cameraConstantBuffers);
+                    currentCameraConstantBuffer = drawCommand.cameraConstantBuffer;
+                }
+
                 // blend state
                 BlendStateResourceD3D11* blendStateD3D11 = static_cast<BlendStateResourceD3D11*>(drawCommand.blendState);
 
@@ -698,10 +789,29 @@ namespace ouzel
                     continue;
                 }
 
-                ID3D11Buffer* buffers[] = {vertexBufferD3D11->getBuffer()};
-                UINT strides[] = {sizeof(Vertex)};
-                UINT offsets[] = {0};
-                context->IASetVertexBuffers(0, 1, buffers, strides, offsets);
+                BufferResourceD3D11* instanceBufferD3D11 = static_cast<BufferResourceD3D11*>(drawCommand.instanceBuffer);
+
+                if (drawCommand.instanceCount &&
+                    (!instanceBufferD3D11 || !instanceBufferD3D11->getBuffer()))
+                {
+                    // don't render if invalid instance buffer
+                    continue;
+                }
+
+                ID3D11InputLayout* inputLayout = shaderD3D11->getInputLayout(meshBufferD3D11->getVertexLayout());
+
+                if (!inputLayout)
+                {
+                    // don't render if the vertex layout doesn't match the shader
+                    continue;
+                }
+
+                context->IASetInputLayout(inputLayout);
+
+                ID3D11Buffer* buffers[] = {vertexBufferD3D11->getBuffer(), drawCommand.instanceCount ? instanceBufferD3D11->getBuffer() : nullptr};
+                UINT strides[] = {meshBufferD3D11->getVertexLayout().getStride(), InstanceData::LAYOUT.getStride()};
+                UINT offsets[] = {0, 0};
+                context->IASetVertexBuffers(0, 2, buffers, strides, offsets);
                 context->IASetIndexBuffer(indexBufferD3D11->getBuffer(), meshBufferD3D11->getIndexFormat(), 0);
 
                 D3D_PRIMITIVE_TOPOLOGY topology;
@@ -725,7 +835,14 @@ namespace ouzel
                     indexCount = (indexBufferD3D11->getSize() / meshBufferD3D11->getIndexSize()) - drawCommand.startIndex;
                 }
 
-                context->DrawIndexed(indexCount, drawCommand.startIndex, 0);
+                if (drawCommand.instanceCount)
+                {
+                    context->DrawIndexedInstanced(indexCount, drawCommand.instanceCount, drawCommand.startIndex, 0, 0);
+                }
+                else
+                {
+                    context->DrawIndexed(indexCount, drawCommand.startIndex, 0);
+                }
             }
 
             swapChain->Present(swapInterval, 0);
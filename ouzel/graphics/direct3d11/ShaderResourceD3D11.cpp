@@ -5,6 +5,7 @@
 
 #if OUZEL_COMPILE_DIRECT3D11
 
+#include <algorithm>
 #include "ShaderResourceD3D11.hpp"
 #include "RenderDeviceD3D11.hpp"
 #include "utils/Log.hpp"
@@ -99,10 +100,8 @@ namespace ouzel
                 vertexShader->Release();
             }
 
-            if (inputLayout)
-            {
-                inputLayout->Release();
-            }
+            for (const auto& inputLayout : inputLayouts)
+                inputLayout.second->Release();
 
             if (pixelShaderConstantBuffer)
             {
@@ -156,88 +155,10 @@ namespace ouzel
                 return false;
             }
 
-            std::vector<D3D11_INPUT_ELEMENT_DESC> vertexInputElements;
+            for (const auto& inputLayout : inputLayouts)
+                inputLayout.second->Release();
 
-            UINT offset = 0;
-
-            for (const Vertex::Attribute& vertexAttribute : Vertex::ATTRIBUTES)
-            {
-                if (vertexAttributes.find(vertexAttribute.usage) != vertexAttributes.end())
-                {
-                    DXGI_FORMAT vertexFormat = getVertexFormat(vertexAttribute.dataType);
-
-                    if (vertexFormat == DXGI_FORMAT_UNKNOWN)
-                    {
-                        Log(Log::Level::ERR) << "Invalid vertex format";
-                        return false;
-                    }
-
-                    const char* semantic;
-                    UINT index = 0;
-
-                    switch (vertexAttribute.usage)
-                    {
-                        case Vertex::Attribute::Usage::BINORMAL:
-                            semantic = "BINORMAL";
-                            break;
-                        case Vertex::Attribute::Usage::BLEND_INDICES:
-                            semantic = "BLENDINDICES";
-                            break;
-                        case Vertex::Attribute::Usage::BLEND_WEIGHT:
-                            semantic = "BLENDWEIGHT";
-                            break;
-                        case Vertex::Attribute::Usage::COLOR:
-                            semantic = "COLOR";
-                            break;
-                        case Vertex::Attribute::Usage::NORMAL:
-                            semantic = "NORMAL";
-                            break;
-                        case Vertex::Attribute::Usage::POSITION:
-                            semantic = "POSITION";
-                            break;
-                        case Vertex::Attribute::Usage::POSITION_TRANSFORMED:
-                            semantic = "POSITIONT";
-                            break;
-                        case Vertex::Attribute::Usage::POINT_SIZE:
-                            semantic = "PSIZE";
-                            break;
-                        case Vertex::Attribute::Usage::TANGENT:
-                            semantic = "TANGENT";
-                            break;
-                        case Vertex::Attribute::Usage::TEXTURE_COORDINATES0:
-                            semantic = "TEXCOORD";
-                            break;
-                        case Vertex::Attribute::Usage::TEXTURE_COORDINATES1:
-                            semantic = "TEXCOORD";
-                            index = 1;
-                            break;
-                        default:
-                            Log(Log::Level::ERR) << "Invalid vertex attribute usage";
-                            return false;
-                    }
-
-                    vertexInputElements.push_back({
-                        semantic, index,
-                        vertexFormat,
-                        0, offset, D3D11_INPUT_PER_VERTEX_DATA, 0
-                    });
-                }
-
-                offset += getDataTypeSize(vertexAttribute.dataType);
-            }
-
-            if (inputLayout) inputLayout->Release();
-
-            hr = renderDeviceD3D11->getDevice()->CreateInputLayout(vertexInputElements.data(),
-                                                                   static_cast<UINT>(vertexInputElements.size()),
-                                                                   vertexShaderData.data(),
-                                                                   vertexShaderData.size(),
-                                                                   &inputLayout);
-            if (FAILED(hr))
-            {
-                Log(Log::Level::ERR) << "Failed to create Direct3D 11 input layout for vertex shader, error: " << hr;
-                return false;
-            }
+            inputLayouts.clear();
 
             if (!pixelShaderConstantInfo.empty())
             {
@@ -303,6 +224,141 @@ namespace ouzel
 
             return true;
         }
+        ID3D11InputLayout* ShaderResourceD3D11::getInputLayout(const VertexLayout& vertexLayout)
+        {
+            auto inputLayoutIterator = inputLayouts.find(vertexLayout);
+            if (inputLayoutIterator != inputLayouts.end()) return inputLayoutIterator->second;
+
+            std::vector<D3D11_INPUT_ELEMENT_DESC> vertexInputElements;
+
+            for (const Vertex::Attribute& vertexAttribute : Vertex::ATTRIBUTES)
+            {
+                if (vertexAttributes.find(vertexAttribute.usage) != vertexAttributes.end())
+                {
+                    // instance attributes come from the instance buffer in the second slot
+                    bool perInstance = (vertexAttribute.usage == Vertex::Attribute::Usage::INSTANCE_TRANSFORM ||
+                                        vertexAttribute.usage == Vertex::Attribute::Usage::INSTANCE_COLOR);
+                    const VertexLayout& sourceLayout = perInstance ? InstanceData::LAYOUT : vertexLayout;
+
+                    const std::vector<Vertex::Attribute>& layoutAttributes = sourceLayout.getAttributes();
+                    auto layoutAttributeIterator = std::find_if(layoutAttributes.begin(), layoutAttributes.end(),
+                                                                [&vertexAttribute](const Vertex::Attribute& attribute) {
+                                                                    return attribute.usage == vertexAttribute.usage;
+                                                                });
+
+                    if (layoutAttributeIterator == layoutAttributes.end())
+                    {
+                        Log(Log::Level::ERR) << "Vertex layout is missing an attribute used by the shader";
+                        return nullptr;
+                    }
+
+                    // matrices are passed as one vector per column
+                    UINT locationCount = VertexLayout::getLocationCount(layoutAttributeIterator->dataType);
+                    DXGI_FORMAT vertexFormat;
+
+                    switch (layoutAttributeIterator->dataType)
+                    {
+                        case DataType::FLOAT_MATRIX3:
+                            vertexFormat = DXGI_FORMAT_R32G32B32_FLOAT;
+                            break;
+                        case DataType::FLOAT_MATRIX4:
+                            vertexFormat = DXGI_FORMAT_R32G32B32A32_FLOAT;
+                            break;
+                        default:
+                            vertexFormat = getVertexFormat(layoutAttributeIterator->dataType);
+                            break;
+                    }
+
+                    if (vertexFormat == DXGI_FORMAT_UNKNOWN)
+                    {
+                        Log(Log::Level::ERR) << "Invalid vertex format";
+                        return nullptr;
+                    }
+
+                    const char* semantic;
+                    UINT index = 0;
+
+                    switch (vertexAttribute.usage)
+                    {
+                        case Vertex::Attribute::Usage::BINORMAL:
+                            semantic = "BINORMAL";
+                            break;
+                        case Vertex::Attribute::Usage::BLEND_INDICES:
+                            semantic = "BLENDINDICES";
+                            break;
+                        case Vertex::Attribute::Usage::BLEND_WEIGHT:
+                            semantic = "BLENDWEIGHT";
+                            break;
+                        case Vertex::Attribute::Usage::COLOR:
+                            semantic = "COLOR";
+                            break;
+                        case Vertex::Attribute::Usage::NORMAL:
+                            semantic = "NORMAL";
+                            break;
+                        case Vertex::Attribute::Usage::POSITION:
+                            semantic = "POSITION";
+                            break;
+                        case Vertex::Attribute::Usage::POSITION_TRANSFORMED:
+                            semantic = "POSITIONT";
+                            break;
+                        case Vertex::Attribute::Usage::POINT_SIZE:
+                            semantic = "PSIZE";
+                            break;
+                        case Vertex::Attribute::Usage::TANGENT:
+                            semantic = "TANGENT";
+                            break;
+                        case Vertex::Attribute::Usage::TEXTURE_COORDINATES0:
+                            semantic = "TEXCOORD";
+                            break;
+                        case Vertex::Attribute::Usage::TEXTURE_COORDINATES1:
+                            semantic = "TEXCOORD";
+                            index = 1;
+                            break;
+                        case Vertex::Attribute::Usage::INSTANCE_TRANSFORM:
+                            semantic = "INSTANCETRANSFORM";
+                            break;
+                        case Vertex::Attribute::Usage::INSTANCE_COLOR:
+                            semantic = "INSTANCECOLOR";
+                            break;
+                        default:
+                            Log(Log::Level::ERR) << "Invalid vertex attribute usage";
+                            return nullptr;
+                    }
+
+                    UINT offset = sourceLayout.getOffsets()[static_cast<size_t>(layoutAttributeIterator - layoutAttributes.begin())];
+                    UINT columnSize = getDataTypeSize(layoutAttributeIterator->dataType) / locationCount;
+
+                    for (UINT column = 0; column < locationCount; ++column)
+                    {
+                        vertexInputElements.push_back({
+                            semantic, index + column,
+                            vertexFormat,
+                            perInstance ? 1U : 0U,
+                            offset + column * columnSize,
+                            perInstance ? D3D11_INPUT_PER_INSTANCE_DATA : D3D11_INPUT_PER_VERTEX_DATA,
+                            perInstance ? 1U : 0U
+                        });
+                    }
+                }
+            }
+
+            ID3D11InputLayout* inputLayout;
+
+            HRESULT hr = renderDeviceD3D11->getDevice()->CreateInputLayout(vertexInputElements.data(),
+                                                                           static_cast<UINT>(vertexInputElements.size()),
+                                                                           vertexShaderData.data(),
+                                                                           vertexShaderData.size(),
+                                                                           &inputLayout);
+            if (FAILED(hr))
+            {
+                Log(Log::Level::ERR) << "Failed to create Direct3D 11 input layout for vertex shader, error: " << hr;
+                return nullptr;
+            }
+
+            inputLayouts[vertexLayout] = inputLayout;
+
+            return inputLayout;
+        }
     } // namespace graphics
 } // namespace ouzel
 
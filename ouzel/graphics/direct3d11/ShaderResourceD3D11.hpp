@@ -7,6 +7,7 @@
 
 #if OUZEL_COMPILE_DIRECT3D11
 
+#include <map>
 #include <vector>
 #include <d3d11.h>
 #include "graphics/ShaderResource.hpp"
@@ -47,14 +48,17 @@ namespace ouzel
 
             ID3D11Buffer* getPixelShaderConstantBuffer() const { return pixelShaderConstantBuffer; }
             ID3D11Buffer* getVertexShaderConstantBuffer() const { return vertexShaderConstantBuffer; }
-            ID3D11InputLayout* getInputLayout() const { return inputLayout; }
+
+            // returns the input layout matching the shader attributes to the mesh buffer's vertex layout,
+            // layouts are created on first use and cached
+            ID3D11InputLayout* getInputLayout(const VertexLayout& vertexLayout);
 
         protected:
             RenderDeviceD3D11* renderDeviceD3D11;
 
             ID3D11PixelShader* pixelShader = nullptr;
             ID3D11VertexShader* vertexShader = nullptr;
-            ID3D11InputLayout* inputLayout = nullptr;
+            std::map<VertexLayout, ID3D11InputLayout*> inputLayouts;
 
             ID3D11Buffer* pixelShaderConstantBuffer = nullptr;
             ID3D11Buffer* vertexShaderConstantBuffer = nullptr;
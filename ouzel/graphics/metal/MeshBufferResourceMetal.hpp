@@ -31,7 +31,7 @@ namespace ouzel
             virtual ~MeshBufferResourceMetal();
 
             virtual bool init(uint32_t newIndexSize, BufferResource* newIndexBuffer,
-                              BufferResource* newVertexBuffer) override;
+                              BufferResource* newVertexBuffer, const VertexLayout& newVertexLayout) override;
 
             virtual bool setIndexSize(uint32_t newIndexSize) override;
             virtual bool setIndexBuffer(BufferResource* newIndexBuffer) override;
@@ -24,9 +24,9 @@ namespace ouzel
         }
 
         bool MeshBufferResourceMetal::init(uint32_t newIndexSize, BufferResource* newIndexBuffer,
-                                           BufferResource* newVertexBuffer)
+                                           BufferResource* newVertexBuffer, const VertexLayout& newVertexLayout)
         {
-            if (!MeshBufferResource::init(newIndexSize, newIndexBuffer, newVertexBuffer))
+            if (!MeshBufferResource::init(newIndexSize, newIndexBuffer, newVertexBuffer, newVertexLayout))
             {
                 return false;
             }
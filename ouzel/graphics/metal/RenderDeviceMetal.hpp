@@ -114,11 +114,12 @@ namespace ouzel
                 NSUInteger sampleCount;
                 MTLPixelFormat colorFormat;
                 MTLPixelFormat depthFormat;
+                VertexLayout vertexLayout;
 
                 bool operator<(const PipelineStateDesc& other) const
                 {
-                    return std::tie(blendState, shader, sampleCount, colorFormat, depthFormat) <
-                        std::tie(other.blendState, other.shader, other.sampleCount, colorFormat, other.depthFormat);
+                    return std::tie(blendState, shader, sampleCount, colorFormat, depthFormat, vertexLayout) <
+                        std::tie(other.blendState, other.shader, other.sampleCount, other.colorFormat, other.depthFormat, other.vertexLayout);
                 }
             };
 
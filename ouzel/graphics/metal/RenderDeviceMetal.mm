@@ -11,6 +11,7 @@
 #include "MeshBufferResourceMetal.hpp"
 #include "BufferResourceMetal.hpp"
 #include "BlendStateResourceMetal.hpp"
+#include "graphics/SharedConstants.hpp"
 #include "events/EventDispatcher.hpp"
 #if OUZEL_PLATFORM_MACOS
     #include "ColorPSMacOS.h"
@@ -173,6 +174,8 @@ namespace ouzel
 
             commandQueue = [device newCommandQueue];
 
+            constantBuffersSupported = true;
+
             if (!commandQueue)
             {
                 Log(Log::Level::ERR) << "Failed to create Metal command queue";
@@ -405,6 +408,7 @@ namespace ouzel
 
             MTLRenderPassDescriptorPtr currentRenderPassDescriptor = nil;
             id<MTLRenderCommandEncoder> currentRenderCommandEncoder = nil;
+            BufferResource* currentCameraConstantBuffer = nullptr;
 
             MTLScissorRect scissorRect;
 
@@ -514,6 +518,27 @@ namespace ouzel
 
                     currentRenderPassDescriptor.colorAttachments[0].loadAction = newColorBufferLoadAction;
                     currentRenderPassDescriptor.depthAttachment.loadAction = newDepthBufferLoadAction;
+
+                    // buffer bindings don't carry over to the new encoder, indices 0 and 1 are taken by vertices and per draw constants
+                    if (frameConstantBuffer)
+                    {
+                        BufferResourceMetal* frameConstantBufferMetal = static_cast<BufferResourceMetal*>(frameConstantBuffer);
+
+                        [currentRenderCommandEncoder setVertexBuffer:frameConstantBufferMetal->getBuffer() offset:0 atIndex:FRAME_CONSTANTS_SLOT + 2];
+                        [currentRenderCommandEncoder setFragmentBuffer:frameConstantBufferMetal->getBuffer() offset:0 atIndex:FRAME_CONSTANTS_SLOT + 2];
+                    }
+
+                    currentCameraConstantBuffer = nullptr;
+                }
+
+                if (drawCommand.cameraConstantBuffer &&
+                    drawCommand.cameraConstantBuffer != currentCameraConstantBuffer)
+                {
+                    BufferResourceMetal* cameraConstantBufferMetal = static_cast<BufferResourceMetal*>(drawCommand.cameraConstantBuffer);
+
+                    [currentRenderCommandEncoder setVertexBuffer:cameraConstantBufferMetal->getBuffer() offset:0 atIndex:CAMERA_CONSTANTS_SLOT + 2];
+                    [currentRenderCommandEncoder setFragmentBuffer:cameraConstantBufferMetal->getBuffer() offset:0 atIndex:CAMERA_CONSTANTS_SLOT + 2];
+                    currentCameraConstantBuffer = drawCommand.cameraConstantBuffer;
                 }
 
                 viewport.originX = static_cast<double>(drawCommand.viewport.position.x);
@@ -659,6 +684,21 @@ namespace ouzel
 
                 shaderConstantBuffer.offset += static_cast<uint32_t>(getVectorSize(shaderData));
 
+                // mesh buffer
+                MeshBufferResourceMetal* meshBufferMetal = static_cast<MeshBufferResourceMetal*>(drawCommand.meshBuffer);
+                BufferResourceMetal* indexBufferMetal = meshBufferMetal->getIndexBufferMetal();
+                BufferResourceMetal* vertexBufferMetal = meshBufferMetal->getVertexBufferMetal();
+
+                if (!meshBufferMetal ||
+                    !indexBufferMetal ||
+                    !vertexBufferMetal ||
+                    !indexBufferMetal->getBuffer() ||
+                    !vertexBufferMetal->getBuffer())
+                {
+                    // don't render if invalid mesh buffer
+                    continue;
+                }
+
                 // blend state
                 BlendStateResourceMetal* blendStateMetal = static_cast<BlendStateResourceMetal*>(drawCommand.blendState);
 
@@ -669,6 +709,7 @@ namespace ouzel
                 }
 
                 pipelineStateDesc.blendState = blendStateMetal;
+                pipelineStateDesc.vertexLayout = meshBufferMetal->getVertexLayout();
 
                 MTLRenderPipelineStatePtr pipelineState = getPipelineState(pipelineStateDesc);
 
@@ -714,21 +755,6 @@ namespace ouzel
                     continue;
                 }
 
-                // mesh buffer
-                MeshBufferResourceMetal* meshBufferMetal = static_cast<MeshBufferResourceMetal*>(drawCommand.meshBuffer);
-                BufferResourceMetal* indexBufferMetal = meshBufferMetal->getIndexBufferMetal();
-                BufferResourceMetal* vertexBufferMetal = meshBufferMetal->getVertexBufferMetal();
-
-                if (!meshBufferMetal ||
-                    !indexBufferMetal ||
-                    !vertexBufferMetal ||
-                    !indexBufferMetal->getBuffer() ||
-                    !vertexBufferMetal->getBuffer())
-                {
-                    // don't render if invalid mesh buffer
-                    continue;
-                }
-
                 [currentRenderCommandEncoder setVertexBuffer:vertexBufferMetal->getBuffer() offset:0 atIndex:0];
 
                 // draw
@@ -865,7 +891,17 @@ namespace ouzel
                 pipelineStateDescriptor.sampleCount = desc.sampleCount;
                 pipelineStateDescriptor.vertexFunction = desc.shader->getVertexShader();
                 pipelineStateDescriptor.fragmentFunction = desc.shader->getPixelShader();
-                pipelineStateDescriptor.vertexDescriptor = desc.shader->getVertexDescriptor();
+
+                MTLVertexDescriptorPtr vertexDescriptor = desc.shader->createVertexDescriptor(desc.vertexLayout);
+
+                if (!vertexDescriptor)
+                {
+                    [pipelineStateDescriptor release];
+                    return nil;
+                }
+
+                pipelineStateDescriptor.vertexDescriptor = vertexDescriptor;
+                [vertexDescriptor release];
 
                 pipelineStateDescriptor.colorAttachments[0].pixelFormat = desc.colorFormat;
                 pipelineStateDescriptor.depthAttachmentPixelFormat = desc.depthFormat;
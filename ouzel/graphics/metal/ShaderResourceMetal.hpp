@@ -53,7 +53,9 @@ namespace ouzel
             inline MTLFunctionPtr getPixelShader() const { return pixelShader; }
             inline MTLFunctionPtr getVertexShader() const { return vertexShader; }
 
-            inline MTLVertexDescriptorPtr getVertexDescriptor() const { return vertexDescriptor;  }
+            // creates a vertex descriptor that maps the mesh buffer's vertex layout to the shader attributes,
+            // the caller owns the returned descriptor
+            MTLVertexDescriptorPtr createVertexDescriptor(const VertexLayout& vertexLayout) const;
 
             inline uint32_t getPixelShaderConstantBufferSize() const { return pixelShaderConstantSize; }
             inline uint32_t getVertexShaderConstantBufferSize() const { return vertexShaderConstantSize; }
@@ -64,8 +66,6 @@ namespace ouzel
             MTLFunctionPtr pixelShader = nil;
             MTLFunctionPtr vertexShader = nil;
 
-            MTLVertexDescriptorPtr vertexDescriptor = nil;
-
             std::vector<Location> pixelShaderConstantLocations;
             uint32_t pixelShaderConstantSize = 0;
             std::vector<Location> vertexShaderConstantLocations;
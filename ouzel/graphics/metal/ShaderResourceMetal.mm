@@ -31,11 +31,6 @@ namespace ouzel
             {
                 [pixelShader release];
             }
-
-            if (vertexDescriptor)
-            {
-                [vertexDescriptor release];
-            }
         }
 
         static MTLVertexFormat getVertexFormat(DataType dataType)
@@ -130,36 +125,6 @@ namespace ouzel
                 return false;
             }
 
-            uint32_t index = 0;
-            NSUInteger offset = 0;
-
-            vertexDescriptor = [MTLVertexDescriptor new];
-
-            for (const Vertex::Attribute& vertexAttribute : Vertex::ATTRIBUTES)
-            {
-                if (vertexAttributes.find(vertexAttribute.usage) != vertexAttributes.end())
-                {
-                    MTLVertexFormat vertexFormat = getVertexFormat(vertexAttribute.dataType);
-
-                    if (vertexFormat == MTLVertexFormatInvalid)
-                    {
-                        Log(Log::Level::ERR) << "Invalid vertex format";
-                        return false;
-                    }
-
-                    vertexDescriptor.attributes[index].format = vertexFormat;
-                    vertexDescriptor.attributes[index].offset = offset;
-                    vertexDescriptor.attributes[index].bufferIndex = 0;
-                    ++index;
-                }
-
-                offset += getDataTypeSize(vertexAttribute.dataType);
-            }
-
-            vertexDescriptor.layouts[0].stride = offset;
-            vertexDescriptor.layouts[0].stepRate = 1;
-            vertexDescriptor.layouts[0].stepFunction = MTLVertexStepFunctionPerVertex;
-
             NSError* err;
 
             dispatch_data_t pixelShaderDispatchData = dispatch_data_create(pixelShaderData.data(), pixelShaderData.size(), nullptr, DISPATCH_DATA_DESTRUCTOR_DEFAULT);
@@ -238,6 +203,51 @@ namespace ouzel
 
             return true;
         }
+        MTLVertexDescriptorPtr ShaderResourceMetal::createVertexDescriptor(const VertexLayout& vertexLayout) const
+        {
+            MTLVertexDescriptor* vertexDescriptor = [MTLVertexDescriptor new];
+
+            const std::vector<Vertex::Attribute>& layoutAttributes = vertexLayout.getAttributes();
+            NSUInteger index = 0;
+
+            for (const Vertex::Attribute& vertexAttribute : Vertex::ATTRIBUTES)
+            {
+                if (vertexAttributes.find(vertexAttribute.usage) != vertexAttributes.end())
+                {
+                    auto layoutAttributeIterator = std::find_if(layoutAttributes.begin(), layoutAttributes.end(),
+                                                                [&vertexAttribute](const Vertex::Attribute& attribute) {
+                                                                    return attribute.usage == vertexAttribute.usage;
+                                                                });
+
+                    if (layoutAttributeIterator == layoutAttributes.end())
+                    {
+                        Log(Log::Level::ERR) << "Vertex layout is missing an attribute used by the shader";
+                        [vertexDescriptor release];
+                        return nil;
+                    }
+
+                    MTLVertexFormat vertexFormat = getVertexFormat(layoutAttributeIterator->dataType);
+
+                    if (vertexFormat == MTLVertexFormatInvalid)
+                    {
+                        Log(Log::Level::ERR) << "Invalid vertex format";
+                        [vertexDescriptor release];
+                        return nil;
+                    }
+
+                    vertexDescriptor.attributes[index].format = vertexFormat;
+                    vertexDescriptor.attributes[index].offset = vertexLayout.getOffsets()[static_cast<size_t>(layoutAttributeIterator - layoutAttributes.begin())];
+                    vertexDescriptor.attributes[index].bufferIndex = 0;
+                    ++index;
+                }
+            }
+
+            vertexDescriptor.layouts[0].stride = vertexLayout.getStride();
+            vertexDescriptor.layouts[0].stepRate = 1;
+            vertexDescriptor.layouts[0].stepFunction = MTLVertexStepFunctionPerVertex;
+
+            return vertexDescriptor;
+        }
     } // namespace graphics
 } // namespace ouzel
 
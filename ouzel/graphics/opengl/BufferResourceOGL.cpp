@@ -199,6 +199,9 @@ namespace ouzel
                 case Buffer::Usage::VERTEX:
                     bufferType = GL_ARRAY_BUFFER;
                     break;
+                case Buffer::Usage::CONSTANT:
+                    bufferType = GL_UNIFORM_BUFFER;
+                    break;
                 default:
                     bufferType = 0;
                     Log(Log::Level::ERR) << "Unsupported buffer type";
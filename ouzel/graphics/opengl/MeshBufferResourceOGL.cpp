@@ -196,9 +196,9 @@ namespace ouzel
         }
 
         bool MeshBufferResourceOGL::init(uint32_t newIndexSize, BufferResource* newIndexBuffer,
-                                         BufferResource* newVertexBuffer)
+                                         BufferResource* newVertexBuffer, const VertexLayout& newVertexLayout)
         {
-            if (!MeshBufferResource::init(newIndexSize, newIndexBuffer, newVertexBuffer))
+            if (!MeshBufferResource::init(newIndexSize, newIndexBuffer, newVertexBuffer, newVertexLayout))
             {
                 return false;
             }
@@ -220,20 +220,29 @@ namespace ouzel
                     return false;
             }
 
-            vertexAttribs.clear();
+            // attributes are indexed by their location, the ones missing from the layout stay disabled
+            vertexAttribs.assign(MAX_VERTEX_ATTRIBUTE_COUNT, {0, 0, GL_FALSE, 0, nullptr});
 
-            GLuint offset = 0;
+            const std::vector<Vertex::Attribute>& attributes = vertexLayout.getAttributes();
+            const std::vector<uint32_t>& offsets = vertexLayout.getOffsets();
 
-            for (const Vertex::Attribute& vertexAttribute : Vertex::ATTRIBUTES)
+            for (size_t i = 0; i < attributes.size(); ++i)
             {
-                vertexAttribs.push_back({
-                    getArraySize(vertexAttribute.dataType),
-                    getVertexFormat(vertexAttribute.dataType),
-                    isNormalized(vertexAttribute.dataType),
-                    static_cast<GLsizei>(sizeof(Vertex)),
-                    static_cast<const GLchar*>(nullptr) + offset
-                });
-                offset += getDataTypeSize(vertexAttribute.dataType);
+                int32_t location = VertexLayout::getLocation(attributes[i].usage);
+
+                if (location < 0 || location >= static_cast<int32_t>(MAX_VERTEX_ATTRIBUTE_COUNT))
+                {
+                    Log(Log::Level::ERR) << "Unsupported vertex attribute usage";
+                    return false;
+                }
+
+                vertexAttribs[static_cast<size_t>(location)] = {
+                    getArraySize(attributes[i].dataType),
+                    getVertexFormat(attributes[i].dataType),
+                    isNormalized(attributes[i].dataType),
+                    static_cast<GLsizei>(vertexLayout.getStride()),
+                    static_cast<const GLchar*>(nullptr) + offsets[i]
+                };
             }
 
             indexBufferOGL = static_cast<BufferResourceOGL*>(indexBuffer);
@@ -326,7 +335,7 @@ namespace ouzel
 
                     for (GLuint index = 0; index < MAX_VERTEX_ATTRIBUTE_COUNT; ++index)
                     {
-                        if (index < vertexAttribs.size())
+                        if (index < vertexAttribs.size() && vertexAttribs[index].size)
                         {
                             glEnableVertexAttribArrayProc(index);
                             glVertexAttribPointerProc(index,
@@ -389,7 +398,7 @@ namespace ouzel
 
                 for (GLuint index = 0; index < MAX_VERTEX_ATTRIBUTE_COUNT; ++index)
                 {
-                    if (index < vertexAttribs.size())
+                    if (index < vertexAttribs.size() && vertexAttribs[index].size)
                     {
                         glEnableVertexAttribArrayProc(index);
                         glVertexAttribPointerProc(index,
@@ -415,6 +424,67 @@ namespace ouzel
             return true;
         }
 
+        bool MeshBufferResourceOGL::bindInstanceBuffer(BufferResourceOGL* instanceBufferOGL)
+        {
+            if (!renderDeviceOGL->bindBuffer(GL_ARRAY_BUFFER, instanceBufferOGL->getBufferId()))
+            {
+                return false;
+            }
+
+            const std::vector<Vertex::Attribute>& attributes = InstanceData::LAYOUT.getAttributes();
+            const std::vector<uint32_t>& offsets = InstanceData::LAYOUT.getOffsets();
+
+            for (size_t i = 0; i < attributes.size(); ++i)
+            {
+                GLuint location = static_cast<GLuint>(VertexLayout::getLocation(attributes[i].usage));
+                GLuint locationCount = VertexLayout::getLocationCount(attributes[i].dataType);
+
+                // matrices are passed as one vector per column
+                for (GLuint column = 0; column < locationCount; ++column)
+                {
+                    glEnableVertexAttribArrayProc(location + column);
+                    glVertexAttribPointerProc(location + column,
+                                              getArraySize(attributes[i].dataType) / static_cast<GLint>(locationCount),
+                                              getVertexFormat(attributes[i].dataType),
+                                              isNormalized(attributes[i].dataType),
+                                              static_cast<GLsizei>(InstanceData::LAYOUT.getStride()),
+                                              static_cast<const GLchar*>(nullptr) + offsets[i] + column * getDataTypeSize(attributes[i].dataType) / locationCount);
+                    glVertexAttribDivisorProc(location + column, 1);
+                }
+            }
+
+            if (RenderDeviceOGL::checkOpenGLError())
+            {
+                Log(Log::Level::ERR) << "Failed to set instance attributes";
+                return false;
+            }
+
+            return true;
+        }
+
+        bool MeshBufferResourceOGL::unbindInstanceBuffer()
+        {
+            for (const Vertex::Attribute& attribute : InstanceData::LAYOUT.getAttributes())
+            {
+                GLuint location = static_cast<GLuint>(VertexLayout::getLocation(attribute.usage));
+                GLuint locationCount = VertexLayout::getLocationCount(attribute.dataType);
+
+                for (GLuint column = 0; column < locationCount; ++column)
+                {
+                    glVertexAttribDivisorProc(location + column, 0);
+                    glDisableVertexAttribArrayProc(location + column);
+                }
+            }
+
+            if (RenderDeviceOGL::checkOpenGLError())
+            {
+                Log(Log::Level::ERR) << "Failed to reset instance attributes";
+                return false;
+            }
+
+            return true;
+        }
+
         bool MeshBufferResourceOGL::createVertexArray()
         {
             if (glGenVertexArraysProc) glGenVertexArraysProc(1, &vertexArrayId);
@@ -445,7 +515,7 @@ namespace ouzel
 
                     for (GLuint index = 0; index < MAX_VERTEX_ATTRIBUTE_COUNT; ++index)
                     {
-                        if (index < vertexAttribs.size())
+                        if (index < vertexAttribs.size() && vertexAttribs[index].size)
                         {
                             glEnableVertexAttribArrayProc(index);
                             glVertexAttribPointerProc(index,
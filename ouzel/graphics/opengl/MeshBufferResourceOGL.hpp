@@ -37,7 +37,7 @@ namespace ouzel
             virtual ~MeshBufferResourceOGL();
 
             virtual bool init(uint32_t newIndexSize, BufferResource* newIndexBuffer,
-                              BufferResource* newVertexBuffer) override;
+                              BufferResource* newVertexBuffer, const VertexLayout& newVertexLayout) override;
 
             virtual bool reload() override;
 
@@ -46,6 +46,9 @@ namespace ouzel
             virtual bool setVertexBuffer(BufferResource* newVertexBuffer) override;
 
             bool bindBuffers();
+            // sets up the InstanceData attributes with a divisor of one, must be called after bindBuffers
+            bool bindInstanceBuffer(BufferResourceOGL* instanceBufferOGL);
+            bool unbindInstanceBuffer();
 
             inline GLenum getIndexType() const { return indexType; }
             inline GLuint getBytesPerIndex() const { return bytesPerIndex; }
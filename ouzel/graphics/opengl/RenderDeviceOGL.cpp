@@ -36,6 +36,7 @@
 #include "RenderDeviceOGL.hpp"
 #include "TextureResourceOGL.hpp"
 #include "ShaderResourceOGL.hpp"
+#include "graphics/SharedConstants.hpp"
 #include "MeshBufferResourceOGL.hpp"
 #include "BufferResourceOGL.hpp"
 #include "BlendStateResourceOGL.hpp"
@@ -56,6 +57,7 @@
 #include "ColorVSGLES3.h"
 #include "TexturePSGLES3.h"
 #include "TextureVSGLES3.h"
+#include "TextureInstancedVSGLES3.h"
 #else
 #include "ColorPSGL2.h"
 #include "ColorVSGL2.h"
@@ -65,10 +67,12 @@
 #include "ColorVSGL3.h"
 #include "TexturePSGL3.h"
 #include "TextureVSGL3.h"
+#include "TextureInstancedVSGL3.h"
 #include "ColorPSGL4.h"
 #include "ColorVSGL4.h"
 #include "TexturePSGL4.h"
 #include "TextureVSGL4.h"
+#include "TextureInstancedVSGL4.h"
 #endif
 
 PFNGLBLENDFUNCSEPARATEPROC glBlendFuncSeparateProc;
@@ -141,6 +145,11 @@ PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArraysProc;
 PFNGLENABLEVERTEXATTRIBARRAYPROC glEnableVertexAttribArrayProc;
 PFNGLDISABLEVERTEXATTRIBARRAYPROC glDisableVertexAttribArrayProc;
 PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointerProc;
+PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisorProc;
+PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstancedProc;
+PFNGLBINDBUFFERBASEPROC glBindBufferBaseProc;
+PFNGLGETUNIFORMBLOCKINDEXPROC glGetUniformBlockIndexProc;
+PFNGLUNIFORMBLOCKBINDINGPROC glUniformBlockBindingProc;
 
 PFNGLGETSTRINGIPROC glGetStringiProc;
 
@@ -414,6 +423,13 @@ namespace ouzel
                 glMapBufferRangeProc = glMapBufferRangeEXT;
 
                 glRenderbufferStorageMultisampleProc = glRenderbufferStorageMultisampleAPPLE;
+
+                glVertexAttribDivisorProc = glVertexAttribDivisor;
+                glDrawElementsInstancedProc = glDrawElementsInstanced;
+
+                glBindBufferBaseProc = glBindBufferBase;
+                glGetUniformBlockIndexProc = glGetUniformBlockIndex;
+                glUniformBlockBindingProc = glUniformBlockBinding;
 #else
                 glUniform1uivProc = reinterpret_cast<PFNGLUNIFORM1UIVPROC>(getProcAddress("glUniform1uiv"));
                 glUniform2uivProc = reinterpret_cast<PFNGLUNIFORM2UIVPROC>(getProcAddress("glUniform2uiv"));
@@ -445,6 +461,13 @@ namespace ouzel
                 glMapBufferRangeProc = reinterpret_cast<PFNGLMAPBUFFERRANGEPROC>(getProcAddress("glMapBufferRange"));
                 glRenderbufferStorageMultisampleProc = reinterpret_cast<PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC>(getProcAddress("glRenderbufferStorageMultisample"));
 
+                glVertexAttribDivisorProc = reinterpret_cast<PFNGLVERTEXATTRIBDIVISORPROC>(getProcAddress("glVertexAttribDivisor"));
+                glDrawElementsInstancedProc = reinterpret_cast<PFNGLDRAWELEMENTSINSTANCEDPROC>(getProcAddress("glDrawElementsInstanced"));
+
+                glBindBufferBaseProc = reinterpret_cast<PFNGLBINDBUFFERBASEPROC>(getProcAddress("glBindBufferBase"));
+                glGetUniformBlockIndexProc = reinterpret_cast<PFNGLGETUNIFORMBLOCKINDEXPROC>(getProcAddress("glGetUniformBlockIndex"));
+                glUniformBlockBindingProc = reinterpret_cast<PFNGLUNIFORMBLOCKBINDINGPROC>(getProcAddress("glUniformBlockBinding"));
+
     #if OUZEL_SUPPORTS_OPENGLES
                 glFramebufferTexture2DMultisampleProc = reinterpret_cast<PFNGLFRAMEBUFFERTEXTURE2DMULTISAMPLEEXTPROC>(getProcAddress("glFramebufferTexture2DMultisample"));
     #endif
@@ -544,6 +567,39 @@ namespace ouzel
                 }
             }
 
+            // the created context can be newer than the requested version
+            GLint contextMajorVersion = apiMajorVersion;
+            GLint contextMinorVersion = apiMinorVersion;
+
+            if (apiMajorVersion >= 3)
+            {
+                glGetIntegerv(GL_MAJOR_VERSION, &contextMajorVersion);
+                glGetIntegerv(GL_MINOR_VERSION, &contextMinorVersion);
+
+                if (checkOpenGLError())
+                {
+                    Log(Log::Level::WARN) << "Failed to get OpenGL version";
+                    contextMajorVersion = apiMajorVersion;
+                    contextMinorVersion = apiMinorVersion;
+                }
+            }
+
+#if OUZEL_SUPPORTS_OPENGLES
+            // uniform buffer objects are core since OpenGL ES 3.0
+            constantBuffersSupported = contextMajorVersion >= 3;
+#else
+            // uniform buffer objects are core since OpenGL 3.1
+            constantBuffersSupported = contextMajorVersion > 3 || (contextMajorVersion == 3 && contextMinorVersion >= 1);
+#endif
+            constantBuffersSupported = constantBuffersSupported && glBindBufferBaseProc && glGetUniformBlockIndexProc && glUniformBlockBindingProc;
+
+            // the built-in shaders for OpenGL 3 and OpenGL ES 3 read the view projection from the camera constant buffer
+            if (apiMajorVersion >= 3 && !constantBuffersSupported)
+            {
+                Log(Log::Level::ERR) << "Uniform buffer objects are not supported";
+                return false;
+            }
+
             std::shared_ptr<Shader> textureShader = std::make_shared<Shader>();
 
             switch (apiMajorVersion)
@@ -561,7 +617,7 @@ namespace ouzel
                                         std::vector<uint8_t>(std::begin(TextureVSGLES3_glsl), std::end(TextureVSGLES3_glsl)),
                                         {Vertex::Attribute::Usage::POSITION, Vertex::Attribute::Usage::COLOR, Vertex::Attribute::Usage::TEXTURE_COORDINATES0},
                                         {{"color", DataType::FLOAT_VECTOR4}},
-                                        {{"modelViewProj", DataType::FLOAT_MATRIX4}});
+                                        {{"model", DataType::FLOAT_MATRIX4}});
                     break;
 #else
                 case 2:
@@ -576,14 +632,14 @@ namespace ouzel
                                         std::vector<uint8_t>(std::begin(TextureVSGL3_glsl), std::end(TextureVSGL3_glsl)),
                                         {Vertex::Attribute::Usage::POSITION, Vertex::Attribute::Usage::COLOR, Vertex::Attribute::Usage::TEXTURE_COORDINATES0},
                                         {{"color", DataType::FLOAT_VECTOR4}},
-                                        {{"modelViewProj", DataType::FLOAT_MATRIX4}});
+                                        {{"model", DataType::FLOAT_MATRIX4}});
                     break;
                 case 4:
                     textureShader->init(std::vector<uint8_t>(std::begin(TexturePSGL4_glsl), std::end(TexturePSGL4_glsl)),
                                         std::vector<uint8_t>(std::begin(TextureVSGL4_glsl), std::end(TextureVSGL4_glsl)),
                                         {Vertex::Attribute::Usage::POSITION, Vertex::Attribute::Usage::COLOR, Vertex::Attribute::Usage::TEXTURE_COORDINATES0},
                                         {{"color", DataType::FLOAT_VECTOR4}},
-                                        {{"modelViewProj", DataType::FLOAT_MATRIX4}});
+                                        {{"model", DataType::FLOAT_MATRIX4}});
                     break;
 #endif
                 default:
@@ -591,6 +647,7 @@ namespace ouzel
                     return false;
             }
 
+            textureShader->setCameraConstantsUsed(apiMajorVersion >= 3);
             engine->getCache()->setShader(SHADER_TEXTURE, textureShader);
 
             std::shared_ptr<Shader> colorShader = std::make_shared<Shader>();
@@ -611,7 +668,7 @@ namespace ouzel
                                       std::vector<uint8_t>(std::begin(ColorVSGLES3_glsl), std::end(ColorVSGLES3_glsl)),
                                       {Vertex::Attribute::Usage::POSITION, Vertex::Attribute::Usage::COLOR},
                                       {{"color", DataType::FLOAT_VECTOR4}},
-                                      {{"modelViewProj", DataType::FLOAT_MATRIX4}});
+                                      {{"model", DataType::FLOAT_MATRIX4}});
                     break;
 #else
                 case 2:
@@ -626,14 +683,14 @@ namespace ouzel
                                       std::vector<uint8_t>(std::begin(ColorVSGL3_glsl), std::end(ColorVSGL3_glsl)),
                                       {Vertex::Attribute::Usage::POSITION, Vertex::Attribute::Usage::COLOR},
                                       {{"color", DataType::FLOAT_VECTOR4}},
-                                      {{"modelViewProj", DataType::FLOAT_MATRIX4}});
+                                      {{"model", DataType::FLOAT_MATRIX4}});
                     break;
                 case 4:
                     colorShader->init(std::vector<uint8_t>(std::begin(ColorPSGL4_glsl), std::end(ColorPSGL4_glsl)),
                                       std::vector<uint8_t>(std::begin(ColorVSGL4_glsl), std::end(ColorVSGL4_glsl)),
                                       {Vertex::Attribute::Usage::POSITION, Vertex::Attribute::Usage::COLOR},
                                       {{"color", DataType::FLOAT_VECTOR4}},
-                                      {{"modelViewProj", DataType::FLOAT_MATRIX4}});
+                                      {{"model", DataType::FLOAT_MATRIX4}});
                     break;
 #endif
                 default:
@@ -641,8 +698,64 @@ namespace ouzel
                     return false;
             }
 
+            colorShader->setCameraConstantsUsed(apiMajorVersion >= 3);
             engine->getCache()->setShader(SHADER_COLOR, colorShader);
 
+#if OUZEL_SUPPORTS_OPENGLES
+            // instanced arrays are core since OpenGL ES 3.0
+            instancingSupported = contextMajorVersion >= 3;
+#else
+            // OpenGL 3.0-3.2 don't have instanced arrays in core
+            instancingSupported = contextMajorVersion > 3 || (contextMajorVersion == 3 && contextMinorVersion >= 3);
+#endif
+            // the entry points can be left over from an earlier context
+            instancingSupported = instancingSupported && glVertexAttribDivisorProc && glDrawElementsInstancedProc;
+
+            if (instancingSupported)
+            {
+                std::shared_ptr<Shader> textureInstancedShader = std::make_shared<Shader>();
+                bool textureInstancedShaderInitialized = false;
+
+                switch (apiMajorVersion)
+                {
+#if OUZEL_SUPPORTS_OPENGLES
+                    case 3:
+                        textureInstancedShaderInitialized = textureInstancedShader->init(std::vector<uint8_t>(std::begin(TexturePSGLES3_glsl), std::end(TexturePSGLES3_glsl)),
+                                                                                         std::vector<uint8_t>(std::begin(TextureInstancedVSGLES3_glsl), std::end(TextureInstancedVSGLES3_glsl)),
+                                                                                         {Vertex::Attribute::Usage::POSITION, Vertex::Attribute::Usage::COLOR, Vertex::Attribute::Usage::TEXTURE_COORDINATES0,
+                                                                                          Vertex::Attribute::Usage::INSTANCE_TRANSFORM, Vertex::Attribute::Usage::INSTANCE_COLOR},
+                                                                                         {{"color", DataType::FLOAT_VECTOR4}},
+                                                                                         {{"model", DataType::FLOAT_MATRIX4}});
+                        break;
+#else
+                    case 3:
+                        textureInstancedShaderInitialized = textureInstancedShader->init(std::vector<uint8_t>(std::begin(TexturePSGL3_glsl), std::end(TexturePSGL3_glsl)),
+                                                                                         std::vector<uint8_t>(std::begin(TextureInstancedVSGL3_glsl), std::end(TextureInstancedVSGL3_glsl)),
+                                                                                         {Vertex::Attribute::Usage::POSITION, Vertex::Attribute::Usage::COLOR, Vertex::Attribute::Usage::TEXTURE_COORDINATES0,
+                                                                                          Vertex::Attribute::Usage::INSTANCE_TRANSFORM, Vertex::Attribute::Usage::INSTANCE_COLOR},
+                                                                                         {{"color", DataType::FLOAT_VECTOR4}},
+                                                                                         {{"model", DataType::FLOAT_MATRIX4}});
+                        break;
+                    case 4:
+                        textureInstancedShaderInitialized = textureInstancedShader->init(std::vector<uint8_t>(std::begin(TexturePSGL4_glsl), std::end(TexturePSGL4_glsl)),
+                                                                                         std::vector<uint8_t>(std::begin(TextureInstancedVSGL4_glsl), std::end(TextureInstancedVSGL4_glsl)),
+                                                                                         {Vertex::Attribute::Usage::POSITION, Vertex::Attribute::Usage::COLOR, Vertex::Attribute::Usage::TEXTURE_COORDINATES0,
+                                                                                          Vertex::Attribute::Usage::INSTANCE_TRANSFORM, Vertex::Attribute::Usage::INSTANCE_COLOR},
+                                                                                         {{"color", DataType::FLOAT_VECTOR4}},
+                                                                                         {{"model", DataType::FLOAT_MATRIX4}});
+                        break;
+#endif
+                    default:
+                        break;
+                }
+
+                if (textureInstancedShaderInitialized)
+                {
+                    textureInstancedShader->setCameraConstantsUsed(true);
+                    engine->getCache()->setShader(SHADER_TEXTURE_INSTANCED, textureInstancedShader);
+                }
+            }
+
             glDisable(GL_DITHER);
             glDepthFunc(GL_LEQUAL);
 
@@ -786,6 +899,16 @@ namespace ouzel
 
         bool RenderDeviceOGL::draw(const std::vector<DrawCommand>& drawCommands)
         {
+            if (frameConstantBuffer)
+            {
+                BufferResourceOGL* frameConstantBufferOGL = static_cast<BufferResourceOGL*>(frameConstantBuffer);
+
+                if (!bindUniformBuffer(FRAME_CONSTANTS_SLOT, frameConstantBufferOGL->getBufferId()))
+                {
+                    return false;
+                }
+            }
+
             if (drawCommands.empty())
             {
                 frameBufferClearedFrame = currentFrame;
@@ -971,6 +1094,16 @@ namespace ouzel
                     }
                 }
 
+                if (drawCommand.cameraConstantBuffer)
+                {
+                    BufferResourceOGL* cameraConstantBufferOGL = static_cast<BufferResourceOGL*>(drawCommand.cameraConstantBuffer);
+
+                    if (!bindUniformBuffer(CAMERA_CONSTANTS_SLOT, cameraConstantBufferOGL->getBufferId()))
+                    {
+                        return false;
+                    }
+                }
+
                 // render target
                 GLuint newFrameBufferId = 0;
                 GLbitfield newClearMask = 0;
@@ -1097,15 +1230,50 @@ namespace ouzel
                     indexCount = (indexBufferOGL->getSize() / meshBufferOGL->getIndexSize()) - drawCommand.startIndex;
                 }
 
-                glDrawElements(mode,
-                               static_cast<GLsizei>(indexCount),
-                               meshBufferOGL->getIndexType(),
-                               static_cast<const char*>(nullptr) + (drawCommand.startIndex * meshBufferOGL->getBytesPerIndex()));
+                if (drawCommand.instanceCount)
+                {
+                    BufferResourceOGL* instanceBufferOGL = static_cast<BufferResourceOGL*>(drawCommand.instanceBuffer);
+
+                    if (!instanceBufferOGL || !instanceBufferOGL->getBufferId())
+                    {
+                        // don't render if invalid instance buffer
+                        continue;
+                    }
 
-                if (checkOpenGLError())
+                    if (!meshBufferOGL->bindInstanceBuffer(instanceBufferOGL))
+                    {
+                        return false;
+                    }
+
+                    glDrawElementsInstancedProc(mode,
+                                                static_cast<GLsizei>(indexCount),
+                                                meshBufferOGL->getIndexType(),
+                                                static_cast<const char*>(nullptr) + (drawCommand.startIndex * meshBufferOGL->getBytesPerIndex()),
+                                                static_cast<GLsizei>(drawCommand.instanceCount));
+
+                    if (checkOpenGLError())
+                    {
+                        Log(Log::Level::ERR) << "Failed to draw instanced elements";
+                        return false;
+                    }
+
+                    if (!meshBufferOGL->unbindInstanceBuffer())
+                    {
+                        return false;
+                    }
+                }
+                else
                 {
-                    Log(Log::Level::ERR) << "Failed to draw elements";
-                    return false;
+                    glDrawElements(mode,
+                                   static_cast<GLsizei>(indexCount),
+                                   meshBufferOGL->getIndexType(),
+                                   static_cast<const char*>(nullptr) + (drawCommand.startIndex * meshBufferOGL->getBytesPerIndex()));
+
+                    if (checkOpenGLError())
+                    {
+                        Log(Log::Level::ERR) << "Failed to draw elements";
+                        return false;
+                    }
                 }
             }
 
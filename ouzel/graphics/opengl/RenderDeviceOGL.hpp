@@ -95,6 +95,11 @@ extern PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArraysProc;
 extern PFNGLENABLEVERTEXATTRIBARRAYPROC glEnableVertexAttribArrayProc;
 extern PFNGLDISABLEVERTEXATTRIBARRAYPROC glDisableVertexAttribArrayProc;
 extern PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointerProc;
+extern PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisorProc;
+extern PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstancedProc;
+extern PFNGLBINDBUFFERBASEPROC glBindBufferBaseProc;
+extern PFNGLGETUNIFORMBLOCKINDEXPROC glGetUniformBlockIndexProc;
+extern PFNGLUNIFORMBLOCKBINDINGPROC glUniformBlockBindingProc;
 
 extern PFNGLGETSTRINGIPROC glGetStringiProc;
 
@@ -232,6 +237,26 @@ namespace ouzel
                 return true;
             }
 
+            inline bool bindUniformBuffer(GLuint index, GLuint bufferId)
+            {
+                GLuint& currentBufferId = stateCache.uniformBufferId[index];
+
+                if (currentBufferId != bufferId)
+                {
+                    glBindBufferBaseProc(GL_UNIFORM_BUFFER, index, bufferId);
+                    currentBufferId = bufferId;
+                    stateCache.bufferId[GL_UNIFORM_BUFFER] = bufferId; // also binds the generic binding point
+
+                    if (checkOpenGLError())
+                    {
+                        Log(Log::Level::ERR) << "Failed to bind uniform buffer";
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
             inline bool bindVertexArray(GLuint vertexArrayId)
             {
                 if (stateCache.vertexArrayId != vertexArrayId)
@@ -555,6 +580,10 @@ namespace ouzel
                 if (elementArrayBufferId == bufferId) elementArrayBufferId = 0;
                 GLuint& arrayBufferId = stateCache.bufferId[GL_ARRAY_BUFFER];
                 if (arrayBufferId == bufferId) arrayBufferId = 0;
+                GLuint& uniformBufferId = stateCache.bufferId[GL_UNIFORM_BUFFER];
+                if (uniformBufferId == bufferId) uniformBufferId = 0;
+                for (auto& indexedBufferId : stateCache.uniformBufferId)
+                    if (indexedBufferId.second == bufferId) indexedBufferId.second = 0;
                 glDeleteBuffersProc(1, &bufferId);
             }
 
@@ -668,6 +697,7 @@ namespace ouzel
                 GLuint frameBufferId = 0;
 
                 std::map<GLuint, GLuint> bufferId;
+                std::map<GLuint, GLuint> uniformBufferId; // indexed GL_UNIFORM_BUFFER bindings
                 GLuint vertexArrayId = 0;
 
                 bool blendEnabled = false;
@@ -7,6 +7,7 @@
 
 #include "ShaderResourceOGL.hpp"
 #include "RenderDeviceOGL.hpp"
+#include "graphics/SharedConstants.hpp"
 #include "utils/Log.hpp"
 
 namespace ouzel
@@ -194,14 +195,22 @@ namespace ouzel
                         case Vertex::Attribute::Usage::TEXTURE_COORDINATES1:
                             name = "texCoord1";
                             break;
+                        case Vertex::Attribute::Usage::INSTANCE_TRANSFORM:
+                            name = "instanceTransform0";
+                            break;
+                        case Vertex::Attribute::Usage::INSTANCE_COLOR:
+                            name = "instanceColor0";
+                            break;
                         default:
                             Log(Log::Level::ERR) << "Invalid vertex attribute usage";
                             return false;
                     }
 
                     glBindAttribLocationProc(programId, index, name);
-                    ++index;
                 }
+
+                // locations are fixed so that mesh buffers can set them up without knowing the shader
+                index += VertexLayout::getLocationCount(vertexAttribute.dataType);
             }
 
             glLinkProgramProc(programId);
@@ -232,6 +241,22 @@ namespace ouzel
                 return false;
             }
 
+            // shared constant buffers are bound to fixed binding points
+            if (glGetUniformBlockIndexProc && glUniformBlockBindingProc)
+            {
+                GLuint frameConstantsIndex = glGetUniformBlockIndexProc(programId, "FrameConstants");
+                if (frameConstantsIndex != GL_INVALID_INDEX) glUniformBlockBindingProc(programId, frameConstantsIndex, FRAME_CONSTANTS_SLOT);
+
+                GLuint cameraConstantsIndex = glGetUniformBlockIndexProc(programId, "CameraConstants");
+                if (cameraConstantsIndex != GL_INVALID_INDEX) glUniformBlockBindingProc(programId, cameraConstantsIndex, CAMERA_CONSTANTS_SLOT);
+
+                if (RenderDeviceOGL::checkOpenGLError())
+                {
+                    Log(Log::Level::ERR) << "Failed to set uniform block bindings";
+                    return false;
+                }
+            }
+
             renderDeviceOGL->useProgram(programId);
 
             GLint texture0Location = glGetUniformLocationProc(programId, "texture0");
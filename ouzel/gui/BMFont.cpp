@@ -1,17 +1,26 @@
 // Copyright (C) 2018 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <limits>
 #include <string>
 #include <iterator>
 #include "BMFont.hpp"
 #include "core/Engine.hpp"
 #include "files/FileSystem.hpp"
+#include "files/MappedFile.hpp"
 #include "assets/Cache.hpp"
 #include "utils/Log.hpp"
+#include "utils/OBF.hpp"
 #include "utils/Utils.hpp"
 
 namespace ouzel
 {
+    // compiled fonts are OBF dictionaries with the characters and the kerning pairs packed in byte arrays
+    static const char* FORMAT = "bmfont";
+    static const uint32_t VERSION = 1;
+    static const uint32_t CHAR_SIZE = sizeof(uint32_t) + 8 * sizeof(int16_t);
+    static const uint32_t KERNING_SIZE = 2 * sizeof(uint32_t) + sizeof(int16_t);
+
     static inline bool isWhitespace(uint8_t c)
     {
         return c == ' ' || c == '\t';
@@ -27,14 +36,14 @@ namespace ouzel
         return c <= 0x1F;
     }
 
-    static bool skipWhitespaces(const std::vector<uint8_t>& str,
-                                std::vector<uint8_t>::const_iterator& iterator)
+    static bool skipWhitespaces(const uint8_t*& iterator,
+                                const uint8_t* end)
     {
-        if (iterator == str.end()) return false;
+        if (iterator == end) return false;
 
         for (;;)
         {
-            if (iterator == str.end()) break;
+            if (iterator == end) break;
 
             if (isWhitespace(*iterator))
                 ++iterator;
@@ -45,12 +54,12 @@ namespace ouzel
         return true;
     }
 
-    static void skipLine(const std::vector<uint8_t>& str,
-                         std::vector<uint8_t>::const_iterator& iterator)
+    static void skipLine(const uint8_t*& iterator,
+                         const uint8_t* end)
     {
         for (;;)
         {
-            if (iterator == str.end()) break;
+            if (iterator == end) break;
 
             if (isNewline(*iterator))
             {
@@ -62,27 +71,30 @@ namespace ouzel
         }
     }
 
-    static bool parseString(const std::vector<uint8_t>& str,
-                            std::vector<uint8_t>::const_iterator& iterator,
+    static bool parseString(const uint8_t*& iterator,
+                            const uint8_t* end,
                             std::string& result)
     {
         result.clear();
 
+        if (iterator == end) return false;
+
         if (*iterator == '"')
         {
             ++iterator;
 
             for (;;)
             {
+                if (iterator == end) return false; // unterminated string
+
                 if (*iterator == '"' &&
-                    (iterator + 1 == str.end() ||
+                    (iterator + 1 == end ||
                      isWhitespace(*(iterator + 1)) ||
-                     isNewline((*(iterator + 1)))))
+                     isNewline(*(iterator + 1))))
                 {
                     ++iterator;
                     break;
                 }
-                if (iterator == str.end()) return false;
 
                 result.push_back(static_cast<char>(*iterator));
 
@@ -95,7 +107,7 @@ namespace ouzel
         {
             for (;;)
             {
-                if (iterator == str.end() || isControlChar(*iterator) || isWhitespace(*iterator) || *iterator == '=') break;
+                if (iterator == end || isControlChar(*iterator) || isWhitespace(*iterator) || *iterator == '=') break;
 
                 result.push_back(static_cast<char>(*iterator));
 
@@ -106,39 +118,38 @@ namespace ouzel
         }
     }
 
-    static bool parseInt(const std::vector<uint8_t>& str,
-                         std::vector<uint8_t>::const_iterator& iterator,
-                         std::string& result)
+    static bool parseInt(const uint8_t*& iterator,
+                         const uint8_t* end,
+                         int32_t& result)
     {
-        result.clear();
-        uint32_t length = 1;
+        bool negative = false;
 
-        if (iterator != str.end() && *iterator == '-')
+        if (iterator != end && *iterator == '-')
         {
-            result.push_back(static_cast<char>(*iterator));
-            ++length;
+            negative = true;
             ++iterator;
         }
 
-        for (;;)
-        {
-            if (iterator == str.end() || *iterator < '0' || *iterator > '9') break;
+        if (iterator == end || *iterator < '0' || *iterator > '9') return false;
 
-            result.push_back(static_cast<char>(*iterator));
+        int64_t value = 0;
 
-            ++iterator;
+        for (; iterator != end && *iterator >= '0' && *iterator <= '9'; ++iterator)
+        {
+            value = value * 10 + (*iterator - '0');
+            if (value > std::numeric_limits<int32_t>::max()) return false;
         }
 
-        if (result.length() < length) return false;
+        result = static_cast<int32_t>(negative ? -value : value);
 
         return true;
     }
 
-    static bool parseToken(const std::vector<uint8_t>& str,
-                           std::vector<uint8_t>::const_iterator& iterator,
+    static bool parseToken(const uint8_t*& iterator,
+                           const uint8_t* end,
                            char token)
     {
-        if (iterator == str.end() || *iterator != static_cast<uint8_t>(token)) return false;
+        if (iterator == end || *iterator != static_cast<uint8_t>(token)) return false;
 
         ++iterator;
 
@@ -156,26 +167,46 @@ namespace ouzel
 
     bool BMFont::init(const std::string& filename, bool mipmaps)
     {
-        std::vector<uint8_t> data;
-        if (!engine->getFileSystem()->readFile(filename, data))
+        MappedFile file;
+        if (!engine->getFileSystem()->mapFile(filename, file))
         {
             return false;
         }
 
-        return init(data, mipmaps);
+        return init(file.getData(), file.getSize(), mipmaps);
     }
 
     bool BMFont::init(const std::vector<uint8_t>& data, bool mipmaps)
     {
-        std::vector<uint8_t>::const_iterator iterator = data.begin();
+        return init(data.data(), static_cast<uint32_t>(data.size()), mipmaps);
+    }
+
+    bool BMFont::init(const uint8_t* data, uint32_t size, bool mipmaps)
+    {
+        if (!parse(data, size)) return false;
+
+        if (!pageFilename.empty())
+            fontTexture = engine->getCache()->getTexture(pageFilename, mipmaps);
+
+        return true;
+    }
+
+    bool BMFont::parse(const uint8_t* data, uint32_t size)
+    {
+        obf::View root(data, size);
+        if (root.getType() == obf::Value::Type::DICTIONARY) return parseCompiled(root);
+
+        const uint8_t* iterator = data;
+        const uint8_t* end = data + size;
 
         std::string keyword;
         std::string key;
         std::string value;
+        int32_t intValue;
 
         for (;;)
         {
-            if (iterator == data.end()) break;
+            if (iterator == end) break;
 
             if (isNewline(*iterator))
             {
@@ -184,8 +215,8 @@ namespace ouzel
             }
             else
             {
-                if (!skipWhitespaces(data, iterator) ||
-                    !parseString(data, iterator, keyword))
+                if (!skipWhitespaces(iterator, end) ||
+                    !parseString(iterator, end, keyword))
                 {
                     Log(Log::Level::ERR) << "Failed to parse keyword";
                     return false;
@@ -195,17 +226,17 @@ namespace ouzel
                 {
                     for (;;)
                     {
-                        if (iterator == data.end() || isNewline(*iterator)) break;
+                        if (iterator == end || isNewline(*iterator)) break;
 
-                        if (!skipWhitespaces(data, iterator) ||
-                            !parseString(data, iterator, key))
+                        if (!skipWhitespaces(iterator, end) ||
+                            !parseString(iterator, end, key))
                         {
                             Log(Log::Level::ERR) << "Failed to parse page";
                             return false;
                         }
 
-                        if (!parseToken(data, iterator, '=') ||
-                            !parseString(data, iterator, value))
+                        if (!parseToken(iterator, end, '=') ||
+                            !parseString(iterator, end, value))
                         {
                             Log(Log::Level::ERR) << "Failed to parse page";
                             return false;
@@ -213,7 +244,7 @@ namespace ouzel
 
                         if (key == "file")
                         {
-                            fontTexture = engine->getCache()->getTexture(value, mipmaps);
+                            pageFilename = value;
                         }
                     }
                 }
@@ -221,16 +252,16 @@ namespace ouzel
                 {
                     for (;;)
                     {
-                        if (iterator == data.end() || isNewline(*iterator)) break;
+                        if (iterator == end || isNewline(*iterator)) break;
 
-                        if (!skipWhitespaces(data, iterator) ||
-                            !parseString(data, iterator, key))
+                        if (!skipWhitespaces(iterator, end) ||
+                            !parseString(iterator, end, key))
                         {
                             Log(Log::Level::ERR) << "Failed to parse common";
                             return false;
                         }
 
-                        if (!parseToken(data, iterator, '='))
+                        if (!parseToken(iterator, end, '='))
                         {
                             Log(Log::Level::ERR) << "Failed to parse common";
                             return false;
@@ -238,67 +269,67 @@ namespace ouzel
 
                         if (key == "lineHeight")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse lineHeight";
                                 return false;
                             }
 
-                            lineHeight = static_cast<uint16_t>(std::stoi(value));
+                            lineHeight = static_cast<uint16_t>(intValue);
                         }
                         else if (key == "base")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse base";
                                 return false;
                             }
 
-                            base = static_cast<uint16_t>(std::stoi(value));
+                            base = static_cast<uint16_t>(intValue);
                         }
                         else if (key == "scaleW")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse scaleW";
                                 return false;
                             }
 
-                            width = static_cast<uint16_t>(std::stoi(value));
+                            width = static_cast<uint16_t>(intValue);
                         }
                         else if (key == "scaleH")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse scaleH";
                                 return false;
                             }
 
-                            height = static_cast<uint16_t>(std::stoi(value));
+                            height = static_cast<uint16_t>(intValue);
                         }
                         else if (key == "pages")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse pages";
                                 return false;
                             }
 
-                            pages = static_cast<uint16_t>(std::stoi(value));
+                            pages = static_cast<uint16_t>(intValue);
                         }
                         else if (key == "outline")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse outline";
                                 return false;
                             }
 
-                            outline = static_cast<uint16_t>(std::stoi(value));
+                            outline = static_cast<uint16_t>(intValue);
                         }
                         else
                         {
-                            if (!parseString(data, iterator, value))
+                            if (!parseString(iterator, end, value))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse common";
                                 return false;
@@ -313,16 +344,16 @@ namespace ouzel
 
                     for (;;)
                     {
-                        if (iterator == data.end() || isNewline(*iterator)) break;
+                        if (iterator == end || isNewline(*iterator)) break;
 
-                        if (!skipWhitespaces(data, iterator) ||
-                            !parseString(data, iterator, key))
+                        if (!skipWhitespaces(iterator, end) ||
+                            !parseString(iterator, end, key))
                         {
                             Log(Log::Level::ERR) << "Failed to parse char";
                             return false;
                         }
 
-                        if (!parseToken(data, iterator, '='))
+                        if (!parseToken(iterator, end, '='))
                         {
                             Log(Log::Level::ERR) << "Failed to parse char";
                             return false;
@@ -330,97 +361,97 @@ namespace ouzel
 
                         if (key == "id")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse id";
                                 return false;
                             }
 
-                            charId = static_cast<uint32_t>(std::stoul(value));
+                            charId = static_cast<uint32_t>(intValue);
                         }
                         else if (key == "x")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse x";
                                 return false;
                             }
 
-                            c.x = static_cast<int16_t>(std::stoi(value));
+                            c.x = static_cast<int16_t>(intValue);
                         }
                         else if (key == "y")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse y";
                                 return false;
                             }
 
-                            c.y = static_cast<int16_t>(std::stoi(value));
+                            c.y = static_cast<int16_t>(intValue);
                         }
                         else if (key == "width")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse width";
                                 return false;
                             }
 
-                            c.width = static_cast<int16_t>(std::stoi(value));
+                            c.width = static_cast<int16_t>(intValue);
                         }
                         else if (key == "height")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse height";
                                 return false;
                             }
 
-                            c.height = static_cast<int16_t>(std::stoi(value));
+                            c.height = static_cast<int16_t>(intValue);
                         }
                         else if (key == "xoffset")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse xoffset";
                                 return false;
                             }
 
-                            c.xOffset = static_cast<int16_t>(std::stoi(value));
+                            c.xOffset = static_cast<int16_t>(intValue);
                         }
                         else if (key == "yoffset")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse yoffset";
                                 return false;
                             }
 
-                            c.yOffset = static_cast<int16_t>(std::stoi(value));
+                            c.yOffset = static_cast<int16_t>(intValue);
                         }
                         else if (key == "xadvance")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse xadvance";
                                 return false;
                             }
 
-                            c.xAdvance = static_cast<int16_t>(std::stoi(value));
+                            c.xAdvance = static_cast<int16_t>(intValue);
                         }
                         else if (key == "page")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse page";
                                 return false;
                             }
 
-                            c.page = static_cast<int16_t>(std::stoi(value));
+                            c.page = static_cast<int16_t>(intValue);
                         }
                         else
                         {
-                            if (!parseString(data, iterator, value))
+                            if (!parseString(iterator, end, value))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse char";
                                 return false;
@@ -434,16 +465,16 @@ namespace ouzel
                 {
                     for (;;)
                     {
-                        if (iterator == data.end() || isNewline(*iterator)) break;
+                        if (iterator == end || isNewline(*iterator)) break;
 
-                        if (!skipWhitespaces(data, iterator) ||
-                            !parseString(data, iterator, key))
+                        if (!skipWhitespaces(iterator, end) ||
+                            !parseString(iterator, end, key))
                         {
                             Log(Log::Level::ERR) << "Failed to parse kernings";
                             return false;
                         }
 
-                        if (!parseToken(data, iterator, '='))
+                        if (!parseToken(iterator, end, '='))
                         {
                             Log(Log::Level::ERR) << "Failed to parse kernings";
                             return false;
@@ -451,17 +482,17 @@ namespace ouzel
 
                         if (key == "count")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse count";
                                 return false;
                             }
 
-                            kernCount = static_cast<uint16_t>(std::stoi(value));
+                            kernCount = static_cast<uint16_t>(intValue);
                         }
                         else
                         {
-                            if (!parseString(data, iterator, value))
+                            if (!parseString(iterator, end, value))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse kernings";
                                 return false;
@@ -476,16 +507,16 @@ namespace ouzel
 
                     for (;;)
                     {
-                        if (iterator == data.end() || isNewline(*iterator)) break;
+                        if (iterator == end || isNewline(*iterator)) break;
 
-                        if (!skipWhitespaces(data, iterator) ||
-                            !parseString(data, iterator, key))
+                        if (!skipWhitespaces(iterator, end) ||
+                            !parseString(iterator, end, key))
                         {
                             Log(Log::Level::ERR) << "Failed to parse kerning";
                             return false;
                         }
 
-                        if (!parseToken(data, iterator, '='))
+                        if (!parseToken(iterator, end, '='))
                         {
                             Log(Log::Level::ERR) << "Failed to parse kerning";
                             return false;
@@ -493,37 +524,37 @@ namespace ouzel
 
                         if (key == "first")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse lineHeight";
                                 return false;
                             }
 
-                            first = static_cast<uint32_t>(std::stoul(value));
+                            first = static_cast<uint32_t>(intValue);
                         }
                         else if (key == "second")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse base";
                                 return false;
                             }
 
-                            second = static_cast<uint32_t>(std::stoul(value));
+                            second = static_cast<uint32_t>(intValue);
                         }
                         else if (key == "amount")
                         {
-                            if (!parseInt(data, iterator, value))
+                            if (!parseInt(iterator, end, intValue))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse scaleW";
                                 return false;
                             }
 
-                            amount = static_cast<int16_t>(std::stoi(value));
+                            amount = static_cast<int16_t>(intValue);
                         }
                         else
                         {
-                            if (!parseString(data, iterator, value))
+                            if (!parseString(iterator, end, value))
                             {
                                 Log(Log::Level::ERR) << "Failed to parse kerning";
                                 return false;
@@ -535,7 +566,7 @@ namespace ouzel
                 }
                 else
                 {
-                    skipLine(data, iterator);
+                    skipLine(iterator, end);
                 }
             }
         }
@@ -543,12 +574,129 @@ namespace ouzel
         return true;
     }
 
+    bool BMFont::parseCompiled(const obf::View& root)
+    {
+        obf::View format = root["format"];
+        obf::View version = root["version"];
+
+        if (!format.isStringType() || format.asString() != FORMAT) return false;
+
+        if (!version.isIntType() || version.asUInt32() != VERSION)
+        {
+            Log(Log::Level::ERR) << "Unsupported compiled font version";
+            return false;
+        }
+
+        obf::View page = root["page"];
+        obf::View common = root["common"];
+        obf::View charData = root["chars"];
+        obf::View kerningData = root["kernings"];
+
+        if (!page.isStringType() ||
+            common.getType() != obf::Value::Type::ARRAY || common.getSize() != 7 ||
+            charData.getType() != obf::Value::Type::BYTE_ARRAY || charData.getByteArraySize() % CHAR_SIZE != 0 ||
+            kerningData.getType() != obf::Value::Type::BYTE_ARRAY || kerningData.getByteArraySize() % KERNING_SIZE != 0)
+        {
+            Log(Log::Level::ERR) << "Invalid compiled font";
+            return false;
+        }
+
+        uint16_t* commonValues[] = {&lineHeight, &base, &width, &height, &pages, &outline, &kernCount};
+
+        for (uint32_t i = 0; i < 7; ++i)
+        {
+            obf::View value = common.getElement(i);
+            if (!value.isIntType()) return false;
+            *commonValues[i] = value.asUInt16();
+        }
+
+        pageFilename = page.asString();
+
+        // characters and kerning pairs are stored as packed big endian records
+        const uint8_t* charIterator = charData.getByteArrayData();
+        uint32_t charCount = charData.getByteArraySize() / CHAR_SIZE;
+
+        chars.clear();
+        chars.reserve(charCount);
+
+        for (uint32_t i = 0; i < charCount; ++i, charIterator += CHAR_SIZE)
+        {
+            CharDescriptor c;
+            c.x = decodeInt16Big(charIterator + 4);
+            c.y = decodeInt16Big(charIterator + 6);
+            c.width = decodeInt16Big(charIterator + 8);
+            c.height = decodeInt16Big(charIterator + 10);
+            c.xOffset = decodeInt16Big(charIterator + 12);
+            c.yOffset = decodeInt16Big(charIterator + 14);
+            c.xAdvance = decodeInt16Big(charIterator + 16);
+            c.page = decodeInt16Big(charIterator + 18);
+
+            chars[decodeUInt32Big(charIterator)] = c;
+        }
+
+        const uint8_t* kerningIterator = kerningData.getByteArrayData();
+        uint32_t kerningCount = kerningData.getByteArraySize() / KERNING_SIZE;
+
+        kern.clear();
+
+        for (uint32_t i = 0; i < kerningCount; ++i, kerningIterator += KERNING_SIZE)
+        {
+            kern[std::make_pair(decodeUInt32Big(kerningIterator), decodeUInt32Big(kerningIterator + 4))] = decodeInt16Big(kerningIterator + 8);
+        }
+
+        return true;
+    }
+
+    bool BMFont::bake(std::vector<uint8_t>& result) const
+    {
+        obf::Value root = obf::Value::Type::DICTIONARY;
+        root["format"] = std::string(FORMAT);
+        root["version"] = VERSION;
+        root["page"] = pageFilename;
+
+        obf::Value common = obf::Value::Type::ARRAY;
+        for (uint16_t value : {lineHeight, base, width, height, pages, outline, kernCount})
+            common.append(value);
+        root["common"] = common;
+
+        std::vector<uint8_t> charData(chars.size() * CHAR_SIZE);
+        uint8_t* charIterator = charData.data();
+
+        for (const auto& i : chars)
+        {
+            const CharDescriptor& c = i.second;
+            encodeUInt32Big(charIterator, i.first);
+            int16_t values[] = {c.x, c.y, c.width, c.height, c.xOffset, c.yOffset, c.xAdvance, c.page};
+            for (uint32_t v = 0; v < 8; ++v)
+                encodeUInt16Big(charIterator + 4 + v * sizeof(int16_t), static_cast<uint16_t>(values[v]));
+            charIterator += CHAR_SIZE;
+        }
+
+        root["chars"] = charData;
+
+        std::vector<uint8_t> kerningData(kern.size() * KERNING_SIZE);
+        uint8_t* kerningIterator = kerningData.data();
+
+        for (const auto& i : kern)
+        {
+            encodeUInt32Big(kerningIterator, i.first.first);
+            encodeUInt32Big(kerningIterator + 4, i.first.second);
+            encodeUInt16Big(kerningIterator + 8, static_cast<uint16_t>(i.second));
+            kerningIterator += KERNING_SIZE;
+        }
+
+        root["kernings"] = kerningData;
+
+        result.clear();
+        return root.encode(result) != 0;
+    }
+
     bool BMFont::getVertices(const std::string& text,
                              const Color& color,
                              float fontSize,
                              const Vector2& anchor,
                              std::vector<uint16_t>& indices,
-                             std::vector<graphics::Vertex>& vertices,
+                             std::vector<graphics::TextureVertex>& vertices,
                              std::shared_ptr<graphics::Texture>& texture)
     {
         Vector2 position;
@@ -593,14 +741,14 @@ namespace ouzel
                 textCoords[2] = Vector2(leftTop.x, leftTop.y);
                 textCoords[3] = Vector2(rightBottom.x, leftTop.y);
 
-                vertices.push_back(graphics::Vertex(Vector3(position.x + f.xOffset, -position.y - f.yOffset - f.height, 0.0f),
-                                                    color, textCoords[0], Vector3(0.0f, 0.0f, -1.0f)));
-                vertices.push_back(graphics::Vertex(Vector3(position.x + f.xOffset + f.width, -position.y - f.yOffset - f.height, 0.0f),
-                                                    color, textCoords[1], Vector3(0.0f, 0.0f, -1.0f)));
-                vertices.push_back(graphics::Vertex(Vector3(position.x + f.xOffset, -position.y - f.yOffset, 0.0f),
-                                                    color, textCoords[2], Vector3(0.0f, 0.0f, -1.0f)));
-                vertices.push_back(graphics::Vertex(Vector3(position.x + f.xOffset + f.width, -position.y - f.yOffset, 0.0f),
-                                                    color, textCoords[3], Vector3(0.0f, 0.0f, -1.0f)));
+                vertices.push_back(graphics::TextureVertex(Vector3(position.x + f.xOffset, -position.y - f.yOffset - f.height, 0.0f),
+                                                           color, textCoords[0]));
+                vertices.push_back(graphics::TextureVertex(Vector3(position.x + f.xOffset + f.width, -position.y - f.yOffset - f.height, 0.0f),
+                                                           color, textCoords[1]));
+                vertices.push_back(graphics::TextureVertex(Vector3(position.x + f.xOffset, -position.y - f.yOffset, 0.0f),
+                                                           color, textCoords[2]));
+                vertices.push_back(graphics::TextureVertex(Vector3(position.x + f.xOffset + f.width, -position.y - f.yOffset, 0.0f),
+                                                           color, textCoords[3]));
 
                 if ((i + 1) != utf32Text.end())
                 {
@@ -7,6 +7,11 @@
 
 namespace ouzel
 {
+    namespace obf
+    {
+        class View;
+    }
+
     class BMFont: public Font
     {
     public:
@@ -15,16 +20,24 @@ namespace ouzel
 
         bool init(const std::string& filename, bool mipmaps = true);
         bool init(const std::vector<uint8_t>& data, bool mipmaps = true);
+        bool init(const uint8_t* data, uint32_t size, bool mipmaps = true);
+
+        // parses either a BMFont text descriptor or a compiled font, the page texture is not loaded
+        bool parse(const uint8_t* data, uint32_t size);
+        // encodes the font in the compiled (OBF) format
+        bool bake(std::vector<uint8_t>& result) const;
 
         virtual bool getVertices(const std::string& text,
                                  const Color& color,
                                  float fontSize,
                                  const Vector2& anchor,
                                  std::vector<uint16_t>& indices,
-                                 std::vector<graphics::Vertex>& vertices,
+                                 std::vector<graphics::TextureVertex>& vertices,
                                  std::shared_ptr<graphics::Texture>& texture) override;
 
     protected:
+        bool parseCompiled(const obf::View& root);
+
         int16_t getKerningPair(uint32_t, uint32_t);
         float getStringWidth(const std::string& text);
 
@@ -49,6 +62,7 @@ namespace ouzel
         uint16_t kernCount = 0;
         std::unordered_map<uint32_t, CharDescriptor> chars;
         std::map<std::pair<uint32_t, uint32_t>, int16_t> kern;
+        std::string pageFilename;
         std::shared_ptr<graphics::Texture> fontTexture;
     };
 }
@@ -21,11 +21,15 @@ namespace ouzel
 
         void Menu::enter()
         {
+            Widget::enter();
+
             engine->getEventDispatcher()->addEventHandler(&eventHandler);
         }
 
         void Menu::leave()
         {
+            Widget::leave();
+
             eventHandler.remove();
         }
 
@@ -43,9 +43,15 @@ namespace ouzel
     }
 
     bool TTFont::init(const std::vector<uint8_t>& newData, bool newMipmaps)
+    {
+        return init(newData.data(), static_cast<uint32_t>(newData.size()), newMipmaps);
+    }
+
+    bool TTFont::init(const uint8_t* newData, uint32_t newDataSize, bool newMipmaps)
     {
         loaded = false;
-        data = newData;
+        // stb_truetype reads the glyphs from the font data, so it has to be kept
+        data.assign(newData, newData + newDataSize);
         mipmaps = newMipmaps;
 
         if (!stbtt_InitFont(&font, data.data(), stbtt_GetFontOffsetForIndex(data.data(), 0)))
@@ -64,7 +70,7 @@ namespace ouzel
                              float fontSize,
                              const Vector2& anchor,
                              std::vector<uint16_t>& indices,
-                             std::vector<graphics::Vertex>& vertices,
+                             std::vector<graphics::TextureVertex>& vertices,
                              std::shared_ptr<graphics::Texture>& texture)
     {
         if (!loaded) return false;
@@ -208,14 +214,14 @@ namespace ouzel
                 textCoords[2] = Vector2(leftTop.x, leftTop.y);
                 textCoords[3] = Vector2(rightBottom.x, leftTop.y);
 
-                vertices.push_back(graphics::Vertex(Vector3(position.x + f.offset.x, -position.y - f.offset.y - f.height, 0.0f),
-                                                    color, textCoords[0], Vector3(0.0f, 0.0f, -1.0f)));
-                vertices.push_back(graphics::Vertex(Vector3(position.x + f.offset.x + f.width, -position.y - f.offset.y - f.height, 0.0f),
-                                                    color, textCoords[1], Vector3(0.0f, 0.0f, -1.0f)));
-                vertices.push_back(graphics::Vertex(Vector3(position.x + f.offset.x, -position.y - f.offset.y, 0.0f),
-                                                    color, textCoords[2], Vector3(0.0f, 0.0f, -1.0f)));
-                vertices.push_back(graphics::Vertex(Vector3(position.x + f.offset.x + f.width, -position.y - f.offset.y, 0.0f),
-                                                    color, textCoords[3], Vector3(0.0f, 0.0f, -1.0f)));
+                vertices.push_back(graphics::TextureVertex(Vector3(position.x + f.offset.x, -position.y - f.offset.y - f.height, 0.0f),
+                                                           color, textCoords[0]));
+                vertices.push_back(graphics::TextureVertex(Vector3(position.x + f.offset.x + f.width, -position.y - f.offset.y - f.height, 0.0f),
+                                                           color, textCoords[1]));
+                vertices.push_back(graphics::TextureVertex(Vector3(position.x + f.offset.x, -position.y - f.offset.y, 0.0f),
+                                                           color, textCoords[2]));
+                vertices.push_back(graphics::TextureVertex(Vector3(position.x + f.offset.x + f.width, -position.y - f.offset.y, 0.0f),
+                                                           color, textCoords[3]));
 
                 if ((i + 1) != utf32Text.end())
                 {
@@ -16,13 +16,14 @@ namespace ouzel
 
         bool init(const std::string& filename, bool newMipmaps = true);
         bool init(const std::vector<uint8_t>& newData, bool newMipmaps = true);
+        bool init(const uint8_t* newData, uint32_t newDataSize, bool newMipmaps = true);
 
         virtual bool getVertices(const std::string& text,
                                  const Color& color,
                                  float fontSize,
                                  const Vector2& anchor,
                                  std::vector<uint16_t>& indices,
-                                 std::vector<graphics::Vertex>& vertices,
+                                 std::vector<graphics::TextureVertex>& vertices,
                                  std::shared_ptr<graphics::Texture>& texture) override;
 
     protected:
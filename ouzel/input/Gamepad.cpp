@@ -44,17 +44,15 @@ namespace ouzel
 
         void Gamepad::handleButtonValueChange(GamepadButton button, bool pressed, float value)
         {
-            Event event;
-            event.type = Event::Type::GAMEPAD_BUTTON_CHANGE;
+            GamepadEvent gamepadEvent;
+            gamepadEvent.gamepad = this;
+            gamepadEvent.button = button;
+            gamepadEvent.previousPressed = buttonStates[static_cast<uint32_t>(button)].pressed;
+            gamepadEvent.pressed = pressed;
+            gamepadEvent.value = value;
+            gamepadEvent.previousValue = buttonStates[static_cast<uint32_t>(button)].value;
 
-            event.gamepadEvent.gamepad = this;
-            event.gamepadEvent.button = button;
-            event.gamepadEvent.previousPressed = buttonStates[static_cast<uint32_t>(button)].pressed;
-            event.gamepadEvent.pressed = pressed;
-            event.gamepadEvent.value = value;
-            event.gamepadEvent.previousValue = buttonStates[static_cast<uint32_t>(button)].value;
-
-            engine->getEventDispatcher()->postEvent(event);
+            engine->getEventDispatcher()->postEvent(Event::Type::GAMEPAD_BUTTON_CHANGE, gamepadEvent);
 
             buttonStates[static_cast<uint32_t>(button)].pressed = pressed;
             buttonStates[static_cast<uint32_t>(button)].value = value;
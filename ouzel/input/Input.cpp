@@ -14,7 +14,11 @@ namespace ouzel
 {
     namespace input
     {
-        Input::Input()
+        // the oldest positions are dropped if more moves than this are received during one update
+        static const size_t MAX_MOVE_HISTORY = 256;
+
+        Input::Input():
+            moveCoalescing(false)
         {
             std::fill(std::begin(keyboardKeyStates), std::end(keyboardKeyStates), false);
             std::fill(std::begin(mouseButtonStates), std::end(mouseButtonStates), false);
@@ -122,22 +126,20 @@ namespace ouzel
 
         void Input::keyPress(KeyboardKey key, uint32_t modifiers)
         {
-            Event event;
+            KeyboardEvent keyboardEvent;
 
-            event.keyboardEvent.key = key;
-            event.keyboardEvent.modifiers = modifiers;
+            keyboardEvent.key = key;
+            keyboardEvent.modifiers = modifiers;
 
             if (!keyboardKeyStates[static_cast<uint32_t>(key)])
             {
                 keyboardKeyStates[static_cast<uint32_t>(key)] = true;
 
-                event.type = Event::Type::KEY_PRESS;
-                engine->getEventDispatcher()->postEvent(event);
+                engine->getEventDispatcher()->postEvent(Event::Type::KEY_PRESS, keyboardEvent);
             }
             else
             {
-                event.type = Event::Type::KEY_REPEAT;
-                engine->getEventDispatcher()->postEvent(event);
+                engine->getEventDispatcher()->postEvent(Event::Type::KEY_REPEAT, keyboardEvent);
             }
         }
 
@@ -145,55 +147,80 @@ namespace ouzel
         {
             keyboardKeyStates[static_cast<uint32_t>(key)] = false;
 
-            Event event;
-            event.type = Event::Type::KEY_RELEASE;
-
-            event.keyboardEvent.key = key;
-            event.keyboardEvent.modifiers = modifiers;
+            KeyboardEvent keyboardEvent;
+            keyboardEvent.key = key;
+            keyboardEvent.modifiers = modifiers;
 
-            engine->getEventDispatcher()->postEvent(event);
+            engine->getEventDispatcher()->postEvent(Event::Type::KEY_RELEASE, keyboardEvent);
         }
 
         void Input::mouseButtonPress(MouseButton button, const Vector2& position, uint32_t modifiers)
         {
-            mouseButtonStates[static_cast<uint32_t>(button)] = true;
+            {
+                Lock lock(moveMutex);
+                postMouseMove(); // the merged move happened before this event
+            }
 
-            Event event;
-            event.type = Event::Type::MOUSE_PRESS;
+            mouseButtonStates[static_cast<uint32_t>(button)] = true;
 
-            event.mouseEvent.button = button;
-            event.mouseEvent.position = position;
-            event.mouseEvent.modifiers = modifiers;
+            MouseEvent mouseEvent;
+            mouseEvent.button = button;
+            mouseEvent.position = position;
+            mouseEvent.modifiers = modifiers;
 
-            engine->getEventDispatcher()->postEvent(event);
+            engine->getEventDispatcher()->postEvent(Event::Type::MOUSE_PRESS, mouseEvent);
         }
 
         void Input::mouseButtonRelease(MouseButton button, const Vector2& position, uint32_t modifiers)
         {
-            mouseButtonStates[static_cast<uint32_t>(button)] = false;
+            {
+                Lock lock(moveMutex);
+                postMouseMove();
+            }
 
-            Event event;
-            event.type = Event::Type::MOUSE_RELEASE;
+            mouseButtonStates[static_cast<uint32_t>(button)] = false;
 
-            event.mouseEvent.button = button;
-            event.mouseEvent.position = position;
-            event.mouseEvent.modifiers = modifiers;
+            MouseEvent mouseEvent;
+            mouseEvent.button = button;
+            mouseEvent.position = position;
+            mouseEvent.modifiers = modifiers;
 
-            engine->getEventDispatcher()->postEvent(event);
+            engine->getEventDispatcher()->postEvent(Event::Type::MOUSE_RELEASE, mouseEvent);
         }
 
         void Input::mouseMove(const Vector2& position, uint32_t modifiers)
         {
-            Event event;
-            event.type = Event::Type::MOUSE_MOVE;
+            Vector2 difference = position - cursorPosition;
+            cursorPosition = position;
 
-            event.mouseEvent.difference = position - cursorPosition;
-            event.mouseEvent.position = position;
-            event.mouseEvent.modifiers = modifiers;
+            if (moveCoalescing)
+            {
+                Lock lock(moveMutex);
 
-            cursorPosition = position;
+                if (!mouseMovePending)
+                {
+                    mouseMovePending = true;
+                    mouseMoveDifference = Vector2();
+                    engine->getFramePacer()->wake();
+                }
+
+                mouseMoveDifference += difference;
+                mouseMovePosition = position;
+                mouseMoveModifiers = modifiers;
+
+                if (pendingMouseMoveHistory.size() >= MAX_MOVE_HISTORY)
+                    pendingMouseMoveHistory.erase(pendingMouseMoveHistory.begin());
+                pendingMouseMoveHistory.push_back(position);
+            }
+            else
+            {
+                MouseEvent mouseEvent;
+                mouseEvent.difference = difference;
+                mouseEvent.position = position;
+                mouseEvent.modifiers = modifiers;
 
-            engine->getEventDispatcher()->postEvent(event);
+                engine->getEventDispatcher()->postEvent(Event::Type::MOUSE_MOVE, mouseEvent);
+            }
         }
 
         void Input::mouseRelativeMove(const Vector2& relativePosition, uint32_t modifiers)
@@ -208,38 +235,47 @@ namespace ouzel
 
         void Input::mouseScroll(const Vector2& scroll, const Vector2& position, uint32_t modifiers)
         {
-            Event event;
-            event.type = Event::Type::MOUSE_SCROLL;
+            {
+                Lock lock(moveMutex);
+                postMouseMove();
+            }
 
-            event.mouseEvent.position = position;
-            event.mouseEvent.scroll = scroll;
-            event.mouseEvent.modifiers = modifiers;
+            MouseEvent mouseEvent;
+            mouseEvent.position = position;
+            mouseEvent.scroll = scroll;
+            mouseEvent.modifiers = modifiers;
 
-            engine->getEventDispatcher()->postEvent(event);
+            engine->getEventDispatcher()->postEvent(Event::Type::MOUSE_SCROLL, mouseEvent);
         }
 
         void Input::touchBegin(uint64_t touchId, const Vector2& position, float force)
         {
-            Event event;
-            event.type = Event::Type::TOUCH_BEGIN;
+            {
+                Lock lock(moveMutex);
+                postTouchMove(touchId);
+            }
 
-            event.touchEvent.touchId = touchId;
-            event.touchEvent.position = position;
-            event.touchEvent.force = force;
+            TouchEvent touchEvent;
+            touchEvent.touchId = touchId;
+            touchEvent.position = position;
+            touchEvent.force = force;
 
             touchPositions[touchId] = position;
 
-            engine->getEventDispatcher()->postEvent(event);
+            engine->getEventDispatcher()->postEvent(Event::Type::TOUCH_BEGIN, touchEvent);
         }
 
         void Input::touchEnd(uint64_t touchId, const Vector2& position, float force)
         {
-            Event event;
-            event.type = Event::Type::TOUCH_END;
+            {
+                Lock lock(moveMutex);
+                postTouchMove(touchId);
+            }
 
-            event.touchEvent.touchId = touchId;
-            event.touchEvent.position = position;
-            event.touchEvent.force = force;
+            TouchEvent touchEvent;
+            touchEvent.touchId = touchId;
+            touchEvent.position = position;
+            touchEvent.force = force;
 
             auto i = touchPositions.find(touchId);
 
@@ -248,32 +284,61 @@ namespace ouzel
                 touchPositions.erase(i);
             }
 
-            engine->getEventDispatcher()->postEvent(event);
+            engine->getEventDispatcher()->postEvent(Event::Type::TOUCH_END, touchEvent);
         }
 
         void Input::touchMove(uint64_t touchId, const Vector2& position, float force)
         {
-            Event event;
-            event.type = Event::Type::TOUCH_MOVE;
+            Vector2 difference = position - touchPositions[touchId];
+            touchPositions[touchId] = position;
 
-            event.touchEvent.touchId = touchId;
-            event.touchEvent.difference = position - touchPositions[touchId];
-            event.touchEvent.position = position;
-            event.touchEvent.force = force;
+            if (moveCoalescing)
+            {
+                Lock lock(moveMutex);
 
-            touchPositions[touchId] = position;
+                auto i = std::find_if(touchMoves.begin(), touchMoves.end(), [touchId](const TouchMove& touchMove) {
+                    return touchMove.touchId == touchId;
+                });
 
-            engine->getEventDispatcher()->postEvent(event);
+                if (i == touchMoves.end())
+                {
+                    TouchMove touchMove;
+                    touchMove.touchId = touchId;
+                    i = touchMoves.insert(touchMoves.end(), touchMove);
+                    engine->getFramePacer()->wake();
+                }
+
+                i->difference += difference;
+                i->position = position;
+                i->force = force;
+
+                if (pendingTouchMoveHistory.size() >= MAX_MOVE_HISTORY)
+                    pendingTouchMoveHistory.erase(pendingTouchMoveHistory.begin());
+                pendingTouchMoveHistory.push_back(std::make_pair(touchId, position));
+            }
+            else
+            {
+                TouchEvent touchEvent;
+                touchEvent.touchId = touchId;
+                touchEvent.difference = difference;
+                touchEvent.position = position;
+                touchEvent.force = force;
+
+                engine->getEventDispatcher()->postEvent(Event::Type::TOUCH_MOVE, touchEvent);
+            }
         }
 
         void Input::touchCancel(uint64_t touchId, const Vector2& position, float force)
         {
-            Event event;
-            event.type = Event::Type::TOUCH_CANCEL;
+            {
+                Lock lock(moveMutex);
+                postTouchMove(touchId);
+            }
 
-            event.touchEvent.touchId = touchId;
-            event.touchEvent.position = position;
-            event.touchEvent.force = force;
+            TouchEvent touchEvent;
+            touchEvent.touchId = touchId;
+            touchEvent.position = position;
+            touchEvent.force = force;
 
             auto i = touchPositions.find(touchId);
 
@@ -282,7 +347,74 @@ namespace ouzel
                 touchPositions.erase(i);
             }
 
-            engine->getEventDispatcher()->postEvent(event);
+            engine->getEventDispatcher()->postEvent(Event::Type::TOUCH_CANCEL, touchEvent);
+        }
+
+        void Input::setMoveCoalescing(bool coalescing)
+        {
+            // the moves that are already merged are posted by the next flushMoves call
+            moveCoalescing = coalescing;
+        }
+
+        void Input::flushMoves()
+        {
+            Lock lock(moveMutex);
+
+            postMouseMove();
+
+            for (const TouchMove& touchMove : touchMoves)
+            {
+                TouchEvent touchEvent;
+                touchEvent.touchId = touchMove.touchId;
+                touchEvent.difference = touchMove.difference;
+                touchEvent.position = touchMove.position;
+                touchEvent.force = touchMove.force;
+
+                engine->getEventDispatcher()->postEvent(Event::Type::TOUCH_MOVE, touchEvent);
+            }
+
+            touchMoves.clear();
+
+            // the history is read on the update thread, so it is handed over only here
+            mouseMoveHistory.swap(pendingMouseMoveHistory);
+            pendingMouseMoveHistory.clear();
+            touchMoveHistory.swap(pendingTouchMoveHistory);
+            pendingTouchMoveHistory.clear();
+        }
+
+        void Input::postMouseMove()
+        {
+            if (mouseMovePending)
+            {
+                MouseEvent mouseEvent;
+                mouseEvent.difference = mouseMoveDifference;
+                mouseEvent.position = mouseMovePosition;
+                mouseEvent.modifiers = mouseMoveModifiers;
+
+                mouseMovePending = false;
+
+                engine->getEventDispatcher()->postEvent(Event::Type::MOUSE_MOVE, mouseEvent);
+            }
+        }
+
+        void Input::postTouchMove(uint64_t touchId)
+        {
+            auto i = std::find_if(touchMoves.begin(), touchMoves.end(), [touchId](const TouchMove& touchMove) {
+                return touchMove.touchId == touchId;
+            });
+
+            if (i != touchMoves.end())
+            {
+                TouchEvent touchEvent;
+                touchEvent.touchId = i->touchId;
+                touchEvent.difference = i->difference;
+                touchEvent.position = i->position;
+                touchEvent.force = i->force;
+
+                touchMoves.erase(i);
+
+                engine->getEventDispatcher()->postEvent(Event::Type::TOUCH_MOVE, touchEvent);
+            }
         }
 
         bool Input::showVirtualKeyboard()
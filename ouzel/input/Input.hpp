@@ -3,9 +3,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <unordered_map>
+#include <utility>
 #include "math/Vector2.hpp"
 #include "thread/Mutex.hpp"
 
@@ -273,10 +275,25 @@ namespace ouzel
             virtual bool showVirtualKeyboard();
             virtual bool hideVirtualKeyboard();
 
+            // merges the mouse and touch moves into one event per pointer per update, the differences are accumulated
+            void setMoveCoalescing(bool coalescing);
+            inline bool isMoveCoalescing() const { return moveCoalescing; }
+
+            // positions of the moves received before the current update, oldest first,
+            // recorded only while the moves are coalesced
+            inline const std::vector<Vector2>& getMouseMoveHistory() const { return mouseMoveHistory; }
+            inline const std::vector<std::pair<uint64_t, Vector2>>& getTouchMoveHistory() const { return touchMoveHistory; }
+
         protected:
             Input();
             virtual bool init();
 
+            // called by the engine on the update thread before the events are dispatched
+            void flushMoves();
+            // post the merged moves, must be called with moveMutex locked
+            void postMouseMove();
+            void postTouchMove(uint64_t touchId);
+
             void setCurrentCursor(Cursor* cursor);
             virtual void activateCursorResource(CursorResource* resource);
             virtual CursorResource* createCursorResource();
@@ -287,6 +304,26 @@ namespace ouzel
             bool mouseButtonStates[static_cast<uint32_t>(MouseButton::BUTTON_COUNT)];
 
             std::unordered_map<uint64_t, Vector2> touchPositions;
+
+            struct TouchMove
+            {
+                uint64_t touchId = 0;
+                Vector2 difference;
+                Vector2 position;
+                float force = 0.0f;
+            };
+
+            std::atomic<bool> moveCoalescing;
+            Mutex moveMutex;
+            bool mouseMovePending = false;
+            uint32_t mouseMoveModifiers = 0;
+            Vector2 mouseMoveDifference;
+            Vector2 mouseMovePosition;
+            std::vector<TouchMove> touchMoves;
+            std::vector<Vector2> pendingMouseMoveHistory;
+            std::vector<std::pair<uint64_t, Vector2>> pendingTouchMoveHistory;
+            std::vector<Vector2> mouseMoveHistory;
+            std::vector<std::pair<uint64_t, Vector2>> touchMoveHistory;
             std::vector<std::unique_ptr<Gamepad>> gamepads;
 
             Mutex resourceMutex;
@@ -26,8 +26,12 @@
 #include "assets/LoaderVorbis.hpp"
 #include "assets/LoaderWave.hpp"
 #include "audio/Audio.hpp"
+#include "audio/Effect.hpp"
+#include "audio/Filter.hpp"
+#include "audio/Limiter.hpp"
 #include "audio/Listener.hpp"
 #include "audio/Mixer.hpp"
+#include "audio/Reverb.hpp"
 #include "audio/Sound.hpp"
 #include "audio/SoundData.hpp"
 #include "audio/SoundDataVorbis.hpp"
@@ -36,8 +40,11 @@
 #include "audio/SoundOutput.hpp"
 #include "core/Setup.h"
 #include "core/Engine.hpp"
+#include "core/FramePacer.hpp"
+#include "core/Profiler.hpp"
 #include "core/Timer.hpp"
 #include "core/UpdateCallback.hpp"
+#include "core/UpdateScheduler.hpp"
 #include "core/Window.hpp"
 #include "events/Event.hpp"
 #include "events/EventDispatcher.hpp"
@@ -45,6 +52,7 @@
 #include "files/Archive.hpp"
 #include "files/File.hpp"
 #include "files/FileSystem.hpp"
+#include "files/MappedFile.hpp"
 #include "graphics/BlendState.hpp"
 #include "graphics/BlendStateResource.hpp"
 #include "graphics/ImageData.hpp"
@@ -58,6 +66,7 @@
 #include "graphics/Renderer.hpp"
 #include "graphics/RenderResource.hpp"
 #include "graphics/Shader.hpp"
+#include "graphics/SharedConstants.hpp"
 #include "graphics/ShaderResource.hpp"
 #include "graphics/Texture.hpp"
 #include "graphics/TextureResource.hpp"
@@ -101,17 +110,22 @@
 #include "scene/Component.hpp"
 #include "scene/Layer.hpp"
 #include "scene/Light.hpp"
+#include "scene/MeshOptimizer.hpp"
 #include "scene/ModelData.hpp"
+#include "scene/InstancedModelRenderer.hpp"
 #include "scene/ModelRenderer.hpp"
 #include "scene/ParticleSystemData.hpp"
 #include "scene/ParticleSystem.hpp"
 #include "scene/Scene.hpp"
+#include "scene/AnimationSystem.hpp"
 #include "scene/SceneManager.hpp"
 #include "scene/ShapeRenderer.hpp"
 #include "scene/Sprite.hpp"
 #include "scene/SpriteData.hpp"
 #include "scene/TextRenderer.hpp"
 #include "thread/Condition.hpp"
+#include "thread/ExecuteQueue.hpp"
+#include "thread/JobSystem.hpp"
 #include "thread/Lock.hpp"
 #include "thread/Mutex.hpp"
 #include "thread/Thread.hpp"
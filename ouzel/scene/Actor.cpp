@@ -6,6 +6,7 @@
 #include "core/Engine.hpp"
 #include "SceneManager.hpp"
 #include "Layer.hpp"
+#include "Scene.hpp"
 #include "Camera.hpp"
 #include "math/MathUtils.hpp"
 #include "Component.hpp"
@@ -352,6 +353,13 @@ namespace ouzel
             ownedComponents.clear();
         }
 
+        void Actor::leave()
+        {
+            ActorContainer::leave();
+
+            if (layer && layer->getScene()) layer->getScene()->releaseActor(this);
+        }
+
         void Actor::setLayer(Layer* newLayer)
         {
             ActorContainer::setLayer(newLayer);
@@ -151,6 +151,7 @@ namespace ouzel
             bool removeChildComponent(Component* component);
 
             virtual void setLayer(Layer* newLayer) override;
+            virtual void leave() override;
 
             void updateLocalTransform();
             void updateTransform(const Matrix4& newParentTransform);
@@ -189,8 +190,6 @@ namespace ouzel
 
             std::vector<Component*> components;
             std::vector<std::unique_ptr<Component>> ownedComponents;
-
-            UpdateCallback animationUpdateCallback;
         };
     } // namespace scene
 } // namespace ouzel
@@ -0,0 +1,142 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include "AnimationSystem.hpp"
+#include "animators/Animator.hpp"
+#include "ParticleSystem.hpp"
+#include "Sprite.hpp"
+
+namespace ouzel
+{
+    namespace scene
+    {
+        template<class T>
+        void AnimationSystem::UpdateList<T>::add(AnimationSystem* system, T* object)
+        {
+            if (object->animationSystem == system) return;
+            if (object->animationSystem) object->animationSystem->remove(object);
+
+            object->animationSystem = system;
+            object->animationIndex = static_cast<uint32_t>(objects.size());
+            objects.push_back(object);
+            ++count;
+        }
+
+        template<class T>
+        void AnimationSystem::UpdateList<T>::remove(AnimationSystem* system, T* object)
+        {
+            if (object->animationSystem != system) return;
+
+            objects[object->animationIndex] = nullptr;
+            object->animationSystem = nullptr;
+            object->animationIndex = INVALID_INDEX;
+            --count;
+        }
+
+        template<class T>
+        void AnimationSystem::UpdateList<T>::compact()
+        {
+            if (count == objects.size()) return;
+
+            // keep the order in which the objects were added
+            uint32_t index = 0;
+            for (T* object : objects)
+            {
+                if (object)
+                {
+                    object->animationIndex = index;
+                    objects[index++] = object;
+                }
+            }
+
+            objects.resize(index);
+        }
+
+        template<class T>
+        void AnimationSystem::UpdateList<T>::clear()
+        {
+            for (T* object : objects)
+            {
+                if (object)
+                {
+                    object->animationSystem = nullptr;
+                    object->animationIndex = INVALID_INDEX;
+                }
+            }
+
+            objects.clear();
+            count = 0;
+        }
+
+        AnimationSystem::AnimationSystem()
+        {
+        }
+
+        AnimationSystem::~AnimationSystem()
+        {
+            animators.clear();
+            sprites.clear();
+            particleSystems.clear();
+        }
+
+        void AnimationSystem::update(float delta)
+        {
+            // objects added during the update are advanced starting with the next frame
+            size_t animatorCount = animators.objects.size();
+            for (size_t i = 0; i < animatorCount; ++i)
+            {
+                Animator* animator = animators.objects[i];
+                if (!animator) continue;
+
+                animator->update(delta);
+                if (!animator->isRunning()) animators.remove(this, animator);
+            }
+
+            size_t spriteCount = sprites.objects.size();
+            for (size_t i = 0; i < spriteCount; ++i)
+            {
+                if (Sprite* sprite = sprites.objects[i]) sprite->update(delta);
+            }
+
+            size_t particleSystemCount = particleSystems.objects.size();
+            for (size_t i = 0; i < particleSystemCount; ++i)
+            {
+                if (ParticleSystem* particleSystem = particleSystems.objects[i]) particleSystem->update(delta);
+            }
+
+            animators.compact();
+            sprites.compact();
+            particleSystems.compact();
+        }
+
+        void AnimationSystem::addAnimator(Animator* animator)
+        {
+            animators.add(this, animator);
+        }
+
+        void AnimationSystem::removeAnimator(Animator* animator)
+        {
+            animators.remove(this, animator);
+        }
+
+        void AnimationSystem::addSprite(Sprite* sprite)
+        {
+            sprites.add(this, sprite);
+        }
+
+        void AnimationSystem::removeSprite(Sprite* sprite)
+        {
+            sprites.remove(this, sprite);
+        }
+
+        void AnimationSystem::addParticleSystem(ParticleSystem* particleSystem)
+        {
+            particleSystems.add(this, particleSystem);
+        }
+
+        void AnimationSystem::removeParticleSystem(ParticleSystem* particleSystem)
+        {
+            particleSystems.remove(this, particleSystem);
+        }
+    } // namespace scene
+} // namespace ouzel
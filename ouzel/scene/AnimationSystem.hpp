@@ -0,0 +1,71 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ouzel
+{
+    namespace scene
+    {
+        class Animator;
+        class ParticleSystem;
+        class Sprite;
+
+        // advances all running animators, sprites and particle systems once per frame
+        class AnimationSystem final
+        {
+        public:
+            static const uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+            AnimationSystem();
+            ~AnimationSystem();
+
+            AnimationSystem(const AnimationSystem&) = delete;
+            AnimationSystem& operator=(const AnimationSystem&) = delete;
+
+            AnimationSystem(AnimationSystem&&) = delete;
+            AnimationSystem& operator=(AnimationSystem&&) = delete;
+
+            void update(float delta);
+
+            void addAnimator(Animator* animator);
+            void removeAnimator(Animator* animator);
+
+            void addSprite(Sprite* sprite);
+            void removeSprite(Sprite* sprite);
+
+            void addParticleSystem(ParticleSystem* particleSystem);
+            void removeParticleSystem(ParticleSystem* particleSystem);
+
+            inline size_t getAnimatorCount() const { return animators.count; }
+            inline size_t getSpriteCount() const { return sprites.count; }
+            inline size_t getParticleSystemCount() const { return particleSystems.count; }
+
+        private:
+            // objects are kept in a dense array and know their own index, so adding and removing is O(1),
+            // removed objects leave a hole that is compacted after the update so that iteration stays valid
+            template<class T> struct UpdateList
+            {
+                void add(AnimationSystem* system, T* object);
+                void remove(AnimationSystem* system, T* object);
+                void compact();
+                void clear();
+
+                std::vector<T*> objects;
+                size_t count = 0;
+            };
+
+            void remove(Animator* animator) { removeAnimator(animator); }
+            void remove(Sprite* sprite) { removeSprite(sprite); }
+            void remove(ParticleSystem* particleSystem) { removeParticleSystem(particleSystem); }
+
+            UpdateList<Animator> animators;
+            UpdateList<Sprite> sprites;
+            UpdateList<ParticleSystem> particleSystems;
+        };
+    } // namespace scene
+} // namespace ouzel
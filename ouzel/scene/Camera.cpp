@@ -7,6 +7,7 @@
 #include "core/Engine.hpp"
 #include "graphics/Renderer.hpp"
 #include "graphics/RenderDevice.hpp"
+#include "graphics/SharedConstants.hpp"
 #include "Layer.hpp"
 #include "graphics/TextureResource.hpp"
 #include "math/Matrix4.hpp"
@@ -180,9 +181,38 @@ namespace ouzel
                 renderViewProjection = engine->getRenderer()->getDevice()->getProjectionTransform(renderTarget != nullptr) * renderViewProjection;
 
                 viewProjectionDirty = false;
+                constantBufferDirty = true;
             }
         }
 
+        const std::shared_ptr<graphics::Buffer>& Camera::getConstantBuffer() const
+        {
+            if (viewProjectionDirty)
+            {
+                calculateViewProjection();
+            }
+
+            if (constantBufferDirty && engine->getRenderer()->getDevice()->isConstantBuffersSupported())
+            {
+                graphics::CameraConstants cameraConstants;
+                cameraConstants.viewProjection = renderViewProjection;
+
+                if (!constantBuffer)
+                {
+                    constantBuffer = std::make_shared<graphics::Buffer>();
+                    constantBuffer->init(graphics::Buffer::Usage::CONSTANT, &cameraConstants, sizeof(cameraConstants), graphics::Buffer::DYNAMIC);
+                }
+                else
+                {
+                    constantBuffer->setData(&cameraConstants, sizeof(cameraConstants));
+                }
+
+                constantBufferDirty = false;
+            }
+
+            return constantBuffer;
+        }
+
         Vector3 Camera::convertNormalizedToWorld(const Vector2& normalizedPosition) const
         {
             // convert window normalized to viewport clip position
@@ -8,6 +8,7 @@
 #include "math/MathUtils.hpp"
 #include "math/Rect.hpp"
 #include "graphics/Texture.hpp"
+#include "graphics/Buffer.hpp"
 
 namespace ouzel
 {
@@ -60,6 +61,9 @@ namespace ouzel
             const Matrix4& getRenderViewProjection() const;
             const Matrix4& getInverseViewProjection() const;
 
+            // CameraConstants with the render view projection, null if the render device has no constant buffers
+            const std::shared_ptr<graphics::Buffer>& getConstantBuffer() const;
+
             Vector3 convertNormalizedToWorld(const Vector2& normalizedPosition) const;
             Vector2 convertWorldToNormalized(const Vector3& worldPosition) const;
 
@@ -124,6 +128,9 @@ namespace ouzel
             mutable bool inverseViewProjectionDirty = true;
             mutable Matrix4 inverseViewProjection;
 
+            mutable bool constantBufferDirty = true;
+            mutable std::shared_ptr<graphics::Buffer> constantBuffer;
+
             std::shared_ptr<graphics::Texture> renderTarget;
         };
     } // namespace scene
@@ -35,7 +35,8 @@ namespace ouzel
                 SOUND = 7,
                 SPRITE = 8,
                 TEXT_RENDERER = 9,
-                LIGHT = 10
+                LIGHT = 10,
+                INSTANCED_MODEL_RENDERER = 11
             };
 
             explicit Component(uint32_t initType);
@@ -0,0 +1,174 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include "InstancedModelRenderer.hpp"
+#include "core/Engine.hpp"
+#include "graphics/RenderDevice.hpp"
+#include "utils/Utils.hpp"
+
+namespace ouzel
+{
+    namespace scene
+    {
+        InstancedModelRenderer::InstancedModelRenderer():
+            Component(TYPE)
+        {
+            whitePixelTexture = engine->getCache()->getTexture(graphics::TEXTURE_WHITE_PIXEL);
+            instancedShader = engine->getCache()->getShader(graphics::SHADER_TEXTURE_INSTANCED);
+
+            instanceBuffer = std::make_shared<graphics::Buffer>();
+            instanceBuffer->init(graphics::Buffer::Usage::VERTEX, graphics::Buffer::DYNAMIC);
+        }
+
+        InstancedModelRenderer::InstancedModelRenderer(const ModelData& modelData):
+            InstancedModelRenderer()
+        {
+            init(modelData);
+        }
+
+        bool InstancedModelRenderer::init(const ModelData& modelData)
+        {
+            modelBoundingBox = modelData.boundingBox;
+            material = modelData.material;
+            meshBuffer = modelData.meshBuffer;
+            indexBuffer = modelData.indexBuffer;
+            vertexBuffer = modelData.vertexBuffer;
+            positionTransform = modelData.positionTransform;
+            dirty = true;
+
+            updateBoundingBox();
+
+            return true;
+        }
+
+        void InstancedModelRenderer::addInstance(const Matrix4& transform, Color color)
+        {
+            instances.push_back(graphics::InstanceData(transform, color));
+            dirty = true;
+
+            updateBoundingBox();
+        }
+
+        void InstancedModelRenderer::setInstances(const std::vector<graphics::InstanceData>& newInstances)
+        {
+            instances = newInstances;
+            dirty = true;
+
+            updateBoundingBox();
+        }
+
+        void InstancedModelRenderer::clearInstances()
+        {
+            instances.clear();
+            dirty = true;
+
+            updateBoundingBox();
+        }
+
+        void InstancedModelRenderer::updateBoundingBox()
+        {
+            boundingBox.reset();
+
+            if (modelBoundingBox.isEmpty()) return;
+
+            Vector3 corners[8];
+            modelBoundingBox.getCorners(corners);
+
+            for (const graphics::InstanceData& instance : instances)
+            {
+                for (Vector3 corner : corners)
+                {
+                    instance.transform.transformPoint(corner);
+                    boundingBox.insertPoint(corner);
+                }
+            }
+        }
+
+        void InstancedModelRenderer::draw(const Matrix4& transformMatrix,
+                                          float opacity,
+                                          const Matrix4& renderViewProjection,
+                                          const std::shared_ptr<graphics::Texture>& renderTarget,
+                                          const Rect& renderViewport,
+                                          bool depthWrite,
+                                          bool depthTest,
+                                          bool wireframe,
+                                          bool scissorTest,
+                                          const Rect& scissorRectangle)
+        {
+            Component::draw(transformMatrix,
+                            opacity,
+                            renderViewProjection,
+                            renderTarget,
+                            renderViewport,
+                            depthWrite,
+                            depthTest,
+                            wireframe,
+                            scissorTest,
+                            scissorRectangle);
+
+            if (!material || instances.empty()) return;
+
+            float colorVector[] = {material->diffuseColor.normR(), material->diffuseColor.normG(), material->diffuseColor.normB(), material->diffuseColor.normA() * opacity * material->opacity};
+
+            std::vector<std::shared_ptr<graphics::Texture>> textures;
+            if (wireframe) textures.push_back(whitePixelTexture);
+            else textures.assign(std::begin(material->textures), std::end(material->textures));
+
+            // the built-in instanced shader replaces only the texture shader,
+            // it reads the view projection from the camera constant buffer
+            bool instanced = engine->getRenderer()->getDevice()->isInstancingSupported() &&
+                engine->getRenderer()->getCameraConstantBuffer() &&
+                instancedShader &&
+                material->shader == engine->getCache()->getShader(graphics::SHADER_TEXTURE);
+
+            if (dirty)
+            {
+                // quantized positions are mapped back to the model space before the instance transform
+                drawInstances = instances;
+
+                if (positionTransform != Matrix4::IDENTITY)
+                {
+                    for (graphics::InstanceData& instance : drawInstances)
+                        instance.transform = instance.transform * positionTransform;
+                }
+
+                if (instanced)
+                    instanceBuffer->setData(drawInstances.data(), static_cast<uint32_t>(getVectorSize(drawInstances)));
+
+                dirty = false;
+            }
+
+            const std::shared_ptr<graphics::Shader>& shader = instanced ? instancedShader : material->shader;
+
+            // without the instanced shader the renderer draws every instance separately
+            Matrix4 transform = (shader && shader->isCameraConstantsUsed()) ? transformMatrix : renderViewProjection * transformMatrix;
+
+            std::vector<std::vector<float>> pixelShaderConstants(1);
+            pixelShaderConstants[0] = {std::begin(colorVector), std::end(colorVector)};
+
+            std::vector<std::vector<float>> vertexShaderConstants(1);
+            vertexShaderConstants[0] = {std::begin(transform.m), std::end(transform.m)};
+
+            // instances can be mirrored, so the faces are never culled
+            engine->getRenderer()->addDrawCommand(textures,
+                                                  instanced ? instancedShader : material->shader,
+                                                  pixelShaderConstants,
+                                                  vertexShaderConstants,
+                                                  material->blendState,
+                                                  meshBuffer,
+                                                  0,
+                                                  graphics::Renderer::DrawMode::TRIANGLE_LIST,
+                                                  0,
+                                                  renderTarget,
+                                                  renderViewport,
+                                                  depthWrite,
+                                                  depthTest,
+                                                  wireframe,
+                                                  scissorTest,
+                                                  scissorRectangle,
+                                                  graphics::Renderer::CullMode::NONE,
+                                                  instanced ? instanceBuffer : nullptr,
+                                                  drawInstances);
+        }
+    } // namespace scene
+} // namespace ouzel
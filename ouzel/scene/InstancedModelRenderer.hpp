@@ -0,0 +1,66 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <vector>
+#include "scene/Component.hpp"
+#include "scene/ModelData.hpp"
+#include "graphics/Vertex.hpp"
+
+namespace ouzel
+{
+    namespace scene
+    {
+        // draws many copies of the same model with a single draw call,
+        // the renderer falls back to one draw call per instance if the render device can't instance
+        class InstancedModelRenderer: public Component
+        {
+        public:
+            static const uint32_t TYPE = Component::INSTANCED_MODEL_RENDERER;
+
+            InstancedModelRenderer();
+            InstancedModelRenderer(const ModelData& modelData);
+
+            bool init(const ModelData& modelData);
+
+            virtual void draw(const Matrix4& transformMatrix,
+                              float opacity,
+                              const Matrix4& renderViewProjection,
+                              const std::shared_ptr<graphics::Texture>& renderTarget,
+                              const Rect& renderViewport,
+                              bool depthWrite,
+                              bool depthTest,
+                              bool wireframe,
+                              bool scissorTest,
+                              const Rect& scissorRectangle) override;
+
+            virtual const std::shared_ptr<graphics::Material>& getMaterial() const { return material; }
+            virtual void setMaterial(const std::shared_ptr<graphics::Material>& newMaterial) { material = newMaterial; dirty = true; }
+
+            // instance transforms are relative to the actor
+            void addInstance(const Matrix4& transform, Color color = Color::WHITE);
+            void setInstances(const std::vector<graphics::InstanceData>& newInstances);
+            void clearInstances();
+            inline const std::vector<graphics::InstanceData>& getInstances() const { return instances; }
+
+        protected:
+            void updateBoundingBox();
+
+            std::shared_ptr<graphics::Material> material;
+            std::shared_ptr<graphics::MeshBuffer> meshBuffer;
+            std::shared_ptr<graphics::Buffer> indexBuffer;
+            std::shared_ptr<graphics::Buffer> vertexBuffer;
+            std::shared_ptr<graphics::Buffer> instanceBuffer;
+            Matrix4 positionTransform = Matrix4::IDENTITY;
+
+            std::shared_ptr<graphics::Texture> whitePixelTexture;
+            std::shared_ptr<graphics::Shader> instancedShader;
+
+            Box3 modelBoundingBox;
+            std::vector<graphics::InstanceData> instances;
+            std::vector<graphics::InstanceData> drawInstances; // instances with the position transform applied
+            bool dirty = false;
+        };
+    } // namespace scene
+} // namespace ouzel
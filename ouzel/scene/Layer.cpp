@@ -34,6 +34,8 @@ namespace ouzel
         {
             for (Camera* camera : cameras)
             {
+                engine->getRenderer()->setCameraConstantBuffer(camera->getConstantBuffer());
+
                 std::vector<Actor*> drawQueue;
 
                 for (Actor* actor : children)
@@ -51,6 +53,8 @@ namespace ouzel
                     }
                 }
             }
+
+            engine->getRenderer()->setCameraConstantBuffer(nullptr);
         }
 
         void Layer::addChildActor(Actor* actor)
@@ -0,0 +1,438 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "MeshOptimizer.hpp"
+#include "math/Box3.hpp"
+#include "math/MathUtils.hpp"
+
+namespace ouzel
+{
+    namespace scene
+    {
+        static const uint32_t NO_VERTEX = std::numeric_limits<uint32_t>::max();
+
+        // returns the next vertex with live triangles from the dead-end stack or in the input order
+        static uint32_t skipDeadEnd(std::vector<uint32_t>& deadEnd,
+                                    const std::vector<uint32_t>& liveCounts,
+                                    uint32_t& cursor)
+        {
+            while (!deadEnd.empty())
+            {
+                uint32_t vertex = deadEnd.back();
+                deadEnd.pop_back();
+
+                if (liveCounts[vertex] > 0) return vertex;
+            }
+
+            for (; cursor < liveCounts.size(); ++cursor)
+            {
+                if (liveCounts[cursor] > 0) return cursor;
+            }
+
+            return NO_VERTEX;
+        }
+
+        static int16_t quantizeSnorm16(float value)
+        {
+            return static_cast<int16_t>(std::round(clamp(value, -1.0f, 1.0f) * 32767.0f));
+        }
+
+        static uint16_t quantizeUnorm16(float value)
+        {
+            return static_cast<uint16_t>(std::round(clamp(value, 0.0f, 1.0f) * 65535.0f));
+        }
+
+        static int8_t quantizeSnorm8(float value)
+        {
+            return static_cast<int8_t>(std::round(clamp(value, -1.0f, 1.0f) * 127.0f));
+        }
+
+        static bool isNormalized(const Vector2& texCoord)
+        {
+            return texCoord.x >= 0.0f && texCoord.x <= 1.0f && texCoord.y >= 0.0f && texCoord.y <= 1.0f;
+        }
+
+        MeshOptimizer::Statistics MeshOptimizer::analyze(const std::vector<uint32_t>& indices,
+                                                         uint32_t vertexCount,
+                                                         uint32_t cacheSize)
+        {
+            Statistics result;
+            result.triangleCount = static_cast<uint32_t>(indices.size() / 3);
+            result.vertexCount = vertexCount;
+
+            std::vector<uint32_t> timestamps(vertexCount, 0);
+            uint32_t time = cacheSize + 1;
+            uint32_t misses = 0;
+
+            for (uint32_t index : indices)
+            {
+                if (index >= vertexCount) continue;
+
+                if (!timestamps[index]) ++result.referencedVertexCount;
+
+                if (time - timestamps[index] > cacheSize)
+                {
+                    timestamps[index] = time++;
+                    ++misses;
+                }
+            }
+
+            if (result.triangleCount) result.acmr = static_cast<float>(misses) / result.triangleCount;
+            if (result.referencedVertexCount) result.atvr = static_cast<float>(misses) / result.referencedVertexCount;
+
+            return result;
+        }
+
+        void MeshOptimizer::optimizeVertexCache(std::vector<uint32_t>& indices,
+                                                uint32_t vertexCount,
+                                                uint32_t cacheSize,
+                                                std::vector<uint32_t>* clusters)
+        {
+            if (clusters) clusters->clear();
+
+            uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+            if (!triangleCount) return;
+
+            // triangles using each vertex
+            std::vector<uint32_t> liveCounts(vertexCount, 0);
+            for (uint32_t index : indices) ++liveCounts[index];
+
+            std::vector<uint32_t> offsets(vertexCount + 1, 0);
+            for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+                offsets[vertex + 1] = offsets[vertex] + liveCounts[vertex];
+
+            std::vector<uint32_t> adjacency(indices.size());
+            std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+            for (uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+            {
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                    adjacency[fill[indices[triangle * 3 + corner]]++] = triangle;
+            }
+
+            std::vector<uint32_t> timestamps(vertexCount, 0);
+            std::vector<bool> emitted(triangleCount, false);
+            std::vector<uint32_t> deadEnd;
+            std::vector<uint32_t> candidates;
+            std::vector<uint32_t> result;
+            result.reserve(triangleCount * 3);
+
+            uint32_t time = cacheSize + 1;
+            uint32_t cursor = 0;
+            uint32_t fanning = skipDeadEnd(deadEnd, liveCounts, cursor);
+
+            if (clusters) clusters->push_back(0);
+
+            while (fanning != NO_VERTEX)
+            {
+                candidates.clear();
+
+                for (uint32_t i = offsets[fanning]; i < offsets[fanning + 1]; ++i)
+                {
+                    uint32_t triangle = adjacency[i];
+                    if (emitted[triangle]) continue;
+
+                    for (uint32_t corner = 0; corner < 3; ++corner)
+                    {
+                        uint32_t vertex = indices[triangle * 3 + corner];
+
+                        result.push_back(vertex);
+                        deadEnd.push_back(vertex);
+                        candidates.push_back(vertex);
+                        --liveCounts[vertex];
+
+                        if (time - timestamps[vertex] > cacheSize)
+                            timestamps[vertex] = time++;
+                    }
+
+                    emitted[triangle] = true;
+                }
+
+                // pick the candidate that will still be in the cache after its remaining triangles are emitted
+                uint32_t next = NO_VERTEX;
+                uint32_t bestPriority = 0;
+
+                for (uint32_t vertex : candidates)
+                {
+                    if (!liveCounts[vertex]) continue;
+
+                    uint32_t priority = 0;
+                    if (time - timestamps[vertex] + 2 * liveCounts[vertex] <= cacheSize)
+                        priority = time - timestamps[vertex];
+
+                    if (priority > bestPriority)
+                    {
+                        bestPriority = priority;
+                        next = vertex;
+                    }
+                }
+
+                if (next == NO_VERTEX)
+                {
+                    next = skipDeadEnd(deadEnd, liveCounts, cursor);
+
+                    // jumping to a new vertex starts a new cluster
+                    if (clusters && next != NO_VERTEX)
+                        clusters->push_back(static_cast<uint32_t>(result.size() / 3));
+                }
+
+                fanning = next;
+            }
+
+            indices.swap(result);
+        }
+
+        void MeshOptimizer::optimizeOverdraw(std::vector<uint32_t>& indices,
+                                             const std::vector<graphics::Vertex>& vertices,
+                                             const std::vector<uint32_t>& clusters,
+                                             float threshold,
+                                             uint32_t cacheSize)
+        {
+            uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+            if (!triangleCount || clusters.empty()) return;
+
+            uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+            float maxMisses = threshold * analyze(indices, vertexCount, cacheSize).acmr;
+
+            // split the clusters where the cache efficiency allows it
+            std::vector<uint32_t> splits;
+            std::vector<uint32_t> timestamps(vertexCount, 0);
+            uint32_t time = cacheSize + 1;
+
+            for (size_t c = 0; c < clusters.size(); ++c)
+            {
+                uint32_t start = clusters[c];
+                uint32_t end = (c + 1 < clusters.size()) ? clusters[c + 1] : triangleCount;
+                uint32_t misses = 0;
+
+                splits.push_back(start);
+                time += cacheSize + 1; // flush the cache
+
+                for (uint32_t triangle = start; triangle < end; ++triangle)
+                {
+                    for (uint32_t corner = 0; corner < 3; ++corner)
+                    {
+                        uint32_t vertex = indices[triangle * 3 + corner];
+
+                        if (time - timestamps[vertex] > cacheSize)
+                        {
+                            timestamps[vertex] = time++;
+                            ++misses;
+                        }
+                    }
+
+                    if (triangle + 1 < end &&
+                        static_cast<float>(misses) <= maxMisses * (triangle + 1 - start))
+                    {
+                        start = triangle + 1;
+                        misses = 0;
+                        splits.push_back(start);
+                        time += cacheSize + 1;
+                    }
+                }
+            }
+
+            // area weighted centroid and normal of every cluster
+            std::vector<Vector3> centroids(splits.size());
+            std::vector<Vector3> normals(splits.size());
+            Vector3 meshCentroid;
+            float meshArea = 0.0f;
+
+            for (size_t s = 0; s < splits.size(); ++s)
+            {
+                uint32_t end = (s + 1 < splits.size()) ? splits[s + 1] : triangleCount;
+                Vector3 centroid;
+                Vector3 normal;
+                float area = 0.0f;
+
+                for (uint32_t triangle = splits[s]; triangle < end; ++triangle)
+                {
+                    const Vector3& p0 = vertices[indices[triangle * 3 + 0]].position;
+                    const Vector3& p1 = vertices[indices[triangle * 3 + 1]].position;
+                    const Vector3& p2 = vertices[indices[triangle * 3 + 2]].position;
+
+                    Vector3 triangleNormal = Vector3::cross(p1 - p0, p2 - p0);
+                    float triangleArea = triangleNormal.length();
+
+                    centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+                    normal += triangleNormal;
+                    area += triangleArea;
+                }
+
+                meshCentroid += centroid;
+                meshArea += area;
+
+                centroids[s] = (area > 0.0f) ? centroid / area : centroid;
+                normals[s] = normal;
+                if (normal.lengthSquared() > 0.0f) normals[s].normalize();
+            }
+
+            if (meshArea > 0.0f) meshCentroid /= meshArea;
+
+            // draw the clusters that face away from the center first
+            std::vector<float> sortKeys(splits.size());
+            std::vector<uint32_t> order(splits.size());
+
+            for (uint32_t s = 0; s < splits.size(); ++s)
+            {
+                sortKeys[s] = Vector3::dot(centroids[s] - meshCentroid, normals[s]);
+                order[s] = s;
+            }
+
+            std::stable_sort(order.begin(), order.end(), [&sortKeys](uint32_t a, uint32_t b) {
+                return sortKeys[a] > sortKeys[b];
+            });
+
+            std::vector<uint32_t> result;
+            result.reserve(indices.size());
+
+            for (uint32_t s : order)
+            {
+                uint32_t end = (s + 1 < splits.size()) ? splits[s + 1] : triangleCount;
+                result.insert(result.end(), indices.begin() + splits[s] * 3, indices.begin() + end * 3);
+            }
+
+            indices.swap(result);
+        }
+
+        void MeshOptimizer::optimizeVertexFetch(std::vector<uint32_t>& indices,
+                                                std::vector<graphics::Vertex>& vertices)
+        {
+            std::vector<uint32_t> remap(vertices.size(), NO_VERTEX);
+            std::vector<graphics::Vertex> result;
+            result.reserve(vertices.size());
+
+            for (uint32_t& index : indices)
+            {
+                if (remap[index] == NO_VERTEX)
+                {
+                    remap[index] = static_cast<uint32_t>(result.size());
+                    result.push_back(vertices[index]);
+                }
+
+                index = remap[index];
+            }
+
+            vertices.swap(result);
+        }
+
+        void MeshOptimizer::optimize(std::vector<uint32_t>& indices,
+                                     std::vector<graphics::Vertex>& vertices,
+                                     Statistics* before,
+                                     Statistics* after)
+        {
+            uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+
+            if (before) *before = analyze(indices, vertexCount);
+
+            std::vector<uint32_t> clusters;
+            optimizeVertexCache(indices, vertexCount, CACHE_SIZE, &clusters);
+            optimizeOverdraw(indices, vertices, clusters);
+            optimizeVertexFetch(indices, vertices);
+
+            if (after) *after = analyze(indices, static_cast<uint32_t>(vertices.size()));
+        }
+
+        void MeshOptimizer::quantize(const std::vector<graphics::Vertex>& vertices,
+                                     QuantizedVertices& result)
+        {
+            Box3 bounds;
+            bool texCoordsNormalized = true;
+            bool secondTexCoords = false;
+
+            for (const graphics::Vertex& vertex : vertices)
+            {
+                bounds.insertPoint(vertex.position);
+
+                if (!isNormalized(vertex.texCoords[0]) || !isNormalized(vertex.texCoords[1])) texCoordsNormalized = false;
+                if (vertex.texCoords[1].x != 0.0f || vertex.texCoords[1].y != 0.0f) secondTexCoords = true;
+            }
+
+            graphics::DataType texCoordType = texCoordsNormalized ? graphics::DataType::UNSIGNED_SHORT_VECTOR2_NORM : graphics::DataType::FLOAT_VECTOR2;
+
+            // three-component 8 and 16-bit formats are not supported by Direct3D, so positions and normals have four
+            std::vector<graphics::Vertex::Attribute> attributes = {
+                graphics::Vertex::Attribute(graphics::Vertex::Attribute::Usage::POSITION, graphics::DataType::SHORT_VECTOR4_NORM),
+                graphics::Vertex::Attribute(graphics::Vertex::Attribute::Usage::COLOR, graphics::DataType::UNSIGNED_BYTE_VECTOR4_NORM),
+                graphics::Vertex::Attribute(graphics::Vertex::Attribute::Usage::TEXTURE_COORDINATES0, texCoordType)
+            };
+
+            // models rarely have the second set, so it is left out if it is not used
+            if (secondTexCoords)
+                attributes.push_back(graphics::Vertex::Attribute(graphics::Vertex::Attribute::Usage::TEXTURE_COORDINATES1, texCoordType));
+
+            attributes.push_back(graphics::Vertex::Attribute(graphics::Vertex::Attribute::Usage::NORMAL, graphics::DataType::BYTE_VECTOR4_NORM));
+
+            result.layout = graphics::VertexLayout(attributes);
+
+            // positions are mapped to -1..1 inside the bounds
+            Vector3 center;
+            Vector3 halfSize(1.0f, 1.0f, 1.0f);
+
+            if (!vertices.empty())
+            {
+                center = Vector3((bounds.min.x + bounds.max.x) / 2.0f, (bounds.min.y + bounds.max.y) / 2.0f, (bounds.min.z + bounds.max.z) / 2.0f);
+
+                if (bounds.max.x > bounds.min.x) halfSize.x = (bounds.max.x - bounds.min.x) / 2.0f;
+                if (bounds.max.y > bounds.min.y) halfSize.y = (bounds.max.y - bounds.min.y) / 2.0f;
+                if (bounds.max.z > bounds.min.z) halfSize.z = (bounds.max.z - bounds.min.z) / 2.0f;
+            }
+
+            Matrix4 translation;
+            Matrix4::createTranslation(center, translation);
+            Matrix4 scale;
+            Matrix4::createScale(halfSize, scale);
+            result.positionTransform = translation * scale;
+
+            uint32_t stride = result.layout.getStride();
+            const std::vector<uint32_t>& offsets = result.layout.getOffsets();
+
+            result.data.resize(vertices.size() * stride);
+
+            for (size_t i = 0; i < vertices.size(); ++i)
+            {
+                const graphics::Vertex& vertex = vertices[i];
+                uint8_t* destination = result.data.data() + i * stride;
+                uint32_t attribute = 0;
+
+                int16_t position[4] = {
+                    quantizeSnorm16((vertex.position.x - center.x) / halfSize.x),
+                    quantizeSnorm16((vertex.position.y - center.y) / halfSize.y),
+                    quantizeSnorm16((vertex.position.z - center.z) / halfSize.z),
+                    0
+                };
+                memcpy(destination + offsets[attribute++], position, sizeof(position));
+
+                memcpy(destination + offsets[attribute++], &vertex.color, sizeof(vertex.color));
+
+                for (uint32_t set = 0; set < (secondTexCoords ? 2 : 1); ++set)
+                {
+                    if (texCoordsNormalized)
+                    {
+                        uint16_t texCoord[2] = {
+                            quantizeUnorm16(vertex.texCoords[set].x),
+                            quantizeUnorm16(vertex.texCoords[set].y)
+                        };
+                        memcpy(destination + offsets[attribute++], texCoord, sizeof(texCoord));
+                    }
+                    else
+                    {
+                        float texCoord[2] = {vertex.texCoords[set].x, vertex.texCoords[set].y};
+                        memcpy(destination + offsets[attribute++], texCoord, sizeof(texCoord));
+                    }
+                }
+
+                int8_t normal[4] = {
+                    quantizeSnorm8(vertex.normal.x),
+                    quantizeSnorm8(vertex.normal.y),
+                    quantizeSnorm8(vertex.normal.z),
+                    0
+                };
+                memcpy(destination + offsets[attribute++], normal, sizeof(normal));
+            }
+        }
+    } // namespace scene
+} // namespace ouzel
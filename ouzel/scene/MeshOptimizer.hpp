@@ -0,0 +1,72 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "graphics/Vertex.hpp"
+
+namespace ouzel
+{
+    namespace scene
+    {
+        class MeshOptimizer final
+        {
+        public:
+            static const uint32_t CACHE_SIZE = 16;
+
+            struct Statistics
+            {
+                uint32_t triangleCount = 0;
+                uint32_t vertexCount = 0;
+                uint32_t referencedVertexCount = 0;
+                float acmr = 0.0f; // average cache miss ratio (transformed vertices per triangle)
+                float atvr = 0.0f; // average transformed vertex ratio (transformed vertices per referenced vertex)
+            };
+
+            struct QuantizedVertices
+            {
+                graphics::VertexLayout layout;
+                std::vector<uint8_t> data;
+                Matrix4 positionTransform; // maps the quantized positions back to the model space
+            };
+
+            MeshOptimizer() = delete;
+
+            // simulates a FIFO post-transform cache
+            static Statistics analyze(const std::vector<uint32_t>& indices,
+                                      uint32_t vertexCount,
+                                      uint32_t cacheSize = CACHE_SIZE);
+
+            // reorders triangles with the Tipsify algorithm, optionally returns the first triangle of every cluster
+            static void optimizeVertexCache(std::vector<uint32_t>& indices,
+                                            uint32_t vertexCount,
+                                            uint32_t cacheSize = CACHE_SIZE,
+                                            std::vector<uint32_t>* clusters = nullptr);
+
+            // sorts the clusters so that the outward facing ones are drawn first,
+            // clusters are split as long as the ACMR stays under threshold * original ACMR
+            static void optimizeOverdraw(std::vector<uint32_t>& indices,
+                                         const std::vector<graphics::Vertex>& vertices,
+                                         const std::vector<uint32_t>& clusters,
+                                         float threshold = 1.05f,
+                                         uint32_t cacheSize = CACHE_SIZE);
+
+            // reorders the vertices in the order they are first referenced and removes the unused ones
+            static void optimizeVertexFetch(std::vector<uint32_t>& indices,
+                                            std::vector<graphics::Vertex>& vertices);
+
+            // runs all of the above passes
+            static void optimize(std::vector<uint32_t>& indices,
+                                 std::vector<graphics::Vertex>& vertices,
+                                 Statistics* before = nullptr,
+                                 Statistics* after = nullptr);
+
+            // packs the vertices into a compact layout: positions as 16-bit values relative to the bounds of the vertices,
+            // normals as 8-bit values and texture coordinates as 16-bit values if all of them are in the 0..1 range
+            static void quantize(const std::vector<graphics::Vertex>& vertices,
+                                 QuantizedVertices& result);
+        };
+    } // namespace scene
+} // namespace ouzel
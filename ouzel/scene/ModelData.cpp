@@ -10,20 +10,46 @@ namespace ouzel
     namespace scene
     {
         bool ModelData::init(Box3 newBoundingBox,
-                             const std::vector<uint32_t> indices,
+                             const std::vector<uint32_t>& indices,
                              const std::vector<graphics::Vertex>& vertices,
                              const std::shared_ptr<graphics::Material>& newMaterial)
+        {
+            return init(newBoundingBox, sizeof(uint32_t), indices.data(), static_cast<uint32_t>(getVectorSize(indices)),
+                        graphics::Vertex::LAYOUT, vertices.data(), static_cast<uint32_t>(getVectorSize(vertices)),
+                        Matrix4::IDENTITY, newMaterial);
+        }
+
+        bool ModelData::init(Box3 newBoundingBox,
+                             const std::vector<uint16_t>& indices,
+                             const std::vector<graphics::Vertex>& vertices,
+                             const std::shared_ptr<graphics::Material>& newMaterial)
+        {
+            return init(newBoundingBox, sizeof(uint16_t), indices.data(), static_cast<uint32_t>(getVectorSize(indices)),
+                        graphics::Vertex::LAYOUT, vertices.data(), static_cast<uint32_t>(getVectorSize(vertices)),
+                        Matrix4::IDENTITY, newMaterial);
+        }
+
+        bool ModelData::init(Box3 newBoundingBox,
+                             uint32_t indexSize,
+                             const void* indices,
+                             uint32_t indicesSize,
+                             const graphics::VertexLayout& vertexLayout,
+                             const void* vertices,
+                             uint32_t verticesSize,
+                             const Matrix4& newPositionTransform,
+                             const std::shared_ptr<graphics::Material>& newMaterial)
         {
             boundingBox = newBoundingBox;
+            positionTransform = newPositionTransform;
 
             indexBuffer = std::make_shared<graphics::Buffer>();
-            indexBuffer->init(graphics::Buffer::Usage::INDEX, indices.data(), static_cast<uint32_t>(getVectorSize(indices)));
+            indexBuffer->init(graphics::Buffer::Usage::INDEX, indices, indicesSize);
 
             vertexBuffer = std::make_shared<graphics::Buffer>();
-            vertexBuffer->init(graphics::Buffer::Usage::VERTEX, vertices.data(), static_cast<uint32_t>(getVectorSize(vertices)));
+            vertexBuffer->init(graphics::Buffer::Usage::VERTEX, vertices, verticesSize);
 
             meshBuffer = std::make_shared<graphics::MeshBuffer>();
-            meshBuffer->init(sizeof(uint32_t), indexBuffer, vertexBuffer);
+            meshBuffer->init(indexSize, indexBuffer, vertexBuffer, vertexLayout);
 
             material = newMaterial;
 
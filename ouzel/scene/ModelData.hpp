@@ -5,7 +5,6 @@
 
 #include <vector>
 #include "graphics/Buffer.hpp"
-#include "graphics/Buffer.hpp"
 #include "graphics/Material.hpp"
 #include "graphics/MeshBuffer.hpp"
 
@@ -16,11 +15,26 @@ namespace ouzel
         struct ModelData
         {
             bool init(Box3 newBoundingBox,
-                      const std::vector<uint32_t> indices,
+                      const std::vector<uint32_t>& indices,
+                      const std::vector<graphics::Vertex>& vertices,
+                      const std::shared_ptr<graphics::Material>& newMaterial);
+            bool init(Box3 newBoundingBox,
+                      const std::vector<uint16_t>& indices,
                       const std::vector<graphics::Vertex>& vertices,
                       const std::shared_ptr<graphics::Material>& newMaterial);
+            // vertices in a custom layout, their positions are transformed by newPositionTransform before the model's transformation
+            bool init(Box3 newBoundingBox,
+                      uint32_t indexSize,
+                      const void* indices,
+                      uint32_t indicesSize,
+                      const graphics::VertexLayout& vertexLayout,
+                      const void* vertices,
+                      uint32_t verticesSize,
+                      const Matrix4& newPositionTransform,
+                      const std::shared_ptr<graphics::Material>& newMaterial);
 
             Box3 boundingBox;
+            Matrix4 positionTransform = Matrix4::IDENTITY;
             std::shared_ptr<graphics::Material> material;
             std::shared_ptr<graphics::MeshBuffer> meshBuffer;
             std::shared_ptr<graphics::Buffer> indexBuffer;
@@ -33,6 +33,7 @@ namespace ouzel
             meshBuffer = modelData.meshBuffer;
             indexBuffer = modelData.indexBuffer;
             vertexBuffer = modelData.vertexBuffer;
+            positionTransform = modelData.positionTransform;
 
             return true;
         }
@@ -67,7 +68,9 @@ namespace ouzel
 
             material->cullMode = graphics::Renderer::CullMode::NONE;
 
-            Matrix4 modelViewProj = renderViewProjection * transformMatrix;
+            // shaders that read the camera constant buffer apply the view projection themselves
+            Matrix4 modelViewProj = (material->shader && material->shader->isCameraConstantsUsed()) ?
+                transformMatrix * positionTransform : renderViewProjection * transformMatrix * positionTransform;
             float colorVector[] = {material->diffuseColor.normR(), material->diffuseColor.normG(), material->diffuseColor.normB(), material->diffuseColor.normA() * opacity * material->opacity};
 
             std::vector<std::vector<float>> pixelShaderConstants(1);
@@ -41,6 +41,7 @@ namespace ouzel
             std::shared_ptr<graphics::MeshBuffer> meshBuffer;
             std::shared_ptr<graphics::Buffer> indexBuffer;
             std::shared_ptr<graphics::Buffer> vertexBuffer;
+            Matrix4 positionTransform = Matrix4::IDENTITY;
 
             std::shared_ptr<graphics::Texture> whitePixelTexture;
         };
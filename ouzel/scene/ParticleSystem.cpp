@@ -25,8 +25,11 @@ namespace ouzel
             shader = engine->getCache()->getShader(graphics::SHADER_TEXTURE);
             blendState = engine->getCache()->getBlendState(graphics::BLEND_ALPHA);
             whitePixelTexture = engine->getCache()->getTexture(graphics::TEXTURE_WHITE_PIXEL);
+        }
 
-            updateCallback.callback = std::bind(&ParticleSystem::update, this, std::placeholders::_1);
+        ParticleSystem::~ParticleSystem()
+        {
+            if (animationSystem) animationSystem->removeParticleSystem(this);
         }
 
         ParticleSystem::ParticleSystem(const std::string& filename):
@@ -65,16 +68,12 @@ namespace ouzel
                     needsMeshUpdate = false;
                 }
 
-                Matrix4 transform;
+                // shaders that read the camera constant buffer apply the view projection themselves
+                Matrix4 transform = (shader && shader->isCameraConstantsUsed()) ? Matrix4::IDENTITY : renderViewProjection;
 
-                if (particleSystemData.positionType == ParticleSystemData::PositionType::FREE ||
-                    particleSystemData.positionType == ParticleSystemData::PositionType::PARENT)
-                {
-                    transform = renderViewProjection;
-                }
-                else if (particleSystemData.positionType == ParticleSystemData::PositionType::GROUPED)
+                if (particleSystemData.positionType == ParticleSystemData::PositionType::GROUPED)
                 {
-                    transform = renderViewProjection * transformMatrix;
+                    transform = transform * transformMatrix;
                 }
 
                 float colorVector[] = {1.0f, 1.0f, 1.0f, opacity};
@@ -143,7 +142,7 @@ namespace ouzel
                 else if (active && !particleCount)
                 {
                     active = false;
-                    updateCallback.remove();
+                    if (animationSystem) animationSystem->removeParticleSystem(this);
 
                     Event finishEvent;
                     finishEvent.type = Event::Type::ANIMATION_FINISH;
@@ -301,7 +300,7 @@ namespace ouzel
                 if (!active)
                 {
                     active = true;
-                    engine->scheduleUpdate(&updateCallback);
+                    engine->getSceneManager()->getAnimationSystem()->addParticleSystem(this);
                 }
 
                 if (particleCount == 0)
@@ -342,14 +341,14 @@ namespace ouzel
                 indices.push_back(i * 4 + 3);
                 indices.push_back(i * 4 + 2);
 
-                vertices.push_back(graphics::Vertex(Vector3(-1.0f, -1.0f, 0.0f), Color::WHITE,
-                                                    Vector2(0.0f, 1.0f), Vector3(0.0f, 0.0f, -1.0f)));
-                vertices.push_back(graphics::Vertex(Vector3(1.0f, -1.0f, 0.0f), Color::WHITE,
-                                                    Vector2(1.0f, 1.0f), Vector3(0.0f, 0.0f, -1.0f)));
-                vertices.push_back(graphics::Vertex(Vector3(-1.0f, 1.0f, 0.0f),  Color::WHITE,
-                                                    Vector2(0.0f, 0.0f), Vector3(0.0f, 0.0f, -1.0f)));
-                vertices.push_back(graphics::Vertex(Vector3(1.0f, 1.0f, 0.0f),  Color::WHITE,
-                                                    Vector2(1.0f, 0.0f), Vector3(0.0f, 0.0f, -1.0f)));
+                vertices.push_back(graphics::TextureVertex(Vector3(-1.0f, -1.0f, 0.0f), Color::WHITE,
+                                                           Vector2(0.0f, 1.0f)));
+                vertices.push_back(graphics::TextureVertex(Vector3(1.0f, -1.0f, 0.0f), Color::WHITE,
+                                                           Vector2(1.0f, 1.0f)));
+                vertices.push_back(graphics::TextureVertex(Vector3(-1.0f, 1.0f, 0.0f),  Color::WHITE,
+                                                           Vector2(0.0f, 0.0f)));
+                vertices.push_back(graphics::TextureVertex(Vector3(1.0f, 1.0f, 0.0f),  Color::WHITE,
+                                                           Vector2(1.0f, 0.0f)));
             }
 
             indexBuffer = std::make_shared<graphics::Buffer>();
@@ -359,7 +358,7 @@ namespace ouzel
             vertexBuffer->init(graphics::Buffer::Usage::VERTEX, vertices.data(), static_cast<uint32_t>(getVectorSize(vertices)), graphics::Buffer::DYNAMIC);
 
             meshBuffer = std::make_shared<graphics::MeshBuffer>();
-            meshBuffer->init(sizeof(uint16_t), indexBuffer, vertexBuffer);
+            meshBuffer->init(sizeof(uint16_t), indexBuffer, vertexBuffer, graphics::TextureVertex::LAYOUT);
 
             particles.resize(particleSystemData.maxParticles);
 
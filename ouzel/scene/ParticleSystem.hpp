@@ -7,11 +7,11 @@
 #include <vector>
 #include <functional>
 #include "scene/Component.hpp"
+#include "scene/AnimationSystem.hpp"
 #include "scene/ParticleSystemData.hpp"
 #include "math/Vector2.hpp"
 #include "math/Color.hpp"
 #include "graphics/Vertex.hpp"
-#include "core/UpdateCallback.hpp"
 #include "graphics/BlendState.hpp"
 #include "graphics/Buffer.hpp"
 #include "graphics/MeshBuffer.hpp"
@@ -24,10 +24,12 @@ namespace ouzel
     {
         class ParticleSystem: public Component
         {
+            friend AnimationSystem;
         public:
             static const uint32_t TYPE = Component::PARTICLE_SYSTEM;
 
             ParticleSystem();
+            virtual ~ParticleSystem();
             ParticleSystem(const std::string& filename);
 
             virtual void draw(const Matrix4& transformMatrix,
@@ -110,7 +112,7 @@ namespace ouzel
             std::shared_ptr<graphics::Buffer> vertexBuffer;
 
             std::vector<uint16_t> indices;
-            std::vector<graphics::Vertex> vertices;
+            std::vector<graphics::TextureVertex> vertices;
 
             uint32_t particleCount = 0;
 
@@ -123,7 +125,8 @@ namespace ouzel
 
             bool needsMeshUpdate = false;
 
-            UpdateCallback updateCallback;
+            AnimationSystem* animationSystem = nullptr;
+            uint32_t animationIndex = AnimationSystem::INVALID_INDEX;
         };
     } // namespace scene
 } // namespace ouzel
@@ -214,18 +214,7 @@ namespace ouzel
                 }
                 case Event::Type::MOUSE_MOVE:
                 {
-                    std::pair<Actor*, ouzel::Vector3> previousActor = pickActor(event.position - event.difference);
-                    pointerLeaveActor(0, previousActor.first, event.position);
-
-                    std::pair<Actor*, ouzel::Vector3> actor = pickActor(event.position);
-                    pointerEnterActor(0, actor.first, event.position);
-
-                    auto i = pointerDownOnActors.find(0);
-
-                    if (i != pointerDownOnActors.end())
-                    {
-                        pointerDragActor(0, i->second.first, event.position, event.difference, i->second.second);
-                    }
+                    pointerMoveActor(0, event.position, event.difference);
                     break;
                 }
                 default:
@@ -249,28 +238,19 @@ namespace ouzel
                 {
                     std::pair<Actor*, ouzel::Vector3> actor = pickActor(event.position);
                     pointerUpOnActor(event.touchId, actor.first, event.position);
+                    pointerOverActors.erase(event.touchId);
                     break;
                 }
                 case Event::Type::TOUCH_MOVE:
                 {
-                    std::pair<Actor*, ouzel::Vector3> previousActor = pickActor(event.position - event.difference);
-                    pointerLeaveActor(0, previousActor.first, event.position);
-
-                    std::pair<Actor*, ouzel::Vector3> actor = pickActor(event.position);
-                    pointerEnterActor(0, actor.first, event.position);
-
-                    auto i = pointerDownOnActors.find(event.touchId);
-
-                    if (i != pointerDownOnActors.end())
-                    {
-                        pointerDragActor(event.touchId, i->second.first, event.position, event.difference, i->second.second);
-                    }
+                    pointerMoveActor(event.touchId, event.position, event.difference);
                     break;
                 }
                 case Event::Type::TOUCH_CANCEL:
                 {
                     std::pair<Actor*, ouzel::Vector3> actor = pickActor(event.position);
                     pointerUpOnActor(event.touchId, actor.first, event.position);
+                    pointerOverActors.erase(event.touchId);
                     break;
                 }
                 default:
@@ -284,14 +264,12 @@ namespace ouzel
         {
             if (actor)
             {
-                Event event;
-                event.type = Event::Type::ACTOR_ENTER;
-
-                event.uiEvent.actor = actor;
-                event.uiEvent.touchId = pointerId;
-                event.uiEvent.position = position;
+                UIEvent uiEvent;
+                uiEvent.actor = actor;
+                uiEvent.touchId = pointerId;
+                uiEvent.position = position;
 
-                engine->getEventDispatcher()->postEvent(event);
+                engine->getEventDispatcher()->postEvent(Event::Type::ACTOR_ENTER, uiEvent);
             }
         }
 
@@ -299,14 +277,12 @@ namespace ouzel
         {
             if (actor)
             {
-                Event event;
-                event.type = Event::Type::ACTOR_LEAVE;
+                UIEvent uiEvent;
+                uiEvent.actor = actor;
+                uiEvent.touchId = pointerId;
+                uiEvent.position = position;
 
-                event.uiEvent.actor = actor;
-                event.uiEvent.touchId = pointerId;
-                event.uiEvent.position = position;
-
-                engine->getEventDispatcher()->postEvent(event);
+                engine->getEventDispatcher()->postEvent(Event::Type::ACTOR_LEAVE, uiEvent);
             }
         }
 
@@ -316,15 +292,13 @@ namespace ouzel
             {
                 pointerDownOnActors[pointerId] = std::make_pair(actor, localPosition);
 
-                Event event;
-                event.type = Event::Type::ACTOR_PRESS;
-
-                event.uiEvent.actor = actor;
-                event.uiEvent.touchId = pointerId;
-                event.uiEvent.position = position;
-                event.uiEvent.localPosition = localPosition;
+                UIEvent uiEvent;
+                uiEvent.actor = actor;
+                uiEvent.touchId = pointerId;
+                uiEvent.position = position;
+                uiEvent.localPosition = localPosition;
 
-                engine->getEventDispatcher()->postEvent(event);
+                engine->getEventDispatcher()->postEvent(Event::Type::ACTOR_PRESS, uiEvent);
             }
         }
 
@@ -338,26 +312,22 @@ namespace ouzel
 
                 if (pointerDownOnActor.first)
                 {
-                    Event releaseEvent;
-                    releaseEvent.type = Event::Type::ACTOR_RELEASE;
+                    UIEvent releaseEvent;
+                    releaseEvent.actor = pointerDownOnActor.first;
+                    releaseEvent.touchId = pointerId;
+                    releaseEvent.position = position;
+                    releaseEvent.localPosition = pointerDownOnActor.second;
 
-                    releaseEvent.uiEvent.actor = pointerDownOnActor.first;
-                    releaseEvent.uiEvent.touchId = pointerId;
-                    releaseEvent.uiEvent.position = position;
-                    releaseEvent.uiEvent.localPosition = pointerDownOnActor.second;
-
-                    engine->getEventDispatcher()->postEvent(releaseEvent);
+                    engine->getEventDispatcher()->postEvent(Event::Type::ACTOR_RELEASE, releaseEvent);
 
                     if (pointerDownOnActor.first == actor)
                     {
-                        Event clickEvent;
-                        clickEvent.type = Event::Type::ACTOR_CLICK;
-
-                        clickEvent.uiEvent.actor = actor;
-                        clickEvent.uiEvent.touchId = pointerId;
-                        clickEvent.uiEvent.position = position;
+                        UIEvent clickEvent;
+                        clickEvent.actor = actor;
+                        clickEvent.touchId = pointerId;
+                        clickEvent.position = position;
 
-                        engine->getEventDispatcher()->postEvent(clickEvent);
+                        engine->getEventDispatcher()->postEvent(Event::Type::ACTOR_CLICK, clickEvent);
                     }
                 }
             }
@@ -370,16 +340,54 @@ namespace ouzel
         {
             if (actor)
             {
-                Event event;
-                event.type = Event::Type::ACTOR_DRAG;
+                UIEvent uiEvent;
+                uiEvent.actor = actor;
+                uiEvent.touchId = pointerId;
+                uiEvent.difference = difference;
+                uiEvent.position = position;
+                uiEvent.localPosition = localPosition;
+
+                engine->getEventDispatcher()->postEvent(Event::Type::ACTOR_DRAG, uiEvent);
+            }
+        }
 
-                event.uiEvent.actor = actor;
-                event.uiEvent.touchId = pointerId;
-                event.uiEvent.difference = difference;
-                event.uiEvent.position = position;
-                event.uiEvent.localPosition = localPosition;
+        void Scene::pointerMoveActor(uint64_t pointerId, const Vector2& position, const Vector2& difference)
+        {
+            Actor* previousActor;
+            auto overIterator = pointerOverActors.find(pointerId);
+
+            if (overIterator != pointerOverActors.end())
+                previousActor = overIterator->second;
+            else
+                previousActor = pickActor(position - difference).first;
+
+            Actor* actor = pickActor(position).first;
+            pointerOverActors[pointerId] = actor;
+
+            if (actor != previousActor)
+            {
+                pointerLeaveActor(pointerId, previousActor, position);
+                pointerEnterActor(pointerId, actor, position);
+            }
+
+            auto i = pointerDownOnActors.find(pointerId);
+
+            if (i != pointerDownOnActors.end())
+            {
+                pointerDragActor(pointerId, i->second.first, position, difference, i->second.second);
+            }
+        }
 
-                engine->getEventDispatcher()->postEvent(event);
+        void Scene::releaseActor(Actor* actor)
+        {
+            for (auto& pointerOverActor : pointerOverActors)
+            {
+                if (pointerOverActor.second == actor) pointerOverActor.second = nullptr;
+            }
+
+            for (auto& pointerDownOnActor : pointerDownOnActors)
+            {
+                if (pointerDownOnActor.second.first == actor) pointerDownOnActor.second.first = nullptr;
             }
         }
     } // namespace scene
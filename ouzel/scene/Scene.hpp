@@ -19,6 +19,7 @@ namespace ouzel
         class Scene
         {
             friend SceneManager;
+            friend Actor;
         public:
             Scene();
             virtual ~Scene();
@@ -80,6 +81,10 @@ namespace ouzel
             void pointerUpOnActor(uint64_t pointerId, Actor* actor, const Vector2& position);
             void pointerDragActor(uint64_t pointerId, Actor* actor, const Vector2& position,
                                  const Vector2& difference, const ouzel::Vector3& localPosition);
+            void pointerMoveActor(uint64_t pointerId, const Vector2& position, const Vector2& difference);
+
+            // called when the actor leaves the scene, so that the pointers don't keep it
+            void releaseActor(Actor* actor);
 
             SceneManager* sceneManger = nullptr;
 
@@ -88,6 +93,8 @@ namespace ouzel
             ouzel::EventHandler eventHandler;
 
             std::unordered_map<uint64_t, std::pair<Actor*, ouzel::Vector3>> pointerDownOnActors;
+            // actors picked after the last move of every pointer, used instead of picking the previous position again
+            std::unordered_map<uint64_t, Actor*> pointerOverActors;
 
             bool entered = false;
         };
@@ -63,8 +63,15 @@ namespace ouzel
             return result;
         }
 
+        void SceneManager::update(float delta)
+        {
+            animationSystem.update(delta);
+        }
+
         void SceneManager::draw()
         {
+            OUZEL_PROFILE_ZONE("SceneManager::draw");
+
             while (scenes.size() > 1)
             {
                 removeScene(scenes.front());
@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <vector>
+#include "scene/AnimationSystem.hpp"
 
 namespace ouzel
 {
@@ -26,6 +27,7 @@ namespace ouzel
             SceneManager(SceneManager&&) = delete;
             SceneManager& operator=(SceneManager&&) = delete;
 
+            void update(float delta);
             void draw();
 
             void setScene(Scene* scene)
@@ -52,6 +54,8 @@ namespace ouzel
             }
             inline Scene* getScene() const { return scenes.empty() ? nullptr : scenes.back(); }
 
+            inline AnimationSystem* getAnimationSystem() { return &animationSystem; }
+
         protected:
             SceneManager();
             virtual void addChildScene(Scene* scene);
@@ -59,6 +63,8 @@ namespace ouzel
 
             std::vector<Scene*> scenes;
             std::vector<std::unique_ptr<Scene>> ownedScenes;
+
+            AnimationSystem animationSystem;
         };
     } // namespace scene
 } // namespace ouzel
@@ -26,7 +26,7 @@ namespace ouzel
             vertexBuffer->init(graphics::Buffer::Usage::VERTEX, graphics::Buffer::DYNAMIC);
 
             meshBuffer = std::make_shared<graphics::MeshBuffer>();
-            meshBuffer->init(sizeof(uint16_t), indexBuffer, vertexBuffer);
+            meshBuffer->init(sizeof(uint16_t), indexBuffer, vertexBuffer, graphics::ColorVertex::LAYOUT);
         }
 
         void ShapeRenderer::draw(const Matrix4& transformMatrix,
@@ -58,7 +58,8 @@ namespace ouzel
                 dirty = false;
             }
 
-            Matrix4 modelViewProj = renderViewProjection * transformMatrix;
+            // shaders that read the camera constant buffer apply the view projection themselves
+            Matrix4 modelViewProj = (shader && shader->isCameraConstantsUsed()) ? transformMatrix : renderViewProjection * transformMatrix;
             float colorVector[] = {1.0f, 1.0f, 1.0f, opacity};
 
             for (const DrawCommand& drawCommand : drawCommands)
@@ -113,8 +114,8 @@ namespace ouzel
             {
                 command.mode = graphics::Renderer::DrawMode::LINE_LIST;
 
-                vertices.push_back(graphics::Vertex(start, color, Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
-                vertices.push_back(graphics::Vertex(finish, color, Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                vertices.push_back(graphics::ColorVertex(start, color));
+                vertices.push_back(graphics::ColorVertex(finish, color));
 
                 command.indexCount = 2;
 
@@ -134,14 +135,10 @@ namespace ouzel
 
                 float halfThickness = thickness / 2.0f;
 
-                vertices.push_back(graphics::Vertex(start - tangent * halfThickness - normal * halfThickness, color,
-                                                    Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
-                vertices.push_back(graphics::Vertex(finish + tangent * halfThickness - normal * halfThickness, color,
-                                                    Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
-                vertices.push_back(graphics::Vertex(start - tangent * halfThickness + normal * halfThickness, color,
-                                                    Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
-                vertices.push_back(graphics::Vertex(finish + tangent * halfThickness + normal * halfThickness, color,
-                                                    Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                vertices.push_back(graphics::ColorVertex(start - tangent * halfThickness - normal * halfThickness, color));
+                vertices.push_back(graphics::ColorVertex(finish + tangent * halfThickness - normal * halfThickness, color));
+                vertices.push_back(graphics::ColorVertex(start - tangent * halfThickness + normal * halfThickness, color));
+                vertices.push_back(graphics::ColorVertex(finish + tangent * halfThickness + normal * halfThickness, color));
 
                 command.indexCount = 6;
 
@@ -184,13 +181,13 @@ namespace ouzel
             {
                 command.mode = graphics::Renderer::DrawMode::TRIANGLE_STRIP;
 
-                vertices.push_back(graphics::Vertex(position, color, Vector2(), Vector3(0.0f, 0.0f, -1.0f))); // center
+                vertices.push_back(graphics::ColorVertex(position, color)); // center
 
                 for (uint32_t i = 0; i <= segments; ++i)
                 {
-                    vertices.push_back(graphics::Vertex(Vector3((position.x + radius * cosf(i * TAU / static_cast<float>(segments))),
-                                                                (position.y + radius * sinf(i * TAU / static_cast<float>(segments))),
-                                                                0.0f), color, Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                    vertices.push_back(graphics::ColorVertex(Vector3((position.x + radius * cosf(i * TAU / static_cast<float>(segments))),
+                                                                     (position.y + radius * sinf(i * TAU / static_cast<float>(segments))),
+                                                                     0.0f), color));
                 }
 
                 command.indexCount = segments * 2 + 1;
@@ -214,9 +211,9 @@ namespace ouzel
 
                     for (uint32_t i = 0; i <= segments; ++i)
                     {
-                        vertices.push_back(graphics::Vertex(Vector3((position.x + radius * cosf(i * TAU / static_cast<float>(segments))),
-                                                                    (position.y + radius * sinf(i * TAU / static_cast<float>(segments))),
-                                                                    0.0f), color, Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                        vertices.push_back(graphics::ColorVertex(Vector3((position.x + radius * cosf(i * TAU / static_cast<float>(segments))),
+                                                                         (position.y + radius * sinf(i * TAU / static_cast<float>(segments))),
+                                                                         0.0f), color));
                     }
 
                     command.indexCount = segments + 1;
@@ -239,16 +236,16 @@ namespace ouzel
 
                     for (uint32_t i = 0; i <= segments; ++i)
                     {
-                        vertices.push_back(graphics::Vertex(Vector3((position.x + (radius - halfThickness) * cosf(i * TAU / static_cast<float>(segments))),
-                                                                    (position.y + (radius - halfThickness) * sinf(i * TAU / static_cast<float>(segments))),
-                                                                    0.0f), color, Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                        vertices.push_back(graphics::ColorVertex(Vector3((position.x + (radius - halfThickness) * cosf(i * TAU / static_cast<float>(segments))),
+                                                                         (position.y + (radius - halfThickness) * sinf(i * TAU / static_cast<float>(segments))),
+                                                                         0.0f), color));
 
-                        vertices.push_back(graphics::Vertex(Vector3((position.x + (radius + halfThickness) * cosf(i * TAU / static_cast<float>(segments))),
-                                                                    (position.y + (radius + halfThickness) * sinf(i * TAU / static_cast<float>(segments))),
-                                                                    0.0f), color, Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                        vertices.push_back(graphics::ColorVertex(Vector3((position.x + (radius + halfThickness) * cosf(i * TAU / static_cast<float>(segments))),
+                                                                         (position.y + (radius + halfThickness) * sinf(i * TAU / static_cast<float>(segments))),
+                                                                         0.0f), color));
                     }
 
-                    for (const graphics::Vertex& vertex : vertices)
+                    for (const graphics::ColorVertex& vertex : vertices)
                     {
                         boundingBox.insertPoint(vertex.position);
                     }
@@ -303,14 +300,10 @@ namespace ouzel
             {
                 command.mode = graphics::Renderer::DrawMode::TRIANGLE_LIST;
 
-                vertices.push_back(graphics::Vertex(Vector3(rectangle.left(), rectangle.bottom(), 0.0f), color,
-                                                    Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
-                vertices.push_back(graphics::Vertex(Vector3(rectangle.right(), rectangle.bottom(), 0.0f), color,
-                                                    Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
-                vertices.push_back(graphics::Vertex(Vector3(rectangle.right(), rectangle.top(), 0.0f), color,
-                                                    Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
-                vertices.push_back(graphics::Vertex(Vector3(rectangle.left(), rectangle.top(), 0.0f), color,
-                                                    Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                vertices.push_back(graphics::ColorVertex(Vector3(rectangle.left(), rectangle.bottom(), 0.0f), color));
+                vertices.push_back(graphics::ColorVertex(Vector3(rectangle.right(), rectangle.bottom(), 0.0f), color));
+                vertices.push_back(graphics::ColorVertex(Vector3(rectangle.right(), rectangle.top(), 0.0f), color));
+                vertices.push_back(graphics::ColorVertex(Vector3(rectangle.left(), rectangle.top(), 0.0f), color));
 
                 command.indexCount = 6;
 
@@ -331,20 +324,16 @@ namespace ouzel
                     command.mode = graphics::Renderer::DrawMode::LINE_STRIP;
 
                     // left bottom
-                    vertices.push_back(graphics::Vertex(Vector3(rectangle.left(), rectangle.bottom(), 0.0f), color,
-                                                        Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                    vertices.push_back(graphics::ColorVertex(Vector3(rectangle.left(), rectangle.bottom(), 0.0f), color));
 
                     // right bottom
-                    vertices.push_back(graphics::Vertex(Vector3(rectangle.right(), rectangle.bottom(), 0.0f), color,
-                                                        Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                    vertices.push_back(graphics::ColorVertex(Vector3(rectangle.right(), rectangle.bottom(), 0.0f), color));
 
                     // right top
-                    vertices.push_back(graphics::Vertex(Vector3(rectangle.right(), rectangle.top(), 0.0f), color,
-                                                        Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                    vertices.push_back(graphics::ColorVertex(Vector3(rectangle.right(), rectangle.top(), 0.0f), color));
 
                     // left top
-                    vertices.push_back(graphics::Vertex(Vector3(rectangle.left(), rectangle.top(), 0.0f), color,
-                                                        Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                    vertices.push_back(graphics::ColorVertex(Vector3(rectangle.left(), rectangle.top(), 0.0f), color));
 
                     command.indexCount = 5;
 
@@ -364,28 +353,20 @@ namespace ouzel
                     float halfThickness = thickness / 2.0f;
 
                     // left bottom
-                    vertices.push_back(graphics::Vertex(Vector3(rectangle.left() - halfThickness, rectangle.bottom() - halfThickness, 0.0f), color,
-                                                        Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
-                    vertices.push_back(graphics::Vertex(Vector3(rectangle.left() + halfThickness, rectangle.bottom() + halfThickness, 0.0f), color,
-                                                        Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                    vertices.push_back(graphics::ColorVertex(Vector3(rectangle.left() - halfThickness, rectangle.bottom() - halfThickness, 0.0f), color));
+                    vertices.push_back(graphics::ColorVertex(Vector3(rectangle.left() + halfThickness, rectangle.bottom() + halfThickness, 0.0f), color));
 
                     // right bottom
-                    vertices.push_back(graphics::Vertex(Vector3(rectangle.right() + halfThickness, rectangle.bottom() - halfThickness, 0.0f), color,
-                                                        Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
-                    vertices.push_back(graphics::Vertex(Vector3(rectangle.right() - halfThickness, rectangle.bottom() + halfThickness, 0.0f), color,
-                                                        Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                    vertices.push_back(graphics::ColorVertex(Vector3(rectangle.right() + halfThickness, rectangle.bottom() - halfThickness, 0.0f), color));
+                    vertices.push_back(graphics::ColorVertex(Vector3(rectangle.right() - halfThickness, rectangle.bottom() + halfThickness, 0.0f), color));
 
                     // right top
-                    vertices.push_back(graphics::Vertex(Vector3(rectangle.right() + halfThickness, rectangle.top() + halfThickness, 0.0f), color,
-                                                        Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
-                    vertices.push_back(graphics::Vertex(Vector3(rectangle.right() - halfThickness, rectangle.top() - halfThickness, 0.0f), color,
-                                                        Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                    vertices.push_back(graphics::ColorVertex(Vector3(rectangle.right() + halfThickness, rectangle.top() + halfThickness, 0.0f), color));
+                    vertices.push_back(graphics::ColorVertex(Vector3(rectangle.right() - halfThickness, rectangle.top() - halfThickness, 0.0f), color));
 
                     // left top
-                    vertices.push_back(graphics::Vertex(Vector3(rectangle.left() - halfThickness, rectangle.top() + halfThickness, 0.0f), color,
-                                                        Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
-                    vertices.push_back(graphics::Vertex(Vector3(rectangle.left() + halfThickness, rectangle.top() - halfThickness, 0.0f), color,
-                                                        Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                    vertices.push_back(graphics::ColorVertex(Vector3(rectangle.left() - halfThickness, rectangle.top() + halfThickness, 0.0f), color));
+                    vertices.push_back(graphics::ColorVertex(Vector3(rectangle.left() + halfThickness, rectangle.top() - halfThickness, 0.0f), color));
 
                     command.indexCount = 24;
                     // bottom
@@ -454,7 +435,7 @@ namespace ouzel
 
                 for (uint16_t i = 0; i < edges.size(); ++i)
                 {
-                    vertices.push_back(graphics::Vertex(edges[i], color, Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                    vertices.push_back(graphics::ColorVertex(edges[i], color));
                 }
 
                 command.indexCount = static_cast<uint32_t>(edges.size() - 2) * 3;
@@ -479,7 +460,7 @@ namespace ouzel
 
                     for (uint16_t i = 0; i < edges.size(); ++i)
                     {
-                        vertices.push_back(graphics::Vertex(edges[i], color, Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                        vertices.push_back(graphics::ColorVertex(edges[i], color));
                     }
 
                     command.indexCount = static_cast<uint32_t>(edges.size()) + 1;
@@ -544,7 +525,7 @@ namespace ouzel
                     {
                         indices.push_back(startVertex + static_cast<uint16_t>(command.indexCount));
                         ++command.indexCount;
-                        vertices.push_back(graphics::Vertex(controlPoints[i], color, Vector2(), Vector3(0.0f, 0.0f, -1.0f)));
+                        vertices.push_back(graphics::ColorVertex(controlPoints[i], color));
                         boundingBox.insertPoint(controlPoints[i]);
                     }
                 }
@@ -556,7 +537,7 @@ namespace ouzel
                     {
                         float t = static_cast<float>(segment) / static_cast<float>(segments - 1);
 
-                        graphics::Vertex vertex(Vector3(), color, Vector2(), Vector3(0.0f, 0.0f, -1.0f));
+                        graphics::ColorVertex vertex(Vector3(), color);
 
                         for (uint16_t n = 0; n < controlPoints.size(); ++n)
                         {
@@ -10,21 +10,30 @@
 #include "files/FileSystem.hpp"
 #include "Layer.hpp"
 #include "assets/Cache.hpp"
+#include "utils/Log.hpp"
 
 namespace ouzel
 {
     namespace scene
     {
+        static const std::shared_ptr<const SpriteData::AnimationMap> EMPTY_ANIMATIONS = std::make_shared<SpriteData::AnimationMap>();
+        // nothing is drawn for animations that don't exist
+        static const SpriteData::Animation EMPTY_ANIMATION;
+
         Sprite::Sprite():
-            Component(TYPE)
+            Component(TYPE),
+            animations(EMPTY_ANIMATIONS)
         {
             whitePixelTexture = engine->getCache()->getTexture(graphics::TEXTURE_WHITE_PIXEL);
 
-            updateCallback.callback = std::bind(&Sprite::update, this, std::placeholders::_1);
-
             currentAnimation = animationQueue.end();
         }
 
+        Sprite::~Sprite()
+        {
+            if (animationSystem) animationSystem->removeSprite(this);
+        }
+
         Sprite::Sprite(const SpriteData& spriteData):
             Sprite()
         {
@@ -55,10 +64,17 @@ namespace ouzel
             material->shader = spriteData.shader ? spriteData.shader : engine->getCache()->getShader(graphics::SHADER_TEXTURE);
             material->textures[0] = spriteData.texture;
 
-            animations = spriteData.animations;
+            animations = spriteData.animations ? spriteData.animations : EMPTY_ANIMATIONS;
+
+            // the animations are shared, sprite data that was built by hand has to be packed once before it is used
+            if (SpriteData::hasUnpackedFrames(*animations))
+            {
+                Log(Log::Level::ERR) << "Sprite frames are not packed, call SpriteData::packFrames before creating the sprite";
+                return false;
+            }
 
             animationQueue.clear();
-            animationQueue.push_back({&animations[""], false});
+            animationQueue.push_back({&findAnimation(""), false});
             currentAnimation = animationQueue.begin();
 
             updateBoundingBox();
@@ -75,13 +91,13 @@ namespace ouzel
             material->shader = engine->getCache()->getShader(graphics::SHADER_TEXTURE);
             material->blendState = engine->getCache()->getBlendState(graphics::BLEND_ALPHA);
 
-            SpriteData spriteData = engine->getCache()->getSpriteData(filename, mipmaps, spritesX, spritesY, pivot);
+            const SpriteData& spriteData = engine->getCache()->getSpriteData(filename, mipmaps, spritesX, spritesY, pivot);
             material->textures[0] = spriteData.texture;
 
-            animations = spriteData.animations;
+            animations = spriteData.animations ? spriteData.animations : EMPTY_ANIMATIONS;
 
             animationQueue.clear();
-            animationQueue.push_back({&animations[""], false});
+            animationQueue.push_back({&findAnimation(""), false});
             currentAnimation = animationQueue.begin();
 
             updateBoundingBox();
@@ -98,32 +114,20 @@ namespace ouzel
             material->shader = engine->getCache()->getShader(graphics::SHADER_TEXTURE);
             material->blendState = engine->getCache()->getBlendState(graphics::BLEND_ALPHA);
             material->textures[0] = newTexture;
-            animations.clear();
-
-            Size2 spriteSize = Size2(material->textures[0]->getSize().width / spritesX,
-                                     material->textures[0]->getSize().height / spritesY);
 
-            SpriteData::Animation animation;
-            animation.frames.reserve(spritesX * spritesY);
+            // the frames are packed once per texture and grid by the cache
+            const SpriteData& spriteData = engine->getCache()->getSpriteData(newTexture, spritesX, spritesY, pivot);
 
-            for (uint32_t x = 0; x < spritesX; ++x)
+            if (!spriteData.animations)
             {
-                for (uint32_t y = 0; y < spritesY; ++y)
-                {
-                    Rect rectangle(spriteSize.width * x,
-                                   spriteSize.height * y,
-                                   spriteSize.width,
-                                   spriteSize.height);
-
-                    SpriteData::Frame frame = SpriteData::Frame("", newTexture->getSize(), rectangle, false, spriteSize, Vector2(), pivot);
-                    animation.frames.push_back(frame);
-                }
+                Log(Log::Level::ERR) << "Failed to create sprite frames";
+                return false;
             }
 
-            animations[""] = std::move(animation);
+            animations = spriteData.animations;
 
             animationQueue.clear();
-            animationQueue.push_back({&animations[""], false});
+            animationQueue.push_back({&findAnimation(""), false});
             currentAnimation = animationQueue.begin();
 
             updateBoundingBox();
@@ -227,7 +231,14 @@ namespace ouzel
                 size_t currentFrame = static_cast<size_t>(currentTime / currentAnimation->animation->frameInterval);
                 if (currentFrame >= currentAnimation->animation->frames.size()) currentFrame = currentAnimation->animation->frames.size() - 1;
 
-                Matrix4 modelViewProj = renderViewProjection * transformMatrix * offsetMatrix;
+                const SpriteData::Frame& frame = currentAnimation->animation->frames[currentFrame];
+
+                // frames without geometry
+                if (!frame.getIndexCount()) return;
+
+                // shaders that read the camera constant buffer apply the view projection themselves
+                Matrix4 modelViewProj = (material->shader && material->shader->isCameraConstantsUsed()) ?
+                    transformMatrix * offsetMatrix : renderViewProjection * transformMatrix * offsetMatrix;
                 float colorVector[] = {material->diffuseColor.normR(), material->diffuseColor.normG(), material->diffuseColor.normB(), material->diffuseColor.normA() * opacity * material->opacity};
 
                 std::vector<std::vector<float>> pixelShaderConstants(1);
@@ -245,10 +256,10 @@ namespace ouzel
                                                             pixelShaderConstants,
                                                             vertexShaderConstants,
                                                             material->blendState,
-                                                            currentAnimation->animation->frames[currentFrame].getMeshBuffer(),
-                                                            0,
+                                                            frame.getMeshBuffer(),
+                                                            frame.getIndexCount(),
                                                             graphics::Renderer::DrawMode::TRIANGLE_LIST,
-                                                            0,
+                                                            frame.getStartIndex(),
                                                             renderTarget,
                                                             renderViewport,
                                                             depthWrite,
@@ -271,7 +282,7 @@ namespace ouzel
         {
             if (!playing)
             {
-                engine->scheduleUpdate(&updateCallback);
+                engine->getSceneManager()->getAnimationSystem()->addSprite(this);
                 playing = true;
                 running = true;
             }
@@ -283,7 +294,7 @@ namespace ouzel
             {
                 playing = false;
                 running = false;
-                updateCallback.remove();
+                if (animationSystem) animationSystem->removeSprite(this);
             }
 
             if (resetAnimation) reset();
@@ -299,17 +310,23 @@ namespace ouzel
 
         bool Sprite::hasAnimation(const std::string& animation) const
         {
-            auto i = animations.find(animation);
+            auto i = animations->find(animation);
+
+            return i != animations->end();
+        }
+
+        const SpriteData::Animation& Sprite::findAnimation(const std::string& name) const
+        {
+            auto i = animations->find(name);
 
-            return i != animations.end();
+            return (i != animations->end()) ? i->second : EMPTY_ANIMATION;
         }
 
         void Sprite::setAnimation(const std::string& newAnimation, bool repeat)
         {
             animationQueue.clear();
 
-            const SpriteData::Animation& animation = animations[newAnimation];
-            animationQueue.push_back({&animation, repeat});
+            animationQueue.push_back({&findAnimation(newAnimation), repeat});
             currentAnimation = animationQueue.begin();
             running = true;
 
@@ -318,8 +335,7 @@ namespace ouzel
 
         void Sprite::addAnimation(const std::string& newAnimation, bool repeat)
         {
-            const SpriteData::Animation& animation = animations[newAnimation];
-            animationQueue.push_back({&animation, repeat});
+            animationQueue.push_back({&findAnimation(newAnimation), repeat});
             running = true;
         }
 
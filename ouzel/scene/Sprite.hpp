@@ -8,7 +8,7 @@
 #include "math/Size2.hpp"
 #include "math/Vector2.hpp"
 #include "scene/SpriteData.hpp"
-#include "core/UpdateCallback.hpp"
+#include "scene/AnimationSystem.hpp"
 #include "graphics/Material.hpp"
 
 namespace ouzel
@@ -19,10 +19,12 @@ namespace ouzel
 
         class Sprite: public Component
         {
+            friend AnimationSystem;
         public:
             static const uint32_t TYPE = Component::SPRITE;
 
             Sprite();
+            virtual ~Sprite();
             Sprite(const SpriteData& spriteData);
             Sprite(const std::string& filename, bool mipmaps = true,
                    uint32_t spritesX = 1, uint32_t spritesY = 1,
@@ -63,7 +65,7 @@ namespace ouzel
             void reset();
             inline bool isPlaying() const { return playing; }
 
-            inline const std::map<std::string, SpriteData::Animation>& getAnimations() const { return animations; }
+            inline const SpriteData::AnimationMap& getAnimations() const { return *animations; }
             inline const SpriteData::Animation* getAnimation() const { return currentAnimation->animation; }
             inline std::string getAnimationName() const { return currentAnimation->animation->name; }
             bool hasAnimation(const std::string& animation) const;
@@ -74,9 +76,10 @@ namespace ouzel
 
         protected:
             void updateBoundingBox();
+            const SpriteData::Animation& findAnimation(const std::string& name) const;
 
             std::shared_ptr<graphics::Material> material;
-            std::map<std::string, SpriteData::Animation> animations;
+            std::shared_ptr<const SpriteData::AnimationMap> animations; // shared with the SpriteData, never null
 
             struct QueuedAnimation
             {
@@ -96,7 +99,8 @@ namespace ouzel
             bool running = false;
             float currentTime = 0.0f;
 
-            UpdateCallback updateCallback;
+            AnimationSystem* animationSystem = nullptr;
+            uint32_t animationIndex = AnimationSystem::INVALID_INDEX;
         };
     } // namespace scene
 } // namespace ouzel
@@ -1,6 +1,7 @@
 // Copyright (C) 2018 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <limits>
 #include "SpriteData.hpp"
 #include "utils/Utils.hpp"
 
@@ -15,10 +16,8 @@ namespace ouzel
                                  const Size2& sourceSize,
                                  const Vector2& sourceOffset,
                                  const Vector2& pivot):
-            name(frameName)
+            name(frameName), indices({0, 1, 2, 1, 3, 2})
         {
-            std::vector<uint16_t> indices = {0, 1, 2, 1, 3, 2};
-
             Vector2 textCoords[4];
             Vector2 finalOffset(-sourceSize.width * pivot.x + sourceOffset.x,
                                 -sourceSize.height * pivot.y + (sourceSize.height - frameRectangle.size.height - sourceOffset.y));
@@ -50,59 +49,41 @@ namespace ouzel
                 textCoords[3] = Vector2(rightBottom.x, rightBottom.y);
             }
 
-            std::vector<graphics::Vertex> vertices = {
-                graphics::Vertex(Vector3(finalOffset.x, finalOffset.y, 0.0f), Color::WHITE,
-                                 textCoords[0], Vector3(0.0f, 0.0f, -1.0f)),
-                graphics::Vertex(Vector3(finalOffset.x + frameRectangle.size.width, finalOffset.y, 0.0f), Color::WHITE,
-                                 textCoords[1], Vector3(0.0f, 0.0f, -1.0f)),
-                graphics::Vertex(Vector3(finalOffset.x, finalOffset.y + frameRectangle.size.height, 0.0f),  Color::WHITE,
-                                 textCoords[2], Vector3(0.0f, 0.0f, -1.0f)),
-                graphics::Vertex(Vector3(finalOffset.x + frameRectangle.size.width, finalOffset.y + frameRectangle.size.height, 0.0f),  Color::WHITE,
-                                 textCoords[3], Vector3(0.0f, 0.0f, -1.0f))
+            vertices = {
+                graphics::TextureVertex(Vector3(finalOffset.x, finalOffset.y, 0.0f), Color::WHITE,
+                                        textCoords[0]),
+                graphics::TextureVertex(Vector3(finalOffset.x + frameRectangle.size.width, finalOffset.y, 0.0f), Color::WHITE,
+                                        textCoords[1]),
+                graphics::TextureVertex(Vector3(finalOffset.x, finalOffset.y + frameRectangle.size.height, 0.0f),  Color::WHITE,
+                                        textCoords[2]),
+                graphics::TextureVertex(Vector3(finalOffset.x + frameRectangle.size.width, finalOffset.y + frameRectangle.size.height, 0.0f),  Color::WHITE,
+                                        textCoords[3])
             };
 
             boundingBox.set(finalOffset, finalOffset + Vector2(frameRectangle.size.width, frameRectangle.size.height));
-
-            indexBuffer = std::make_shared<graphics::Buffer>();
-            indexBuffer->init(graphics::Buffer::Usage::INDEX, indices.data(), static_cast<uint32_t>(getVectorSize(indices)), 0);
-
-            vertexBuffer = std::make_shared<graphics::Buffer>();
-            vertexBuffer->init(graphics::Buffer::Usage::VERTEX, vertices.data(), static_cast<uint32_t>(getVectorSize(vertices)), 0);
-
-            meshBuffer = std::make_shared<graphics::MeshBuffer>();
-            meshBuffer->init(sizeof(uint16_t), indexBuffer, vertexBuffer);
         }
 
         SpriteData::Frame::Frame(const std::string& frameName,
-                                 const std::vector<uint16_t>& indices,
-                                 const std::vector<graphics::Vertex>& vertices):
-            name(frameName)
+                                 const std::vector<uint16_t>& frameIndices,
+                                 const std::vector<graphics::TextureVertex>& frameVertices):
+            name(frameName), indices(frameIndices), vertices(frameVertices)
         {
-            for (const graphics::Vertex& vertex : vertices)
+            for (const graphics::TextureVertex& vertex : vertices)
             {
                 boundingBox.insertPoint(vertex.position);
             }
-
-            indexBuffer = std::make_shared<graphics::Buffer>();
-            indexBuffer->init(graphics::Buffer::Usage::INDEX, indices.data(), static_cast<uint32_t>(getVectorSize(indices)), 0);
-
-            vertexBuffer = std::make_shared<graphics::Buffer>();
-            vertexBuffer->init(graphics::Buffer::Usage::VERTEX, vertices.data(), static_cast<uint32_t>(getVectorSize(vertices)), 0);
-
-            meshBuffer = std::make_shared<graphics::MeshBuffer>();
-            meshBuffer->init(sizeof(uint16_t), indexBuffer, vertexBuffer);
         }
 
         SpriteData::Frame::Frame(const std::string& frameName,
-                                 const std::vector<uint16_t>& indices,
-                                 const std::vector<graphics::Vertex>& vertices,
+                                 const std::vector<uint16_t>& frameIndices,
+                                 const std::vector<graphics::TextureVertex>& frameVertices,
                                  const Rect& frameRectangle,
                                  const Size2& sourceSize,
                                  const Vector2& sourceOffset,
                                  const Vector2& pivot):
-            name(frameName)
+            name(frameName), indices(frameIndices), vertices(frameVertices)
         {
-            for (const graphics::Vertex& vertex : vertices)
+            for (const graphics::TextureVertex& vertex : vertices)
             {
                 boundingBox.insertPoint(vertex.position);
             }
@@ -110,15 +91,128 @@ namespace ouzel
             // TODO: fix
             Vector2 finalOffset(-sourceSize.width * pivot.x + sourceOffset.x,
                                 -sourceSize.height * pivot.y + (sourceSize.height - frameRectangle.size.height - sourceOffset.y));
+        }
+
+        bool SpriteData::hasUnpackedFrames(const AnimationMap& animationMap)
+        {
+            for (const auto& animation : animationMap)
+            {
+                for (const Frame& frame : animation.second.frames)
+                {
+                    if (!frame.meshBuffer && !frame.indices.empty()) return true;
+                }
+            }
+
+            return false;
+        }
+
+        bool SpriteData::createGrid(AnimationMap& animationMap, const std::string& frameName, const Size2& textureSize,
+                                    uint32_t spritesX, uint32_t spritesY, const Vector2& pivot)
+        {
+            if (spritesX == 0) spritesX = 1;
+            if (spritesY == 0) spritesY = 1;
+
+            Size2 spriteSize = Size2(textureSize.width / spritesX,
+                                     textureSize.height / spritesY);
+
+            Animation animation;
+            animation.frames.reserve(spritesX * spritesY);
+
+            for (uint32_t x = 0; x < spritesX; ++x)
+            {
+                for (uint32_t y = 0; y < spritesY; ++y)
+                {
+                    Rect rectangle(spriteSize.width * x,
+                                   spriteSize.height * y,
+                                   spriteSize.width,
+                                   spriteSize.height);
+
+                    animation.frames.push_back(Frame(frameName, textureSize, rectangle, false, spriteSize, Vector2(), pivot));
+                }
+            }
 
-            indexBuffer = std::make_shared<graphics::Buffer>();
-            indexBuffer->init(graphics::Buffer::Usage::INDEX, indices.data(), static_cast<uint32_t>(getVectorSize(indices)), 0);
+            animationMap[""] = std::move(animation);
 
-            vertexBuffer = std::make_shared<graphics::Buffer>();
-            vertexBuffer->init(graphics::Buffer::Usage::VERTEX, vertices.data(), static_cast<uint32_t>(getVectorSize(vertices)), 0);
+            return packFrames(animationMap);
+        }
+
+        bool SpriteData::packFrames(AnimationMap& animationMap)
+        {
+            size_t indexCount = 0;
+            size_t vertexCount = 0;
+
+            for (auto& animation : animationMap)
+            {
+                for (const Frame& frame : animation.second.frames)
+                {
+                    if (frame.meshBuffer) continue;
+
+                    indexCount += frame.indices.size();
+                    vertexCount += frame.vertices.size();
+                }
+            }
+
+            if (!indexCount) return true;
+
+            // 16-bit indices are enough unless the sheet has lots of polygon frames
+            bool wideIndices = vertexCount > std::numeric_limits<uint16_t>::max();
+            uint32_t indexSize = wideIndices ? sizeof(uint32_t) : sizeof(uint16_t);
+
+            std::vector<uint8_t> indexData;
+            indexData.reserve(indexCount * indexSize);
+            std::vector<graphics::TextureVertex> vertexData;
+            vertexData.reserve(vertexCount);
+
+            std::shared_ptr<graphics::MeshBuffer> meshBuffer = std::make_shared<graphics::MeshBuffer>();
+
+            for (auto& animation : animationMap)
+            {
+                for (Frame& frame : animation.second.frames)
+                {
+                    // frames that have already been packed keep their mesh buffer
+                    if (frame.meshBuffer) continue;
+
+                    uint32_t baseVertex = static_cast<uint32_t>(vertexData.size());
+
+                    frame.meshBuffer = meshBuffer;
+                    frame.startIndex = static_cast<uint32_t>(indexData.size() / indexSize);
+                    frame.indexCount = static_cast<uint32_t>(frame.indices.size());
+
+                    // indices are rebased, because not all of the render devices support a base vertex
+                    for (uint16_t index : frame.indices)
+                    {
+                        if (wideIndices)
+                        {
+                            uint32_t packedIndex = baseVertex + index;
+                            indexData.insert(indexData.end(), reinterpret_cast<uint8_t*>(&packedIndex), reinterpret_cast<uint8_t*>(&packedIndex) + sizeof(packedIndex));
+                        }
+                        else
+                        {
+                            uint16_t packedIndex = static_cast<uint16_t>(baseVertex + index);
+                            indexData.insert(indexData.end(), reinterpret_cast<uint8_t*>(&packedIndex), reinterpret_cast<uint8_t*>(&packedIndex) + sizeof(packedIndex));
+                        }
+                    }
+
+                    vertexData.insert(vertexData.end(), frame.vertices.begin(), frame.vertices.end());
+
+                    std::vector<uint16_t>().swap(frame.indices);
+                    std::vector<graphics::TextureVertex>().swap(frame.vertices);
+                }
+            }
+
+            std::shared_ptr<graphics::Buffer> indexBuffer = std::make_shared<graphics::Buffer>();
+            if (!indexBuffer->init(graphics::Buffer::Usage::INDEX, indexData, 0))
+            {
+                return false;
+            }
+
+            std::shared_ptr<graphics::Buffer> vertexBuffer = std::make_shared<graphics::Buffer>();
+            if (!vertexBuffer->init(graphics::Buffer::Usage::VERTEX, vertexData.data(), static_cast<uint32_t>(getVectorSize(vertexData)), 0))
+            {
+                return false;
+            }
 
-            meshBuffer = std::make_shared<graphics::MeshBuffer>();
-            meshBuffer->init(sizeof(uint16_t), indexBuffer, vertexBuffer);
+            return meshBuffer->init(indexSize, indexBuffer, vertexBuffer, graphics::TextureVertex::LAYOUT);
         }
     } // namespace scene
 } // namespace ouzel
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <vector>
 #include "math/Box2.hpp"
 #include "math/Rect.hpp"
@@ -32,11 +33,11 @@ namespace ouzel
 
                 Frame(const std::string& frameName,
                       const std::vector<uint16_t>& indices,
-                      const std::vector<graphics::Vertex>& vertices);
+                      const std::vector<graphics::TextureVertex>& vertices);
 
                 Frame(const std::string& frameName,
                       const std::vector<uint16_t>& indices,
-                      const std::vector<graphics::Vertex>& vertices,
+                      const std::vector<graphics::TextureVertex>& vertices,
                       const Rect& frameRectangle,
                       const Size2& sourceSize,
                       const Vector2& sourceOffset,
@@ -45,14 +46,24 @@ namespace ouzel
                 inline const std::string& getName() const { return name; }
 
                 inline const Box2& getBoundingBox() const { return boundingBox; }
+
+                // valid after SpriteData::packFrames, all frames of a sprite sheet share the mesh buffer
                 inline const std::shared_ptr<graphics::MeshBuffer>& getMeshBuffer() const { return meshBuffer; }
+                inline uint32_t getStartIndex() const { return startIndex; }
+                inline uint32_t getIndexCount() const { return indexCount; }
 
             protected:
+                friend SpriteData;
+
                 std::string name;
                 Box2 boundingBox;
                 std::shared_ptr<graphics::MeshBuffer> meshBuffer;
-                std::shared_ptr<graphics::Buffer> indexBuffer;
-                std::shared_ptr<graphics::Buffer> vertexBuffer;
+                uint32_t startIndex = 0;
+                uint32_t indexCount = 0;
+
+                // geometry waiting to be packed
+                std::vector<uint16_t> indices;
+                std::vector<graphics::TextureVertex> vertices;
             };
 
             struct Animation
@@ -62,7 +73,17 @@ namespace ouzel
                 float frameInterval = 0.1f;
             };
 
-            std::map<std::string, Animation> animations;
+            typedef std::map<std::string, Animation> AnimationMap;
+
+            // uploads the geometry of all frames that don't have a mesh buffer yet into one index and vertex buffer
+            static bool packFrames(AnimationMap& animationMap);
+            static bool hasUnpackedFrames(const AnimationMap& animationMap);
+            // splits the texture into spritesX by spritesY frames of the default animation and packs them
+            static bool createGrid(AnimationMap& animationMap, const std::string& frameName, const Size2& textureSize,
+                                   uint32_t spritesX, uint32_t spritesY, const Vector2& pivot);
+
+            // immutable once loaded, shared by all of the sprites created from this data, the frames must be packed
+            std::shared_ptr<const AnimationMap> animations;
             std::shared_ptr<graphics::Texture> texture;
             std::shared_ptr<graphics::BlendState> blendState;
             std::shared_ptr<graphics::Shader> shader;
@@ -36,7 +36,7 @@ namespace ouzel
             vertexBuffer->init(graphics::Buffer::Usage::VERTEX, graphics::Buffer::DYNAMIC);
 
             meshBuffer = std::make_shared<graphics::MeshBuffer>();
-            meshBuffer->init(sizeof(uint16_t), indexBuffer, vertexBuffer);
+            meshBuffer->init(sizeof(uint16_t), indexBuffer, vertexBuffer, graphics::TextureVertex::LAYOUT);
 
             font = engine->getCache()->getFont(fontFile, mipmaps);
 
@@ -94,7 +94,8 @@ namespace ouzel
                 needsMeshUpdate = false;
             }
 
-            Matrix4 modelViewProj = renderViewProjection * transformMatrix;
+            // shaders that read the camera constant buffer apply the view projection themselves
+            Matrix4 modelViewProj = (shader && shader->isCameraConstantsUsed()) ? transformMatrix : renderViewProjection * transformMatrix;
             float colorVector[] = {color.normR(), color.normG(), color.normB(), color.normA() * opacity};
 
             std::vector<std::vector<float>> pixelShaderConstants(1);
@@ -143,7 +144,7 @@ namespace ouzel
                 font->getVertices(text, Color::WHITE, fontSize, textAnchor, indices, vertices, texture);
                 needsMeshUpdate = true;
 
-                for (const graphics::Vertex& vertex : vertices)
+                for (const graphics::TextureVertex& vertex : vertices)
                 {
                     boundingBox.insertPoint(Vector2(vertex.position.x, vertex.position.y));
                 }
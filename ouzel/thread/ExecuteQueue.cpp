@@ -0,0 +1,86 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include "ExecuteQueue.hpp"
+
+namespace ouzel
+{
+    ExecuteQueue::ExecuteQueue(uint32_t initCapacity):
+        enqueuePosition(0), overflowing(false)
+    {
+        // the capacity must be a power of two, so that the position can be masked
+        size_t capacity = 2;
+        while (capacity < initCapacity) capacity <<= 1;
+
+        cells.reset(new Cell[capacity]);
+        mask = capacity - 1;
+
+        for (size_t i = 0; i < capacity; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    ExecuteQueue::~ExecuteQueue()
+    {
+        for (;;)
+        {
+            Cell& cell = cells[dequeuePosition & mask];
+            if (cell.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) break;
+
+            cell.task.destroy(cell.task.storage);
+            ++dequeuePosition;
+        }
+
+        for (Task& task : overflow)
+            task.destroy(task.storage);
+    }
+
+    uint32_t ExecuteQueue::executeAll()
+    {
+        uint32_t count = 0;
+        std::vector<Task> batch;
+
+        for (;;)
+        {
+            uint32_t previousCount = count;
+
+            for (;;)
+            {
+                Cell& cell = cells[dequeuePosition & mask];
+
+                // stops at the first cell that is empty or is still being written
+                if (cell.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) break;
+
+                cell.task.invoke(cell.task.storage);
+                cell.task.destroy(cell.task.storage);
+                cell.sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+                ++dequeuePosition;
+                ++count;
+            }
+
+            // the overflow holds functions that were pushed after everything in the ring,
+            // so it can be executed only after the ring has been drained
+            if (overflowing.load(std::memory_order_acquire) &&
+                enqueuePosition.load(std::memory_order_acquire) == dequeuePosition)
+            {
+                {
+                    Lock lock(overflowMutex);
+                    batch.swap(overflow);
+                    overflowing.store(false, std::memory_order_release);
+                }
+
+                for (Task& task : batch)
+                {
+                    task.invoke(task.storage);
+                    task.destroy(task.storage);
+                    ++count;
+                }
+
+                batch.clear();
+            }
+
+            if (count == previousCount) break;
+        }
+
+        return count;
+    }
+}
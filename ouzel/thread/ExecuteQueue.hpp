@@ -0,0 +1,129 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "thread/Lock.hpp"
+#include "thread/Mutex.hpp"
+
+namespace ouzel
+{
+    // queue of functions that any thread can add to and a single thread executes,
+    // functions that fit into STORAGE_SIZE bytes are stored in the queue without allocating memory
+    class ExecuteQueue final
+    {
+    public:
+        static const size_t STORAGE_SIZE = 96;
+        static const uint32_t DEFAULT_CAPACITY = 1024;
+
+        explicit ExecuteQueue(uint32_t initCapacity = DEFAULT_CAPACITY);
+        ~ExecuteQueue();
+
+        ExecuteQueue(const ExecuteQueue&) = delete;
+        ExecuteQueue& operator=(const ExecuteQueue&) = delete;
+
+        ExecuteQueue(ExecuteQueue&&) = delete;
+        ExecuteQueue& operator=(ExecuteQueue&&) = delete;
+
+        // can be called from any thread, functions from the same thread are executed in the order they were pushed
+        template<class F> void push(F&& function)
+        {
+            typedef typename std::decay<F>::type T;
+
+            if (!overflowing.load(std::memory_order_acquire))
+            {
+                size_t position = enqueuePosition.load(std::memory_order_relaxed);
+
+                for (;;)
+                {
+                    Cell& cell = cells[position & mask];
+                    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                    intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+                    if (difference == 0)
+                    {
+                        if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        {
+                            construct<T>(cell.task, std::forward<F>(function), std::integral_constant<bool, IsInline<T>::value>());
+                            cell.sequence.store(position + 1, std::memory_order_release);
+                            return;
+                        }
+                    }
+                    else if (difference < 0) // the ring is full
+                        break;
+                    else
+                        position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            Task task;
+            construct<T>(task, std::forward<F>(function), std::false_type());
+
+            Lock lock(overflowMutex);
+            overflow.push_back(task);
+            overflowing.store(true, std::memory_order_release);
+        }
+
+        // must be called only from the consumer thread, executes the functions until the queue is empty,
+        // returns the number of executed functions
+        uint32_t executeAll();
+
+    private:
+        typedef std::aligned_storage<STORAGE_SIZE>::type Storage;
+
+        template<class T> struct IsInline:
+            std::integral_constant<bool, sizeof(T) <= sizeof(Storage) && alignof(T) <= alignof(Storage)> {};
+
+        struct Task
+        {
+            void (*invoke)(Storage& storage);
+            void (*destroy)(Storage& storage);
+            Storage storage;
+        };
+
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            Task task;
+        };
+
+        template<class T, class F> static void construct(Task& task, F&& function, std::true_type)
+        {
+            new (&task.storage) T(std::forward<F>(function));
+            task.invoke = [](Storage& storage) { (*reinterpret_cast<T*>(&storage))(); };
+            task.destroy = [](Storage& storage) { reinterpret_cast<T*>(&storage)->~T(); };
+        }
+
+        // functions that don't fit into the storage and the ones in the overflow list are allocated on the heap,
+        // so that the task only holds a pointer and can be copied
+        template<class T, class F> static void construct(Task& task, F&& function, std::false_type)
+        {
+            *reinterpret_cast<T**>(&task.storage) = new T(std::forward<F>(function));
+            task.invoke = [](Storage& storage) { (**reinterpret_cast<T**>(&storage))(); };
+            task.destroy = [](Storage& storage) { delete *reinterpret_cast<T**>(&storage); };
+        }
+
+        std::unique_ptr<Cell[]> cells;
+        size_t mask;
+
+        // positions are kept on separate cache lines
+        char padding0[64];
+        std::atomic<size_t> enqueuePosition;
+        char padding1[64];
+        size_t dequeuePosition = 0;
+        char padding2[64];
+
+        // used when the ring is full, until the consumer has drained it
+        Mutex overflowMutex;
+        std::vector<Task> overflow;
+        std::atomic<bool> overflowing;
+    };
+}
@@ -0,0 +1,287 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include <thread>
+#include "JobSystem.hpp"
+#include "thread/Lock.hpp"
+
+namespace ouzel
+{
+    // parallelFor doesn't split the work into more ranges than this per thread
+    static const uint32_t RANGES_PER_THREAD = 4;
+
+    bool JobSystem::Handle::isFinished() const
+    {
+        return !job || job->finished;
+    }
+
+    JobSystem::JobSystem(uint32_t initWorkerCount):
+        queuedJobCount(0), sleepingWorkerCount(0), running(true)
+    {
+        // workers wait for the lock before looking at the worker list, so the list is complete by then
+        Lock lock(sleepMutex);
+
+        for (uint32_t i = 0; i < initWorkerCount; ++i)
+        {
+            std::unique_ptr<Worker> worker(new Worker());
+            worker->executedJobs = 0;
+            worker->stolenJobs = 0;
+            worker->sleeps = 0;
+            workers.push_back(std::move(worker));
+        }
+
+        for (uint32_t i = 0; i < initWorkerCount; ++i)
+            workers[i]->thread = Thread(std::bind(&JobSystem::main, this, i), "Worker");
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            Lock lock(sleepMutex);
+            running = false;
+            sleepCondition.broadcast();
+        }
+
+        for (const std::unique_ptr<Worker>& worker : workers)
+            if (worker->thread.isJoinable()) worker->thread.join();
+    }
+
+    JobSystem::Handle JobSystem::schedule(const std::function<void()>& function,
+                                          const std::vector<Handle>& dependencies)
+    {
+        std::shared_ptr<Job> job = std::make_shared<Job>();
+        job->function = function;
+        job->finished = false;
+        job->pendingDependencies = 1; // released below, after all of the dependencies are registered
+
+        for (const Handle& dependency : dependencies)
+        {
+            if (!dependency.job) continue;
+
+            Lock lock(dependency.job->mutex);
+            if (!dependency.job->finished)
+            {
+                ++job->pendingDependencies;
+                dependency.job->continuations.push_back(job);
+            }
+        }
+
+        if (--job->pendingDependencies == 0) enqueue(job);
+
+        return Handle(job);
+    }
+
+    void JobSystem::wait(const Handle& handle)
+    {
+        if (!handle.job) return;
+
+        uint32_t workerIndex = getCurrentWorker();
+
+        while (!handle.job->finished)
+        {
+            bool stolen = false;
+            std::shared_ptr<Job> job = findJob(workerIndex, stolen);
+
+            if (job)
+            {
+                execute(job);
+
+                if (workerIndex != INVALID_WORKER)
+                {
+                    ++workers[workerIndex]->executedJobs;
+                    if (stolen) ++workers[workerIndex]->stolenJobs;
+                }
+            }
+            else
+                std::this_thread::yield(); // the job or its dependencies are running on other threads
+        }
+    }
+
+    void JobSystem::parallelFor(uint32_t count,
+                                const std::function<void(uint32_t begin, uint32_t end)>& function,
+                                uint32_t granularity)
+    {
+        if (!count) return;
+        if (!granularity) granularity = 1;
+
+        uint32_t maxRanges = (getWorkerCount() + 1) * RANGES_PER_THREAD;
+        uint32_t rangeCount = std::max(1U, std::min(maxRanges, count / granularity));
+
+        if (rangeCount == 1)
+        {
+            function(0, count);
+            return;
+        }
+
+        std::vector<Handle> handles;
+        handles.reserve(rangeCount);
+
+        for (uint32_t i = 0; i < rangeCount; ++i)
+        {
+            uint32_t begin = static_cast<uint32_t>(static_cast<uint64_t>(count) * i / rangeCount);
+            uint32_t end = static_cast<uint32_t>(static_cast<uint64_t>(count) * (i + 1) / rangeCount);
+
+            handles.push_back(schedule(std::bind(function, begin, end)));
+        }
+
+        for (const Handle& handle : handles)
+            wait(handle);
+    }
+
+    std::vector<JobSystem::WorkerStatistics> JobSystem::getStatistics() const
+    {
+        std::vector<WorkerStatistics> result(workers.size());
+
+        for (size_t i = 0; i < workers.size(); ++i)
+        {
+            result[i].executedJobs = workers[i]->executedJobs;
+            result[i].stolenJobs = workers[i]->stolenJobs;
+            result[i].sleeps = workers[i]->sleeps;
+        }
+
+        return result;
+    }
+
+    void JobSystem::main(uint32_t workerIndex)
+    {
+        {
+            Lock lock(sleepMutex);
+        }
+
+        Worker& worker = *workers[workerIndex];
+
+        while (running)
+        {
+            bool stolen = false;
+            std::shared_ptr<Job> job = findJob(workerIndex, stolen);
+
+            if (job)
+            {
+                execute(job);
+
+                ++worker.executedJobs;
+                if (stolen) ++worker.stolenJobs;
+            }
+            else
+            {
+                // the counter is raised before checking for jobs, so enqueue either sees it or the job is found here
+                ++sleepingWorkerCount;
+
+                {
+                    Lock lock(sleepMutex);
+                    if (running && queuedJobCount == 0)
+                    {
+                        ++worker.sleeps;
+                        sleepCondition.wait(sleepMutex);
+                    }
+                }
+
+                --sleepingWorkerCount;
+            }
+        }
+    }
+
+    uint32_t JobSystem::getCurrentWorker() const
+    {
+        Thread::ID currentThreadId = Thread::getCurrentThreadId();
+
+        for (uint32_t i = 0; i < workers.size(); ++i)
+            if (workers[i]->thread.getId() == currentThreadId) return i;
+
+        return INVALID_WORKER;
+    }
+
+    void JobSystem::enqueue(const std::shared_ptr<Job>& job)
+    {
+        uint32_t workerIndex = getCurrentWorker();
+
+        // counted before it is pushed, so that the count never drops below the number of queued jobs
+        ++queuedJobCount;
+
+        if (workerIndex != INVALID_WORKER)
+        {
+            Lock lock(workers[workerIndex]->mutex);
+            workers[workerIndex]->jobs.push_back(job);
+        }
+        else
+        {
+            Lock lock(queueMutex);
+            queue.push_back(job);
+        }
+
+        if (sleepingWorkerCount)
+        {
+            Lock lock(sleepMutex);
+            sleepCondition.signal();
+        }
+    }
+
+    std::shared_ptr<JobSystem::Job> JobSystem::findJob(uint32_t workerIndex, bool& stolen)
+    {
+        std::shared_ptr<Job> result;
+        stolen = false;
+
+        if (!queuedJobCount) return result;
+
+        // the newest job of the own queue is the most likely to have its data in the cache
+        if (workerIndex != INVALID_WORKER)
+        {
+            Worker& worker = *workers[workerIndex];
+            Lock lock(worker.mutex);
+
+            if (!worker.jobs.empty())
+            {
+                result = std::move(worker.jobs.back());
+                worker.jobs.pop_back();
+            }
+        }
+
+        if (!result)
+        {
+            Lock lock(queueMutex);
+
+            if (!queue.empty())
+            {
+                result = std::move(queue.front());
+                queue.pop_front();
+            }
+        }
+
+        // steal the oldest job from the other workers
+        for (uint32_t i = 1; !result && i <= workers.size(); ++i)
+        {
+            uint32_t victimIndex = (workerIndex == INVALID_WORKER) ? i - 1 : static_cast<uint32_t>((workerIndex + i) % workers.size());
+            if (victimIndex == workerIndex) continue;
+
+            Worker& victim = *workers[victimIndex];
+            Lock lock(victim.mutex);
+
+            if (!victim.jobs.empty())
+            {
+                result = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+                stolen = true;
+            }
+        }
+
+        if (result) --queuedJobCount;
+
+        return result;
+    }
+
+    void JobSystem::execute(const std::shared_ptr<Job>& job)
+    {
+        if (job->function) job->function();
+
+        std::vector<std::shared_ptr<Job>> continuations;
+        {
+            Lock lock(job->mutex);
+            job->finished = true;
+            continuations.swap(job->continuations);
+        }
+
+        for (const std::shared_ptr<Job>& continuation : continuations)
+            if (--continuation->pendingDependencies == 0) enqueue(continuation);
+    }
+}
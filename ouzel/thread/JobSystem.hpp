@@ -0,0 +1,114 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "thread/Condition.hpp"
+#include "thread/Mutex.hpp"
+#include "thread/Thread.hpp"
+
+namespace ouzel
+{
+    // thread pool where every worker has its own job queue and steals from the others when it runs out
+    class JobSystem final
+    {
+        struct Job;
+    public:
+        static const uint32_t INVALID_WORKER = 0xFFFFFFFF;
+
+        class Handle final
+        {
+            friend JobSystem;
+        public:
+            Handle() {}
+
+            inline bool isValid() const { return job != nullptr; }
+            bool isFinished() const;
+
+        private:
+            explicit Handle(const std::shared_ptr<Job>& initJob): job(initJob) {}
+
+            std::shared_ptr<Job> job;
+        };
+
+        struct WorkerStatistics
+        {
+            uint64_t executedJobs = 0;
+            uint64_t stolenJobs = 0;
+            uint64_t sleeps = 0;
+        };
+
+        // with no workers the jobs are run by the thread that waits for them in the order they were scheduled
+        explicit JobSystem(uint32_t initWorkerCount);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        JobSystem(JobSystem&&) = delete;
+        JobSystem& operator=(JobSystem&&) = delete;
+
+        inline uint32_t getWorkerCount() const { return static_cast<uint32_t>(workers.size()); }
+
+        // the job is started after all of the dependencies have finished
+        Handle schedule(const std::function<void()>& function,
+                        const std::vector<Handle>& dependencies = std::vector<Handle>());
+
+        // runs other jobs on the calling thread until the job has finished
+        void wait(const Handle& handle);
+
+        // calls the function with ranges of at least granularity elements that together cover [0, count),
+        // returns after all of the ranges are processed
+        void parallelFor(uint32_t count,
+                         const std::function<void(uint32_t begin, uint32_t end)>& function,
+                         uint32_t granularity = 1);
+
+        std::vector<WorkerStatistics> getStatistics() const;
+
+    private:
+        struct Job
+        {
+            std::function<void()> function;
+            std::atomic<uint32_t> pendingDependencies;
+            std::atomic<bool> finished;
+
+            Mutex mutex;
+            std::vector<std::shared_ptr<Job>> continuations;
+        };
+
+        struct Worker
+        {
+            Thread thread;
+            Mutex mutex;
+            std::deque<std::shared_ptr<Job>> jobs;
+
+            std::atomic<uint64_t> executedJobs;
+            std::atomic<uint64_t> stolenJobs;
+            std::atomic<uint64_t> sleeps;
+        };
+
+        void main(uint32_t workerIndex);
+        uint32_t getCurrentWorker() const;
+        void enqueue(const std::shared_ptr<Job>& job);
+        std::shared_ptr<Job> findJob(uint32_t workerIndex, bool& stolen);
+        void execute(const std::shared_ptr<Job>& job);
+
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        // jobs scheduled from threads that are not workers
+        Mutex queueMutex;
+        std::deque<std::shared_ptr<Job>> queue;
+
+        Mutex sleepMutex;
+        Condition sleepCondition;
+        std::atomic<uint32_t> queuedJobCount;
+        std::atomic<uint32_t> sleepingWorkerCount;
+        std::atomic<bool> running;
+    };
+}
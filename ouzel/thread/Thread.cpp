@@ -1,7 +1,10 @@
 // Copyright (C) 2018 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <utility>
+#include <vector>
 #include "Thread.hpp"
+#include "Lock.hpp"
 
 #if defined(_MSC_VER)
 static const DWORD MS_VC_EXCEPTION = 0x406D1388;
@@ -37,6 +40,29 @@ static void* threadFunction(void* parameter)
 
 namespace ouzel
 {
+    // names are kept after the threads exit, only a handful of threads are ever named
+    static Mutex threadNameMutex;
+    static std::vector<std::pair<Thread::ID, std::string>> threadNames;
+
+    // kept out of setCurrentThreadName, because MSVC doesn't allow __try in functions with destructors
+    static void storeThreadName(const std::string& name)
+    {
+        Lock lock(threadNameMutex);
+
+        Thread::ID currentThreadId = Thread::getCurrentThreadId();
+
+        for (std::pair<Thread::ID, std::string>& threadName : threadNames)
+        {
+            if (threadName.first == currentThreadId)
+            {
+                threadName.second = name;
+                return;
+            }
+        }
+
+        threadNames.push_back(std::make_pair(currentThreadId, name));
+    }
+
     Thread::Thread(const std::function<void()>& function, const std::string& name):
         state(new State())
     {
@@ -111,6 +137,8 @@ namespace ouzel
 
     bool Thread::setCurrentThreadName(const std::string& name)
     {
+        storeThreadName(name);
+
 #if defined(_MSC_VER)
         THREADNAME_INFO info;
         info.dwType = 0x1000;
@@ -134,4 +162,18 @@ namespace ouzel
 #endif
 #endif
     }
+
+    std::string Thread::getCurrentThreadName()
+    {
+        Lock lock(threadNameMutex);
+
+        ID currentThreadId = getCurrentThreadId();
+
+        for (std::pair<ID, std::string>& threadName : threadNames)
+        {
+            if (threadName.first == currentThreadId) return threadName.second;
+        }
+
+        return "";
+    }
 }
@@ -99,6 +99,8 @@ namespace ouzel
         }
 
         static bool setCurrentThreadName(const std::string& name);
+        // returns the name that was set with setCurrentThreadName or an empty string
+        static std::string getCurrentThreadName();
 
         struct State
         {
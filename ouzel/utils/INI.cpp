@@ -6,6 +6,8 @@
 #include <iterator>
 #include "INI.hpp"
 #include "core/Engine.hpp"
+#include "files/FileSystem.hpp"
+#include "files/MappedFile.hpp"
 #include "utils/Log.hpp"
 #include "utils/Utils.hpp"
 
@@ -111,14 +113,14 @@ namespace ouzel
 
         bool Data::init(const std::string& filename)
         {
-            std::vector<uint8_t> data;
+            MappedFile file;
 
-            if (!engine->getFileSystem()->readFile(filename, data))
+            if (!engine->getFileSystem()->mapFile(filename, file))
             {
                 return false;
             }
 
-            return init(data);
+            return init(file.getData(), file.getSize());
         }
 
         static inline std::vector<uint32_t>& ltrimUtf32(std::vector<uint32_t>& s)
@@ -141,22 +143,27 @@ namespace ouzel
         }
 
         bool Data::init(const std::vector<uint8_t>& data)
+        {
+            return init(data.data(), static_cast<uint32_t>(data.size()));
+        }
+
+        bool Data::init(const uint8_t* data, uint32_t size)
         {
             std::vector<uint32_t> str;
 
             // BOM
-            if (data.size() >= 3 &&
+            if (size >= 3 &&
                 data[0] == 0xEF &&
                 data[1] == 0xBB &&
                 data[2] == 0xBF)
             {
                 bom = true;
-                str = utf8ToUtf32(std::vector<uint8_t>(data.begin() + 3, data.end()));
+                str = utf8ToUtf32(data + 3, data + size);
             }
             else
             {
                 bom = false;
-                str = utf8ToUtf32(data);
+                str = utf8ToUtf32(data, data + size);
             }
 
             Section* section = &sections[""]; // default section
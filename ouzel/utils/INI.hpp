@@ -48,6 +48,7 @@ namespace ouzel
 
             bool init(const std::string& filename);
             bool init(const std::vector<uint8_t>& data);
+            bool init(const uint8_t* data, uint32_t size);
             bool save(const std::string& filename) const;
             bool encode(std::vector<uint8_t>& data) const;
 
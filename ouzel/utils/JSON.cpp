@@ -1,8 +1,11 @@
 // Copyright (C) 2018 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <cstdlib>
 #include "JSON.hpp"
 #include "core/Engine.hpp"
+#include "files/FileSystem.hpp"
+#include "files/MappedFile.hpp"
 #include "Log.hpp"
 #include "Utils.hpp"
 
@@ -10,244 +13,435 @@ namespace ouzel
 {
     namespace json
     {
-        bool Value::parseValue(const std::vector<Token>& tokens,
-                               std::vector<Token>::const_iterator&iterator)
+        const Value Value::EMPTY;
+
+        static inline bool isWhitespace(uint8_t c)
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        static inline bool isDigit(uint8_t c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        static inline void skipWhitespaces(const uint8_t*& iterator, const uint8_t* end)
+        {
+            while (iterator != end && isWhitespace(*iterator)) ++iterator;
+        }
+
+        static bool parseKeyword(const uint8_t*& iterator, const uint8_t* end, const char* keyword)
         {
-            if (iterator == tokens.end())
+            for (const char* c = keyword; *c; ++c, ++iterator)
             {
-                Log(Log::Level::ERR) << "Unexpected end of data";
-                return false;
+                if (iterator == end || *iterator != static_cast<uint8_t>(*c))
+                {
+                    Log(Log::Level::ERR) << "Unknown keyword";
+                    return false;
+                }
             }
 
-            if (iterator->type == Token::Type::LEFT_BRACE)
+            return true;
+        }
+
+        static bool parseNumber(const uint8_t*& iterator, const uint8_t* end, double& result)
+        {
+            // powers of ten that can be represented exactly by a double
+            static const double POWERS_OF_TEN[] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+
+            const uint8_t* start = iterator;
+            bool negative = false;
+
+            if (iterator != end && *iterator == '-')
             {
-                return parseObject(tokens, iterator);
+                negative = true;
+                ++iterator;
             }
-            else if (iterator->type == Token::Type::LEFT_BRACKET)
+
+            uint64_t mantissa = 0;
+            int32_t exponent = 0;
+            bool truncated = false;
+            bool hasDigits = false;
+
+            for (; iterator != end && isDigit(*iterator); ++iterator)
             {
-                return parseArray(tokens, iterator);
+                hasDigits = true;
+
+                if (mantissa < (UINT64_MAX - 9) / 10)
+                    mantissa = mantissa * 10 + (*iterator - '0');
+                else
+                {
+                    ++exponent;
+                    truncated = true;
+                }
             }
-            else if (iterator->type == Token::Type::LITERAL_NUMBER)
+
+            if (iterator != end && *iterator == '.')
             {
-                type = Type::NUMBER;
-                doubleValue = std::stod(utf32ToUtf8(iterator->value));
                 ++iterator;
+
+                for (; iterator != end && isDigit(*iterator); ++iterator)
+                {
+                    hasDigits = true;
+
+                    if (mantissa < (UINT64_MAX - 9) / 10)
+                    {
+                        mantissa = mantissa * 10 + (*iterator - '0');
+                        --exponent;
+                    }
+                    else
+                        truncated = true;
+                }
             }
-            else if (iterator->type == Token::Type::OPERATOR_MINUS)
+
+            if (!hasDigits)
             {
-                if (++iterator == tokens.end())
+                Log(Log::Level::ERR) << "Expected a number";
+                return false;
+            }
+
+            if (iterator != end && (*iterator == 'e' || *iterator == 'E'))
+            {
+                ++iterator;
+
+                bool negativeExponent = false;
+
+                if (iterator != end && (*iterator == '+' || *iterator == '-'))
                 {
-                    Log(Log::Level::ERR) << "Unexpected end of data";
-                    return false;
+                    negativeExponent = (*iterator == '-');
+                    ++iterator;
                 }
 
-                if (iterator->type != Token::Type::LITERAL_NUMBER)
+                if (iterator == end || !isDigit(*iterator))
                 {
-                    Log(Log::Level::ERR) << "Expected a number";
+                    Log(Log::Level::ERR) << "Invalid exponent";
                     return false;
                 }
 
-                type = Type::NUMBER;
-                doubleValue = -std::stod(utf32ToUtf8(iterator->value));
-                ++iterator;
+                int32_t exponentValue = 0;
+
+                for (; iterator != end && isDigit(*iterator); ++iterator)
+                {
+                    if (exponentValue < 10000) exponentValue = exponentValue * 10 + (*iterator - '0');
+                }
+
+                exponent += negativeExponent ? -exponentValue : exponentValue;
             }
-            else if (iterator->type == Token::Type::LITERAL_STRING)
+
+            if (!truncated && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22)
             {
-                type = Type::STRING;
-                stringValue = utf32ToUtf8(iterator->value);
-                ++iterator;
+                // both the mantissa and the power of ten are exact, so the result is correctly rounded
+                double value = static_cast<double>(mantissa);
+                value = (exponent < 0) ? value / POWERS_OF_TEN[-exponent] : value * POWERS_OF_TEN[exponent];
+                result = negative ? -value : value;
             }
-            else if (iterator->type == Token::Type::KEYWORD_TRUE ||
-                     iterator->type == Token::Type::KEYWORD_FALSE)
+            else
             {
-                type = Type::BOOLEAN;
-                boolValue = (iterator->type == Token::Type::KEYWORD_TRUE);
-                ++iterator;
+                std::string value(start, iterator);
+                result = std::strtod(value.c_str(), nullptr);
             }
-            else if (iterator->type == Token::Type::KEYWORD_NULL)
+
+            return true;
+        }
+
+        static bool parseHex(const uint8_t*& iterator, const uint8_t* end, uint32_t& result)
+        {
+            result = 0;
+
+            for (uint32_t i = 0; i < 4; ++i, ++iterator)
             {
-                type = Type::OBJECT;
-                nullValue = true;
-                ++iterator;
+                if (iterator == end)
+                {
+                    Log(Log::Level::ERR) << "Unexpected end of data";
+                    return false;
+                }
+
+                uint32_t code;
+
+                if (*iterator >= '0' && *iterator <= '9') code = *iterator - '0';
+                else if (*iterator >= 'a' && *iterator <= 'f') code = *iterator - 'a' + 10;
+                else if (*iterator >= 'A' && *iterator <= 'F') code = *iterator - 'A' + 10;
+                else
+                {
+                    Log(Log::Level::ERR) << "Invalid character code";
+                    return false;
+                }
+
+                result = (result << 4) | code;
             }
-            else
+
+            return true;
+        }
+
+        static bool parseString(const uint8_t*& iterator, const uint8_t* end, std::string& result)
+        {
+            ++iterator; // skip the quotation mark
+
+            result.clear();
+
+            // runs of characters without escape sequences are appended at once
+            const uint8_t* start = iterator;
+
+            for (;;)
             {
-                Log(Log::Level::ERR) << "Expected a value";
-                return false;
+                if (iterator == end)
+                {
+                    Log(Log::Level::ERR) << "Unterminated string literal";
+                    return false;
+                }
+
+                if (*iterator == '"')
+                {
+                    result.append(start, iterator);
+                    ++iterator;
+                    break;
+                }
+                else if (*iterator == '\\')
+                {
+                    result.append(start, iterator);
+
+                    if (++iterator == end)
+                    {
+                        Log(Log::Level::ERR) << "Unterminated string literal";
+                        return false;
+                    }
+
+                    if (*iterator == '"') result.push_back('"');
+                    else if (*iterator == '\\') result.push_back('\\');
+                    else if (*iterator == '/') result.push_back('/');
+                    else if (*iterator == 'b') result.push_back('\b');
+                    else if (*iterator == 'f') result.push_back('\f');
+                    else if (*iterator == 'n') result.push_back('\n');
+                    else if (*iterator == 'r') result.push_back('\r');
+                    else if (*iterator == 't') result.push_back('\t');
+                    else if (*iterator == 'u')
+                    {
+                        uint32_t c;
+                        if (!parseHex(++iterator, end, c)) return false;
+
+                        // surrogate pair
+                        if (c >= 0xD800 && c <= 0xDBFF &&
+                            end - iterator >= 6 && iterator[0] == '\\' && iterator[1] == 'u')
+                        {
+                            const uint8_t* next = iterator + 2;
+                            uint32_t low;
+                            if (!parseHex(next, end, low)) return false;
+
+                            if (low >= 0xDC00 && low <= 0xDFFF)
+                            {
+                                c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+                                iterator = next;
+                            }
+                        }
+
+                        result += utf32ToUtf8(c);
+                        start = iterator;
+                        continue;
+                    }
+                    else
+                    {
+                        Log(Log::Level::ERR) << "Unrecognized escape character";
+                        return false;
+                    }
+
+                    start = ++iterator;
+                }
+                else if (*iterator <= 0x1F)
+                {
+                    Log(Log::Level::ERR) << "Unterminated string literal";
+                    return false;
+                }
+                else
+                    ++iterator;
             }
 
             return true;
         }
 
-        bool Value::parseObject(const std::vector<Token>& tokens,
-                                std::vector<Token>::const_iterator&iterator)
+        bool Value::parseValue(const uint8_t*& iterator, const uint8_t* end)
         {
-            if (iterator == tokens.end())
+            skipWhitespaces(iterator, end);
+
+            if (iterator == end)
             {
                 Log(Log::Level::ERR) << "Unexpected end of data";
                 return false;
             }
 
-            if (iterator->type != Token::Type::LEFT_BRACE)
+            if (*iterator == '{')
+            {
+                return parseObject(iterator, end);
+            }
+            else if (*iterator == '[')
+            {
+                return parseArray(iterator, end);
+            }
+            else if (*iterator == '-' || *iterator == '.' || isDigit(*iterator))
+            {
+                type = Type::NUMBER;
+                return parseNumber(iterator, end, doubleValue);
+            }
+            else if (*iterator == '"')
+            {
+                type = Type::STRING;
+                return parseString(iterator, end, stringValue);
+            }
+            else if (*iterator == 't')
+            {
+                type = Type::BOOLEAN;
+                boolValue = true;
+                return parseKeyword(iterator, end, "true");
+            }
+            else if (*iterator == 'f')
+            {
+                type = Type::BOOLEAN;
+                boolValue = false;
+                return parseKeyword(iterator, end, "false");
+            }
+            else if (*iterator == 'n')
             {
-                Log(Log::Level::ERR) << "Expected a left brace";
+                type = Type::OBJECT;
+                nullValue = true;
+                return parseKeyword(iterator, end, "null");
+            }
+            else
+            {
+                Log(Log::Level::ERR) << "Expected a value";
                 return false;
             }
+        }
 
+        bool Value::parseObject(const uint8_t*& iterator, const uint8_t* end)
+        {
             ++iterator; // skip the left brace
 
-            bool first = true;
+            type = Type::OBJECT;
 
-            for (;;)
+            for (bool first = true;; first = false)
             {
-                if (iterator == tokens.end())
+                skipWhitespaces(iterator, end);
+
+                if (iterator == end)
                 {
                     Log(Log::Level::ERR) << "Unexpected end of data";
                     return false;
                 }
 
-                if (iterator->type == Token::Type::RIGHT_BRACE)
+                if (*iterator == '}')
                 {
-                    ++iterator;// skip the right brace
+                    ++iterator; // skip the right brace
                     break;
                 }
 
-                if (first)
+                if (!first)
                 {
-                    first = false;
-                }
-                else
-                {
-                    if (iterator->type != Token::Type::COMMA)
+                    if (*iterator != ',')
                     {
                         Log(Log::Level::ERR) << "Expected a comma";
                         return false;
                     }
 
-                    if (++iterator == tokens.end())
+                    ++iterator;
+                    skipWhitespaces(iterator, end);
+
+                    if (iterator == end)
                     {
                         Log(Log::Level::ERR) << "Unexpected end of data";
                         return false;
                     }
                 }
 
-                if (iterator->type != Token::Type::LITERAL_STRING)
+                if (*iterator != '"')
                 {
                     Log(Log::Level::ERR) << "Expected a string literal";
                     return false;
                 }
 
-                std::string key = utf32ToUtf8(iterator->value);
+                objectValue.push_back(std::make_pair(std::string(), Value()));
+                std::pair<std::string, Value>& member = objectValue.back();
 
-                if (objectValue.find(key) != objectValue.end())
-                {
-                    Log(Log::Level::ERR) << "Duplicate key value";
-                    return false;
-                }
+                if (!parseString(iterator, end, member.first)) return false;
 
-                if (++iterator == tokens.end())
-                {
-                    Log(Log::Level::ERR) << "Unexpected end of data";
-                    return false;
-                }
+                skipWhitespaces(iterator, end);
 
-                if (iterator->type != Token::Type::COLON)
+                if (iterator == end || *iterator != ':')
                 {
                     Log(Log::Level::ERR) << "Expected a colon";
                     return false;
                 }
 
-                if (++iterator == tokens.end())
-                {
-                    Log(Log::Level::ERR) << "Unexpected end of data";
-                    return false;
-                }
+                ++iterator;
 
-                Value value;
-                if (!value.parseValue(tokens, iterator))
+                if (!member.second.parseValue(iterator, end)) return false;
+            }
+
+            // sort the members once instead of keeping them sorted during parsing
+            std::stable_sort(objectValue.begin(), objectValue.end(),
+                             [](const std::pair<std::string, Value>& a, const std::pair<std::string, Value>& b) { return a.first < b.first; });
+
+            for (size_t i = 1; i < objectValue.size(); ++i)
+            {
+                if (objectValue[i - 1].first == objectValue[i].first)
                 {
+                    Log(Log::Level::ERR) << "Duplicate key value";
                     return false;
                 }
-
-                objectValue[key] = value;
             }
 
-            type = Type::OBJECT;
-
             return true;
         }
 
-        bool Value::parseArray(const std::vector<Token>& tokens,
-                               std::vector<Token>::const_iterator&iterator)
+        bool Value::parseArray(const uint8_t*& iterator, const uint8_t* end)
         {
-            if (iterator == tokens.end())
-            {
-                Log(Log::Level::ERR) << "Unexpected end of data";
-                return false;
-            }
-
-            if (iterator->type != Token::Type::LEFT_BRACKET)
-            {
-                Log(Log::Level::ERR) << "Expected a left bracket";
-                return false;
-            }
-
             ++iterator; // skip the left bracket
 
-            bool first = true;
+            type = Type::ARRAY;
 
-            for (;;)
+            for (bool first = true;; first = false)
             {
-                if (iterator == tokens.end())
+                skipWhitespaces(iterator, end);
+
+                if (iterator == end)
                 {
                     Log(Log::Level::ERR) << "Unexpected end of data";
                     return false;
                 }
 
-                if (iterator->type == Token::Type::RIGHT_BRACKET)
+                if (*iterator == ']')
                 {
-                    ++iterator;// skip the right bracket
+                    ++iterator; // skip the right bracket
                     break;
                 }
 
-                if (first)
-                {
-                    first = false;
-                }
-                else
+                if (!first)
                 {
-                    if (iterator->type != Token::Type::COMMA)
+                    if (*iterator != ',')
                     {
                         Log(Log::Level::ERR) << "Expected a comma";
                         return false;
                     }
 
-                    if (++iterator == tokens.end())
-                    {
-                        Log(Log::Level::ERR) << "Unexpected end of data";
-                        return false;
-                    }
+                    ++iterator;
                 }
 
-                Value value;
-                if (!value.parseValue(tokens, iterator))
-                {
-                    return false;
-                }
+                arrayValue.push_back(Value());
 
-                arrayValue.push_back(value);
+                if (!arrayValue.back().parseValue(iterator, end)) return false;
             }
 
-            type = Type::ARRAY;
-
             return true;
         }
 
         static bool encodeString(std::vector<uint8_t>& data,
-                                 const std::vector<uint32_t>& str)
+                                 const std::string& str)
         {
-            for (uint32_t c : str)
+            for (char ch : str)
             {
+                uint8_t c = static_cast<uint8_t>(ch);
+
                 if (c == '"') data.insert(data.end(), {'\\', '"'});
                 else if (c == '\\') data.insert(data.end(), {'\\', '\\'});
                 else if (c == '/') data.insert(data.end(), {'\\', '/'});
@@ -264,8 +458,8 @@ namespace ouzel
                 }
                 else
                 {
-                    std::string encoded = utf32ToUtf8(c);
-                    data.insert(data.end(), encoded.begin(), encoded.end());
+                    // multi-byte UTF-8 sequences are copied as they are
+                    data.push_back(c);
                 }
             }
 
@@ -284,7 +478,7 @@ namespace ouzel
                 }
                 case Type::STRING:
                     data.push_back('"');
-                    if (!encodeString(data, utf8ToUtf32(stringValue))) return false;
+                    if (!encodeString(data, stringValue)) return false;
                     data.push_back('"');
                     break;
                 case Type::OBJECT:
@@ -305,7 +499,7 @@ namespace ouzel
                             else data.push_back(',');
 
                             data.push_back('"');
-                            if (!encodeString(data, utf8ToUtf32(value.first))) return false;
+                            if (!encodeString(data, value.first)) return false;
                             data.insert(data.end(), {'"', ':'});
                             value.second.encodeValue(data);
                         }
@@ -359,266 +553,244 @@ namespace ouzel
 
         bool Data::init(const std::string& filename)
         {
-            std::vector<uint8_t> data;
+            MappedFile file;
 
-            if (!engine->getFileSystem()->readFile(filename, data))
+            if (!engine->getFileSystem()->mapFile(filename, file))
             {
                 return false;
             }
 
-            return init(data);
+            return init(file.getData(), file.getSize());
         }
 
-        static inline bool isWhitespace(uint32_t c)
+        bool Data::init(const std::vector<uint8_t>& data)
         {
-            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+            return init(data.data(), static_cast<uint32_t>(data.size()));
+        }
+
+        bool Data::init(const uint8_t* data, uint32_t size)
+        {
+            const uint8_t* iterator = data;
+            const uint8_t* end = data + size;
+
+            // BOM
+            if (size >= 3 &&
+                data[0] == 0xEF &&
+                data[1] == 0xBB &&
+                data[2] == 0xBF)
+            {
+                bom = true;
+                iterator += 3;
+            }
+            else
+            {
+                bom = false;
+            }
+
+            type = Type::NONE;
+            objectValue.clear();
+            arrayValue.clear();
+            stringValue.clear();
+
+            if (!parseValue(iterator, end))
+            {
+                return false;
+            }
+
+            skipWhitespaces(iterator, end);
+
+            if (iterator != end)
+            {
+                Log(Log::Level::ERR) << "Unexpected data after the root value";
+                return false;
+            }
+
+            return true;
         }
 
-        static inline bool isControlChar(uint32_t c)
+        Reader::Reader(const uint8_t* initData, uint32_t initSize):
+            iterator(initData), end(initData + initSize)
         {
-            return c <= 0x1F;
+            // BOM
+            if (initSize >= 3 &&
+                initData[0] == 0xEF &&
+                initData[1] == 0xBB &&
+                initData[2] == 0xBF)
+            {
+                iterator += 3;
+            }
         }
 
-        static bool tokenize(const std::vector<uint32_t>& str, std::vector<Token>& tokens)
+        Reader::Event Reader::next()
         {
-            tokens.clear();
+            if (event == Event::END || event == Event::INVALID) return event;
 
-            static const std::map<std::vector<uint32_t>, Token::Type> keywordMap = {
-                {{'t', 'r', 'u', 'e'}, Token::Type::KEYWORD_TRUE},
-                {{'f', 'a', 'l', 's', 'e'}, Token::Type::KEYWORD_FALSE},
-                {{'n', 'u', 'l', 'l'}, Token::Type::KEYWORD_NULL}
-            };
+            skipWhitespaces(iterator, end);
 
-            // tokenize
-            for (std::vector<uint32_t>::const_iterator iterator = str.begin(); iterator != str.end();)
+            if (stack.empty())
             {
-                Token token;
-
-                if (*iterator == '{' || *iterator == '}' ||
-                    *iterator == '[' || *iterator == ']' ||
-                    *iterator == ',' || *iterator == ':') // punctuation
+                if (!started)
                 {
-                    if (*iterator == '{') token.type = Token::Type::LEFT_BRACE;
-                    if (*iterator == '}') token.type = Token::Type::RIGHT_BRACE;
-                    if (*iterator == '[') token.type = Token::Type::LEFT_BRACKET;
-                    if (*iterator == ']') token.type = Token::Type::RIGHT_BRACKET;
-                    if (*iterator == ',') token.type = Token::Type::COMMA;
-                    if (*iterator == ':') token.type = Token::Type::COLON;
-                    token.value.push_back(*iterator);
-
-                    ++iterator;
+                    started = true;
+                    return event = readValue();
                 }
-                else if ((*iterator >= '0' && *iterator <= '9') ||  // number
-                         (*iterator == '.' && (iterator + 1) != str.end() &&
-                          *(iterator + 1) >= '0' && *(iterator + 1) <= '9')) // starts with a dot
-                {
-                    token.type = Token::Type::LITERAL_NUMBER;
 
-                    while (iterator != str.end() &&
-                           ((*iterator >= '0' && *iterator <= '9')))
-                    {
-                        token.value.push_back(*iterator);
-                        ++iterator;
-                    }
-
-                    if (iterator != str.end() && *iterator == '.')
-                    {
-                        token.value.push_back(*iterator);
-                        ++iterator;
+                if (iterator != end)
+                {
+                    Log(Log::Level::ERR) << "Unexpected data after the root value";
+                    return event = Event::INVALID;
+                }
 
-                        while (iterator != str.end() &&
-                               ((*iterator >= '0' && *iterator <= '9')))
-                        {
-                            token.value.push_back(*iterator);
-                            ++iterator;
-                        }
-                    }
+                return event = Event::END;
+            }
 
-                    // parse exponent
-                    if (iterator != str.end() &&
-                        (*iterator == 'e' || *iterator == 'E'))
-                    {
-                        token.value.push_back(*iterator);
+            if (iterator == end)
+            {
+                Log(Log::Level::ERR) << "Unexpected end of data";
+                return event = Event::INVALID;
+            }
 
-                        if (++iterator == str.end() || *iterator != '+' || *iterator != '-')
-                        {
-                            Log(Log::Level::ERR) << "Invalid exponent";
-                            return false;
-                        }
+            Container& container = stack.back();
 
-                        token.value.push_back(*iterator);
+            if (container.expectValue)
+            {
+                container.expectValue = false;
+                return event = readValue();
+            }
 
-                        if (++iterator == str.end() || *iterator < '0' || *iterator > '9')
-                        {
-                            Log(Log::Level::ERR) << "Invalid exponent";
-                            return false;
-                        }
+            if (*iterator == (container.object ? '}' : ']'))
+            {
+                ++iterator;
+                bool object = container.object;
+                stack.pop_back();
+                return event = (object ? Event::END_OBJECT : Event::END_ARRAY);
+            }
 
-                        while (iterator != str.end() &&
-                               ((*iterator >= '0' && *iterator <= '9')))
-                        {
-                            token.value.push_back(*iterator);
-                            ++iterator;
-                        }
-                    }
-                }
-                else if (*iterator == '"') // string literal
+            if (container.first)
+            {
+                container.first = false;
+            }
+            else
+            {
+                if (*iterator != ',')
                 {
-                    token.type = Token::Type::LITERAL_STRING;
+                    Log(Log::Level::ERR) << "Expected a comma";
+                    return event = Event::INVALID;
+                }
 
-                    for (;;)
-                    {
-                        if (++iterator == str.end())
-                        {
-                            Log(Log::Level::ERR) << "Unterminated string literal";
-                            return false;
-                        }
+                ++iterator;
+                skipWhitespaces(iterator, end);
+            }
 
-                        if (*iterator == '"')
-                        {
-                            ++iterator;
-                            break;
-                        }
-                        else if (*iterator == '\\')
-                        {
-                            if (++iterator == str.end())
-                            {
-                                Log(Log::Level::ERR) << "Unterminated string literal";
-                                return false;
-                            }
+            if (!container.object) return event = readValue();
 
-                            if (*iterator == '"') token.value.push_back('"');
-                            else if (*iterator == '\\') token.value.push_back('\\');
-                            else if (*iterator == '/') token.value.push_back('/');
-                            else if (*iterator == 'b') token.value.push_back('\b');
-                            else if (*iterator == 'f') token.value.push_back('\f');
-                            else if (*iterator == 'n') token.value.push_back('\n');
-                            else if (*iterator == 'r') token.value.push_back('\r');
-                            else if (*iterator == 't') token.value.push_back('\t');
-                            else if (*iterator == 'u')
-                            {
-                                if (std::distance<std::vector<uint32_t>::const_iterator>(++iterator, str.end()) < 4)
-                                {
-                                    Log(Log::Level::ERR) << "Unexpected end of data";
-                                    return false;
-                                }
-
-                                uint32_t c = 0;
-
-                                for (uint32_t i = 0; i < 4; ++i, ++iterator)
-                                {
-                                    uint8_t code = 0;
-
-                                    if (*iterator >= '0' && *iterator <= '9') code = static_cast<uint8_t>(*iterator) - '0';
-                                    else if (*iterator >= 'a' && *iterator <='f') code = static_cast<uint8_t>(*iterator) - 'a' + 10;
-                                    else if (*iterator >= 'A' && *iterator <='F') code = static_cast<uint8_t>(*iterator) - 'A' + 10;
-                                    else
-                                    {
-                                        Log(Log::Level::ERR) << "Invalid character code";
-                                        return false;
-                                    }
-                                    c = (c << 4) | code;
-                                }
-
-                                token.value.push_back(c);
-
-                                return false;
-                            }
-                            else
-                            {
-                                Log(Log::Level::ERR) << "Unrecognized escape character";
-                                return false;
-                            }
-                        }
-                        else if (isControlChar(*iterator))
-                        {
-                            Log(Log::Level::ERR) << "Unterminated string literal";
-                            return false;
-                        }
-                        else
-                        {
-                            token.value.push_back(*iterator);
-                        }
-                    }
-                }
-                else if ((*iterator >= 'a' && *iterator <= 'z') ||
-                         (*iterator >= 'A' && *iterator <= 'Z') ||
-                         *iterator == '_')
-                {
-                    while (iterator != str.end() &&
-                           ((*iterator >= 'a' && *iterator <= 'z') ||
-                            (*iterator >= 'A' && *iterator <= 'Z') ||
-                            *iterator == '_' ||
-                            (*iterator >= '0' && *iterator <= '9')))
-                    {
-                        token.value.push_back(*iterator);
-                        ++iterator;
-                    }
+            if (iterator == end || *iterator != '"')
+            {
+                Log(Log::Level::ERR) << "Expected a string literal";
+                return event = Event::INVALID;
+            }
 
-                    std::map<std::vector<uint32_t>, Token::Type>::const_iterator keywordIterator;
+            if (!parseString(iterator, end, stringValue)) return event = Event::INVALID;
 
-                    if ((keywordIterator = keywordMap.find(token.value)) != keywordMap.end())
-                    {
-                        token.type = keywordIterator->second;
-                    }
-                    else
-                    {
-                        Log(Log::Level::ERR) << "Unknown keyword";
-                        return false;
-                    }
-                }
-                else if (*iterator == '-')
-                {
-                    token.type = Token::Type::OPERATOR_MINUS;
-                    token.value.push_back(*iterator);
-                    ++iterator;
-                }
-                else if (isWhitespace(*iterator)) // whitespace
-                {
-                    ++iterator;
-                    continue;
-                }
-                else
-                {
-                    Log(Log::Level::ERR) << "Unknown character";
-                    return false;
-                }
+            skipWhitespaces(iterator, end);
 
-                tokens.push_back(token);
+            if (iterator == end || *iterator != ':')
+            {
+                Log(Log::Level::ERR) << "Expected a colon";
+                return event = Event::INVALID;
             }
 
-            return true;
+            ++iterator;
+            container.expectValue = true;
+
+            return event = Event::KEY;
         }
 
-        bool Data::init(const std::vector<uint8_t>& data)
+        Reader::Event Reader::readValue()
         {
-            std::vector<Token> tokens;
+            skipWhitespaces(iterator, end);
 
-            std::vector<uint32_t> str;
+            if (iterator == end)
+            {
+                Log(Log::Level::ERR) << "Unexpected end of data";
+                return Event::INVALID;
+            }
 
-            // BOM
-            if (data.size() >= 3 &&
-                data[0] == 0xEF &&
-                data[1] == 0xBB &&
-                data[2] == 0xBF)
+            if (*iterator == '{' || *iterator == '[')
             {
-                bom = true;
-                str = utf8ToUtf32(std::vector<uint8_t>(data.begin() + 3, data.end()));
+                Container container;
+                container.object = (*iterator == '{');
+                container.first = true;
+                container.expectValue = false;
+                stack.push_back(container);
+                ++iterator;
+                return container.object ? Event::BEGIN_OBJECT : Event::BEGIN_ARRAY;
+            }
+            else if (*iterator == '-' || *iterator == '.' || isDigit(*iterator))
+            {
+                return parseNumber(iterator, end, doubleValue) ? Event::NUMBER : Event::INVALID;
+            }
+            else if (*iterator == '"')
+            {
+                return parseString(iterator, end, stringValue) ? Event::STRING : Event::INVALID;
+            }
+            else if (*iterator == 't')
+            {
+                boolValue = true;
+                return parseKeyword(iterator, end, "true") ? Event::BOOLEAN : Event::INVALID;
+            }
+            else if (*iterator == 'f')
+            {
+                boolValue = false;
+                return parseKeyword(iterator, end, "false") ? Event::BOOLEAN : Event::INVALID;
+            }
+            else if (*iterator == 'n')
+            {
+                return parseKeyword(iterator, end, "null") ? Event::NULL_VALUE : Event::INVALID;
             }
             else
             {
-                bom = false;
-                str = utf8ToUtf32(data);
+                Log(Log::Level::ERR) << "Expected a value";
+                return Event::INVALID;
             }
+        }
 
-            if (!tokenize(str, tokens))
+        bool Reader::skipValue()
+        {
+            switch (next())
             {
-                return false;
+                case Event::BEGIN_OBJECT:
+                case Event::BEGIN_ARRAY:
+                    return skipContainer();
+                case Event::NUMBER:
+                case Event::STRING:
+                case Event::BOOLEAN:
+                case Event::NULL_VALUE:
+                    return true;
+                default:
+                    return false;
             }
+        }
 
-            std::vector<Token>::const_iterator iterator = tokens.cbegin();
+        bool Reader::skipContainer()
+        {
+            size_t depth = stack.size();
 
-            return parseValue(tokens, iterator);
+            for (;;)
+            {
+                switch (next())
+                {
+                    case Event::END_OBJECT:
+                    case Event::END_ARRAY:
+                        if (stack.size() < depth) return true;
+                        break;
+                    case Event::END:
+                    case Event::INVALID:
+                        return false;
+                    default:
+                        break;
+                }
+            }
         }
 
         bool Data::save(const std::string& filename) const
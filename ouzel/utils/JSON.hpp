@@ -3,38 +3,17 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
-#include <map>
+#include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ouzel
 {
     namespace json
     {
-        struct Token
-        {
-            enum class Type
-            {
-                NONE,
-                LITERAL_NUMBER, // float
-                LITERAL_STRING, // string
-                KEYWORD_TRUE, // true
-                KEYWORD_FALSE, // false
-                KEYWORD_NULL, // null
-                LEFT_BRACE, // {
-                RIGHT_BRACE, // }
-                LEFT_BRACKET, // [
-                RIGHT_BRACKET, // ]
-                COMMA, // ,
-                COLON, // :
-                OPERATOR_MINUS // -
-            };
-
-            Type type = Type::NONE;
-            std::vector<uint32_t> value;
-        };
-
         class Value
         {
         public:
@@ -187,24 +166,29 @@ namespace ouzel
             inline bool hasMember(const std::string& member) const
             {
                 assert(type == Type::OBJECT);
-                return objectValue.find(member) != objectValue.end();
+                auto i = findMember(member);
+                return i != objectValue.end() && i->first == member;
             }
 
             inline Value& operator[](const std::string& member)
             {
                 assert(type == Type::OBJECT);
-                return objectValue[member];
+                auto i = findMember(member);
+                if (i == objectValue.end() || i->first != member)
+                    i = objectValue.insert(i, std::make_pair(member, Value()));
+                return i->second;
             }
 
-            inline Value operator[](const std::string& member) const
+            inline const Value& operator[](const std::string& member) const
             {
                 assert(type == Type::OBJECT);
-                auto i = objectValue.find(member);
-                if (i != objectValue.end()) return i->second;
-                else return Value();
+                auto i = findMember(member);
+                if (i != objectValue.end() && i->first == member) return i->second;
+                else return EMPTY;
             }
 
-            inline const std::map<std::string, Value>& asMap() const
+            // members are sorted by their keys
+            inline const std::vector<std::pair<std::string, Value>>& asMap() const
             {
                 assert(type == Type::OBJECT);
                 return objectValue;
@@ -217,11 +201,11 @@ namespace ouzel
                 return arrayValue[index];
             }
 
-            inline Value operator[](size_t index) const
+            inline const Value& operator[](size_t index) const
             {
                 assert(type == Type::ARRAY);
                 if (index < arrayValue.size()) return arrayValue[index];
-                else return Value();
+                else return EMPTY;
             }
 
             inline std::vector<Value>& asArray()
@@ -243,16 +227,27 @@ namespace ouzel
             }
 
         protected:
-            bool parseValue(const std::vector<Token>& tokens,
-                            std::vector<Token>::const_iterator& iterator);
-            bool parseObject(const std::vector<Token>& tokens,
-                             std::vector<Token>::const_iterator& iterator);
-            bool parseArray(const std::vector<Token>& tokens,
-                            std::vector<Token>::const_iterator& iterator);
+            static const Value EMPTY;
+
+            inline std::vector<std::pair<std::string, Value>>::iterator findMember(const std::string& member)
+            {
+                return std::lower_bound(objectValue.begin(), objectValue.end(), member,
+                                        [](const std::pair<std::string, Value>& a, const std::string& b) { return a.first < b; });
+            }
+
+            inline std::vector<std::pair<std::string, Value>>::const_iterator findMember(const std::string& member) const
+            {
+                return std::lower_bound(objectValue.begin(), objectValue.end(), member,
+                                        [](const std::pair<std::string, Value>& a, const std::string& b) { return a.first < b; });
+            }
+
+            bool parseValue(const uint8_t*& iterator, const uint8_t* end);
+            bool parseObject(const uint8_t*& iterator, const uint8_t* end);
+            bool parseArray(const uint8_t*& iterator, const uint8_t* end);
             bool encodeValue(std::vector<uint8_t>& data) const;
 
             Type type = Type::NONE;
-            std::map<std::string, Value> objectValue;
+            std::vector<std::pair<std::string, Value>> objectValue; // sorted by key, looked up with a binary search
             std::vector<Value> arrayValue;
             std::string stringValue;
             union
@@ -272,6 +267,7 @@ namespace ouzel
 
             bool init(const std::string& filename);
             bool init(const std::vector<uint8_t>& data);
+            bool init(const uint8_t* data, uint32_t size);
 
             bool save(const std::string& filename) const;
             bool encode(std::vector<uint8_t>& data) const;
@@ -282,5 +278,91 @@ namespace ouzel
         protected:
             bool bom = false;
         };
+
+        // pull parser that reports the document as a sequence of events without building a tree of values
+        class Reader
+        {
+        public:
+            enum class Event
+            {
+                NONE,
+                BEGIN_OBJECT,
+                END_OBJECT,
+                BEGIN_ARRAY,
+                END_ARRAY,
+                KEY,
+                NUMBER,
+                STRING,
+                BOOLEAN,
+                NULL_VALUE,
+                END, // end of the document
+                INVALID // parse error, logged
+            };
+
+            Reader(const uint8_t* initData, uint32_t initSize);
+
+            Reader(const Reader&) = delete;
+            Reader& operator=(const Reader&) = delete;
+
+            Reader(Reader&&) = delete;
+            Reader& operator=(Reader&&) = delete;
+
+            Event next();
+
+            // skips the value that follows a KEY event or the next array element
+            bool skipValue();
+            // skips the rest of the object or array the reader is currently in, including its end event
+            bool skipContainer();
+
+            inline Event getEvent() const { return event; }
+            inline size_t getDepth() const { return stack.size(); }
+
+            // key of the KEY event or value of the STRING event
+            inline const std::string& asString() const
+            {
+                assert(event == Event::KEY || event == Event::STRING);
+                return stringValue;
+            }
+
+            inline bool asBool() const
+            {
+                assert(event == Event::BOOLEAN || event == Event::NUMBER);
+                if (event == Event::BOOLEAN) return boolValue;
+                else if (event == Event::NUMBER) return doubleValue != 0.0;
+                else return false;
+            }
+
+            inline double asDouble() const
+            {
+                assert(event == Event::BOOLEAN || event == Event::NUMBER);
+                if (event == Event::BOOLEAN) return boolValue;
+                else if (event == Event::NUMBER) return doubleValue;
+                else return 0.0;
+            }
+
+            inline float asFloat() const { return static_cast<float>(asDouble()); }
+            inline int32_t asInt32() const { return static_cast<int32_t>(asDouble()); }
+            inline uint32_t asUInt32() const { return static_cast<uint32_t>(asDouble()); }
+
+        protected:
+            Event readValue();
+
+            struct Container
+            {
+                bool object;
+                bool first;
+                bool expectValue; // a key has been read, its value comes next
+            };
+
+            const uint8_t* iterator;
+            const uint8_t* end;
+            bool started = false;
+            std::vector<Container> stack;
+
+            Event event = Event::NONE;
+            std::string stringValue;
+            double doubleValue = 0.0;
+            bool boolValue = false;
+        };
     } // namespace json
 } // namespace ouzel
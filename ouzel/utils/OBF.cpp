@@ -1,7 +1,9 @@
 // Copyright (C) 2018 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <cstring>
 #include "OBF.hpp"
+#include "Log.hpp"
 #include "Utils.hpp"
 
 namespace ouzel
@@ -9,178 +11,178 @@ namespace ouzel
     namespace obf
     {
         // reading
-        static uint32_t readInt8(const std::vector<uint8_t>& buffer, uint32_t offset, uint8_t& result)
+        static uint32_t readInt8(const uint8_t* buffer, uint32_t size, uint32_t offset, uint8_t& result)
         {
-            if (buffer.size() - offset < sizeof(result))
+            if (size - offset < sizeof(result))
             {
                 return 0;
             }
 
-            result = *reinterpret_cast<const uint8_t*>(buffer.data() + offset);
+            result = *buffer + offset;
 
             return sizeof(result);
         }
 
-        static uint32_t readInt16(const std::vector<uint8_t>& buffer, uint32_t offset, uint16_t& result)
+        static uint32_t readInt16(const uint8_t* buffer, uint32_t size, uint32_t offset, uint16_t& result)
         {
-            if (buffer.size() - offset < sizeof(result))
+            if (size - offset < sizeof(result))
             {
                 return 0;
             }
 
-            result = decodeUInt16Big(buffer.data() + offset);
+            result = decodeUInt16Big(buffer + offset);
 
             return sizeof(result);
         }
 
-        static uint32_t readInt32(const std::vector<uint8_t>& buffer, uint32_t offset, uint32_t& result)
+        static uint32_t readInt32(const uint8_t* buffer, uint32_t size, uint32_t offset, uint32_t& result)
         {
-            if (buffer.size() - offset < sizeof(result))
+            if (size - offset < sizeof(result))
             {
                 return 0;
             }
 
-            result = decodeUInt32Big(buffer.data() + offset);
+            result = decodeUInt32Big(buffer + offset);
 
             return sizeof(result);
         }
 
-        static uint32_t readInt64(const std::vector<uint8_t>& buffer, uint32_t offset, uint64_t& result)
+        static uint32_t readInt64(const uint8_t* buffer, uint32_t size, uint32_t offset, uint64_t& result)
         {
-            if (buffer.size() - offset < sizeof(result))
+            if (size - offset < sizeof(result))
             {
                 return 0;
             }
 
-            result = decodeUInt64Big(buffer.data() + offset);
+            result = decodeUInt64Big(buffer + offset);
 
             return sizeof(result);
         }
 
-        static uint32_t readFloat(const std::vector<uint8_t>& buffer, uint32_t offset, float& result)
+        static uint32_t readFloat(const uint8_t* buffer, uint32_t size, uint32_t offset, float& result)
         {
-            if (buffer.size() - offset < sizeof(float))
+            if (size - offset < sizeof(float))
             {
                 return 0;
             }
 
-            result = *reinterpret_cast<const float*>(buffer.data() + offset);
+            result = decodeFloatBig(buffer + offset);
 
             return sizeof(result);
         }
 
-        static uint32_t readDouble(const std::vector<uint8_t>& buffer, uint32_t offset, double& result)
+        static uint32_t readDouble(const uint8_t* buffer, uint32_t size, uint32_t offset, double& result)
         {
-            if (buffer.size() - offset < sizeof(double))
+            if (size - offset < sizeof(double))
             {
                 return 0;
             }
 
-            result = *reinterpret_cast<const double*>(buffer.data() + offset);
+            result = decodeDoubleBig(buffer + offset);
 
             return sizeof(result);
         }
 
-        static uint32_t readString(const std::vector<uint8_t>& buffer, uint32_t offset, std::string& result)
+        static uint32_t readString(const uint8_t* buffer, uint32_t size, uint32_t offset, std::string& result)
         {
             uint32_t originalOffset = offset;
 
-            if (buffer.size() - offset < sizeof(uint16_t))
+            if (size - offset < sizeof(uint16_t))
             {
                 return 0;
             }
 
-            uint16_t length = decodeUInt16Big(buffer.data() + offset);
+            uint16_t length = decodeUInt16Big(buffer + offset);
 
             offset += sizeof(length);
 
-            if (buffer.size() - offset < length)
+            if (size - offset < length)
             {
                 return 0;
             }
 
-            result.assign(reinterpret_cast<const char*>(buffer.data() + offset), length);
+            result.assign(reinterpret_cast<const char*>(buffer + offset), length);
             offset += length;
 
             return offset - originalOffset;
         }
 
-        static uint32_t readLongString(const std::vector<uint8_t>& buffer, uint32_t offset, std::string& result)
+        static uint32_t readLongString(const uint8_t* buffer, uint32_t size, uint32_t offset, std::string& result)
         {
             uint32_t originalOffset = offset;
 
-            if (buffer.size() - offset < sizeof(uint32_t))
+            if (size - offset < sizeof(uint32_t))
             {
                 return 0;
             }
 
-            uint32_t length = decodeUInt32Big(buffer.data() + offset);
+            uint32_t length = decodeUInt32Big(buffer + offset);
 
             offset += sizeof(length);
 
-            if (buffer.size() - offset < length)
+            if (size - offset < length)
             {
                 return 0;
             }
 
-            result.assign(reinterpret_cast<const char*>(buffer.data() + offset), length);
+            result.assign(reinterpret_cast<const char*>(buffer + offset), length);
             offset += length;
 
             return offset - originalOffset;
         }
 
-        static uint32_t readByteArray(const std::vector<uint8_t>& buffer, uint32_t offset, std::vector<uint8_t>& result)
+        static uint32_t readByteArray(const uint8_t* buffer, uint32_t size, uint32_t offset, std::vector<uint8_t>& result)
         {
             uint32_t originalOffset = offset;
 
-            if (buffer.size() - offset < sizeof(uint32_t))
+            if (size - offset < sizeof(uint32_t))
             {
                 return 0;
             }
 
-            uint32_t length = decodeUInt32Big(buffer.data() + offset);
+            uint32_t length = decodeUInt32Big(buffer + offset);
 
             offset += sizeof(length);
 
-            if (buffer.size() - offset < length)
+            if (size - offset < length)
             {
                 return 0;
             }
 
-            result.assign(reinterpret_cast<const uint8_t*>(buffer.data() + offset),
-                          reinterpret_cast<const uint8_t*>(buffer.data() + offset) + length);
+            result.assign(buffer + offset,
+                          buffer + offset + length);
             offset += length;
 
             return offset - originalOffset;
         }
 
-        static uint32_t readObject(const std::vector<uint8_t>& buffer, uint32_t offset, std::map<uint32_t, Value>& result)
+        static uint32_t readObject(const uint8_t* buffer, uint32_t size, uint32_t offset, std::map<uint32_t, Value>& result)
         {
             uint32_t originalOffset = offset;
 
-            if (buffer.size() - offset < sizeof(uint32_t))
+            if (size - offset < sizeof(uint32_t))
             {
                 return 0;
             }
 
-            uint32_t count = decodeUInt32Big(buffer.data() + offset);
+            uint32_t count = decodeUInt32Big(buffer + offset);
 
             offset += sizeof(count);
 
             for (uint32_t i = 0; i < count; ++i)
             {
-                if (buffer.size() - offset < sizeof(uint32_t))
+                if (size - offset < sizeof(uint32_t))
                 {
                     return 0;
                 }
 
-                uint32_t key = decodeUInt32Big(buffer.data() + offset);
+                uint32_t key = decodeUInt32Big(buffer + offset);
 
                 offset += sizeof(key);
 
                 Value node;
 
-                uint32_t ret = node.decode(buffer, offset);
+                uint32_t ret = node.decode(buffer, size, offset);
 
                 if (ret == 0)
                 {
@@ -188,29 +190,29 @@ namespace ouzel
                 }
                 offset += ret;
 
-                result[static_cast<uint32_t>(key)] = node;
+                result[key] = std::move(node);
             }
 
             return offset - originalOffset;
         }
 
-        static uint32_t readArray(const std::vector<uint8_t>& buffer, uint32_t offset, std::vector<Value>& result)
+        static uint32_t readArray(const uint8_t* buffer, uint32_t size, uint32_t offset, std::vector<Value>& result)
         {
             uint32_t originalOffset = offset;
 
-            if (buffer.size() - offset < sizeof(uint32_t))
+            if (size - offset < sizeof(uint32_t))
             {
                 return 0;
             }
 
-            uint32_t count = decodeUInt32Big(buffer.data() + offset);
+            uint32_t count = decodeUInt32Big(buffer + offset);
 
             offset += sizeof(count);
 
             for (uint32_t i = 0; i < count; ++i)
             {
                 Value node;
-                uint32_t ret = node.decode(buffer, offset);
+                uint32_t ret = node.decode(buffer, size, offset);
 
                 if (ret == 0)
                 {
@@ -219,47 +221,47 @@ namespace ouzel
 
                 offset += ret;
 
-                result.push_back(node);
+                result.push_back(std::move(node));
             }
 
             return offset - originalOffset;
         }
 
-        static uint32_t readDictionary(const std::vector<uint8_t>& buffer, uint32_t offset, std::map<std::string, Value>& result)
+        static uint32_t readDictionary(const uint8_t* buffer, uint32_t size, uint32_t offset, std::map<std::string, Value>& result)
         {
             uint32_t originalOffset = offset;
 
-            if (buffer.size() - offset < sizeof(uint32_t))
+            if (size - offset < sizeof(uint32_t))
             {
                 return 0;
             }
 
-            uint32_t count = decodeUInt32Big(buffer.data() + offset);
+            uint32_t count = decodeUInt32Big(buffer + offset);
 
             offset += sizeof(count);
 
             for (uint32_t i = 0; i < count; ++i)
             {
-                if (buffer.size() - offset < sizeof(uint16_t))
+                if (size - offset < sizeof(uint16_t))
                 {
                     return 0;
                 }
 
-                uint16_t length = decodeUInt16Big(buffer.data() + offset);
+                uint16_t length = decodeUInt16Big(buffer + offset);
 
                 offset += sizeof(length);
 
-                if (buffer.size() - offset < length)
+                if (size - offset < length)
                 {
                     return 0;
                 }
 
-                std::string key(reinterpret_cast<const char*>(buffer.data() + offset), length);
+                std::string key(reinterpret_cast<const char*>(buffer + offset), length);
                 offset += length;
 
                 Value node;
 
-                uint32_t ret = node.decode(buffer, offset);
+                uint32_t ret = node.decode(buffer, size, offset);
 
                 if (ret == 0)
                 {
@@ -267,7 +269,7 @@ namespace ouzel
                 }
                 offset += ret;
 
-                result[key] = node;
+                result[key] = std::move(node);
             }
 
             return offset - originalOffset;
@@ -316,18 +318,18 @@ namespace ouzel
 
         static uint32_t writeFloat(std::vector<uint8_t>& buffer, float value)
         {
-            buffer.insert(buffer.end(),
-                          reinterpret_cast<const uint8_t*>(&value),
-                          reinterpret_cast<const uint8_t*>(&value) + sizeof(value));
+            uint8_t data[sizeof(float)];
+            encodeFloatBig(data, value);
+            buffer.insert(buffer.end(), std::begin(data), std::end(data));
 
             return sizeof(float);
         }
 
         static uint32_t writeDouble(std::vector<uint8_t>& buffer, double value)
         {
-            buffer.insert(buffer.end(),
-                          reinterpret_cast<const uint8_t*>(&value),
-                          reinterpret_cast<const uint8_t*>(&value) + sizeof(value));
+            uint8_t data[sizeof(double)];
+            encodeDoubleBig(data, value);
+            buffer.insert(buffer.end(), std::begin(data), std::end(data));
 
             return sizeof(double);
         }
@@ -460,15 +462,20 @@ namespace ouzel
         }
 
         uint32_t Value::decode(const std::vector<uint8_t>& buffer, uint32_t offset)
+        {
+            return decode(buffer.data(), static_cast<uint32_t>(buffer.size()), offset);
+        }
+
+        uint32_t Value::decode(const uint8_t* buffer, uint32_t size, uint32_t offset)
         {
             uint32_t originalOffset = offset;
 
-            if (buffer.size() - offset < 1)
+            if (offset >= size)
             {
                 return 0;
             }
 
-            Marker marker = *reinterpret_cast<const Marker*>(buffer.data() + offset);
+            Marker marker = *reinterpret_cast<const Marker*>(buffer + offset);
             offset += 1;
 
             uint32_t ret = 0;
@@ -485,7 +492,7 @@ namespace ouzel
                     type = Type::INT;
 
                     uint8_t int8Value;
-                    if ((ret = readInt8(buffer, offset, int8Value)) == 0)
+                    if ((ret = readInt8(buffer, size, offset, int8Value)) == 0)
                     {
                         return 0;
                     }
@@ -498,7 +505,7 @@ namespace ouzel
                     type = Type::INT;
 
                     uint16_t int16Value;
-                    if ((ret = readInt16(buffer, offset, int16Value)) == 0)
+                    if ((ret = readInt16(buffer, size, offset, int16Value)) == 0)
                     {
                         return 0;
                     }
@@ -511,7 +518,7 @@ namespace ouzel
                     type = Type::INT;
 
                     uint32_t int32Value;
-                    if ((ret = readInt32(buffer, offset, int32Value)) == 0)
+                    if ((ret = readInt32(buffer, size, offset, int32Value)) == 0)
                     {
                         return 0;
                     }
@@ -523,7 +530,7 @@ namespace ouzel
                 {
                     type = Type::INT;
 
-                    if ((ret = readInt64(buffer, offset, intValue)) == 0)
+                    if ((ret = readInt64(buffer, size, offset, intValue)) == 0)
                     {
                         return 0;
                     }
@@ -534,7 +541,7 @@ namespace ouzel
                     type = Type::FLOAT;
 
                     float floatValue;
-                    if ((ret = readFloat(buffer, offset, floatValue)) == 0)
+                    if ((ret = readFloat(buffer, size, offset, floatValue)) == 0)
                     {
                         return 0;
                     }
@@ -546,7 +553,7 @@ namespace ouzel
                 {
                     type = Type::DOUBLE;
 
-                    if ((ret = readDouble(buffer, offset, doubleValue)) == 0)
+                    if ((ret = readDouble(buffer, size, offset, doubleValue)) == 0)
                     {
                         return 0;
                     }
@@ -556,7 +563,7 @@ namespace ouzel
                 {
                     type = Type::STRING;
 
-                    if ((ret = readString(buffer, offset, stringValue)) == 0)
+                    if ((ret = readString(buffer, size, offset, stringValue)) == 0)
                     {
                         return 0;
                     }
@@ -566,7 +573,7 @@ namespace ouzel
                 {
                     type = Type::STRING;
 
-                    if ((ret = readLongString(buffer, offset, stringValue)) == 0)
+                    if ((ret = readLongString(buffer, size, offset, stringValue)) == 0)
                     {
                         return 0;
                     }
@@ -576,7 +583,7 @@ namespace ouzel
                 {
                     type = Type::BYTE_ARRAY;
 
-                    if ((ret = readByteArray(buffer, offset, byteArrayValue)) == 0)
+                    if ((ret = readByteArray(buffer, size, offset, byteArrayValue)) == 0)
                     {
                         return 0;
                     }
@@ -586,7 +593,7 @@ namespace ouzel
                 {
                     type = Type::OBJECT;
 
-                    if ((ret = readObject(buffer, offset, objectValue)) == 0)
+                    if ((ret = readObject(buffer, size, offset, objectValue)) == 0)
                     {
                         return 0;
                     }
@@ -596,7 +603,7 @@ namespace ouzel
                 {
                     type = Type::ARRAY;
 
-                    if ((ret = readArray(buffer, offset, arrayValue)) == 0)
+                    if ((ret = readArray(buffer, size, offset, arrayValue)) == 0)
                     {
                         return 0;
                     }
@@ -606,7 +613,7 @@ namespace ouzel
                 {
                     type = Type::DICTIONARY;
 
-                    if ((ret = readDictionary(buffer, offset, dictionaryValue)) == 0)
+                    if ((ret = readDictionary(buffer, size, offset, dictionaryValue)) == 0)
                     {
                         return 0;
                     }
@@ -727,5 +734,585 @@ namespace ouzel
 
             return size;
         }
+
+        // containers nested deeper than this are treated as malformed, so that the recursion can't overflow the stack
+        static const uint32_t MAX_SKIP_DEPTH = 256;
+
+        // returns the number of bytes the value at the beginning of the buffer takes or 0 if it is malformed
+        static uint32_t skipValue(const uint8_t* buffer, uint32_t size, uint32_t depth = 0)
+        {
+            if (size < 1) return 0;
+
+            uint32_t offset = 1;
+
+            switch (static_cast<Value::Marker>(buffer[0]))
+            {
+                case Value::Marker::NONE: return offset;
+                case Value::Marker::INT8: offset += sizeof(uint8_t); break;
+                case Value::Marker::INT16: offset += sizeof(uint16_t); break;
+                case Value::Marker::INT32: offset += sizeof(uint32_t); break;
+                case Value::Marker::INT64: offset += sizeof(uint64_t); break;
+                case Value::Marker::FLOAT: offset += sizeof(float); break;
+                case Value::Marker::DOUBLE: offset += sizeof(double); break;
+                case Value::Marker::STRING:
+                {
+                    if (size - offset < sizeof(uint16_t)) return 0;
+                    uint16_t length = decodeUInt16Big(buffer + offset);
+                    offset += sizeof(length);
+                    if (size - offset < length) return 0;
+                    return offset + length;
+                }
+                case Value::Marker::LONG_STRING:
+                case Value::Marker::BYTE_ARRAY:
+                {
+                    if (size - offset < sizeof(uint32_t)) return 0;
+                    uint32_t length = decodeUInt32Big(buffer + offset);
+                    offset += sizeof(length);
+                    if (size - offset < length) return 0;
+                    return offset + length;
+                }
+                case Value::Marker::OBJECT:
+                case Value::Marker::ARRAY:
+                case Value::Marker::DICTIONARY:
+                {
+                    Value::Marker marker = static_cast<Value::Marker>(buffer[0]);
+
+                    if (depth >= MAX_SKIP_DEPTH) return 0;
+                    if (size - offset < sizeof(uint32_t)) return 0;
+                    uint32_t count = decodeUInt32Big(buffer + offset);
+                    offset += sizeof(count);
+
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        if (marker == Value::Marker::OBJECT)
+                        {
+                            if (size - offset < sizeof(uint32_t)) return 0;
+                            offset += sizeof(uint32_t);
+                        }
+                        else if (marker == Value::Marker::DICTIONARY)
+                        {
+                            if (size - offset < sizeof(uint16_t)) return 0;
+                            uint16_t length = decodeUInt16Big(buffer + offset);
+                            offset += sizeof(length);
+                            if (size - offset < length) return 0;
+                            offset += length;
+                        }
+
+                        uint32_t ret = skipValue(buffer + offset, size - offset, depth + 1);
+                        if (ret == 0) return 0;
+                        offset += ret;
+                    }
+
+                    return offset;
+                }
+                default: return 0;
+            }
+
+            return (size < offset) ? 0 : offset;
+        }
+
+        View::View(const uint8_t* initData, uint32_t initSize)
+        {
+            if (initSize < 1) return;
+
+            uint32_t offset = 1;
+            uint32_t valueSize = 0;
+
+            switch (static_cast<Value::Marker>(initData[0]))
+            {
+                case Value::Marker::NONE: type = Value::Type::NONE; break;
+                case Value::Marker::INT8: type = Value::Type::INT; valueSize = sizeof(uint8_t); break;
+                case Value::Marker::INT16: type = Value::Type::INT; valueSize = sizeof(uint16_t); break;
+                case Value::Marker::INT32: type = Value::Type::INT; valueSize = sizeof(uint32_t); break;
+                case Value::Marker::INT64: type = Value::Type::INT; valueSize = sizeof(uint64_t); break;
+                case Value::Marker::FLOAT: type = Value::Type::FLOAT; valueSize = sizeof(float); break;
+                case Value::Marker::DOUBLE: type = Value::Type::DOUBLE; valueSize = sizeof(double); break;
+                case Value::Marker::STRING:
+                    if (initSize - offset < sizeof(uint16_t)) return;
+                    type = Value::Type::STRING;
+                    length = decodeUInt16Big(initData + offset);
+                    offset += sizeof(uint16_t);
+                    valueSize = length;
+                    break;
+                case Value::Marker::LONG_STRING:
+                case Value::Marker::BYTE_ARRAY:
+                    if (initSize - offset < sizeof(uint32_t)) return;
+                    type = (initData[0] == static_cast<uint8_t>(Value::Marker::BYTE_ARRAY)) ? Value::Type::BYTE_ARRAY : Value::Type::STRING;
+                    length = decodeUInt32Big(initData + offset);
+                    offset += sizeof(uint32_t);
+                    valueSize = length;
+                    break;
+                case Value::Marker::OBJECT:
+                case Value::Marker::ARRAY:
+                case Value::Marker::DICTIONARY:
+                    if (initSize - offset < sizeof(uint32_t)) return;
+                    type = (initData[0] == static_cast<uint8_t>(Value::Marker::OBJECT)) ? Value::Type::OBJECT :
+                        (initData[0] == static_cast<uint8_t>(Value::Marker::ARRAY)) ? Value::Type::ARRAY : Value::Type::DICTIONARY;
+                    length = decodeUInt32Big(initData + offset);
+                    offset += sizeof(uint32_t);
+                    valueSize = length; // every element takes at least one byte
+                    break;
+                default:
+                    return;
+            }
+
+            if (initSize - offset < valueSize)
+            {
+                type = Value::Type::NONE;
+                length = 0;
+                return;
+            }
+
+            data = initData;
+            size = initSize;
+            marker = initData[0];
+            payloadOffset = offset;
+        }
+
+        View::View(const std::vector<uint8_t>& buffer, uint32_t offset):
+            View(offset < buffer.size() ? buffer.data() + offset : nullptr,
+                 offset < buffer.size() ? static_cast<uint32_t>(buffer.size()) - offset : 0)
+        {
+        }
+
+        uint32_t View::getEncodedSize() const
+        {
+            return data ? skipValue(data, size) : 0;
+        }
+
+        uint64_t View::asUInt64() const
+        {
+            assert(type == Value::Type::INT);
+
+            switch (static_cast<Value::Marker>(marker))
+            {
+                case Value::Marker::INT8: return data[payloadOffset];
+                case Value::Marker::INT16: return decodeUInt16Big(data + payloadOffset);
+                case Value::Marker::INT32: return decodeUInt32Big(data + payloadOffset);
+                case Value::Marker::INT64: return decodeUInt64Big(data + payloadOffset);
+                default: return 0;
+            }
+        }
+
+        double View::asDouble() const
+        {
+            assert(type == Value::Type::FLOAT || type == Value::Type::DOUBLE);
+
+            if (type == Value::Type::FLOAT)
+                return decodeFloatBig(data + payloadOffset);
+            else if (type == Value::Type::DOUBLE)
+                return decodeDoubleBig(data + payloadOffset);
+            else
+                return 0.0;
+        }
+
+        bool View::buildOffsets() const
+        {
+            if (offsetsBuilt) return offsets.size() == length;
+
+            // the constructor has checked that the count doesn't exceed the size of the buffer
+            offsetsBuilt = true;
+            offsets.reserve(length);
+
+            uint32_t offset = payloadOffset;
+
+            for (uint32_t i = 0; i < length; ++i)
+            {
+                offsets.push_back(offset);
+
+                if (type == Value::Type::OBJECT)
+                {
+                    if (size - offset < sizeof(uint32_t)) break;
+                    offset += sizeof(uint32_t);
+                }
+                else if (type == Value::Type::DICTIONARY)
+                {
+                    if (size - offset < sizeof(uint16_t)) break;
+                    uint16_t keyLength = decodeUInt16Big(data + offset);
+                    offset += sizeof(keyLength);
+                    if (size - offset < keyLength) break;
+                    offset += keyLength;
+                }
+
+                uint32_t ret = skipValue(data + offset, size - offset);
+                if (ret == 0) break;
+                offset += ret;
+            }
+
+            if (offsets.size() != length)
+            {
+                // keep only the elements that were decoded successfully
+                offsets.pop_back();
+                return false;
+            }
+
+            return true;
+        }
+
+        uint32_t View::getValueOffset(uint32_t index) const
+        {
+            uint32_t offset = offsets[index];
+
+            if (type == Value::Type::OBJECT)
+                offset += sizeof(uint32_t);
+            else if (type == Value::Type::DICTIONARY)
+                offset += sizeof(uint16_t) + decodeUInt16Big(data + offset);
+
+            return offset;
+        }
+
+        View View::getElement(uint32_t index) const
+        {
+            assert(type == Value::Type::OBJECT || type == Value::Type::ARRAY || type == Value::Type::DICTIONARY);
+
+            buildOffsets();
+
+            if (index >= offsets.size()) return View();
+
+            uint32_t offset = getValueOffset(index);
+
+            return View(data + offset, size - offset);
+        }
+
+        uint32_t View::getKey(uint32_t index) const
+        {
+            assert(type == Value::Type::OBJECT);
+
+            buildOffsets();
+
+            if (index >= offsets.size()) return 0;
+
+            return decodeUInt32Big(data + offsets[index]);
+        }
+
+        std::string View::getName(uint32_t index) const
+        {
+            assert(type == Value::Type::DICTIONARY);
+
+            buildOffsets();
+
+            if (index >= offsets.size()) return std::string();
+
+            uint32_t offset = offsets[index];
+            uint16_t keyLength = decodeUInt16Big(data + offset);
+
+            return std::string(reinterpret_cast<const char*>(data + offset + sizeof(keyLength)), keyLength);
+        }
+
+        View View::operator[](uint32_t key) const
+        {
+            assert(type == Value::Type::OBJECT || type == Value::Type::ARRAY);
+
+            if (type == Value::Type::ARRAY) return getElement(key);
+
+            buildOffsets();
+
+            for (uint32_t i = 0; i < offsets.size(); ++i)
+            {
+                if (decodeUInt32Big(data + offsets[i]) == key)
+                {
+                    uint32_t offset = getValueOffset(i);
+                    return View(data + offset, size - offset);
+                }
+            }
+
+            return View();
+        }
+
+        View View::operator[](const std::string& key) const
+        {
+            assert(type == Value::Type::DICTIONARY);
+
+            buildOffsets();
+
+            for (uint32_t i = 0; i < offsets.size(); ++i)
+            {
+                uint32_t offset = offsets[i];
+                uint16_t keyLength = decodeUInt16Big(data + offset);
+
+                if (keyLength == key.length() &&
+                    memcmp(data + offset + sizeof(keyLength), key.data(), keyLength) == 0)
+                {
+                    offset = getValueOffset(i);
+                    return View(data + offset, size - offset);
+                }
+            }
+
+            return View();
+        }
+
+        bool View::decode(Value& value) const
+        {
+            return data && value.decode(data, size) != 0;
+        }
+
+        Writer::Writer(uint8_t* initBuffer, uint32_t initCapacity):
+            buffer(initBuffer), capacity(initCapacity)
+        {
+        }
+
+        void Writer::reset()
+        {
+            offset = 0;
+            depth = 0;
+            overflown = false;
+        }
+
+        bool Writer::reserve(uint64_t count)
+        {
+            if (overflown || capacity - offset < count)
+            {
+                overflown = true;
+                return false;
+            }
+
+            return true;
+        }
+
+        bool Writer::beginValue()
+        {
+            if (depth > 0)
+            {
+                Container& container = stack[depth - 1];
+
+                if (container.marker == Value::Marker::ARRAY)
+                    ++container.count;
+                else if (container.expectValue)
+                    container.expectValue = false;
+                else
+                {
+                    Log(Log::Level::ERR) << "Expected a key";
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool Writer::writeNone()
+        {
+            if (!reserve(1) || !beginValue()) return false;
+
+            buffer[offset++] = static_cast<uint8_t>(Value::Marker::NONE);
+
+            return true;
+        }
+
+        bool Writer::writeInt(uint64_t value)
+        {
+            if (value > std::numeric_limits<uint32_t>::max())
+            {
+                if (!reserve(1 + sizeof(uint64_t)) || !beginValue()) return false;
+                buffer[offset++] = static_cast<uint8_t>(Value::Marker::INT64);
+                encodeUInt64Big(buffer + offset, value);
+                offset += sizeof(uint64_t);
+            }
+            else if (value > std::numeric_limits<uint16_t>::max())
+            {
+                if (!reserve(1 + sizeof(uint32_t)) || !beginValue()) return false;
+                buffer[offset++] = static_cast<uint8_t>(Value::Marker::INT32);
+                encodeUInt32Big(buffer + offset, static_cast<uint32_t>(value));
+                offset += sizeof(uint32_t);
+            }
+            else if (value > std::numeric_limits<uint8_t>::max())
+            {
+                if (!reserve(1 + sizeof(uint16_t)) || !beginValue()) return false;
+                buffer[offset++] = static_cast<uint8_t>(Value::Marker::INT16);
+                encodeUInt16Big(buffer + offset, static_cast<uint16_t>(value));
+                offset += sizeof(uint16_t);
+            }
+            else
+            {
+                if (!reserve(1 + sizeof(uint8_t)) || !beginValue()) return false;
+                buffer[offset++] = static_cast<uint8_t>(Value::Marker::INT8);
+                buffer[offset++] = static_cast<uint8_t>(value);
+            }
+
+            return true;
+        }
+
+        bool Writer::writeFloat(float value)
+        {
+            if (!reserve(1 + sizeof(value)) || !beginValue()) return false;
+
+            buffer[offset++] = static_cast<uint8_t>(Value::Marker::FLOAT);
+            encodeFloatBig(buffer + offset, value);
+            offset += sizeof(value);
+
+            return true;
+        }
+
+        bool Writer::writeDouble(double value)
+        {
+            if (!reserve(1 + sizeof(value)) || !beginValue()) return false;
+
+            buffer[offset++] = static_cast<uint8_t>(Value::Marker::DOUBLE);
+            encodeDoubleBig(buffer + offset, value);
+            offset += sizeof(value);
+
+            return true;
+        }
+
+        bool Writer::writeString(const char* value, uint32_t valueLength)
+        {
+            if (valueLength > std::numeric_limits<uint16_t>::max())
+            {
+                if (!reserve(1 + sizeof(uint32_t) + static_cast<uint64_t>(valueLength)) || !beginValue()) return false;
+
+                buffer[offset++] = static_cast<uint8_t>(Value::Marker::LONG_STRING);
+                encodeUInt32Big(buffer + offset, valueLength);
+                offset += sizeof(uint32_t);
+            }
+            else
+            {
+                if (!reserve(1 + sizeof(uint16_t) + valueLength) || !beginValue()) return false;
+
+                buffer[offset++] = static_cast<uint8_t>(Value::Marker::STRING);
+                encodeUInt16Big(buffer + offset, static_cast<uint16_t>(valueLength));
+                offset += sizeof(uint16_t);
+            }
+
+            memcpy(buffer + offset, value, valueLength);
+            offset += valueLength;
+
+            return true;
+        }
+
+        bool Writer::writeByteArray(const uint8_t* value, uint32_t valueSize)
+        {
+            if (!reserve(1 + sizeof(uint32_t) + static_cast<uint64_t>(valueSize)) || !beginValue()) return false;
+
+            buffer[offset++] = static_cast<uint8_t>(Value::Marker::BYTE_ARRAY);
+            encodeUInt32Big(buffer + offset, valueSize);
+            offset += sizeof(uint32_t);
+
+            memcpy(buffer + offset, value, valueSize);
+            offset += valueSize;
+
+            return true;
+        }
+
+        bool Writer::writeValue(const Value& value)
+        {
+            switch (value.getType())
+            {
+                case Value::Type::NONE: return writeNone();
+                case Value::Type::INT: return writeInt(value.asUInt64());
+                case Value::Type::FLOAT: return writeFloat(value.asFloat());
+                case Value::Type::DOUBLE: return writeDouble(value.asDouble());
+                case Value::Type::STRING: return writeString(value.asString());
+                case Value::Type::BYTE_ARRAY: return writeByteArray(value.asByteArray());
+                case Value::Type::OBJECT:
+                    if (!beginObject()) return false;
+                    for (const auto& i : value.asMap())
+                        if (!writeKey(i.first) || !writeValue(i.second)) return false;
+                    return endObject();
+                case Value::Type::ARRAY:
+                    if (!beginArray()) return false;
+                    for (const Value& i : value.asVector())
+                        if (!writeValue(i)) return false;
+                    return endArray();
+                case Value::Type::DICTIONARY:
+                    if (!beginDictionary()) return false;
+                    for (const auto& i : value.asDictionary())
+                        if (!writeKey(i.first) || !writeValue(i.second)) return false;
+                    return endDictionary();
+            }
+
+            return false;
+        }
+
+        bool Writer::beginContainer(Value::Marker containerMarker)
+        {
+            if (depth >= MAX_DEPTH)
+            {
+                Log(Log::Level::ERR) << "Maximum nesting depth exceeded";
+                return false;
+            }
+
+            if (!reserve(1 + sizeof(uint32_t)) || !beginValue()) return false;
+
+            buffer[offset++] = static_cast<uint8_t>(containerMarker);
+
+            Container& container = stack[depth++];
+            container.marker = containerMarker;
+            container.countOffset = offset;
+            container.count = 0;
+            container.expectValue = false;
+
+            offset += sizeof(uint32_t); // filled in by endContainer
+
+            return true;
+        }
+
+        bool Writer::endContainer(Value::Marker containerMarker)
+        {
+            if (overflown) return false;
+
+            if (depth == 0 ||
+                stack[depth - 1].marker != containerMarker ||
+                stack[depth - 1].expectValue)
+            {
+                Log(Log::Level::ERR) << "Unexpected end of a container";
+                return false;
+            }
+
+            const Container& container = stack[--depth];
+            encodeUInt32Big(buffer + container.countOffset, container.count);
+
+            return true;
+        }
+
+        bool Writer::beginObject() { return beginContainer(Value::Marker::OBJECT); }
+        bool Writer::endObject() { return endContainer(Value::Marker::OBJECT); }
+        bool Writer::beginArray() { return beginContainer(Value::Marker::ARRAY); }
+        bool Writer::endArray() { return endContainer(Value::Marker::ARRAY); }
+        bool Writer::beginDictionary() { return beginContainer(Value::Marker::DICTIONARY); }
+        bool Writer::endDictionary() { return endContainer(Value::Marker::DICTIONARY); }
+
+        bool Writer::writeKey(uint32_t key)
+        {
+            if (depth == 0 ||
+                stack[depth - 1].marker != Value::Marker::OBJECT ||
+                stack[depth - 1].expectValue)
+            {
+                Log(Log::Level::ERR) << "Unexpected object key";
+                return false;
+            }
+
+            if (!reserve(sizeof(key))) return false;
+
+            encodeUInt32Big(buffer + offset, key);
+            offset += sizeof(key);
+
+            ++stack[depth - 1].count;
+            stack[depth - 1].expectValue = true;
+
+            return true;
+        }
+
+        bool Writer::writeKey(const std::string& key)
+        {
+            if (depth == 0 ||
+                stack[depth - 1].marker != Value::Marker::DICTIONARY ||
+                stack[depth - 1].expectValue ||
+                key.length() > std::numeric_limits<uint16_t>::max())
+            {
+                Log(Log::Level::ERR) << "Unexpected dictionary key";
+                return false;
+            }
+
+            if (!reserve(sizeof(uint16_t) + key.length())) return false;
+
+            encodeUInt16Big(buffer + offset, static_cast<uint16_t>(key.length()));
+            offset += sizeof(uint16_t);
+            memcpy(buffer + offset, key.data(), key.length());
+            offset += static_cast<uint32_t>(key.length());
+
+            ++stack[depth - 1].count;
+            stack[depth - 1].expectValue = true;
+
+            return true;
+        }
     } // namespace obf
 } // namespace ouzel
@@ -205,6 +205,7 @@ namespace ouzel
             inline bool isStringType() const { return type == Type::STRING; }
 
             uint32_t decode(const std::vector<uint8_t>& buffer, uint32_t offset = 0);
+            uint32_t decode(const uint8_t* buffer, uint32_t size, uint32_t offset = 0);
             uint32_t encode(std::vector<uint8_t>& buffer) const;
 
             inline bool operator!()
@@ -471,5 +472,177 @@ namespace ouzel
             std::vector<Value> arrayValue;
             std::map<std::string, Value> dictionaryValue;
         };
+
+        // read-only view of an encoded value that decodes it lazily from a borrowed buffer
+        class View
+        {
+        public:
+            View() {}
+            View(const uint8_t* initData, uint32_t initSize);
+            View(const std::vector<uint8_t>& buffer, uint32_t offset = 0);
+
+            inline bool isValid() const { return data != nullptr; }
+            inline Value::Type getType() const { return type; }
+            inline bool isIntType() const { return type == Value::Type::INT; }
+            inline bool isFloatType() const { return type == Value::Type::FLOAT || type == Value::Type::DOUBLE; }
+            inline bool isStringType() const { return type == Value::Type::STRING; }
+
+            // number of bytes the value takes in the buffer, 0 if it is malformed
+            uint32_t getEncodedSize() const;
+
+            uint64_t asUInt64() const;
+            inline int8_t asInt8() const { return static_cast<int8_t>(asUInt64()); }
+            inline uint8_t asUInt8() const { return static_cast<uint8_t>(asUInt64()); }
+            inline int16_t asInt16() const { return static_cast<int16_t>(asUInt64()); }
+            inline uint16_t asUInt16() const { return static_cast<uint16_t>(asUInt64()); }
+            inline int32_t asInt32() const { return static_cast<int32_t>(asUInt64()); }
+            inline uint32_t asUInt32() const { return static_cast<uint32_t>(asUInt64()); }
+            inline int64_t asInt64() const { return static_cast<int64_t>(asUInt64()); }
+            double asDouble() const;
+            inline float asFloat() const { return static_cast<float>(asDouble()); }
+
+            inline std::string asString() const
+            {
+                assert(type == Value::Type::STRING);
+
+                return std::string(reinterpret_cast<const char*>(data + payloadOffset), length);
+            }
+
+            // strings and byte arrays point into the buffer
+            inline const char* getStringData() const
+            {
+                assert(type == Value::Type::STRING);
+
+                return reinterpret_cast<const char*>(data + payloadOffset);
+            }
+
+            inline uint32_t getStringLength() const
+            {
+                assert(type == Value::Type::STRING);
+
+                return length;
+            }
+
+            inline const uint8_t* getByteArrayData() const
+            {
+                assert(type == Value::Type::BYTE_ARRAY);
+
+                return data + payloadOffset;
+            }
+
+            inline uint32_t getByteArraySize() const
+            {
+                assert(type == Value::Type::BYTE_ARRAY);
+
+                return length;
+            }
+
+            // number of elements in an object, array or dictionary
+            inline uint32_t getSize() const
+            {
+                assert(type == Value::Type::OBJECT || type == Value::Type::ARRAY || type == Value::Type::DICTIONARY);
+
+                return length;
+            }
+
+            // the element at the given position of an object, array or dictionary
+            View getElement(uint32_t index) const;
+            uint32_t getKey(uint32_t index) const; // object key
+            std::string getName(uint32_t index) const; // dictionary key
+
+            View operator[](uint32_t key) const; // array index or object key
+            View operator[](const std::string& key) const; // dictionary key
+
+            inline bool hasElement(uint32_t key) const { return (*this)[key].isValid(); }
+            inline bool hasElement(const std::string& key) const { return (*this)[key].isValid(); }
+
+            // decodes the whole value into a tree
+            bool decode(Value& value) const;
+
+        private:
+            bool buildOffsets() const;
+            uint32_t getValueOffset(uint32_t index) const;
+
+            const uint8_t* data = nullptr;
+            uint32_t size = 0;
+            Value::Type type = Value::Type::NONE;
+            uint8_t marker = 0;
+            uint32_t payloadOffset = 0; // offset of the string, byte array or the first element
+            uint32_t length = 0; // string length, byte array size or element count
+            mutable std::vector<uint32_t> offsets; // element offsets, built on the first element access
+            mutable bool offsetsBuilt = false; // the offsets of a malformed container are not rebuilt
+        };
+
+        // streaming encoder that writes into a preallocated buffer
+        class Writer
+        {
+        public:
+            static const uint32_t MAX_DEPTH = 32;
+
+            Writer(uint8_t* initBuffer, uint32_t initCapacity);
+
+            Writer(const Writer&) = delete;
+            Writer& operator=(const Writer&) = delete;
+
+            Writer(Writer&&) = delete;
+            Writer& operator=(Writer&&) = delete;
+
+            // all the writes fail after the buffer has overflown
+            inline bool hasOverflown() const { return overflown; }
+            inline uint32_t getSize() const { return offset; }
+            inline uint32_t getDepth() const { return depth; }
+
+            void reset();
+
+            bool writeNone();
+            bool writeInt(uint64_t value);
+            bool writeFloat(float value);
+            bool writeDouble(double value);
+            bool writeString(const char* value, uint32_t valueLength);
+            inline bool writeString(const std::string& value)
+            {
+                return writeString(value.data(), static_cast<uint32_t>(value.length()));
+            }
+            bool writeByteArray(const uint8_t* value, uint32_t valueSize);
+            inline bool writeByteArray(const std::vector<uint8_t>& value)
+            {
+                return writeByteArray(value.data(), static_cast<uint32_t>(value.size()));
+            }
+            bool writeValue(const Value& value);
+
+            // element counts are filled in when the container is ended
+            bool beginObject();
+            bool endObject();
+            bool beginArray();
+            bool endArray();
+            bool beginDictionary();
+            bool endDictionary();
+
+            // every value of an object or a dictionary must be preceded by a key
+            bool writeKey(uint32_t key);
+            bool writeKey(const std::string& key);
+
+        private:
+            bool reserve(uint64_t count);
+            bool beginValue();
+            bool beginContainer(Value::Marker containerMarker);
+            bool endContainer(Value::Marker containerMarker);
+
+            uint8_t* buffer;
+            uint32_t capacity;
+            uint32_t offset = 0;
+            bool overflown = false;
+
+            struct Container
+            {
+                Value::Marker marker;
+                uint32_t countOffset;
+                uint32_t count;
+                bool expectValue;
+            };
+
+            Container stack[MAX_DEPTH];
+            uint32_t depth = 0;
+        };
     } // namespace obf
 } // namespace ouzel
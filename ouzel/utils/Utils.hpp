@@ -7,6 +7,7 @@
 #include <vector>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <functional>
 #include <random>
@@ -187,6 +188,22 @@ namespace ouzel
         return static_cast<uint16_t>(result);
     };
 
+    inline float decodeFloatBig(const void* buffer)
+    {
+        uint32_t bits = decodeUInt32Big(buffer);
+        float result;
+        memcpy(&result, &bits, sizeof(result));
+        return result;
+    };
+
+    inline double decodeDoubleBig(const void* buffer)
+    {
+        uint64_t bits = decodeUInt64Big(buffer);
+        double result;
+        memcpy(&result, &bits, sizeof(result));
+        return result;
+    };
+
     // encoding
 
     inline void encodeInt64Big(void* buffer, int64_t value)
@@ -317,12 +334,26 @@ namespace ouzel
         bytes[0] = static_cast<uint8_t>(value);
     };
 
-    template<class T>
-    inline std::vector<uint32_t> utf8ToUtf32(const T& text)
+    inline void encodeFloatBig(void* buffer, float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        encodeUInt32Big(buffer, bits);
+    };
+
+    inline void encodeDoubleBig(void* buffer, double value)
+    {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        encodeUInt64Big(buffer, bits);
+    };
+
+    template<class Iterator>
+    inline std::vector<uint32_t> utf8ToUtf32(Iterator begin, Iterator end)
     {
         std::vector<uint32_t> result;
 
-        for (auto i = text.begin(); i != text.end(); ++i)
+        for (Iterator i = begin; i != end; ++i)
         {
             uint32_t cp = *i & 0xff;
 
@@ -332,23 +363,23 @@ namespace ouzel
             }
             else if ((cp >> 5) == 0x6) // length = 2
             {
-                if (++i == text.end()) return result;
+                if (++i == end) return result;
                 cp = ((cp << 6) & 0x7ff) + (*i & 0x3f);
             }
             else if ((cp >> 4) == 0xe) // length = 3
             {
-                if (++i == text.end()) return result;
+                if (++i == end) return result;
                 cp = ((cp << 12) & 0xffff) + (((*i & 0xff) << 6) & 0xfff);
-                if (++i == text.end()) return result;
+                if (++i == end) return result;
                 cp += *i & 0x3f;
             }
             else if ((cp >> 3) == 0x1e) // length = 4
             {
-                if (++i == text.end()) return result;
+                if (++i == end) return result;
                 cp = ((cp << 18) & 0x1fffff) + (((*i & 0xff) << 12) & 0x3ffff);
-                if (++i == text.end()) return result;
+                if (++i == end) return result;
                 cp += ((*i & 0xff) << 6) & 0xfff;
-                if (++i == text.end()) return result;
+                if (++i == end) return result;
                 cp += (*i) & 0x3f;
             }
 
@@ -358,6 +389,12 @@ namespace ouzel
         return result;
     }
 
+    template<class T>
+    inline std::vector<uint32_t> utf8ToUtf32(const T& text)
+    {
+        return utf8ToUtf32(text.begin(), text.end());
+    }
+
     inline std::string utf32ToUtf8(uint32_t c)
     {
         std::string result;
@@ -1,9 +1,11 @@
 // Copyright (C) 2018 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
-#include <algorithm>
+#include <cstring>
 #include "XML.hpp"
 #include "core/Engine.hpp"
+#include "files/FileSystem.hpp"
+#include "files/MappedFile.hpp"
 #include "Log.hpp"
 #include "Utils.hpp"
 
@@ -11,7 +13,9 @@ namespace ouzel
 {
     namespace xml
     {
-        static inline bool isWhitespace(uint32_t c)
+        const std::string Node::EMPTY;
+
+        static inline bool isWhitespace(uint8_t c)
         {
             return c == ' ' || c == '\t' || c == '\r' || c == '\n';
         }
@@ -40,69 +44,111 @@ namespace ouzel
                 (c >= 0x203F && c <= 0x2040);
         }
 
-        static bool skipWhitespaces(const std::vector<uint32_t>& str,
-                                    std::vector<uint32_t>::const_iterator& iterator)
+        // decodes the UTF-8 sequence at the iterator and returns its length or 0 if it is truncated
+        static inline uint32_t decodeChar(const uint8_t* iterator, const uint8_t* end, uint32_t& c)
         {
-            for (;;)
-            {
-                if (iterator == str.end()) break;
+            c = *iterator;
 
-                if (isWhitespace(*iterator))
-                    ++iterator;
-                else
-                    break;
+            if (c <= 0x7F) return 1;
+
+            uint32_t length;
+            if ((c >> 5) == 0x06)
+            {
+                length = 2;
+                c &= 0x1F;
+            }
+            else if ((c >> 4) == 0x0E)
+            {
+                length = 3;
+                c &= 0x0F;
             }
+            else if ((c >> 3) == 0x1E)
+            {
+                length = 4;
+                c &= 0x07;
+            }
+            else return 1; // invalid lead byte, it will not match any name character
 
-            return true;
+            if (end - iterator < static_cast<ptrdiff_t>(length)) return 0;
+
+            for (uint32_t i = 1; i < length; ++i)
+                c = (c << 6) | (iterator[i] & 0x3F);
+
+            return length;
+        }
+
+        static inline void skipWhitespaces(const uint8_t*& iterator, const uint8_t* end)
+        {
+            while (iterator != end && isWhitespace(*iterator)) ++iterator;
+        }
+
+        static inline void append(std::string& result, const uint8_t* begin, const uint8_t* end)
+        {
+            result.append(reinterpret_cast<const char*>(begin), static_cast<size_t>(end - begin));
         }
 
-        static bool parseName(const std::vector<uint32_t>& str,
-                              std::vector<uint32_t>::const_iterator& iterator,
-                              std::string& result)
+        static bool skipName(const uint8_t*& iterator, const uint8_t* end)
         {
-            result.clear();
+            if (iterator == end)
+            {
+                Log(Log::Level::ERR) << "Unexpected end of data";
+                return false;
+            }
 
-            if (iterator == str.end())
+            uint32_t c;
+            uint32_t length = decodeChar(iterator, end, c);
+
+            if (length == 0)
             {
                 Log(Log::Level::ERR) << "Unexpected end of data";
                 return false;
             }
 
-            if (!isNameStartChar(*iterator))
+            if (!isNameStartChar(c))
             {
                 Log(Log::Level::ERR) << "Invalid name start";
                 return false;
             }
 
+            iterator += length;
+
             for (;;)
             {
-                if (iterator == str.end())
+                if (iterator == end ||
+                    (length = decodeChar(iterator, end, c)) == 0)
                 {
                     Log(Log::Level::ERR) << "Unexpected end of data";
                     return false;
                 }
 
-                if (!isNameChar(*iterator))
-                {
-                    break;
-                }
-                else
-                {
-                    result += utf32ToUtf8(*iterator);
-                    ++iterator;
-                }
+                if (!isNameChar(c)) break;
+
+                iterator += length;
             }
 
             return true;
         }
 
-        static bool parseEntity(const std::vector<uint32_t>& str,
-                                std::vector<uint32_t>::const_iterator& iterator,
-                                std::string& result)
+        static bool parseName(const uint8_t*& iterator, const uint8_t* end, std::string& result)
         {
-            result.clear();
+            const uint8_t* start = iterator;
+            if (!skipName(iterator, end)) return false;
+
+            result.assign(reinterpret_cast<const char*>(start), static_cast<size_t>(iterator - start));
+
+            return true;
+        }
+
+        static bool matches(const uint8_t* begin, const uint8_t* end, const char* str)
+        {
+            size_t length = strlen(str);
+            return static_cast<size_t>(end - begin) == length && memcmp(begin, str, length) == 0;
+        }
 
-            if (iterator == str.end())
+        // appends the decoded entity to the result
+        static bool parseEntity(const uint8_t*& iterator, const uint8_t* end, std::string& result)
+        {
+            if (iterator == end)
             {
                 Log(Log::Level::ERR) << "Unexpected end of data";
                 return false;
@@ -114,56 +160,42 @@ namespace ouzel
                 return false;
             }
 
-            std::string value;
+            const uint8_t* start = ++iterator;
 
             for (;;)
             {
-                if (++iterator == str.end())
+                if (iterator == end)
                 {
                     Log(Log::Level::ERR) << "Unexpected end of data";
                     return false;
                 }
 
-                if (*iterator == ';')
-                {
-                    ++iterator;
-                    break;
-                }
-                else
-                {
-                    value.push_back(static_cast<char>(*iterator));
-                }
+                if (*iterator == ';') break;
+
+                ++iterator;
             }
 
-            if (value.empty())
+            const uint8_t* valueEnd = iterator++; // skip the semicolon
+
+            if (start == valueEnd)
             {
                 Log(Log::Level::ERR) << "Invalid entity";
                 return false;
             }
 
-            if (value == "quot")
-            {
-                result = "\"";
-            }
-            else if (value == "amp")
-            {
-                result = "&";
-            }
-            else if (value == "apos")
+            if (matches(start, valueEnd, "quot")) result.push_back('"');
+            else if (matches(start, valueEnd, "amp")) result.push_back('&');
+            else if (matches(start, valueEnd, "apos")) result.push_back('\'');
+            else if (matches(start, valueEnd, "lt")) result.push_back('<');
+            else if (matches(start, valueEnd, "gt")) result.push_back('>');
+            else if (*start == '#')
             {
-                result = "'";
-            }
-            else if (value == "lt")
-            {
-                result = "<";
-            }
-            else if (value == "gt")
-            {
-                result = ">";
-            }
-            else if (value[0] == '#')
-            {
-                if (value.length() < 2)
+                const uint8_t* i = start + 1;
+                bool hex = (i != valueEnd && *i == 'x');
+                if (hex) ++i;
+
+                // at most 6 hex or 7 decimal digits for code points up to 0x10FFFF
+                if (i == valueEnd || valueEnd - i > (hex ? 6 : 7))
                 {
                     Log(Log::Level::ERR) << "Invalid entity";
                     return false;
@@ -171,52 +203,29 @@ namespace ouzel
 
                 uint32_t c = 0;
 
-                if (value[1] == 'x') // hex value
+                for (; i != valueEnd; ++i)
                 {
-                    if (value.length() != 2 + 4)
-                    {
-                        Log(Log::Level::ERR) << "Invalid entity";
-                        return false;
-                    }
+                    uint32_t code;
 
-                    for (size_t i = 0; i < 4; ++i)
-                    {
-                        uint8_t code = 0;
-
-                        if (value[i + 2] >= '0' && value[i + 2] <= '9') code = static_cast<uint8_t>(value[i + 2]) - '0';
-                        else if (value[i + 2] >= 'a' && value[i + 2] <='f') code = static_cast<uint8_t>(value[i + 2]) - 'a' + 10;
-                        else if (value[i + 2] >= 'A' && value[i + 2] <='F') code = static_cast<uint8_t>(value[i + 2]) - 'A' + 10;
-                        else
-                        {
-                            Log(Log::Level::ERR) << "Invalid character code";
-                            return false;
-                        }
-                        c = (c << 4) | code;
-                    }
-                }
-                else
-                {
-                    if (value.length() != 1 + 4)
+                    if (*i >= '0' && *i <= '9') code = *i - '0';
+                    else if (hex && *i >= 'a' && *i <= 'f') code = *i - 'a' + 10;
+                    else if (hex && *i >= 'A' && *i <= 'F') code = *i - 'A' + 10;
+                    else
                     {
-                        Log(Log::Level::ERR) << "Invalid entity";
+                        Log(Log::Level::ERR) << "Invalid character code";
                         return false;
                     }
 
-                    for (size_t i = 0; i < 4; ++i)
-                    {
-                        uint8_t code = 0;
+                    c = hex ? ((c << 4) | code) : (c * 10 + code);
+                }
 
-                        if (value[i + 1] >= '0' && value[i + 1] <= '9') code = static_cast<uint8_t>(value[i + 1]) - '0';
-                        else
-                        {
-                            Log(Log::Level::ERR) << "Invalid character code";
-                            return false;
-                        }
-                        c = c * 10 + code;
-                    }
+                if (c > 0x10FFFF)
+                {
+                    Log(Log::Level::ERR) << "Invalid character code";
+                    return false;
                 }
 
-                result = utf32ToUtf8(c);
+                result += utf32ToUtf8(c);
             }
             else
             {
@@ -227,13 +236,9 @@ namespace ouzel
             return true;
         }
 
-        static bool parseString(const std::vector<uint32_t>& str,
-                                std::vector<uint32_t>::const_iterator& iterator,
-                                std::string& result)
+        static bool parseString(const uint8_t*& iterator, const uint8_t* end, std::string& result)
         {
-            result.clear();
-
-            if (iterator == str.end())
+            if (iterator == end)
             {
                 Log(Log::Level::ERR) << "Unexpected end of data";
                 return false;
@@ -245,66 +250,105 @@ namespace ouzel
                 return false;
             }
 
-            char quotes = static_cast<char>(*iterator);
+            uint8_t quotes = *iterator;
 
-            ++iterator;
+            const uint8_t* start = ++iterator;
 
             for (;;)
             {
-                if (iterator == str.end())
+                if (iterator == end)
                 {
                     Log(Log::Level::ERR) << "Unexpected end of data";
                     return false;
                 }
 
-                if (*iterator == static_cast<uint32_t>(quotes))
+                if (*iterator == quotes)
                 {
+                    append(result, start, iterator);
                     ++iterator;
                     break;
                 }
                 else if (*iterator == '&')
                 {
-                    std::string entity;
-                    if (!parseEntity(str, iterator, entity)) return false;
-                    result += entity;
+                    append(result, start, iterator);
+                    if (!parseEntity(iterator, end, result)) return false;
+                    start = iterator;
                 }
                 else
-                {
-                    result += utf32ToUtf8(*iterator);
                     ++iterator;
-                }
             }
 
             return true;
         }
 
-        static bool encodeString(std::vector<uint8_t>& data,
-                                 const std::vector<uint32_t>& str)
+        static void encodeString(std::vector<uint8_t>& data, const std::string& str)
         {
-            for (uint32_t c : str)
+            for (char c : str)
             {
                 if (c == '"') data.insert(data.end(), {'&', 'q', 'u', 'o', 't', ';'});
                 else if (c == '&') data.insert(data.end(), {'&', 'a', 'm', 'p', ';'});
                 else if (c == '\'') data.insert(data.end(), {'&', 'a', 'p', 'o', 's', ';'});
                 else if (c == '<') data.insert(data.end(), {'&', 'l', 't', ';'});
                 else if (c == '>') data.insert(data.end(), {'&', 'g', 't', ';'});
-                else
-                {
-                    std::string encoded = utf32ToUtf8(c);
-                    data.insert(data.end(), encoded.begin(), encoded.end());
-                }
+                else data.push_back(static_cast<uint8_t>(c));
             }
+        }
 
-            return true;
+        static void encodeAttributes(std::vector<uint8_t>& data,
+                                     const std::vector<std::pair<std::string, std::string>>& attributes)
+        {
+            for (const auto& attribute : attributes)
+            {
+                data.push_back(' ');
+                data.insert(data.end(), attribute.first.begin(), attribute.first.end());
+                data.insert(data.end(), {'=', '"'});
+                encodeString(data, attribute.second);
+                data.push_back('"');
+            }
         }
 
-        bool Node::parse(const std::vector<uint32_t>& str,
-                         std::vector<uint32_t>::const_iterator& iterator,
+        bool Node::parseAttribute(const uint8_t*& iterator, const uint8_t* end)
+        {
+            std::string name;
+            if (!parseName(iterator, end, name)) return false;
+
+            skipWhitespaces(iterator, end);
+
+            if (iterator == end)
+            {
+                Log(Log::Level::ERR) << "Unexpected end of data";
+                return false;
+            }
+
+            if (*iterator != '=')
+            {
+                Log(Log::Level::ERR) << "Expected an equal sign";
+                return false;
+            }
+
+            ++iterator;
+
+            skipWhitespaces(iterator, end);
+
+            auto i = findAttribute(name);
+
+            if (i != attributes.end() && i->first == name)
+            {
+                Log(Log::Level::ERR) << "Duplicate attribute " << name;
+                return false;
+            }
+
+            i = attributes.insert(i, std::make_pair(std::move(name), std::string()));
+
+            return parseString(iterator, end, i->second);
+        }
+
+        bool Node::parse(const uint8_t*& iterator, const uint8_t* end,
                          bool preserveWhitespaces,
                          bool preserveComments,
                          bool preserveProcessingInstructions)
         {
-            if (iterator == str.end())
+            if (iterator == end)
             {
                 Log(Log::Level::ERR) << "Unexpected end of data";
                 return false;
@@ -312,7 +356,7 @@ namespace ouzel
 
             if (*iterator == '<')
             {
-                if (++iterator == str.end())
+                if (++iterator == end)
                 {
                     Log(Log::Level::ERR) << "Unexpected end of data";
                     return false;
@@ -320,7 +364,7 @@ namespace ouzel
 
                 if (*iterator == '!') // <!
                 {
-                    if (++iterator == str.end())
+                    if (++iterator == end)
                     {
                         Log(Log::Level::ERR) << "Unexpected end of data";
                         return false;
@@ -328,7 +372,7 @@ namespace ouzel
 
                     if (*iterator == '-') // <!-
                     {
-                        if (++iterator == str.end())
+                        if (++iterator == end)
                         {
                             Log(Log::Level::ERR) << "Unexpected end of data";
                             return false;
@@ -340,78 +384,71 @@ namespace ouzel
                             return false;
                         }
 
+                        const uint8_t* start = ++iterator;
+
                         for (;;)
                         {
-                            if (std::distance<std::vector<uint32_t>::const_iterator>(++iterator, str.end()) < 3)
+                            if (end - iterator < 3)
                             {
                                 Log(Log::Level::ERR) << "Unexpected end of data";
                                 return false;
                             }
 
-                            if (*iterator == '-')
+                            if (iterator[0] == '-' && iterator[1] == '-') // --
                             {
-                                if (*(iterator + 1) == '-') // --
+                                if (iterator[2] != '>') // -->
                                 {
-                                    iterator += 2;
-
-                                    if (*iterator == '>') // -->
-                                    {
-                                        ++iterator;
-                                        break;
-                                    }
-                                    else
-                                    {
-                                        Log(Log::Level::ERR) << "Unexpected double-hyphen inside comment";
-                                        return false;
-                                    }
+                                    Log(Log::Level::ERR) << "Unexpected double-hyphen inside comment";
+                                    return false;
                                 }
+
+                                value.assign(reinterpret_cast<const char*>(start), static_cast<size_t>(iterator - start));
+                                iterator += 3;
+                                break;
                             }
 
-                            value += utf32ToUtf8(*iterator);
+                            ++iterator;
                         }
 
                         type = Type::COMMENT;
                     }
                     else if (*iterator == '[') // <![
                     {
-                        std::string name;
-                        if (!parseName(str, ++iterator, name)) return false;
+                        const uint8_t* name = ++iterator;
+                        if (!skipName(iterator, end)) return false;
 
-                        if (name != "CDATA")
+                        if (!matches(name, iterator, "CDATA"))
                         {
                             Log(Log::Level::ERR) << "Expected CDATA";
                             return false;
                         }
 
-                        if (iterator == str.end())
-                        {
-                            Log(Log::Level::ERR) << "Unexpected end of data";
-                            return false;
-                        }
-
                         if (*iterator != '[')
                         {
                             Log(Log::Level::ERR) << "Expected a left bracket";
                             return false;
                         }
 
+                        const uint8_t* start = ++iterator;
+
                         for (;;)
                         {
-                            if (std::distance<std::vector<uint32_t>::const_iterator>(++iterator, str.end()) < 3)
+                            if (end - iterator < 3)
                             {
                                 Log(Log::Level::ERR) << "Unexpected end of data";
                                 return false;
                             }
 
-                            if (*iterator == ']' &&
-                                *(iterator + 1) == ']' &&
-                                *(iterator + 2) == '>')
+                            if (iterator[0] == ']' &&
+                                iterator[1] == ']' &&
+                                iterator[2] == '>')
                             {
+                                value.assign(reinterpret_cast<const char*>(start), static_cast<size_t>(iterator - start));
                                 iterator += 3;
                                 break;
                             }
 
-                            value += utf32ToUtf8(*iterator);
+                            ++iterator;
                         }
 
                         type = Type::CDATA;
@@ -424,13 +461,13 @@ namespace ouzel
                 }
                 else if (*iterator == '?') // <?
                 {
-                    if (!parseName(str, ++iterator, value)) return false;
+                    if (!parseName(++iterator, end, value)) return false;
 
                     for (;;)
                     {
-                        if (!skipWhitespaces(str, iterator)) return false;
+                        skipWhitespaces(iterator, end);
 
-                        if (iterator == str.end())
+                        if (iterator == end)
                         {
                             Log(Log::Level::ERR) << "Unexpected end of data";
                             return false;
@@ -438,7 +475,7 @@ namespace ouzel
 
                         if (*iterator == '?')
                         {
-                            if (++iterator == str.end())
+                            if (++iterator == end)
                             {
                                 Log(Log::Level::ERR) << "Unexpected end of data";
                                 return false;
@@ -454,45 +491,22 @@ namespace ouzel
                             break;
                         }
 
-                        std::string attribute;
-                        if (!parseName(str, iterator, attribute)) return false;
-
-                        if (!skipWhitespaces(str, iterator)) return false;
-
-                        if (iterator == str.end())
-                        {
-                            Log(Log::Level::ERR) << "Unexpected end of data";
-                            return false;
-                        }
-
-                        if (*iterator != '=')
-                        {
-                            Log(Log::Level::ERR) << "Expected an equal sign";
-                            return false;
-                        }
-
-                        ++iterator;
-
-                        if (!skipWhitespaces(str, iterator)) return false;
-
-                        if (!parseString(str, iterator, attributes[attribute])) return false;
+                        if (!parseAttribute(iterator, end)) return false;
                     }
 
                     type = Type::PROCESSING_INSTRUCTION;
-
-                    return true;
                 }
                 else // <
                 {
-                    if (!parseName(str, iterator, value)) return false;
+                    if (!parseName(iterator, end, value)) return false;
 
                     bool tagClosed = false;
 
                     for (;;)
                     {
-                        if (!skipWhitespaces(str, iterator)) return false;
+                        skipWhitespaces(iterator, end);
 
-                        if (iterator == str.end())
+                        if (iterator == end)
                         {
                             Log(Log::Level::ERR) << "Unexpected end of data";
                             return false;
@@ -505,7 +519,7 @@ namespace ouzel
                         }
                         else if (*iterator == '/')
                         {
-                            if (++iterator == str.end())
+                            if (++iterator == end)
                             {
                                 Log(Log::Level::ERR) << "Unexpected end of data";
                                 return false;
@@ -522,64 +536,37 @@ namespace ouzel
                             break;
                         }
 
-                        std::string attribute;
-                        if (!parseName(str, iterator, attribute)) return false;
-
-                        if (!skipWhitespaces(str, iterator)) return false;
-
-                        if (iterator == str.end())
-                        {
-                            Log(Log::Level::ERR) << "Unexpected end of data";
-                            return false;
-                        }
-
-                        if (*iterator != '=')
-                        {
-                            Log(Log::Level::ERR) << "Expected an equal sign";
-                            return false;
-                        }
-
-                        ++iterator;
-
-                        if (!skipWhitespaces(str, iterator)) return false;
-
-                        if (!parseString(str, iterator, attributes[attribute])) return false;
+                        if (!parseAttribute(iterator, end)) return false;
                     }
 
                     if (!tagClosed)
                     {
                         for (;;)
                         {
-                            if (!preserveWhitespaces) skipWhitespaces(str, iterator);
+                            if (!preserveWhitespaces) skipWhitespaces(iterator, end);
 
-                            if (iterator == str.end())
+                            if (iterator == end)
                             {
                                 Log(Log::Level::ERR) << "Unexpected end of data";
                                 return false;
                             }
 
                             if (*iterator == '<' &&
-                                iterator + 1 != str.end() &&
-                                *(iterator + 1) == '/')
+                                end - iterator > 1 &&
+                                iterator[1] == '/')
                             {
-                                ++iterator; // skip the left angle bracket
-                                ++iterator; // skip the slash
+                                iterator += 2; // skip the left angle bracket and the slash
 
-                                std::string tag;
-                                if (!parseName(str, iterator, tag)) return false;
+                                const uint8_t* tag = iterator;
+                                if (!skipName(iterator, end)) return false;
 
-                                if (tag != value)
+                                if (static_cast<size_t>(iterator - tag) != value.length() ||
+                                    memcmp(tag, value.data(), value.length()) != 0)
                                 {
                                     Log(Log::Level::ERR) << "Tag not closed properly";
                                     return false;
                                 }
 
-                                if (iterator == str.end())
-                                {
-                                    Log(Log::Level::ERR) << "Unexpected end of data";
-                                    return false;
-                                }
-
                                 if (*iterator != '>')
                                 {
                                     Log(Log::Level::ERR) << "Expected a right angle bracket";
@@ -592,51 +579,50 @@ namespace ouzel
                             }
                             else
                             {
-                                Node node;
-                                if (!node.parse(str, iterator, preserveWhitespaces, preserveComments, preserveProcessingInstructions))
+                                // parse the child in place instead of copying it into the vector
+                                children.emplace_back();
+                                Node& node = children.back();
+
+                                if (!node.parse(iterator, end, preserveWhitespaces, preserveComments, preserveProcessingInstructions))
                                 {
                                     return false;
                                 }
 
-                                if ((preserveComments || node.getType() != Type::COMMENT) &&
-                                    (preserveProcessingInstructions || node.getType() != Type::PROCESSING_INSTRUCTION))
+                                if ((!preserveComments && node.getType() == Type::COMMENT) ||
+                                    (!preserveProcessingInstructions && node.getType() == Type::PROCESSING_INSTRUCTION))
                                 {
-                                    children.push_back(node);
+                                    children.pop_back();
                                 }
                             }
                         }
                     }
 
                     type = Type::TAG;
-
-                    return true;
                 }
             }
             else
             {
+                const uint8_t* start = iterator;
+
                 for (;;)
                 {
-                    if (iterator == str.end() || // end of a file
+                    if (iterator == end || // end of a file
                         *iterator == '<') // start of a tag
                     {
+                        append(value, start, iterator);
                         break;
                     }
                     else if (*iterator == '&')
                     {
-                        std::string entity;
-                        if (!parseEntity(str, iterator, entity)) return false;
-                        value += entity;
+                        append(value, start, iterator);
+                        if (!parseEntity(iterator, end, value)) return false;
+                        start = iterator;
                     }
                     else
-                    {
-                        value += utf32ToUtf8(*iterator);
                         ++iterator;
-                    }
                 }
 
                 type = Type::TEXT;
-
-                return true;
             }
 
             return true;
@@ -658,46 +644,17 @@ namespace ouzel
                     break;
                 case Node::Type::TYPE_DECLARATION:
                     Log(Log::Level::ERR) << "Type declarations are not supported";
-                    break;
+                    return false;
                 case Node::Type::PROCESSING_INSTRUCTION:
                     data.insert(data.end(), {'<', '?'});
                     data.insert(data.end(), value.begin(), value.end());
-
-                    if (attributes.empty())
-                    {
-                        data.insert(data.end(), ' ');
-                    }
-                    else
-                    {
-                        for (const auto& attribute : attributes)
-                        {
-                            data.insert(data.end(), attribute.first.begin(), attribute.first.end());
-                            data.insert(data.end(), {'=', '"'});
-                            if (!encodeString(data, utf8ToUtf32(attribute.second))) return false;
-                            data.insert(data.end(), '"');
-                        }
-                    }
-
+                    encodeAttributes(data, attributes);
                     data.insert(data.end(), {'?', '>'});
                     break;
                 case Node::Type::TAG:
-                    data.insert(data.end(), '<');
+                    data.push_back('<');
                     data.insert(data.end(), value.begin(), value.end());
-
-                    if (attributes.empty())
-                    {
-                        data.insert(data.end(), ' ');
-                    }
-                    else
-                    {
-                        for (const auto& attribute : attributes)
-                        {
-                            data.insert(data.end(), attribute.first.begin(), attribute.first.end());
-                            data.insert(data.end(), {'=', '"'});
-                            data.insert(data.end(), attribute.second.begin(), attribute.second.end());
-                            data.insert(data.end(), '"');
-                        }
-                    }
+                    encodeAttributes(data, attributes);
 
                     if (children.empty())
                     {
@@ -705,30 +662,25 @@ namespace ouzel
                     }
                     else
                     {
-                        data.insert(data.end(), '>');
+                        data.push_back('>');
 
                         for (const Node& node : children)
                         {
-                            node.encode(data);
+                            if (!node.encode(data)) return false;
                         }
 
                         data.insert(data.end(), {'<', '/'});
                         data.insert(data.end(), value.begin(), value.end());
-                        data.insert(data.end(), '>');
+                        data.push_back('>');
                     }
                     break;
                 case Node::Type::TEXT:
-                    if (!encodeString(data, utf8ToUtf32(value))) return false;
+                    encodeString(data, value);
                     break;
                 default:
                     return false;
             }
 
-            for (const Node& node : children)
-            {
-                node.encode(data);
-            }
-
             return true;
         }
 
@@ -763,14 +715,14 @@ namespace ouzel
                         bool preserveComments,
                         bool preserveProcessingInstructions)
         {
-            std::vector<uint8_t> data;
+            MappedFile file;
 
-            if (!engine->getFileSystem()->readFile(filename, data))
+            if (!engine->getFileSystem()->mapFile(filename, file))
             {
                 return false;
             }
 
-            return init(data,
+            return init(file.getData(), file.getSize(),
                         preserveWhitespaces,
                         preserveComments,
                         preserveProcessingInstructions);
@@ -781,35 +733,46 @@ namespace ouzel
                         bool preserveComments,
                         bool preserveProcessingInstructions)
         {
-            std::vector<uint32_t> str;
+            return init(data.data(), static_cast<uint32_t>(data.size()),
+                        preserveWhitespaces,
+                        preserveComments,
+                        preserveProcessingInstructions);
+        }
+
+        bool Data::init(const uint8_t* data, uint32_t size,
+                        bool preserveWhitespaces,
+                        bool preserveComments,
+                        bool preserveProcessingInstructions)
+        {
+            const uint8_t* iterator = data;
+            const uint8_t* end = data + size;
 
             // BOM
-            if (data.size() >= 3 &&
+            if (size >= 3 &&
                 data[0] == 0xEF &&
                 data[1] == 0xBB &&
                 data[2] == 0xBF)
             {
                 bom = true;
-                str = utf8ToUtf32(std::vector<uint8_t>(data.begin() + 3, data.end()));
+                iterator += 3;
             }
             else
-            {
                 bom = false;
-                str = utf8ToUtf32(data);
-            }
 
-            bool rootTagFound = false;
+            children.clear();
 
-            std::vector<uint32_t>::const_iterator iterator = str.cbegin();
+            bool rootTagFound = false;
 
             for (;;)
             {
-                if (!preserveWhitespaces) skipWhitespaces(str, iterator);
+                if (!preserveWhitespaces) skipWhitespaces(iterator, end);
 
-                if (iterator == str.end()) break;
+                if (iterator == end) break;
 
-                Node node;
-                if (!node.parse(str, iterator,
+                children.emplace_back();
+                Node& node = children.back();
+
+                if (!node.parse(iterator, end,
                                 preserveWhitespaces,
                                 preserveComments,
                                 preserveProcessingInstructions))
@@ -817,22 +780,21 @@ namespace ouzel
                     return false;
                 }
 
-                if ((preserveComments || node.getType() != Node::Type::COMMENT) &&
-                    (preserveProcessingInstructions || node.getType() != Node::Type::PROCESSING_INSTRUCTION))
+                if ((!preserveComments && node.getType() == Node::Type::COMMENT) ||
+                    (!preserveProcessingInstructions && node.getType() == Node::Type::PROCESSING_INSTRUCTION))
                 {
-                    children.push_back(node);
-
-                    if (node.getType() == Node::Type::TAG)
+                    children.pop_back();
+                }
+                else if (node.getType() == Node::Type::TAG)
+                {
+                    if (rootTagFound)
                     {
-                        if (rootTagFound)
-                        {
-                            Log(Log::Level::ERR) << "Multiple root tags found";
-                            return false;
-                        }
-                        else
-                        {
-                            rootTagFound = true;
-                        }
+                        Log(Log::Level::ERR) << "Multiple root tags found";
+                        return false;
+                    }
+                    else
+                    {
+                        rootTagFound = true;
                     }
                 }
             }
@@ -3,8 +3,9 @@
 
 #pragma once
 
-#include <map>
+#include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ouzel
@@ -37,22 +38,61 @@ namespace ouzel
             inline Type getType() const { return type; }
 
             inline const std::string& getValue() const { return value; }
-            inline void getValue(const std::string& newValue) { value = newValue; }
+            inline void setValue(const std::string& newValue) { value = newValue; }
 
+            inline bool hasAttribute(const std::string& name) const
+            {
+                auto i = findAttribute(name);
+                return i != attributes.end() && i->first == name;
+            }
+
+            inline const std::string& getAttribute(const std::string& name) const
+            {
+                auto i = findAttribute(name);
+                if (i != attributes.end() && i->first == name) return i->second;
+                else return EMPTY;
+            }
+
+            inline void setAttribute(const std::string& name, const std::string& newValue)
+            {
+                auto i = findAttribute(name);
+                if (i != attributes.end() && i->first == name) i->second = newValue;
+                else attributes.insert(i, std::make_pair(name, newValue));
+            }
+
+            // attributes are sorted by their names
+            inline const std::vector<std::pair<std::string, std::string>>& getAttributes() const { return attributes; }
+
+            inline std::vector<Node>& getChildren() { return children; }
             inline const std::vector<Node>& getChildren() const { return children; }
 
-            bool parse(const std::vector<uint32_t>& str,
-                       std::vector<uint32_t>::const_iterator& iterator,
+            bool parse(const uint8_t*& iterator, const uint8_t* end,
                        bool preserveWhitespaces = false,
                        bool preserveComments = false,
                        bool preserveProcessingInstructions = false);
             bool encode(std::vector<uint8_t>& data) const;
 
         protected:
+            static const std::string EMPTY;
+
+            inline std::vector<std::pair<std::string, std::string>>::iterator findAttribute(const std::string& name)
+            {
+                return std::lower_bound(attributes.begin(), attributes.end(), name,
+                                        [](const std::pair<std::string, std::string>& a, const std::string& b) { return a.first < b; });
+            }
+
+            inline std::vector<std::pair<std::string, std::string>>::const_iterator findAttribute(const std::string& name) const
+            {
+                return std::lower_bound(attributes.begin(), attributes.end(), name,
+                                        [](const std::pair<std::string, std::string>& a, const std::string& b) { return a.first < b; });
+            }
+
+            bool parseAttribute(const uint8_t*& iterator, const uint8_t* end);
+
             Type type = Type::NONE;
 
             std::string value;
-            std::map<std::string, std::string> attributes;
+            std::vector<std::pair<std::string, std::string>> attributes; // sorted by name, looked up with a binary search
             std::vector<Node> children;
         };
 
@@ -77,6 +117,10 @@ namespace ouzel
                       bool preserveWhitespaces = false,
                       bool preserveComments = false,
                       bool preserveProcessingInstructions = false);
+            bool init(const uint8_t* data, uint32_t size,
+                      bool preserveWhitespaces = false,
+                      bool preserveComments = false,
+                      bool preserveProcessingInstructions = false);
 
             bool save(const std::string& filename) const;
             bool encode(std::vector<uint8_t>& data) const;
@@ -84,6 +128,7 @@ namespace ouzel
             inline bool hasBOM() const { return bom; }
             inline void setBOM(bool newBOM) { bom = newBOM; }
 
+            inline std::vector<Node>& getChildren() { return children; }
             inline const std::vector<Node>& getChildren() const { return children; }
 
         protected:
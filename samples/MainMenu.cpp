@@ -22,6 +22,9 @@ MainMenu::MainMenu():
     inputButton("button.png", "button_selected.png", "button_down.png", "", "Input", "arial.fnt", 1.0f, Color(20, 0, 0, 255), Color::BLACK, Color::BLACK),
     soundButton("button.png", "button_selected.png", "button_down.png", "", "Sound", "arial.fnt", 1.0f, Color(20, 0, 0, 255), Color::BLACK, Color::BLACK),
     perspectiveButton("button.png", "button_selected.png", "button_down.png", "", "Perspective", "arial.fnt", 1.0f, Color(20, 0, 0, 255), Color::BLACK, Color::BLACK)
+#if OUZEL_ENABLE_PROFILER
+    , profilerLabel("", "arial.fnt", 0.5f, Color::WHITE, Vector2(0.0f, 1.0f))
+#endif
 {
     eventHandler.uiHandler = bind(&MainMenu::handleUI, this, placeholders::_1, placeholders::_2);
     eventHandler.keyboardHandler = bind(&MainMenu::handleKeyboard, this, placeholders::_1, placeholders::_2);
@@ -59,6 +62,22 @@ MainMenu::MainMenu():
 
     perspectiveButton.setPosition(Vector2(0.0f, -160.0f));
     menu.addWidget(&perspectiveButton);
+
+#if OUZEL_ENABLE_PROFILER
+    profilerLabel.setPosition(Vector2(-190.0f, 290.0f));
+    layer.addChild(&profilerLabel);
+
+    // the summary of the last second is refreshed once per second
+    profilerUpdate.callback = [this](float delta) {
+        profilerTime += delta;
+        if (profilerTime >= 1.0f)
+        {
+            profilerTime = 0.0f;
+            profilerLabel.setText(engine->getProfiler()->getSummary(1.0f));
+        }
+    };
+    engine->scheduleUpdate(&profilerUpdate);
+#endif
 }
 
 bool MainMenu::handleKeyboard(Event::Type type, const KeyboardEvent& event)
@@ -72,6 +91,16 @@ bool MainMenu::handleKeyboard(Event::Type type, const KeyboardEvent& event)
 
         return false;
     }
+#if OUZEL_ENABLE_PROFILER
+    else if (event.key == ouzel::input::KeyboardKey::P)
+    {
+        // open the trace in chrome://tracing
+        if (type == Event::Type::KEY_PRESS)
+            engine->getProfiler()->exportTrace(engine->getFileSystem()->getStorageDirectory() + FileSystem::DIRECTORY_SEPARATOR + "trace.json");
+
+        return false;
+    }
+#endif
 
     return true;
 }
@@ -27,4 +27,10 @@ private:
     ouzel::gui::Button inputButton;
     ouzel::gui::Button soundButton;
     ouzel::gui::Button perspectiveButton;
+
+#if OUZEL_ENABLE_PROFILER
+    ouzel::gui::Label profilerLabel;
+    ouzel::UpdateCallback profilerUpdate;
+    float profilerTime = 0.0f;
+#endif
 };
@@ -0,0 +1,43 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+cbuffer Constants: register(b0)
+{
+    float4x4 model;
+}
+
+cbuffer CameraConstants: register(b2)
+{
+    float4x4 viewProj;
+}
+
+struct VSInput
+{
+    float3 position: POSITION;
+    float4 color: COLOR;
+    float2 texCoord0: TEXCOORD0;
+    float4 instanceTransform0: INSTANCETRANSFORM0; // one column of the instance transform per element
+    float4 instanceTransform1: INSTANCETRANSFORM1;
+    float4 instanceTransform2: INSTANCETRANSFORM2;
+    float4 instanceTransform3: INSTANCETRANSFORM3;
+    float4 instanceColor: INSTANCECOLOR;
+};
+
+struct VS2PS
+{
+    float4 position: SV_POSITION;
+    float4 color: COLOR;
+    float2 texCoord: TEXCOORD;
+};
+
+void main(in VSInput input, out VS2PS output)
+{
+    float4 instancePosition = input.instanceTransform0 * input.position.x +
+                              input.instanceTransform1 * input.position.y +
+                              input.instanceTransform2 * input.position.z +
+                              input.instanceTransform3;
+
+    output.position = mul(viewProj, mul(model, instancePosition));
+    output.color = input.color * input.instanceColor;
+    output.texCoord = input.texCoord0;
+}
@@ -2,4 +2,7 @@ fxc /Zi /E"main" /Od /Fh"../../ouzel/graphics/direct3d11/TexturePSD3D11.h" /Vn"T
 fxc /Zi /E"main" /Od /Fh"../../ouzel/graphics/direct3d11/TextureVSD3D11.h" /Vn"TEXTURE_VERTEX_SHADER_D3D11" /T vs_4_0_level_9_1 /nologo TextureVS.hlsl
 
 fxc /Zi /E"main" /Od /Fh"../../ouzel/graphics/direct3d11/ColorPSD3D11.h" /Vn"COLOR_PIXEL_SHADER_D3D11" /T ps_4_0_level_9_1 /nologo ColorPS.hlsl
-fxc /Zi /E"main" /Od /Fh"../../ouzel/graphics/direct3d11/ColorVSD3D11.h" /Vn"COLOR_VERTEX_SHADER_D3D11" /T vs_4_0_level_9_1 /nologo ColorVS.hlsl
\ No newline at end of file
+fxc /Zi /E"main" /Od /Fh"../../ouzel/graphics/direct3d11/ColorVSD3D11.h" /Vn"COLOR_VERTEX_SHADER_D3D11" /T vs_4_0_level_9_1 /nologo ColorVS.hlsl
+
+rem the instanced vertex shader is compiled by the render device at runtime (it needs feature level 9_3), only its source is embedded:
+rem xxd -i TextureInstancedVS.hlsl ../../ouzel/graphics/direct3d11/TextureInstancedVSD3D11.h
\ No newline at end of file
@@ -0,0 +1,20 @@
+#version 300 es
+precision highp float;
+in vec3 position0;
+in vec4 color0;
+in vec2 texCoord0;
+in mat4 instanceTransform0;
+in vec4 instanceColor0;
+layout(std140) uniform CameraConstants
+{
+    mat4 viewProj;
+};
+uniform mat4 model;
+out lowp vec4 exColor;
+out vec2 exTexCoord;
+void main()
+{
+    gl_Position = viewProj * model * instanceTransform0 * vec4(position0, 1.0);
+    exColor = color0 * instanceColor0;
+    exTexCoord = texCoord0;
+}
@@ -2,12 +2,16 @@
 in vec3 position0;
 in vec4 color0;
 in vec2 texCoord0;
-uniform mat4 modelViewProj;
+layout(std140) uniform CameraConstants
+{
+    mat4 viewProj;
+};
+uniform mat4 model;
 out vec4 exColor;
 out vec2 exTexCoord;
 void main()
 {
-    gl_Position = modelViewProj * vec4(position0, 1.0);
+    gl_Position = viewProj * model * vec4(position0, 1.0);
     exColor = color0;
     exTexCoord = texCoord0;
 }
@@ -0,0 +1,134 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+// Converts sprite sheets, particle systems and BMFont descriptors to the compiled format,
+// so that the loaders do not have to parse text at startup.
+// Usage: bake [-type sprite|particle_system|font] input output
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "assets/LoaderParticleSystem.hpp"
+#include "assets/LoaderSprite.hpp"
+#include "gui/BMFont.hpp"
+
+// required by the engine library, the engine itself is never started
+std::string DEVELOPER_NAME = "org.ouzel";
+std::string APPLICATION_NAME = "bake";
+
+void ouzelMain(const std::vector<std::string>&)
+{
+}
+
+using namespace ouzel;
+
+static bool readFile(const std::string& filename, std::vector<uint8_t>& data)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) return false;
+
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static bool writeFile(const std::string& filename, const std::vector<uint8_t>& data)
+{
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) return false;
+
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return file.good();
+}
+
+static bool bakeSprite(const std::vector<uint8_t>& data, std::vector<uint8_t>& result)
+{
+    assets::LoaderSprite::SheetDescription sheet;
+    return assets::LoaderSprite::parse(data.data(), static_cast<uint32_t>(data.size()), sheet) &&
+        assets::LoaderSprite::bake(sheet, result);
+}
+
+static bool bakeParticleSystem(const std::vector<uint8_t>& data, std::vector<uint8_t>& result)
+{
+    scene::ParticleSystemData particleSystemData;
+    std::string textureFilename;
+    return assets::LoaderParticleSystem::parse(data.data(), static_cast<uint32_t>(data.size()), particleSystemData, textureFilename) &&
+        assets::LoaderParticleSystem::bake(particleSystemData, textureFilename, result);
+}
+
+static bool bakeFont(const std::vector<uint8_t>& data, std::vector<uint8_t>& result)
+{
+    BMFont font;
+    return font.parse(data.data(), static_cast<uint32_t>(data.size())) &&
+        font.bake(result);
+}
+
+int main(int argc, char* argv[])
+{
+    std::string type;
+    std::vector<std::string> filenames;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "-type" && i + 1 < argc)
+            type = argv[++i];
+        else
+            filenames.push_back(arg);
+    }
+
+    if (filenames.size() != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " [-type sprite|particle_system|font] input output" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string& input = filenames[0];
+    const std::string& output = filenames[1];
+
+    std::vector<uint8_t> data;
+    if (!readFile(input, data))
+    {
+        std::cerr << "Failed to read " << input << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (type.empty())
+    {
+        std::string::size_type pos = input.rfind('.');
+        std::string extension = (pos == std::string::npos) ? std::string() : input.substr(pos + 1);
+
+        if (extension == "fnt") type = "font";
+    }
+
+    std::vector<uint8_t> result;
+    bool baked = false;
+
+    if (type == "sprite") baked = bakeSprite(data, result);
+    else if (type == "particle_system") baked = bakeParticleSystem(data, result);
+    else if (type == "font") baked = bakeFont(data, result);
+    else if (type.empty()) // JSON files can be either sprite sheets or particle systems
+        baked = bakeSprite(data, result) || bakeParticleSystem(data, result);
+    else
+    {
+        std::cerr << "Invalid type " << type << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (!baked)
+    {
+        std::cerr << "Failed to bake " << input << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (!writeFile(output, result))
+    {
+        std::cerr << "Failed to write " << output << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+// Measures the update scheduler with lots of callbacks spread across priorities and both update phases.
+// Usage: benchmark [-callbacks count] [-priorities count] [-frames count]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "core/UpdateScheduler.hpp"
+
+// required by the engine library, the engine itself is never started
+std::string DEVELOPER_NAME = "org.ouzel";
+std::string APPLICATION_NAME = "benchmark";
+
+void ouzelMain(const std::vector<std::string>&)
+{
+}
+
+using namespace ouzel;
+
+typedef std::chrono::steady_clock Clock;
+
+static double getMilliseconds(const Clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static void printResult(const std::string& name, double milliseconds)
+{
+    std::cout << name << ": " << milliseconds << " ms" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t callbackCount = 100000;
+    uint32_t priorityCount = 16;
+    uint32_t frameCount = 100;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "-callbacks" && i + 1 < argc)
+            callbackCount = static_cast<uint32_t>(std::stoul(argv[++i]));
+        else if (arg == "-priorities" && i + 1 < argc)
+            priorityCount = static_cast<uint32_t>(std::stoul(argv[++i]));
+        else if (arg == "-frames" && i + 1 < argc)
+            frameCount = static_cast<uint32_t>(std::stoul(argv[++i]));
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [-callbacks count] [-priorities count] [-frames count]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!priorityCount) priorityCount = 1;
+    if (!frameCount) frameCount = 1;
+
+    // every fourth callback runs in the fixed phase
+    std::vector<std::unique_ptr<UpdateCallback>> callbacks;
+    callbacks.reserve(callbackCount);
+
+    uint64_t calls = 0;
+
+    for (uint32_t i = 0; i < callbackCount; ++i)
+    {
+        UpdateCallback::Phase phase = (i % 4 == 0) ? UpdateCallback::Phase::FIXED : UpdateCallback::Phase::VARIABLE;
+        int32_t priority = static_cast<int32_t>(i % priorityCount);
+
+        std::unique_ptr<UpdateCallback> callback(new UpdateCallback(priority, phase));
+        callback->callback = [&calls](float) { ++calls; };
+        callbacks.push_back(std::move(callback));
+    }
+
+    UpdateScheduler scheduler;
+
+    // one fixed step per frame
+    const float delta = scheduler.getFixedStep();
+
+    Clock::time_point start = Clock::now();
+    for (const std::unique_ptr<UpdateCallback>& callback : callbacks)
+        scheduler.add(callback.get());
+    printResult("Add " + std::to_string(callbackCount) + " callbacks", getMilliseconds(start));
+
+    // the first update moves the pending callbacks into their buckets
+    start = Clock::now();
+    scheduler.update(delta);
+    printResult("First update", getMilliseconds(start));
+
+    start = Clock::now();
+    for (uint32_t frame = 0; frame < frameCount; ++frame)
+        scheduler.update(delta);
+    printResult("Update (average of " + std::to_string(frameCount) + " frames)", getMilliseconds(start) / frameCount);
+
+    // remove every other callback, so that all of the buckets have to be compacted
+    start = Clock::now();
+    for (size_t i = 0; i < callbacks.size(); i += 2)
+        scheduler.remove(callbacks[i].get());
+    scheduler.update(delta);
+    printResult("Remove half of the callbacks and update", getMilliseconds(start));
+
+    start = Clock::now();
+    for (size_t i = 1; i < callbacks.size(); i += 2)
+        scheduler.remove(callbacks[i].get());
+    printResult("Remove the rest of the callbacks", getMilliseconds(start));
+
+    scheduler.clear();
+
+    std::cout << "Callbacks called: " << calls << std::endl;
+
+    return EXIT_SUCCESS;
+}